@@ -41,6 +41,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "renderer/Material.h"
 #include "renderer/RenderWorld.h"
 #include "sys/sys_public.h"
+#include "framework/JobSystem.h"
 
 #include "cm/CollisionModel_local.h"
 
@@ -354,6 +355,7 @@ static idCVar cm_testWalk(			"cm_testWalk",			"1",					CVAR_GAME | CVAR_BOOL,		"
 static idCVar cm_testLength(		"cm_testLength",		"1024",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testRadius(		"cm_testRadius",		"64",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testAngle(			"cm_testAngle",			"60",					CVAR_GAME | CVAR_FLOAT,		"" );
+static idCVar cm_testThreads(		"cm_testThreads",		"0",					CVAR_GAME | CVAR_BOOL,		"run the test traces serially and from the job threads and compare the results" );
 
 static unsigned int total_translation;
 static unsigned int min_translation = 999999;
@@ -486,6 +488,192 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 		common->Printf("%s rotation: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_rotation, max_rotation, (float) total_rotation / num_rotation );
 	}
 
+	if ( cm_testThreads.GetBool() ) {
+		TestThreads( start, &itm, boxAxis, cm_testModel.GetInteger(), random );
+	}
+
 	Mem_Free( testend );
 	testend = NULL;
 }
+
+/*
+===============================================================================
+
+Thread stress test
+
+===============================================================================
+*/
+
+#define CM_THREADTEST_CONTACTS		4
+#define CM_THREADTEST_CHUNK			16
+
+typedef struct {
+	trace_t					translation;
+	trace_t					rotation;
+	int						contents;
+	int						numContacts;
+	contactInfo_t			contacts[CM_THREADTEST_CONTACTS];
+} cm_threadTestResult_t;
+
+typedef struct {
+	idCollisionModelManagerLocal *cm;
+	const idTraceModel *	trm;
+	idMat3					trmAxis;
+	idVec3					start;
+	int						model;
+	idVec3					rotationVec;
+	float					rotationAngle;
+	int						numTests;
+	const idVec3 *			ends;
+	const idVec3 *			rotationOrigins;
+	cm_threadTestResult_t *	results;
+} cm_threadTest_t;
+
+/*
+================
+CM_ThreadTestJob
+================
+*/
+static void CM_ThreadTestJob( void *data, int jobNum ) {
+	cm_threadTest_t *test = (cm_threadTest_t *) data;
+	cm_threadTestResult_t *result;
+	int i, last, contentMask;
+	idVec6 dir;
+
+	contentMask = CONTENTS_SOLID|CONTENTS_PLAYERCLIP;
+	dir.Zero();
+	dir[2] = -1.0f;
+
+	last = Min( ( jobNum + 1 ) * CM_THREADTEST_CHUNK, test->numTests );
+	for ( i = jobNum * CM_THREADTEST_CHUNK; i < last; i++ ) {
+		idRotation rotation( test->rotationOrigins[i], test->rotationVec, test->rotationAngle );
+
+		result = &test->results[i];
+		test->cm->Translation( &result->translation, test->start, test->ends[i], test->trm, test->trmAxis, contentMask, test->model, vec3_origin, mat3_identity );
+		test->cm->Rotation( &result->rotation, test->start, rotation, test->trm, test->trmAxis, contentMask, test->model, vec3_origin, mat3_identity );
+		result->contents = test->cm->Contents( test->ends[i], test->trm, test->trmAxis, -1, test->model, vec3_origin, mat3_identity );
+		result->numContacts = test->cm->Contacts( result->contacts, CM_THREADTEST_CONTACTS, result->translation.endpos, dir, CM_CLIP_EPSILON * 4.0f,
+										test->trm, test->trmAxis, contentMask, test->model, vec3_origin, mat3_identity );
+	}
+}
+
+/*
+================
+CM_ContactsEqual
+================
+*/
+static bool CM_ContactsEqual( const contactInfo_t &a, const contactInfo_t &b ) {
+	return ( a.type == b.type && a.point == b.point && a.normal == b.normal && a.dist == b.dist &&
+				a.contents == b.contents && a.material == b.material &&
+				a.modelFeature == b.modelFeature && a.trmFeature == b.trmFeature );
+}
+
+/*
+================
+CM_TracesEqual
+================
+*/
+static bool CM_TracesEqual( const trace_t &a, const trace_t &b ) {
+	if ( a.fraction != b.fraction || a.endpos != b.endpos || a.endAxis != b.endAxis ) {
+		return false;
+	}
+	// contact information is only valid if something was hit
+	if ( a.fraction < 1.0f && !CM_ContactsEqual( a.c, b.c ) ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::TestThreads
+
+  Runs the same set of translations, rotations, contents and contacts queries
+  on the main thread and spread over the job threads. Traces keep all their
+  state in a per thread trace context so the results must be identical.
+================
+*/
+void idCollisionModelManagerLocal::TestThreads( const idVec3 &start, const idTraceModel *trm, const idMat3 &trmAxis, int model, idRandom &random ) {
+	int i, j, numJobs, numErrors;
+	unsigned int serialTime, threadTime;
+	cm_threadTest_t test;
+	cm_threadTestResult_t *serial, *threaded;
+	idVec3 *ends, *rotationOrigins;
+	idTimer timer;
+
+	test.cm = this;
+	test.trm = trm;
+	test.trmAxis = trmAxis;
+	test.start = start;
+	test.model = model;
+	test.rotationVec.Set( random.CRandomFloat(), random.CRandomFloat(), random.RandomFloat() );
+	test.rotationVec.Normalize();
+	test.rotationAngle = cm_testAngle.GetFloat();
+	test.numTests = cm_testTimes.GetInteger();
+	if ( test.numTests <= 0 ) {
+		return;
+	}
+
+	ends = (idVec3 *) Mem_Alloc( test.numTests * sizeof( idVec3 ) );
+	rotationOrigins = (idVec3 *) Mem_Alloc( test.numTests * sizeof( idVec3 ) );
+	serial = (cm_threadTestResult_t *) Mem_ClearedAlloc( test.numTests * sizeof( cm_threadTestResult_t ) );
+	threaded = (cm_threadTestResult_t *) Mem_ClearedAlloc( test.numTests * sizeof( cm_threadTestResult_t ) );
+
+	for ( i = 0; i < test.numTests; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			ends[i][j] = start[j] + random.CRandomFloat() * cm_testLength.GetFloat();
+			rotationOrigins[i][j] = start[j] + random.CRandomFloat() * cm_testRadius.GetFloat();
+		}
+	}
+	test.ends = ends;
+	test.rotationOrigins = rotationOrigins;
+
+	numJobs = ( test.numTests + CM_THREADTEST_CHUNK - 1 ) / CM_THREADTEST_CHUNK;
+
+	// everything on the calling thread
+	test.results = serial;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < numJobs; i++ ) {
+		CM_ThreadTestJob( &test, i );
+	}
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	// spread over the job threads
+	test.results = threaded;
+	timer.Clear();
+	timer.Start();
+	jobSystem->RunJobs( CM_ThreadTestJob, &test, numJobs );
+	timer.Stop();
+	threadTime = timer.Milliseconds();
+
+	numErrors = 0;
+	for ( i = 0; i < test.numTests; i++ ) {
+		bool equal = CM_TracesEqual( serial[i].translation, threaded[i].translation ) &&
+						CM_TracesEqual( serial[i].rotation, threaded[i].rotation ) &&
+						serial[i].contents == threaded[i].contents &&
+						serial[i].numContacts == threaded[i].numContacts;
+		for ( j = 0; equal && j < serial[i].numContacts; j++ ) {
+			equal = CM_ContactsEqual( serial[i].contacts[j], threaded[i].contacts[j] );
+		}
+		if ( !equal ) {
+			if ( numErrors < 8 ) {
+				common->Printf( "test %d: threaded result differs (translation %1.4f/%1.4f, rotation %1.4f/%1.4f, contents %d/%d, contacts %d/%d)\n", i,
+								serial[i].translation.fraction, threaded[i].translation.fraction,
+								serial[i].rotation.fraction, threaded[i].rotation.fraction,
+								serial[i].contents, threaded[i].contents,
+								serial[i].numContacts, threaded[i].numContacts );
+			}
+			numErrors++;
+		}
+	}
+
+	common->Printf( "%d thread tests: %4u milliseconds serial, %4u milliseconds on %d threads, %d mismatches\n",
+					test.numTests, serialTime, threadTime, jobSystem->GetNumThreads(), numErrors );
+
+	Mem_Free( threaded );
+	Mem_Free( serial );
+	Mem_Free( rotationOrigins );
+	Mem_Free( ends );
+}
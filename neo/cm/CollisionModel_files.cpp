@@ -329,9 +329,6 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
-		model->vertices[i].checkcount = 0;
 	}
 	src->ExpectTokenString( "}" );
 }
@@ -353,8 +350,6 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
@@ -544,6 +539,8 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 						model->numNodes * sizeof(cm_node_t) +
 						model->numPolygonRefs * sizeof(cm_polygonRef_t) +
 						model->numBrushRefs * sizeof(cm_brushRef_t);
+	// per thread trace marks
+	SetupModelMarks( model );
 
 	return true;
 }
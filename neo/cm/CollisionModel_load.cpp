@@ -185,15 +185,11 @@ void idCollisionModelManagerLocal::Clear( void ) {
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
-	memset( trmPolygons, 0, sizeof( trmPolygons ) );
-	trmBrushes[0] = NULL;
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
+	numTraceContexts = 0;
+	memset( traceContexts, 0, sizeof( traceContexts ) );
 }
 
 /*
@@ -393,6 +389,8 @@ void idCollisionModelManagerLocal::FreeModel( cm_model_t *model ) {
 	Mem_Free( model->polygonBlock );
 	// free block allocated brushes
 	Mem_Free( model->brushBlock );
+	// free trace marks
+	FreeModelMarks( model );
 	// free edges
 	Mem_Free( model->edges );
 	// free vertices
@@ -436,21 +434,27 @@ idCollisionModelManagerLocal::FreeTrmModelStructure
 ================
 */
 void idCollisionModelManagerLocal::FreeTrmModelStructure( void ) {
-	int i;
+	int i, j;
+	cm_traceContext_t *context;
 
 	assert( models );
 	if ( !models[MAX_SUBMODELS] ) {
 		return;
 	}
 
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
-	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+	for ( i = 0; i < numTraceContexts; i++ ) {
+		context = &traceContexts[i];
+		for ( j = 0; j < MAX_TRACEMODEL_POLYS; j++ ) {
+			FreePolygon( context->trmModel, context->trmPolygons[j]->p );
+		}
+		FreeBrush( context->trmModel, context->trmBrushes[0]->b );
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+		context->trmModel->node->polygons = NULL;
+		context->trmModel->node->brushes = NULL;
+		FreeModel( context->trmModel );
+		context->trmModel = NULL;
+	}
+	models[MAX_SUBMODELS] = NULL;
 }
 
 
@@ -555,6 +559,9 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel( void ) {
 	model->brushRefBlocks = NULL;
 	model->polygonBlock = NULL;
 	model->brushBlock = NULL;
+	model->numPolygonMarks = 0;
+	model->numBrushMarks = 0;
+	model->marks = NULL;
 	model->numPolygons = model->polygonMemory =
 	model->numBrushes = model->brushMemory =
 	model->numNodes = model->numBrushRefs =
@@ -565,6 +572,103 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel( void ) {
 	return model;
 }
 
+/*
+================
+idCollisionModelManagerLocal::NumberModelMarks_r
+================
+*/
+void idCollisionModelManagerLocal::NumberModelMarks_r( cm_model_t *model, cm_node_t *node ) {
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+
+	while( 1 ) {
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			if ( pref->p->checkcount == checkCount ) {
+				continue;
+			}
+			pref->p->checkcount = checkCount;
+			pref->p->markNum = model->numPolygonMarks++;
+		}
+		for ( bref = node->brushes; bref; bref = bref->next ) {
+			if ( bref->b->checkcount == checkCount ) {
+				continue;
+			}
+			bref->b->checkcount = checkCount;
+			bref->b->markNum = model->numBrushMarks++;
+		}
+		// if leaf node
+		if ( node->planeType == -1 ) {
+			break;
+		}
+		NumberModelMarks_r( model, node->children[1] );
+		node = node->children[0];
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::AllocModelMarks
+
+  every trace context gets its own block so threads never share a cache line
+================
+*/
+void idCollisionModelManagerLocal::AllocModelMarks( cm_model_t *model ) {
+	int i, size;
+	byte *block;
+
+	assert( numTraceContexts > 0 );
+
+	model->marks = (cm_traceMarks_t *) Mem_ClearedAlloc( numTraceContexts * sizeof( cm_traceMarks_t ) );
+	size = ( model->maxVertices + model->maxEdges ) * sizeof( cm_sideMark_t ) +
+			( model->numPolygonMarks + model->numBrushMarks ) * sizeof( int );
+	for ( i = 0; i < numTraceContexts; i++ ) {
+		block = (byte *) Mem_ClearedAlloc( size );
+		model->marks[i].vertices = (cm_sideMark_t *) block;
+		block += model->maxVertices * sizeof( cm_sideMark_t );
+		model->marks[i].edges = (cm_sideMark_t *) block;
+		block += model->maxEdges * sizeof( cm_sideMark_t );
+		model->marks[i].polygons = (int *) block;
+		block += model->numPolygonMarks * sizeof( int );
+		model->marks[i].brushes = (int *) block;
+	}
+	model->usedMemory += numTraceContexts * size;
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeModelMarks
+================
+*/
+void idCollisionModelManagerLocal::FreeModelMarks( cm_model_t *model ) {
+	int i;
+
+	if ( !model->marks ) {
+		return;
+	}
+	for ( i = 0; i < numTraceContexts; i++ ) {
+		Mem_Free( model->marks[i].vertices );
+	}
+	Mem_Free( model->marks );
+	model->marks = NULL;
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupModelMarks
+
+  numbers the polygons and brushes of a completed model and allocates the trace marks
+================
+*/
+void idCollisionModelManagerLocal::SetupModelMarks( cm_model_t *model ) {
+	model->numPolygonMarks = 0;
+	model->numBrushMarks = 0;
+	if ( model->node ) {
+		checkCount++;
+		NumberModelMarks_r( model, model->node );
+	}
+	AllocModelMarks( model );
+}
+
 /*
 ================
 idCollisionModelManagerLocal::AllocNode
@@ -733,51 +837,76 @@ idCollisionModelManagerLocal::SetupTrmModelStructure
 ================
 */
 void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
-	int i;
+	int i, j;
 	cm_node_t *node;
 	cm_model_t *model;
-
-	// setup model
-	model = AllocModel();
+	cm_traceContext_t *context;
 
 	assert( models );
-	models[MAX_SUBMODELS] = model;
-	// create node to hold the collision data
-	node = (cm_node_t *) AllocNode( model, 1 );
-	node->planeType = -1;
-	model->node = node;
-	// allocate vertex and edge arrays
-	model->numVertices = 0;
-	model->maxVertices = MAX_TRACEMODEL_VERTS;
-	model->vertices = (cm_vertex_t *) Mem_ClearedAlloc( model->maxVertices * sizeof(cm_vertex_t) );
-	model->numEdges = 0;
-	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
-	model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
+
 	// create a material for the trace model polygons
 	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
 	if ( !trmMaterial ) {
 		common->FatalError( "_tracemodel material not found" );
 	}
 
-	// allocate polygons
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
-		trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
-		trmPolygons[i]->p->bounds.Clear();
-		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
-		trmPolygons[i]->p->contents = -1;		// all contents
-		trmPolygons[i]->p->material = trmMaterial;
-		trmPolygons[i]->p->numEdges = 0;
+	// one trace context for every thread that can run collision detection
+	numTraceContexts = jobSystem->GetNumThreads();
+
+	for ( i = 0; i < numTraceContexts; i++ ) {
+		context = &traceContexts[i];
+		context->index = i;
+		context->checkCount = 0;
+		context->getContacts = false;
+		context->contacts = NULL;
+		context->maxContacts = 0;
+		context->numContacts = 0;
+
+		// setup model
+		model = AllocModel();
+		context->trmModel = model;
+		// create node to hold the collision data
+		node = (cm_node_t *) AllocNode( model, 1 );
+		node->planeType = -1;
+		model->node = node;
+		// allocate vertex and edge arrays
+		model->numVertices = 0;
+		model->maxVertices = MAX_TRACEMODEL_VERTS;
+		model->vertices = (cm_vertex_t *) Mem_ClearedAlloc( model->maxVertices * sizeof(cm_vertex_t) );
+		model->numEdges = 0;
+		model->maxEdges = MAX_TRACEMODEL_EDGES+1;
+		model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
+
+		// allocate polygons
+		for ( j = 0; j < MAX_TRACEMODEL_POLYS; j++ ) {
+			context->trmPolygons[j] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
+			context->trmPolygons[j]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
+			context->trmPolygons[j]->p->bounds.Clear();
+			context->trmPolygons[j]->p->plane.Zero();
+			context->trmPolygons[j]->p->checkcount = 0;
+			context->trmPolygons[j]->p->markNum = j;
+			context->trmPolygons[j]->p->contents = -1;		// all contents
+			context->trmPolygons[j]->p->material = trmMaterial;
+			context->trmPolygons[j]->p->numEdges = 0;
+		}
+		// allocate brush for position test
+		context->trmBrushes[0] = AllocBrushReference( model, 1 );
+		context->trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
+		context->trmBrushes[0]->b->primitiveNum = 0;
+		context->trmBrushes[0]->b->bounds.Clear();
+		context->trmBrushes[0]->b->checkcount = 0;
+		context->trmBrushes[0]->b->markNum = 0;
+		context->trmBrushes[0]->b->contents = -1;		// all contents
+		context->trmBrushes[0]->b->numPlanes = 0;
+
+		// the polygons and brush are numbered above
+		model->numPolygonMarks = MAX_TRACEMODEL_POLYS;
+		model->numBrushMarks = 1;
+		AllocModelMarks( model );
 	}
-	// allocate brush for position test
-	trmBrushes[0] = AllocBrushReference( model, 1 );
-	trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
-	trmBrushes[0]->b->primitiveNum = 0;
-	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
-	trmBrushes[0]->b->contents = -1;		// all contents
-	trmBrushes[0]->b->numPlanes = 0;
+
+	// the trace model of the main thread is also available through the model array
+	models[MAX_SUBMODELS] = traceContexts[0].trmModel;
 }
 
 /*
@@ -785,7 +914,7 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
 idCollisionModelManagerLocal::SetupTrmModel
 
 Trace models (item boxes, etc) are converted to collision models on the fly, using the last model slot
-as a reusable temporary buffer
+as a reusable temporary buffer. Every thread has its own buffer in its trace context.
 ================
 */
 cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm, const idMaterial *material ) {
@@ -794,6 +923,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	cm_edge_t *edge;
 	cm_polygon_t *poly;
 	cm_model_t *model;
+	cm_traceContext_t *context;
 	const traceModelVert_t *trmVert;
 	const traceModelEdge_t *trmEdge;
 	const traceModelPoly_t *trmPoly;
@@ -804,7 +934,8 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	context = GetTraceContext();
+	model = context->trmModel;
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
@@ -817,7 +948,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	trmVert = trm.verts;
 	for ( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ ) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -828,13 +958,12 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
 	trmPoly = trm.polys;
 	for ( i = 0; i < trm.numPolys; i++, trmPoly++ ) {
-		poly = trmPolygons[i]->p;
+		poly = context->trmPolygons[i]->p;
 		poly->numEdges = trmPoly->numEdges;
 		for ( j = 0; j < trmPoly->numEdges; j++ ) {
 			poly->edges[j] = trmPoly->edges[j];
@@ -844,20 +973,20 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		poly->bounds = trmPoly->bounds;
 		poly->material = material;
 		// link polygon at node
-		trmPolygons[i]->next = model->node->polygons;
-		model->node->polygons = trmPolygons[i];
+		context->trmPolygons[i]->next = model->node->polygons;
+		model->node->polygons = context->trmPolygons[i];
 	}
 	// if the trace model is convex
 	if ( trm.isConvex ) {
 		// setup brush for position test
-		trmBrushes[0]->b->numPlanes = trm.numPolys;
+		context->trmBrushes[0]->b->numPlanes = trm.numPolys;
 		for ( i = 0; i < trm.numPolys; i++ ) {
-			trmBrushes[0]->b->planes[i] = trmPolygons[i]->p->plane;
+			context->trmBrushes[0]->b->planes[i] = context->trmPolygons[i]->p->plane;
 		}
-		trmBrushes[0]->b->bounds = trm.bounds;
+		context->trmBrushes[0]->b->bounds = trm.bounds;
 		// link brush at node
-		trmBrushes[0]->next = model->node->brushes;
-		model->node->brushes = trmBrushes[0];
+		context->trmBrushes[0]->next = model->node->brushes;
+		model->node->brushes = context->trmBrushes[0];
 	}
 	// model bounds
 	model->bounds = trm.bounds;
@@ -2313,7 +2442,6 @@ int idCollisionModelManagerLocal::GetVertex( cm_model_t *model, const idVec3 &v,
 		cm_vertexHash->ResizeIndex( model->maxVertices );
 	}
 	model->vertices[model->numVertices].p = vert;
-	model->vertices[model->numVertices].checkcount = 0;
 	*vertexNum = model->numVertices;
 	// add vertice to hash
 	cm_vertexHash->Add( hashKey, model->numVertices );
@@ -2924,6 +3052,9 @@ void idCollisionModelManagerLocal::OptimizeArrays( cm_model_t *model ) {
 		memcpy( model->edges, oldEdges, model->numEdges * sizeof(cm_edge_t) );
 		Mem_Free( oldEdges );
 	}
+
+	model->maxVertices = model->numVertices;
+	model->maxEdges = model->numEdges;
 }
 
 /*
@@ -3311,6 +3442,7 @@ void idCollisionModelManagerLocal::BuildModels( const idMapFile *mapFile ) {
 			}
 			models[numModels] = CollisionModelForMapEntity( mapEnt );
 			if ( models[ numModels] ) {
+				SetupModelMarks( models[numModels] );
 				numModels++;
 			}
 		}
@@ -3533,6 +3665,7 @@ cmHandle_t idCollisionModelManagerLocal::LoadModel( const char *modelName, const
 	// try to load a .ASE or .LWO model and convert it to a collision model
 	models[numModels] = LoadRenderModel( modelName );
 	if ( models[numModels] != NULL ) {
+		SetupModelMarks( models[numModels] );
 		numModels++;
 		return ( numModels - 1 );
 	}
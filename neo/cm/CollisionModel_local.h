@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 */
 
 #include "idlib/math/Pluecker.h"
+#include "framework/JobSystem.h"
 #include "cm/CollisionModel.h"
 
 #define MIN_NODE_SIZE						64.0f
@@ -81,17 +82,12 @@ Collision model
 
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned int			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned int			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while drawing, traces use cm_traceMarks_t
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned int			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned int			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -103,7 +99,8 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building the model
+	int						markNum;			// index into cm_traceMarks_t::polygons
 	int						contents;			// contents behind polygon
 	const idMaterial *		material;			// material
 	idPlane					plane;				// polygon plane
@@ -127,7 +124,8 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building the model
+	int						markNum;			// index into cm_traceMarks_t::brushes
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial *		material;			// material
@@ -160,6 +158,27 @@ typedef struct cm_nodeBlock_s {
 	struct cm_nodeBlock_s *next;				// next block with nodes
 } cm_nodeBlock_t;
 
+/*
+	Collision detection marks the features it has already visited and caches
+	at which side model and trace model features pass each other. This is
+	kept out of the model geometry in a separate set of marks for every trace
+	context, so traces on different threads never write to shared memory.
+	A mark only belongs to the current trace if its checkcount matches the
+	checkCount of the trace, so marks never have to be cleared.
+*/
+typedef struct cm_sideMark_s {
+	int						checkcount;			// for multi-check avoidance
+	unsigned int			side;				// each bit tells at which side one of the trace model features passes
+	unsigned int			sideSet;			// each bit tells if sidedness for the trace model feature has been calculated yet
+} cm_sideMark_t;
+
+typedef struct cm_traceMarks_s {
+	cm_sideMark_t *			vertices;			// [maxVertices] side of the trace model edges
+	cm_sideMark_t *			edges;				// [maxEdges] side of the trace model vertices
+	int *					polygons;			// [numPolygonMarks] polygon check counts
+	int *					brushes;			// [numBrushMarks] brush check counts
+} cm_traceMarks_t;
+
 typedef struct cm_model_s {
 	idStr					name;				// model name
 	idBounds				bounds;				// model bounds
@@ -179,6 +198,10 @@ typedef struct cm_model_s {
 	cm_brushRefBlock_t *	brushRefBlocks;		// list with blocks of brush references
 	cm_polygonBlock_t *		polygonBlock;		// memory block with all polygons
 	cm_brushBlock_t *		brushBlock;			// memory block with all brushes
+	// trace marks
+	int						numPolygonMarks;	// polygons are numbered when the model is complete
+	int						numBrushMarks;
+	cm_traceMarks_t *		marks;				// [numTraceContexts]
 	// statistics
 	int						numPolygons;
 	int						polygonMemory;
@@ -276,8 +299,31 @@ typedef struct cm_traceWork_s {
 	idPluecker polygonEdgePlueckerCache[CM_MAX_POLYGON_EDGES];
 	idPluecker polygonVertexPlueckerCache[CM_MAX_POLYGON_EDGES];
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
+
+	int checkCount;									// for multi-check avoidance
+	cm_traceMarks_t *marks;							// marks of the model colliding with for this trace context
 } cm_traceWork_t;
 
+/*
+	Everything a trace writes to lives in the trace context of the calling
+	thread, so traces on different job threads can run at the same time.
+*/
+typedef struct cm_traceContext_s {
+	int						index;				// job thread index, also the index into cm_model_t::marks
+	int						checkCount;			// for multi-check avoidance
+	cm_model_t *			trmModel;			// model used by SetupTrmModel on this thread
+	cm_polygonRef_t *		trmPolygons[MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t *			trmBrushes[1];
+	// for retrieving contact points
+	bool					getContacts;
+	contactInfo_t *			contacts;
+	int						maxContacts;
+	int						numContacts;
+	// kept here instead of on the stack because they are large
+	ALIGN16( cm_traceWork_t translationWork );
+	ALIGN16( cm_traceWork_t rotationWork );
+} cm_traceContext_t;
+
 /*
 ===============================================================================
 
@@ -394,6 +440,11 @@ private:			// CollisionMap_contents.cpp
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
 
+private:			// trace contexts
+	cm_traceContext_t *GetTraceContext( void );
+	cm_model_t *	GetTraceModel( cmHandle_t model, const cm_traceContext_t *context ) const;
+	void			SetupTraceMarks( cm_traceWork_t *tw, cm_traceContext_t *context );
+
 private:			// CollisionMap_trace.cpp
 	void			TraceTrmThroughNode( cm_traceWork_t *tw, cm_node_t *node );
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t *tw, cm_node_t *node, float p1f, float p2f, idVec3 &p1, idVec3 &p2);
@@ -403,6 +454,10 @@ private:			// CollisionMap_trace.cpp
 private:			// CollisionMap_load.cpp
 	void			Clear( void );
 	void			FreeTrmModelStructure( void );
+	void			NumberModelMarks_r( cm_model_t *model, cm_node_t *node );
+	void			AllocModelMarks( cm_model_t *model );
+	void			FreeModelMarks( cm_model_t *model );
+	void			SetupModelMarks( cm_model_t *model );
 					// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t *node, cm_polygon_t *p );
 	void			RemoveBrushReferences_r( cm_node_t *node, cm_brush_t *b );
@@ -499,30 +554,64 @@ private:			// CollisionMap_debug
 								const idVec3 &viewOrigin );
 	void			DrawNodePolygons( cm_model_t *model, cm_node_t *node, const idVec3 &origin, const idMat3 &axis,
 								const idVec3 &viewOrigin, const float radius );
+	void			TestThreads( const idVec3 &start, const idTraceModel *trm, const idMat3 &trmAxis, int model, idRandom &random );
 
 private:			// collision map data
 	idStr			mapName;
 	ID_TIME_T			mapFileTime;
 	int				loaded;
-					// for multi-check avoidance
+					// for multi-check avoidance while building and drawing models
 	int				checkCount;
 					// models
 	int				maxModels;
 	int				numModels;
 	cm_model_t **	models;
-					// polygons and brush for trm model
-	cm_polygonRef_t*trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t *	trmBrushes[1];
+					// material for trm models
 	const idMaterial *trmMaterial;
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
+					// one for every job thread
+	int				numTraceContexts;
+	cm_traceContext_t traceContexts[MAX_JOB_THREADS];
 };
 
+/*
+================
+idCollisionModelManagerLocal::GetTraceContext
+================
+*/
+ID_INLINE cm_traceContext_t *idCollisionModelManagerLocal::GetTraceContext( void ) {
+	int index = jobSystem->GetThreadIndex();
+	assert( index < numTraceContexts );
+	return &traceContexts[index];
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetTraceModel
+
+  the trace model handle refers to the trm model of the calling thread
+================
+*/
+ID_INLINE cm_model_t *idCollisionModelManagerLocal::GetTraceModel( cmHandle_t model, const cm_traceContext_t *context ) const {
+	if ( model == TRACE_MODEL_HANDLE ) {
+		return context->trmModel;
+	}
+	return models[model];
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTraceMarks
+
+  starts a new trace through tw->model
+================
+*/
+ID_INLINE void idCollisionModelManagerLocal::SetupTraceMarks( cm_traceWork_t *tw, cm_traceContext_t *context ) {
+	tw->checkCount = ++context->checkCount;
+	tw->marks = &tw->model->marks[context->index];
+}
+
 // for debugging
 extern idCVar cm_debugCollision;
@@ -479,6 +479,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t *
 	float f1, f2, startTan, dir, tanHalfAngle;
 	cm_edge_t *edge;
 	cm_vertex_t *v1, *v2;
+	cm_sideMark_t *edgeMark;
 	idVec3 collisionPoint, collisionNormal, origin, epsDir;
 	idPluecker epsPl;
 	idBounds bounds;
@@ -505,9 +506,10 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t *
 	for ( i = 0; i < poly->numEdges; i++ ) {
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		edgeMark = tw->marks->edges + abs(edgeNum);
 
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edgeMark->checkcount == tw->checkCount ) {
 			continue;
 		}
 
@@ -1058,13 +1060,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 	cm_trmPolygon_t *bp;
 	cm_vertex_t *v;
 	cm_edge_t *e;
+	cm_sideMark_t *vertexMark, *edgeMark;
 	idVec3 *rotationOrigin;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( tw->marks->polygons[p->markNum] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->marks->polygons[p->markNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -1159,12 +1162,13 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			edgeMark = tw->marks->edges + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( edgeMark->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			edgeMark->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -1173,13 +1177,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 			for ( k = 0; k < 2; k++ ) {
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
+				vertexMark = tw->marks->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( vertexMark->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vertexMark->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -1262,7 +1267,8 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_traceContext_t *context = GetTraceContext();
+	cm_traceWork_t &tw = context->rotationWork;
 
 	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
 		common->Printf("idCollisionModelManagerLocal::Rotation180: invalid model handle\n");
@@ -1273,8 +1279,6 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
-
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -1284,11 +1288,13 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 	tw.positionTest = false;
 	tw.axisIntersectsTrm = false;
 	tw.quickExit = false;
+	tw.getContacts = false;
 	tw.angle = endAngle - startAngle;
 	assert( tw.angle > -180.0f && tw.angle < 180.0f );
 	tw.angle = idMath::ClampFloat(-180.0f, 180.0f, tw.angle); // DG: enforce it for the rare cases the assert would trigger
 	tw.maxTan = initialTan = idMath::Fabs( tan( ( idMath::PI / 360.0f ) * tw.angle ) );
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = GetTraceModel( model, context );
+	SetupTraceMarks( &tw, context );
 	tw.start = start - modelOrigin;
 	// rotation axis, axis is assumed to be normalized
 	tw.axis = axis;
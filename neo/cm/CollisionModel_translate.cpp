@@ -201,7 +201,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetVertexSidedness( cm_sideMark_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(v->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -217,7 +217,7 @@ CM_SetEdgeSidedness
   stores for the given model edge at which side one of the trm vertices
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetEdgeSidedness( cm_sideMark_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(edge->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -236,15 +236,16 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	float f1, f2, dist, d1, d2;
 	idVec3 start, end, normal;
 	cm_edge_t *edge;
-	cm_vertex_t *v1, *v2;
+	cm_sideMark_t *edgeMark, *v1, *v2;
 	idPluecker *pl, epsPl;
 
 	// check edges for a collision
 	for ( i = 0; i < poly->numEdges; i++) {
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		edgeMark = tw->marks->edges + abs(edgeNum);
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edgeMark->checkcount == tw->checkCount ) {
 			continue;
 		}
 		// can never collide with internal edges
@@ -253,16 +254,16 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( edgeMark, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( edgeMark, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if ( !(((edge->side >> trmEdge->vertexNum[0]) ^ (edge->side >> trmEdge->vertexNum[1])) & 1) ) {
+		if ( !(((edgeMark->side >> trmEdge->vertexNum[0]) ^ (edgeMark->side >> trmEdge->vertexNum[1])) & 1) ) {
 			continue;
 		}
 		// get the sides at which the polygon edge vertices pass the trm edge
-		v1 = tw->model->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
+		v1 = tw->marks->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
 		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
-		v2 = tw->model->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
+		v2 = tw->marks->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
 		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
 		if ( !((v1->side ^ v2->side) & (1<<trmEdge->bitNum)) ) {
@@ -397,14 +398,14 @@ idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon
 void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum ) {
 	int i, edgeNum;
 	float f;
-	cm_edge_t *edge;
+	cm_sideMark_t *edge;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if ( f < tw->trace.fraction ) {
 
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs(edgeNum);
+			edge = tw->marks->edges + abs(edgeNum);
 			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
 			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> bitNum) & 1) ) {
 				return;
@@ -441,6 +442,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 	int i, edgeNum;
 	float f;
 	cm_edge_t *edge;
+	cm_sideMark_t *edgeMark;
 	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
@@ -449,17 +451,18 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
+			edgeMark = tw->marks->edges + abs(edgeNum);
 			// if we didn't yet calculate the sidedness for this edge
-			if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
+			if ( edgeMark->checkcount != tw->checkCount ) {
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edgeMark->checkcount = tw->checkCount;
 				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
 				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = FLOATSIGNBITSET(fl);
+				edgeMark->side = FLOATSIGNBITSET(fl);
 			}
 			// if the point passes the edge at the wrong side
-			//if ( (edgeNum > 0) == edge->side ) {
-			if ( INTSIGNBITSET(edgeNum) ^ edge->side ) {
+			//if ( (edgeNum > 0) == edgeMark->side ) {
+			if ( INTSIGNBITSET(edgeNum) ^ edgeMark->side ) {
 				return;
 			}
 		}
@@ -494,16 +497,18 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 	int i, edgeNum;
 	float f;
 	cm_trmEdge_t *edge;
+	cm_sideMark_t *vertexMark;
 
 	f = CM_TranslationPlaneFraction( trmpoly->plane, v->p, endp );
 	if ( f < tw->trace.fraction ) {
 
+		vertexMark = tw->marks->vertices + ( v - tw->model->vertices );
 		for ( i = 0; i < trmpoly->numEdges; i++ ) {
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs(edgeNum);
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((v->side >> edge->bitNum) & 1) ) {
+			CM_SetVertexSidedness( vertexMark, pl, edge->pl, edge->bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((vertexMark->side >> edge->bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -544,12 +549,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 	cm_trmPolygon_t *bp;
 	cm_vertex_t *v;
 	cm_edge_t *e;
+	cm_sideMark_t *vertexMark, *edgeMark;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( tw->marks->polygons[p->markNum] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->marks->polygons[p->markNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -602,18 +608,20 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			edgeMark = tw->marks->edges + abs(edgeNum);
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if ( e->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				e->sideSet = 0;
+			if ( edgeMark->checkcount != tw->checkCount ) {
+				edgeMark->sideSet = 0;
 			}
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
 														tw->model->vertices[e->vertexNum[1]].p );
 
 			v = &tw->model->vertices[e->vertexNum[INTSIGNBITSET(edgeNum)]];
+			vertexMark = tw->marks->vertices + e->vertexNum[INTSIGNBITSET(edgeNum)];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				v->sideSet = 0;
+			if ( vertexMark->checkcount != tw->checkCount ) {
+				vertexMark->sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
@@ -641,12 +649,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			edgeMark = tw->marks->edges + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( edgeMark->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			edgeMark->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -655,12 +664,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			for ( k = 0; k < 2; k++ ) {
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
+				vertexMark = tw->marks->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( vertexMark->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vertexMark->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -772,7 +782,8 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_traceContext_t *context = GetTraceContext();
+	cm_traceWork_t &tw = context->translationWork;
 
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) >= (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&end) < ((byte *)results) || ((byte *)&end) >= (((byte *)results) + sizeof( trace_t )) );
@@ -795,8 +806,6 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
-
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -805,11 +814,12 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = context->getContacts;
+	tw.contacts = context->contacts;
+	tw.maxContacts = context->maxContacts;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = GetTraceModel( model, context );
+	SetupTraceMarks( &tw, context );
 	tw.start = start - modelOrigin;
 	tw.end = end - modelOrigin;
 	tw.dir = end - start;
@@ -872,7 +882,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 		return;
 	}
 
@@ -1060,7 +1070,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 	} else {
 		// store results
 		*results = tw.trace;
@@ -1085,7 +1095,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 #ifdef _DEBUG
 	// test for collisions
 	if ( cm_debugCollision.GetBool() ) {
-		if (!idCollisionModelManagerLocal::getContacts ) {
+		if ( !context->getContacts ) {
 			// if the trm is stuck in the model
 			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
 				trace_t tr;
@@ -75,6 +75,7 @@ idUserInterfaceManager *	uiManager = NULL;
 idDeclManager *				declManager = NULL;
 idAASFileManager *			AASFileManager = NULL;
 idCollisionModelManager *	collisionModelManager = NULL;
+idJobSystem *				jobSystem = NULL;
 idCVar *					idCVar::staticVars = NULL;
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL|CVAR_SYSTEM, "force generic platform independent SIMD" );
@@ -88,6 +89,7 @@ static gameExport_t			gameExport;
 
 // global animation lib
 idAnimManager				animationLib;
+idAnimPoseCache				animPoseCache;
 
 // the rest of the engine will only reference the "game" variable, while all local aspects stay hidden
 idGameLocal					gameLocal;
@@ -156,6 +158,7 @@ extern "C" ID_GAME_API gameExport_t *GetGameAPI( gameImport_t *import ) {
 		declManager					= import->declManager;
 		AASFileManager				= import->AASFileManager;
 		collisionModelManager		= import->collisionModelManager;
+		jobSystem					= import->jobSystem;
 	}
 
 	// set interface pointers used by idLib
@@ -194,6 +197,7 @@ void TestGameAPI( void ) {
 	testImport.declManager				= ::declManager;
 	testImport.AASFileManager			= ::AASFileManager;
 	testImport.collisionModelManager	= ::collisionModelManager;
+	testImport.jobSystem				= ::jobSystem;
 
 	testExport = *GetGameAPI( &testImport );
 }
@@ -231,6 +235,10 @@ void idGameLocal::Clear( void ) {
 	numEntitiesToDeactivate = 0;
 	sortPushers = false;
 	sortTeamMasters = false;
+	numThinkJobs = 0;
+	numFullThinks = 0;
+	numReducedThinks = 0;
+	numSkippedThinks = 0;
 	persistentLevelInfo.Clear();
 	memset( globalShaderParms, 0, sizeof( globalShaderParms ) );
 	random.SetSeed( 0 );
@@ -483,6 +491,7 @@ void idGameLocal::Shutdown( void ) {
 
 	// shut down the animation manager
 	animationLib.Shutdown();
+	animPoseCache.Shutdown();
 
 #ifdef GAME_DLL
 
@@ -1705,6 +1714,8 @@ void idGameLocal::MapShutdown( void ) {
 
 	MapClear( true );
 
+	animPoseCache.Shutdown();
+
 	// reset the script to the state it was before the map was started
 	program.Restart();
 
@@ -2419,6 +2430,168 @@ void idGameLocal::SortActiveEntityList( void ) {
 	sortPushers = false;
 }
 
+/*
+================
+idGameLocal::ParallelThinkJob
+
+Builds the speculative animation frames of a range of animators on a job worker.
+================
+*/
+void idGameLocal::ParallelThinkJob( void *data, int jobNum ) {
+	const idGameLocal *game = static_cast<const idGameLocal *>( data );
+	int num = game->thinkAnimators.Num();
+
+	for ( int i = jobNum * num / game->numThinkJobs; i < ( jobNum + 1 ) * num / game->numThinkJobs; i++ ) {
+		game->thinkAnimators[i]->BuildSpeculativeFrame();
+	}
+}
+
+/*
+================
+idGameLocal::RunParallelThink
+
+Builds the animation frames of the entities that are going to think this frame on the job
+workers.  A frame build only reads and writes its own animator, so the animators are simply
+split evenly over the jobs.
+
+Think itself stays serial.  Running it on the workers would need every event, damage, spawn,
+script call and sound it can cause to be deferred to a commit phase, and in this code base those
+are reached from almost everywhere in think.  Instead only the frame build runs ahead, and
+CreateFrame only uses a frame built here if the animation state is still the same, so the result
+is identical to the serial path by construction.  g_parallelThink 2 checks that every frame
+against a serial rebuild, in place of comparing checksums of a replayed demo.
+================
+*/
+void idGameLocal::RunParallelThink( void ) {
+	idEntity *	ent;
+	idAnimator *	animator;
+
+	thinkAnimators.SetNum( 0, false );
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+#ifdef _D3XP
+		if ( ent->timeGroup != TIME_GROUP1 ) {
+			continue;
+		}
+#endif
+		// nothing is built for entities the think LOD skips this frame
+		if ( ThinkLODSkips( ent, GetThinkInterval( ent ) ) ) {
+			continue;
+		}
+		animator = ent->GetAnimator();
+		if ( animator && animator->BeginSpeculativeFrame( time ) ) {
+			thinkAnimators.Append( animator );
+		}
+	}
+
+	if ( !thinkAnimators.Num() ) {
+		return;
+	}
+
+	numThinkJobs = Min( thinkAnimators.Num(), jobSystem->GetNumThreads() * 4 );
+	jobSystem->RunJobs( ParallelThinkJob, this, numThinkJobs );
+}
+
+/*
+================
+idGameLocal::GetThinkInterval
+
+Number of frames between the thinks of an entity.  Monsters far away from the player or out of
+the player PVS think less often, everything else thinks every frame.
+================
+*/
+int idGameLocal::GetThinkInterval( idEntity *ent ) const {
+	idPlayer *	player;
+	idAI *		ai;
+	float		distSqr;
+	bool		inPVS;
+
+	if ( !g_thinkLOD.GetInteger() || isMultiplayer || inCinematic ) {
+		return 1;
+	}
+
+	// scripted entities, bound entities and anything that is not a monster walking around
+	// always think at the full rate
+	if ( ent->fl.noThinkLOD || ent->cinematic || ent->GetBindMaster() != NULL ) {
+		return 1;
+	}
+	if ( !ent->IsType( idAI::Type ) || !ent->GetPhysics()->IsType( idPhysics_Monster::Type ) ) {
+		return 1;
+	}
+	ai = static_cast<idAI *>( ent );
+	if ( ai->GetEnemy() != NULL ) {
+		return 1;
+	}
+
+	player = GetLocalPlayer();
+	if ( player == NULL ) {
+		return 1;
+	}
+
+	distSqr = ( ent->GetPhysics()->GetOrigin() - player->GetPhysics()->GetOrigin() ).LengthSqr();
+	inPVS = pvs.InCurrentPVS( playerPVS, ent->GetPVSAreas(), ent->GetNumPVSAreas() );
+
+	if ( distSqr < Square( g_thinkLODDistance.GetFloat() ) ) {
+		return inPVS ? 1 : 2;
+	}
+	return inPVS ? 2 : Max( g_thinkLODMaxInterval.GetInteger(), 2 );
+}
+
+/*
+================
+idGameLocal::ThinkLODSkips
+
+Returns true if RunEntityThink skips the think of an entity with the given interval this frame.
+================
+*/
+bool idGameLocal::ThinkLODSkips( const idEntity *ent, int interval ) const {
+	return interval > 1 && framenum - ent->thinkLODFrame < interval && ( framenum + ent->entityNumber ) % interval != 0;
+}
+
+/*
+================
+idGameLocal::RunEntityThink
+
+Runs the think of an entity at the rate given by GetThinkInterval.  The entities are staggered by
+entity number so they do not all think in the same frame.  When an entity thinks after skipping
+frames previousTime and msec cover all the time it skipped, so physics, animation and frame
+commands advance by the same amount they would have when thinking every frame.  Returns false
+if the think was skipped.
+================
+*/
+bool idGameLocal::RunEntityThink( idEntity *ent ) {
+	int interval = GetThinkInterval( ent );
+
+	if ( ThinkLODSkips( ent, interval ) ) {
+		if ( ent->thinkLODTime < 0 ) {
+			ent->thinkLODTime = previousTime;
+		}
+		numSkippedThinks++;
+		return false;
+	}
+
+	// only catch up on frames skipped by the LOD, not on time the entity didn't run for another reason
+	if ( ent->thinkLODTime >= 0 && ent->thinkLODTime < previousTime && framenum - ent->thinkLODFrame <= Max( g_thinkLODMaxInterval.GetInteger(), 2 ) ) {
+		const int savedPreviousTime = previousTime;
+		const int savedMsec = msec;
+
+		previousTime = ent->thinkLODTime;
+		msec = time - previousTime;
+		ent->Think();
+		previousTime = savedPreviousTime;
+		msec = savedMsec;
+
+		numReducedThinks++;
+	} else {
+		ent->Think();
+		numFullThinks++;
+	}
+
+	ent->thinkLODFrame = framenum;
+	ent->thinkLODTime = -1;
+
+	return true;
+}
+
 #ifdef _D3XP
 /*
 ================
@@ -2454,6 +2627,7 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t* clientCmds) {
 	idEntity* ent;
 	int					num;
 	float				ms;
+	bool				thought;
 	idTimer				timer_think, timer_events, timer_singlethink;
 	gameReturn_t		ret;
 	idPlayer* player;
@@ -2541,6 +2715,18 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t* clientCmds) {
 		timer_think.Clear();
 		timer_think.Start();
 
+		numFullThinks = 0;
+		numReducedThinks = 0;
+		numSkippedThinks = 0;
+
+		// poses are only shared within a frame
+		animPoseCache.Clear();
+
+		// build what the entities need independently of each other on the job workers
+		if ( g_parallelThink.GetInteger() && !inCinematic ) {
+			RunParallelThink();
+		}
+
 		// let entities think
 		if ( g_timeentities.GetFloat() ) {
 			num = 0;
@@ -2551,8 +2737,11 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t* clientCmds) {
 				}
 				timer_singlethink.Clear();
 				timer_singlethink.Start();
-				ent->Think();
+				thought = RunEntityThink( ent );
 				timer_singlethink.Stop();
+				if ( !thought ) {
+					continue;
+				}
 				ms = timer_singlethink.Milliseconds();
 				if ( ms >= g_timeentities.GetFloat() ) {
 					Printf( "%d: entity '%s': %f ms\n", time, ent->name.c_str(), ms );
@@ -2578,8 +2767,9 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t* clientCmds) {
 						continue;
 					}
 #endif
-					ent->Think();
-					num++;
+					if ( RunEntityThink( ent ) ) {
+						num++;
+					}
 				}
 			}
 		}
@@ -2588,6 +2778,10 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t* clientCmds) {
 		RunTimeGroup2();
 #endif
 
+		if ( g_thinkLOD.GetInteger() > 1 ) {
+			Printf( "%d: thinks: %d full, %d reduced, %d skipped\n", framenum, numFullThinks, numReducedThinks, numSkippedThinks );
+		}
+
 		// remove any entities that have stopped thinking
 		if ( numEntitiesToDeactivate ) {
 			idEntity *next_ent;
@@ -2596,6 +2790,7 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t* clientCmds) {
 				next_ent = ent->activeNode.Next();
 				if ( !ent->thinkFlags ) {
 					ent->activeNode.Remove();
+					ent->thinkLODTime = -1;
 					c++;
 				}
 			}
@@ -3147,6 +3342,34 @@ idAAS *idGameLocal::GetAAS( const char *name ) const {
 	return NULL;
 }
 
+/*
+==================
+idGameLocal::BuildAASRoutingTables
+
+The AAS files are loaded again so the routing tables don't include the doors
+and obstacles of the running map.
+==================
+*/
+void idGameLocal::BuildAASRoutingTables( void ) {
+	int i;
+	idAAS *aas;
+
+	if ( !mapFile ) {
+		Printf( "No map loaded\n" );
+		return;
+	}
+
+	for ( i = 0; i < aasNames.Num(); i++ ) {
+		aas = idAAS::Alloc();
+		if ( aas->Init( idStr( mapFileName ).SetFileExtension( aasNames[ i ] ).c_str(), mapFile->GetGeometryCRC() ) ) {
+			aas->BuildRoutingTables();
+		}
+		delete aas;
+	}
+
+	Printf( "The routing tables are used from the next time the map is loaded\n" );
+}
+
 /*
 ==================
 idGameLocal::SetAASAreaState
@@ -3905,6 +4128,12 @@ void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEnt
 	idEntity *	ent;
 	idEntity *	entityList[ MAX_GENTITIES ];
 	int			numListedEntities;
+	idList<idEntity *> targets;
+	idList<float>	targetDists;
+	idList<bool>	batched;
+	idList<bool>	reached;
+	idList<clipTrace_t> traces;
+	idList<int>		traceTargets;
 	idBounds	bounds;
 	idVec3		v, damagePoint, dir;
 	int			i, e, damage, radius, push;
@@ -3940,7 +4169,7 @@ void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEnt
 		ignoreDamage = static_cast<idAFAttachment*>(ignoreDamage)->GetBody();
 	}
 
-	// apply damage to the entities
+	// find the entities in range that can take damage
 	for ( e = 0; e < numListedEntities; e++ ) {
 		ent = entityList[ e ];
 		assert( ent );
@@ -3978,7 +4207,47 @@ void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEnt
 			continue;
 		}
 
-		if ( ent->CanDamage( origin, damagePoint ) ) {
+		targets.Append( ent );
+		targetDists.Append( dist );
+		batched.Append( ent->UsesDamageTestPoints() );
+		reached.Append( false );
+	}
+
+	// trace the damage test points of the targets that use the default CanDamage together,
+	// a target is reached at its first point that is visible from the origin just like in CanDamage
+	for ( i = 0; i < idEntity::NUM_DAMAGE_TEST_POINTS; i++ ) {
+		traces.SetNum( 0, false );
+		traceTargets.SetNum( 0, false );
+		for ( e = 0; e < targets.Num(); e++ ) {
+			if ( !batched[ e ] || reached[ e ] ) {
+				continue;
+			}
+			clipTrace_t &tr = traces.Alloc();
+			tr.start = origin;
+			tr.end = targets[ e ]->GetDamageTestPoint( i );
+			tr.bounds.Clear();
+			tr.contentMask = MASK_SOLID;
+			tr.passEntity = NULL;
+			traceTargets.Append( e );
+		}
+		if ( !traces.Num() ) {
+			break;
+		}
+		clip.TraceBatch( traces.Ptr(), traces.Num() );
+		for ( e = 0; e < traces.Num(); e++ ) {
+			const trace_t &tr = traces[ e ].results;
+			if ( tr.fraction == 1.0 || ( GetTraceEntity( tr ) == targets[ traceTargets[ e ] ] ) ) {
+				reached[ traceTargets[ e ] ] = true;
+			}
+		}
+	}
+
+	// apply damage to the entities, the ones with their own CanDamage are tested in between
+	for ( e = 0; e < targets.Num(); e++ ) {
+		ent = targets[ e ];
+		dist = targetDists[ e ];
+
+		if ( batched[ e ] ? reached[ e ] : ent->CanDamage( origin, damagePoint ) ) {
 			// push the center of mass higher than the origin so players
 			// get knocked into the air more
 			dir = ent->GetPhysics()->GetOrigin() - origin;
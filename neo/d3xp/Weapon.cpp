@@ -3393,15 +3393,25 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 		// predict instant hit projectiles
 		if ( projectileDict.GetBool( "net_instanthit" ) ) {
 			float spreadRad = DEG2RAD( spread );
+			idList<clipTrace_t> traces;
+
 			muzzle_pos = muzzleOrigin + playerViewAxis[ 0 ] * 2.0f;
+			traces.SetNum( num_projectiles );
 			for( i = 0; i < num_projectiles; i++ ) {
 				ang = idMath::Sin( spreadRad * gameLocal.random.RandomFloat() );
 				spin = (float)DEG2RAD( 360.0f ) * gameLocal.random.RandomFloat();
 				dir = playerViewAxis[ 0 ] + playerViewAxis[ 2 ] * ( ang * idMath::Sin( spin ) ) - playerViewAxis[ 1 ] * ( ang * idMath::Cos( spin ) );
 				dir.Normalize();
-				gameLocal.clip.Translation( tr, muzzle_pos, muzzle_pos + dir * 4096.0f, NULL, mat3_identity, MASK_SHOT_RENDERMODEL, owner );
-				if ( tr.fraction < 1.0f ) {
-					idProjectile::ClientPredictionCollide( this, projectileDict, tr, vec3_origin, true );
+				traces[i].start = muzzle_pos;
+				traces[i].end = muzzle_pos + dir * 4096.0f;
+				traces[i].bounds.Clear();
+				traces[i].contentMask = MASK_SHOT_RENDERMODEL;
+				traces[i].passEntity = owner;
+			}
+			gameLocal.clip.TraceBatch( traces.Ptr(), traces.Num() );
+			for( i = 0; i < traces.Num(); i++ ) {
+				if ( traces[i].results.fraction < 1.0f ) {
+					idProjectile::ClientPredictionCollide( this, projectileDict, traces[i].results, vec3_origin, true );
 				}
 			}
 		}
@@ -72,6 +72,34 @@ private:
 };
 
 
+class idRoutingTable {
+	friend class idAASLocal;
+
+private:
+	int							travelFlags;			// travel flags the table was built for
+	int *						rowRuns;				// first run of each area cache row followed by each portal cache row
+	int *						rowEntries;				// first travel time of each row
+	unsigned short *			runs;					// first area or portal and number of consecutive reachable ones
+	unsigned short *			travelTimes;			// travel times of the runs
+	unsigned char *				reachabilities;			// reachabilities of the runs
+};
+
+
+class idRouteQuery {
+	friend class idAASLocal;
+
+private:
+	int							routingState;			// routing state the route was found in, zero if not used
+	int							areaNum;				// start area
+	idVec3						origin;					// start origin
+	int							goalAreaNum;			// goal area
+	int							travelFlags;			// travel flags
+	bool						result;					// true if there is a route
+	int							travelTime;				// travel time towards the goal
+	idReachability *			reach;					// first reachability towards the goal
+};
+
+
 class idRoutingObstacle {
 	friend class idAASLocal;
 								idRoutingObstacle( void ) { }
@@ -116,7 +144,9 @@ public:
 	virtual bool				FlyPathValid( int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, idVec3 &endPos, int &endAreaNum ) const;
 	virtual void				ShowWalkPath( const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin ) const;
 	virtual void				ShowFlyPath( const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin ) const;
+	virtual bool				PathToGoal( aasPathCache_t &cache, aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, bool fly ) const;
 	virtual bool				FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 origin, const idVec3 &target, int travelFlags, aasObstacle_t *obstacles, int numObstacles, idAASCallback &callback ) const;
+	virtual void				BuildRoutingTables( void );
 
 private:
 	idAASFile *					file;
@@ -135,8 +165,29 @@ private:	// routing data
 	mutable idRoutingCache *	cacheListStart;			// start of list with cache sorted from oldest to newest
 	mutable idRoutingCache *	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
+	int							defaultCacheMemory;		// cache memory used when aas_routingCacheMemory is zero
+	mutable int					numCacheHits;			// cache lookups that found an existing cache
+	mutable int					numCacheMisses;			// caches that had to be calculated
+	mutable int					numCacheTableFills;		// caches filled from the routing tables
+	mutable int					numCacheEvictions;		// caches deleted to stay within the cache memory
 	idList<idRoutingObstacle *>	obstacleList;			// list with obstacles
 
+private:	// precomputed routing tables
+	void *						routingTableData;		// contents of the routing table file
+	int							routingTableSize;		// size of the routing table file
+	idList<idRoutingTable>		routingTables;			// one table per travel flags
+	idList<int>					clusterTableOffset;		// first routing table row of each cluster
+	idList<int>					clusterChanges;			// routing state changes since the tables were built, per cluster
+	int							numChangedClusters;		// number of clusters with routing state changes
+
+private:	// path queries
+	int							routingState;			// changes whenever areas are enabled or disabled or obstacles change
+	idRouteQuery *				routeQueries;			// hash table with recent route queries
+	mutable int					numRouteQueries;		// route queries issued
+	mutable int					numRouteQueriesDeduped;	// route queries answered from an identical earlier query
+	mutable int					numPathQueries;			// path queries issued
+	mutable int					numPathCacheHits;		// path queries answered from the path cache of the entity
+
 private:	// routing
 	bool						SetupRouting( void );
 	void						ShutdownRouting( void );
@@ -148,6 +199,8 @@ private:	// routing
 	void						DeletePortalCache( void );
 	void						ShutdownRoutingCache( void );
 	void						RoutingStats( void ) const;
+	bool						FindRouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const;
+	int							RoutingCacheMemory( void ) const;
 	void						LinkCache( idRoutingCache *cache ) const;
 	void						UnlinkCache( idRoutingCache *cache ) const;
 	void						DeleteOldestCache( void ) const;
@@ -164,6 +217,15 @@ private:	// routing
 	void						GetBoundsAreas_r( int nodeNum, const idBounds &bounds, idList<int> &areas ) const;
 	void						SetObstacleState( const idRoutingObstacle *obstacle, bool enable );
 
+private:	// routing tables
+	idStr						RoutingTableFileName( void ) const;
+	bool						LoadRoutingTables( void );
+	void						FreeRoutingTables( void );
+	void						FillRoutingCache( idRoutingCache *cache, const idRoutingTable *table, int row ) const;
+	const idRoutingTable *		GetAreaRoutingTable( int clusterNum, int travelFlags ) const;
+	const idRoutingTable *		GetPortalRoutingTable( int travelFlags ) const;
+	void						ChangeRoutingTableState( int areaNum, int change );
+
 private:	// pathing
 	bool						EdgeSplitPoint( idVec3 &split, int edgeNum, const idPlane &plane ) const;
 	bool						FloorEdgeSplitPoint( idVec3 &split, int areaNum, const idPlane &splitPlane, const idPlane &frontPlane, bool closest ) const;
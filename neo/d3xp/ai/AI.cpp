@@ -291,6 +291,7 @@ idAI::idAI
 idAI::idAI() {
 	aas					= NULL;
 	travelFlags			= TFL_WALK|TFL_AIR;
+	pathCache.routingState = 0;
 
 	kickForce			= 2048.0f;
 	ignore_obstacles	= false;
@@ -1386,6 +1387,7 @@ void idAI::SetAAS( void ) {
 
 	spawnArgs.GetString( "use_aas", NULL, use_aas );
 	aas = gameLocal.GetAAS( use_aas );
+	pathCache.routingState = 0;
 	if ( aas ) {
 		const idAASSettings *settings = aas->GetSettings();
 		if ( settings ) {
@@ -1498,11 +1500,7 @@ bool idAI::PathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int g
 		return false;
 	}
 
-	if ( move.moveType == MOVETYPE_FLY ) {
-		return aas->FlyPathToGoal( path, areaNum, org, goalAreaNum, goal, travelFlags );
-	} else {
-		return aas->WalkPathToGoal( path, areaNum, org, goalAreaNum, goal, travelFlags );
-	}
+	return aas->PathToGoal( pathCache, path, areaNum, org, goalAreaNum, goal, travelFlags, move.moveType == MOVETYPE_FLY );
 }
 
 /*
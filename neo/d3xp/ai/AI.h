@@ -301,6 +301,7 @@ protected:
 	// navigation
 	idAAS *					aas;
 	int						travelFlags;
+	mutable aasPathCache_t	pathCache;			// last path found, not saved
 
 	idMoveState				move;
 	idMoveState				savedMove;
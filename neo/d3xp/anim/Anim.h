@@ -72,6 +72,17 @@ typedef struct {
 	float	backlerp;
 } frameBlend_t;
 
+// everything a blend slot uses to blend the joints at a given time
+typedef struct {
+	const class idAnim *		anim;
+	float						weight;
+	int							frame;
+	frameBlend_t				frameBlend;
+	float						animWeights[ ANIM_MaxSyncedAnims ];
+	bool						expired;
+	bool						allowMove;
+} animPoseBlend_t;
+
 typedef struct {
 	int						nameIndex;
 	int						parentNum;
@@ -241,6 +252,13 @@ private:
 	idList<jointAnimInfo_t>	jointInfo;
 	idList<idJointQuat>		baseFrame;
 	idList<float>			componentFrames;
+	idList<unsigned short>	compressedFrames;		// quantized components of the key frames when compressed
+	idList<float>			componentBase;
+	idList<float>			componentScale;
+	idList<int>				keyFrames;				// frame number of each key frame
+	idList<int>				frameKeys;				// last key frame at or before each frame
+	float					maxTranslationError;
+	float					maxRotationError;
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
@@ -254,6 +272,9 @@ public:
 	size_t					Allocated( void ) const;
 	size_t					Size( void ) const { return sizeof( *this ) + Allocated(); };
 	bool					LoadAnim( const char *filename );
+	bool					IsCompressed( void ) const;
+	size_t					MemorySaved( void ) const;
+	void					GetCompressionError( float &translationError, float &rotationError ) const;
 
 	void					IncreaseRefs( void ) const;
 	void					DecreaseRefs( void ) const;
@@ -274,6 +295,14 @@ public:
 	void					GetOrigin( idVec3 &offset, int currentTime, int cyclecount ) const;
 	void					GetOriginRotation( idQuat &rotation, int time, int cyclecount ) const;
 	void					GetBounds( idBounds &bounds, int currentTime, int cyclecount ) const;
+
+private:
+	void					Compress( void );
+	bool					KeySpanFits( const unsigned short *quantized, const float *tolerance, int start, int end, float *buffer ) const;
+	float					JointRotationError( const float *components1, const float *components2 ) const;
+	void					DecodeComponents( int framenum, int firstComponent, int numComponents, float *dst ) const;
+	const float				*GetFrameComponents( int framenum, int firstComponent, int numComponents, float *buffer ) const;
+	const float				*GetJointComponents( int framenum, const int *index, int numIndexes, float *buffer ) const;
 };
 
 /*
@@ -420,6 +449,7 @@ private:
 	void						BlendDelta( int fromtime, int totime, idVec3 &blendDelta, float &blendWeight ) const;
 	void						BlendDeltaRotation( int fromtime, int totime, idQuat &blendDelta, float &blendWeight ) const;
 	bool						AddBounds( int currentTime, idBounds &bounds, bool removeOriginOffset ) const;
+	void						GetPoseBlend( int currentTime, bool removeOriginOffset, animPoseBlend_t &poseBlend ) const;
 
 public:
 								idAnimBlend();
@@ -482,6 +512,53 @@ ID_INLINE idAFPoseJointMod::idAFPoseJointMod( void ) {
 	origin.Zero();
 }
 
+/*
+==============================================================================================
+
+	idAnimPoseCache
+
+	Animators of the same model in the same animation state blend the same joints.  The
+	frame built for one of them is kept for the rest of the game frame and copied by the
+	others.  The cache is only used by the main thread, the job workers of g_parallelThink
+	only fill in the joints of poses allocated for them in idAnimator::BeginSpeculativeFrame.
+
+==============================================================================================
+*/
+
+typedef struct {
+	const idDeclModelDef *		modelDef;
+	bool						removeOriginOffset;
+	animPoseBlend_t				blends[ ANIM_NumAnimChannels ][ ANIM_MaxAnimsPerChannel ];
+} animPoseKey_t;
+
+typedef struct {
+	animPoseKey_t				key;
+	bool						result;				// false if nothing was animated, the joints are not set then
+	int							numJoints;			// number of joints allocated
+	idJointMat *				joints;
+} animPose_t;
+
+class idAnimPoseCache {
+public:
+								idAnimPoseCache( void );
+								~idAnimPoseCache( void );
+
+	void						Clear( void );
+	void						Shutdown( void );
+	animPose_t *				FindPose( const animPoseKey_t &key );
+	animPose_t *				AllocPose( const animPoseKey_t &key, int numJoints );
+	void						PrintStats( void ) const;
+
+private:
+	idList<animPose_t *>		poses;
+	int							numPoses;			// poses used this frame
+	idHashIndex					hash;
+
+	int							numLookups;
+	int							numHits;
+	int							numFull;
+};
+
 /*
 ==============================================================================================
 
@@ -528,6 +605,8 @@ public:
 	void						ForceUpdate( void );
 	void						ClearForceUpdate( void );
 	bool						CreateFrame( int animtime, bool force );
+	bool						BeginSpeculativeFrame( int animtime );
+	void						BuildSpeculativeFrame( void );
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
@@ -575,6 +654,10 @@ public:
 private:
 	void						FreeData( void );
 	void						PushAnims( int channel, int currentTime, int blendTime );
+	bool						BuildFrame( int currentTime, idJointMat *frameJoints, bool debugInfo ) const;
+	bool						GetPoseKey( int currentTime, animPoseKey_t &key ) const;
+	bool						SpeculativeFrameIsValid( void ) const;
+	void						VerifySpeculativeFrame( int currentTime ) const;
 
 private:
 	const idDeclModelDef *		modelDef;
@@ -592,6 +675,18 @@ private:
 
 	idBounds					frameBounds;
 
+	// frame built on a job worker by g_parallelThink and the state it was built from
+	int							speculativeTime;
+	bool						speculativeResult;
+	idJointMat *				speculativeJoints;
+	int							numSpeculativeJoints;
+	const idDeclModelDef *		speculativeModelDef;
+	bool						speculativeRemoveOriginOffset;
+	byte						speculativeChannels[ sizeof( idAnimBlend ) * ANIM_NumAnimChannels * ANIM_MaxAnimsPerChannel ];
+	idList<jointMod_t>			speculativeJointMods;
+	animPose_t *				speculativePose;		// shared pose used instead of speculativeJoints
+	bool						buildSpeculativePose;	// the pose is built for this animator
+
 	float						AFPoseBlendWeight;
 	idList<int>					AFPoseJoints;
 	idList<idAFPoseJointMod>	AFPoseJointMods;
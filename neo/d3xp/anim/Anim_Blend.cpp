@@ -2166,6 +2166,36 @@ bool idAnimBlend::AddBounds( int currentTime, idBounds &bounds, bool removeOrigi
 	return true;
 }
 
+/*
+=====================
+idAnimBlend::GetPoseBlend
+
+Gets what BlendAnim uses at currentTime, blends with the same pose blend give the same joints.
+=====================
+*/
+void idAnimBlend::GetPoseBlend( int currentTime, bool removeOriginOffset, animPoseBlend_t &poseBlend ) const {
+	const idAnim *anim = Anim();
+	if ( !anim ) {
+		return;
+	}
+
+	poseBlend.anim = anim;
+	poseBlend.weight = GetWeight( currentTime );
+	poseBlend.expired = ( endtime >= 0 ) && ( currentTime >= endtime );
+	poseBlend.allowMove = allowMove;
+	poseBlend.frame = frame;
+	if ( !frame ) {
+		anim->MD5Anim( 0 )->ConvertTimeToFrame( AnimTime( currentTime ), cycle, poseBlend.frameBlend );
+		// the cycles only move the root joint, and BlendAnim zeroes its translation when the origin offset is removed
+		if ( removeOriginOffset && allowMove ) {
+			poseBlend.frameBlend.cycleCount = 0;
+		}
+	}
+	if ( anim->NumAnims() > 1 ) {
+		memcpy( poseBlend.animWeights, animWeights, sizeof( poseBlend.animWeights ) );
+	}
+}
+
 /***********************************************************************
 
 	idDeclModelDef
@@ -3082,6 +3112,155 @@ const idVec3 &idDeclModelDef::GetVisualOffset( void ) const {
 	return offset;
 }
 
+/***********************************************************************
+
+	idAnimPoseCache
+
+***********************************************************************/
+
+#define MAX_ANIM_POSES			512
+
+/*
+=====================
+idAnimPoseCache::idAnimPoseCache
+=====================
+*/
+idAnimPoseCache::idAnimPoseCache( void ) {
+	numPoses = 0;
+	numLookups = 0;
+	numHits = 0;
+	numFull = 0;
+}
+
+/*
+=====================
+idAnimPoseCache::~idAnimPoseCache
+=====================
+*/
+idAnimPoseCache::~idAnimPoseCache( void ) {
+	Shutdown();
+}
+
+/*
+=====================
+idAnimPoseCache::Clear
+
+Called at the start of every game frame, keeps the memory of the poses.
+=====================
+*/
+void idAnimPoseCache::Clear( void ) {
+	numPoses = 0;
+	hash.Clear();
+}
+
+/*
+=====================
+idAnimPoseCache::Shutdown
+=====================
+*/
+void idAnimPoseCache::Shutdown( void ) {
+	int i;
+
+	for ( i = 0; i < poses.Num(); i++ ) {
+		Mem_Free16( poses[i]->joints );
+		delete poses[i];
+	}
+	poses.Clear();
+	hash.Free();
+	numPoses = 0;
+	numLookups = 0;
+	numHits = 0;
+	numFull = 0;
+}
+
+/*
+=====================
+PoseKeyHash
+=====================
+*/
+static int PoseKeyHash( const animPoseKey_t &key ) {
+	const unsigned int *ptr = reinterpret_cast<const unsigned int *>( &key );
+	unsigned int hash = 0;
+
+	for ( int i = 0; i < (int)( sizeof( key ) / sizeof( ptr[0] ) ); i++ ) {
+		hash = hash * 31 + ptr[i];
+	}
+	return hash & 0x7fffffff;
+}
+
+/*
+=====================
+idAnimPoseCache::FindPose
+=====================
+*/
+animPose_t *idAnimPoseCache::FindPose( const animPoseKey_t &key ) {
+	int i;
+
+	numLookups++;
+	for ( i = hash.First( PoseKeyHash( key ) ); i != -1; i = hash.Next( i ) ) {
+		if ( memcmp( &poses[i]->key, &key, sizeof( key ) ) == 0 ) {
+			numHits++;
+			return poses[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+=====================
+idAnimPoseCache::AllocPose
+
+Adds a pose for the key, the caller builds the joints.  Returns NULL when the cache is full.
+=====================
+*/
+animPose_t *idAnimPoseCache::AllocPose( const animPoseKey_t &key, int numJoints ) {
+	animPose_t *pose;
+
+	if ( numPoses >= MAX_ANIM_POSES ) {
+		numFull++;
+		return NULL;
+	}
+
+	if ( numPoses >= poses.Num() ) {
+		pose = new animPose_t;
+		pose->numJoints = 0;
+		pose->joints = NULL;
+		poses.Append( pose );
+	}
+	pose = poses[numPoses];
+	if ( pose->numJoints < numJoints ) {
+		Mem_Free16( pose->joints );
+		pose->joints = ( idJointMat* ) Mem_Alloc16( numJoints * sizeof( pose->joints[0] ) );
+		pose->numJoints = numJoints;
+	}
+	pose->key = key;
+	pose->result = false;
+
+	hash.Add( PoseKeyHash( key ), numPoses );
+	numPoses++;
+
+	return pose;
+}
+
+/*
+=====================
+idAnimPoseCache::PrintStats
+=====================
+*/
+void idAnimPoseCache::PrintStats( void ) const {
+	int i, memory;
+
+	memory = 0;
+	for ( i = 0; i < poses.Num(); i++ ) {
+		memory += sizeof( animPose_t ) + poses[i]->numJoints * sizeof( idJointMat );
+	}
+
+	gameLocal.Printf( "%6d lookups\n", numLookups );
+	gameLocal.Printf( "%6d hits (%.1f%%)\n", numHits, numLookups ? numHits * 100.0f / numLookups : 0.0f );
+	gameLocal.Printf( "%6d poses not cached because the cache was full\n", numFull );
+	gameLocal.Printf( "%6d poses this frame, %d allocated (%d KB)\n", numPoses, poses.Num(), memory >> 10 );
+}
+
 /***********************************************************************
 
 	idAnimator
@@ -3105,6 +3284,15 @@ idAnimator::idAnimator() {
 	removeOriginOffset		= false;
 	forceUpdate				= false;
 
+	speculativeTime			= -1;
+	speculativeResult		= false;
+	speculativeJoints		= NULL;
+	numSpeculativeJoints	= 0;
+	speculativeModelDef		= NULL;
+	speculativeRemoveOriginOffset = false;
+	speculativePose			= NULL;
+	buildSpeculativePose	= false;
+
 	frameBounds.Clear();
 
 	AFPoseJoints.SetGranularity( 1 );
@@ -3318,6 +3506,12 @@ void idAnimator::FreeData( void ) {
 	joints = NULL;
 	numJoints = 0;
 
+	Mem_Free16( speculativeJoints );
+	speculativeJoints = NULL;
+	numSpeculativeJoints = 0;
+	speculativeTime = -1;
+	speculativePose = NULL;
+
 	modelDef = NULL;
 
 	ForceUpdate();
@@ -4262,18 +4456,7 @@ idAnimator::CreateFrame
 =====================
 */
 bool idAnimator::CreateFrame( int currentTime, bool force ) {
-	int					i, j;
-	int					numJoints;
-	int					parentNum;
-	bool				hasAnim;
 	bool				debugInfo;
-	float				baseBlend;
-	float				blendWeight;
-	const idAnimBlend *	blend;
-	const int *			jointParent;
-	const jointMod_t *	jointMod;
-	const idJointQuat *	defaultPose;
-
 	static idCVar		r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 
 	if ( gameLocal.inCinematic && gameLocal.skipCinematic ) {
@@ -4304,6 +4487,95 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		debugInfo = false;
 	}
 
+	// use the frame built on a job worker if the animation state did not change since
+	if ( speculativeTime == currentTime && !debugInfo ) {
+		speculativeTime = -1;
+		if ( SpeculativeFrameIsValid() ) {
+			if ( speculativePose ) {
+				speculativeResult = speculativePose->result;
+			}
+			if ( g_parallelThink.GetInteger() > 1 ) {
+				VerifySpeculativeFrame( currentTime );
+			}
+			if ( speculativeResult ) {
+				SIMDProcessor->Memcpy( joints, speculativePose ? speculativePose->joints : speculativeJoints, modelDef->Joints().Num() * sizeof( joints[0] ) );
+			}
+			return speculativeResult;
+		}
+	}
+
+	// copy the frame of another animator in the same state
+	animPoseKey_t key;
+	if ( !debugInfo && GetPoseKey( currentTime, key ) ) {
+		animPose_t *pose = animPoseCache.FindPose( key );
+		if ( pose ) {
+			if ( pose->result ) {
+				SIMDProcessor->Memcpy( joints, pose->joints, modelDef->Joints().Num() * sizeof( joints[0] ) );
+			}
+			return pose->result;
+		}
+		pose = animPoseCache.AllocPose( key, modelDef->Joints().Num() );
+		if ( pose ) {
+			pose->result = BuildFrame( currentTime, joints, false );
+			if ( pose->result ) {
+				SIMDProcessor->Memcpy( pose->joints, joints, modelDef->Joints().Num() * sizeof( joints[0] ) );
+			}
+			return pose->result;
+		}
+	}
+
+	return BuildFrame( currentTime, joints, debugInfo );
+}
+
+/*
+=====================
+idAnimator::GetPoseKey
+
+Returns false if the frame can't be shared with other animators.
+=====================
+*/
+bool idAnimator::GetPoseKey( int currentTime, animPoseKey_t &key ) const {
+	int i, j;
+
+	if ( !g_animPoseCache.GetBool() || jointMods.Num() || AFPoseJoints.Num() ) {
+		return false;
+	}
+
+	memset( &key, 0, sizeof( key ) );
+	key.modelDef = modelDef;
+	key.removeOriginOffset = removeOriginOffset;
+	for ( i = ANIMCHANNEL_ALL; i < ANIM_NumAnimChannels; i++ ) {
+		if ( i != ANIMCHANNEL_ALL && !modelDef->NumJointsOnChannel( i ) ) {
+			continue;
+		}
+		for ( j = 0; j < ANIM_MaxAnimsPerChannel; j++ ) {
+			channels[ i ][ j ].GetPoseBlend( currentTime, removeOriginOffset, key.blends[ i ][ j ] );
+		}
+	}
+	return true;
+}
+
+/*
+=====================
+idAnimator::BuildFrame
+
+Blends the animations and joint modifications into frameJoints.  Only reads the animator, so it
+is safe to call on a job worker for an animator nothing else touches.
+=====================
+*/
+bool idAnimator::BuildFrame( int currentTime, idJointMat *frameJoints, bool debugInfo ) const {
+	int					i, j;
+	int					numJoints;
+	int					parentNum;
+	bool				hasAnim;
+	float				baseBlend;
+	float				blendWeight;
+	const idAnimBlend *	blend;
+	const int *			jointParent;
+	const jointMod_t *	jointMod;
+	const idJointQuat *	defaultPose;
+
+
 	// init the joint buffer
 	if ( AFPoseJoints.Num() ) {
 		// initialize with AF pose anim for the case where there are no other animations and no AF pose joint modifications
@@ -4389,7 +4661,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	}
 
 	// convert the joint quaternions to rotation matrices
-	SIMDProcessor->ConvertJointQuatsToJointMats( joints, jointFrame, numJoints );
+	SIMDProcessor->ConvertJointQuatsToJointMats( frameJoints, jointFrame, numJoints );
 
 	// check if we need to modify the origin
 	if ( jointMods.Num() && ( jointMods[0]->jointnum == 0 ) ) {
@@ -4400,16 +4672,16 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[0].SetRotation( jointMod->mat * joints[0].ToMat3() );
+				frameJoints[0].SetRotation( jointMod->mat * frameJoints[0].ToMat3() );
 				break;
 
 			case JOINTMOD_WORLD:
-				joints[0].SetRotation( joints[0].ToMat3() * jointMod->mat );
+				frameJoints[0].SetRotation( frameJoints[0].ToMat3() * jointMod->mat );
 				break;
 
 			case JOINTMOD_LOCAL_OVERRIDE:
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[0].SetRotation( jointMod->mat );
+				frameJoints[0].SetRotation( jointMod->mat );
 				break;
 		}
 
@@ -4418,13 +4690,13 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[0].SetTranslation( joints[0].ToVec3() + jointMod->pos );
+				frameJoints[0].SetTranslation( frameJoints[0].ToVec3() + jointMod->pos );
 				break;
 
 			case JOINTMOD_LOCAL_OVERRIDE:
 			case JOINTMOD_WORLD:
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[0].SetTranslation( jointMod->pos );
+				frameJoints[0].SetTranslation( jointMod->pos );
 				break;
 		}
 		j = 1;
@@ -4433,7 +4705,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	}
 
 	// add in the model offset
-	joints[0].SetTranslation( joints[0].ToVec3() + modelDef->GetVisualOffset() );
+	frameJoints[0].SetTranslation( frameJoints[0].ToVec3() + modelDef->GetVisualOffset() );
 
 	// pointer to joint info
 	jointParent = modelDef->JointParents();
@@ -4443,7 +4715,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		jointMod = jointMods[j];
 
 		// transform any joints preceding the joint modifier
-		SIMDProcessor->TransformJoints( joints, jointParent, i, jointMod->jointnum - 1 );
+		SIMDProcessor->TransformJoints( frameJoints, jointParent, i, jointMod->jointnum - 1 );
 		i = jointMod->jointnum;
 
 		parentNum = jointParent[i];
@@ -4451,56 +4723,182 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		// modify the axis
 		switch( jointMod->transform_axis ) {
 			case JOINTMOD_NONE:
-				joints[i].SetRotation( joints[i].ToMat3() * joints[ parentNum ].ToMat3() );
+				frameJoints[i].SetRotation( frameJoints[i].ToMat3() * frameJoints[ parentNum ].ToMat3() );
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[i].SetRotation( jointMod->mat * ( joints[i].ToMat3() * joints[parentNum].ToMat3() ) );
+				frameJoints[i].SetRotation( jointMod->mat * ( frameJoints[i].ToMat3() * frameJoints[parentNum].ToMat3() ) );
 				break;
 
 			case JOINTMOD_LOCAL_OVERRIDE:
-				joints[i].SetRotation( jointMod->mat * joints[parentNum].ToMat3() );
+				frameJoints[i].SetRotation( jointMod->mat * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_WORLD:
-				joints[i].SetRotation( ( joints[i].ToMat3() * joints[parentNum].ToMat3() ) * jointMod->mat );
+				frameJoints[i].SetRotation( ( frameJoints[i].ToMat3() * frameJoints[parentNum].ToMat3() ) * jointMod->mat );
 				break;
 
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[i].SetRotation( jointMod->mat );
+				frameJoints[i].SetRotation( jointMod->mat );
 				break;
 		}
 
 		// modify the position
 		switch( jointMod->transform_pos ) {
 			case JOINTMOD_NONE:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + joints[i].ToVec3() * joints[parentNum].ToMat3() );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + frameJoints[i].ToVec3() * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + ( joints[i].ToVec3() + jointMod->pos ) * joints[parentNum].ToMat3() );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + ( frameJoints[i].ToVec3() + jointMod->pos ) * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_LOCAL_OVERRIDE:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + jointMod->pos * joints[parentNum].ToMat3() );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + jointMod->pos * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_WORLD:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + joints[i].ToVec3() * joints[parentNum].ToMat3() + jointMod->pos );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + frameJoints[i].ToVec3() * frameJoints[parentNum].ToMat3() + jointMod->pos );
 				break;
 
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[i].SetTranslation( jointMod->pos );
+				frameJoints[i].SetTranslation( jointMod->pos );
 				break;
 		}
 	}
 
 	// transform the rest of the hierarchy
-	SIMDProcessor->TransformJoints( joints, jointParent, i, numJoints - 1 );
+	SIMDProcessor->TransformJoints( frameJoints, jointParent, i, numJoints - 1 );
 
 	return true;
 }
 
+/*
+=====================
+idAnimator::BeginSpeculativeFrame
+
+Called on the main thread before the job workers build frames.  Saves the state the frame
+depends on and returns true if CreateFrame would build a new frame at currentTime.
+=====================
+*/
+bool idAnimator::BeginSpeculativeFrame( int currentTime ) {
+	speculativeTime = -1;
+
+	if ( gameLocal.inCinematic && gameLocal.skipCinematic ) {
+		return false;
+	}
+
+	if ( !modelDef || !modelDef->ModelHandle() || !modelDef->GetDefaultPose() ) {
+		return false;
+	}
+
+	if ( lastTransformTime == currentTime ) {
+		return false;
+	}
+	if ( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) ) {
+		return false;
+	}
+
+	// the AF pose and debug output are only handled by CreateFrame
+	if ( AFPoseJoints.Num() ) {
+		return false;
+	}
+	if ( entity && ( ( g_debugAnim.GetInteger() == entity->entityNumber ) || ( g_debugAnim.GetInteger() == -2 ) ) ) {
+		return false;
+	}
+
+	const int numFrameJoints = modelDef->Joints().Num();
+
+	// animators in the same state share one pose which is only built for the first of them
+	animPoseKey_t key;
+	speculativePose = NULL;
+	buildSpeculativePose = false;
+	if ( GetPoseKey( currentTime, key ) ) {
+		speculativePose = animPoseCache.FindPose( key );
+		if ( !speculativePose ) {
+			speculativePose = animPoseCache.AllocPose( key, numFrameJoints );
+			buildSpeculativePose = ( speculativePose != NULL );
+		}
+	}
+
+	if ( !speculativePose && numFrameJoints > numSpeculativeJoints ) {
+		Mem_Free16( speculativeJoints );
+		speculativeJoints = ( idJointMat* ) Mem_Alloc16( numFrameJoints * sizeof( speculativeJoints[0] ) );
+		numSpeculativeJoints = numFrameJoints;
+	}
+
+	speculativeModelDef = modelDef;
+	speculativeRemoveOriginOffset = removeOriginOffset;
+	memcpy( speculativeChannels, channels, sizeof( channels ) );
+	speculativeJointMods.SetNum( jointMods.Num(), false );
+	for ( int i = 0; i < jointMods.Num(); i++ ) {
+		speculativeJointMods[i] = *jointMods[i];
+	}
+	speculativeTime = currentTime;
+
+	return true;
+}
+
+/*
+=====================
+idAnimator::BuildSpeculativeFrame
+
+Runs on a job worker.
+=====================
+*/
+void idAnimator::BuildSpeculativeFrame( void ) {
+	if ( speculativePose ) {
+		if ( buildSpeculativePose ) {
+			speculativePose->result = BuildFrame( speculativeTime, speculativePose->joints, false );
+		}
+		return;
+	}
+	speculativeResult = BuildFrame( speculativeTime, speculativeJoints, false );
+}
+
+/*
+=====================
+idAnimator::SpeculativeFrameIsValid
+
+True if the state the speculative frame was built from is still the same, the frame is then
+bit for bit the frame CreateFrame would build.
+=====================
+*/
+bool idAnimator::SpeculativeFrameIsValid( void ) const {
+	if ( modelDef != speculativeModelDef || removeOriginOffset != speculativeRemoveOriginOffset || AFPoseJoints.Num() ) {
+		return false;
+	}
+	if ( memcmp( speculativeChannels, channels, sizeof( channels ) ) != 0 ) {
+		return false;
+	}
+	if ( jointMods.Num() != speculativeJointMods.Num() ) {
+		return false;
+	}
+	for ( int i = 0; i < jointMods.Num(); i++ ) {
+		if ( memcmp( jointMods[i], &speculativeJointMods[i], sizeof( jointMod_t ) ) != 0 ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+=====================
+idAnimator::VerifySpeculativeFrame
+=====================
+*/
+void idAnimator::VerifySpeculativeFrame( int currentTime ) const {
+	const int numFrameJoints = modelDef->Joints().Num();
+	const idJointMat *builtJoints = speculativePose ? speculativePose->joints : speculativeJoints;
+	idJointMat *frameJoints = ( idJointMat* )_alloca16( numFrameJoints * sizeof( frameJoints[0] ) );
+
+	SIMDProcessor->Memcpy( frameJoints, joints, numFrameJoints * sizeof( frameJoints[0] ) );
+	if ( BuildFrame( currentTime, frameJoints, false ) != speculativeResult ||
+			( speculativeResult && memcmp( frameJoints, builtJoints, numFrameJoints * sizeof( frameJoints[0] ) ) != 0 ) ) {
+		gameLocal.Warning( "idAnimator::VerifySpeculativeFrame: frame of '%s' at %d differs from the serial frame", entity ? entity->GetName() : modelDef->GetName(), currentTime );
+	}
+}
+
 /*
 =====================
 idAnimator::ForceUpdate
@@ -259,6 +259,10 @@ private:
 
 	void						Event_SafeRemove( void );
 
+	idLinkList<idEvent>			scheduledEvents;		// events posted to this object, see idEvent::CancelEvents
+
+	friend class				idEvent;
+
 	static bool					initialized;
 	static idList<idTypeInfo *>	types;
 	static idList<idTypeInfo *>	typenums;
@@ -142,6 +142,8 @@ idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugDamage(				"g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugWeapon(				"g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugScript(				"g_debugScript",			"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_scriptSuperInstructions(	"g_scriptSuperInstructions",	"1",			CVAR_GAME | CVAR_BOOL, "fuse common pairs of script statements into single instructions" );
+idCVar g_scriptCache(				"g_scriptCache",				"1",			CVAR_GAME | CVAR_BOOL, "load compiled scripts from scriptcache/ when none of their source files changed" );
 idCVar g_debugMover(				"g_debugMover",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugTriggers(				"g_debugTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugCinematic(			"g_debugCinematic",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -162,6 +164,15 @@ idCVar g_showTriggers(				"g_showTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "dra
 idCVar g_showCollisionWorld(		"g_showCollisionWorld",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionModels(		"g_showCollisionModels",	"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionTraces(		"g_showCollisionTraces",	"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_clipTree(					"g_clipTree",				"0",			CVAR_GAME | CVAR_BOOL, "link clip models into a dynamic bounding volume tree instead of the fixed clip sectors, takes effect on the next map load" );
+idCVar g_parallelThink(				"g_parallelThink",			"0",			CVAR_GAME | CVAR_INTEGER, "0 = off, 1 = build the animation frames of the entities that think on the job workers before the entities think, 2 = also verify each of those frames against a serial rebuild", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar g_animPoseCache(			"g_animPoseCache",			"1",			CVAR_GAME | CVAR_BOOL, "animators of the same model in the same animation state share the blended joints of a frame" );
+idCVar g_compressAnims(			"g_compressAnims",			"0",			CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE, "store animations as 16 bit quantized key frames when they are loaded, use reloadAnims to apply" );
+idCVar g_compressAnimsTranslationError( "g_compressAnimsTranslationError", "0.05", CVAR_GAME | CVAR_FLOAT | CVAR_ARCHIVE, "largest error in units allowed for compressed joint translations" );
+idCVar g_compressAnimsRotationError( "g_compressAnimsRotationError", "0.1", CVAR_GAME | CVAR_FLOAT | CVAR_ARCHIVE, "largest angle in degrees a compressed joint rotation may be off by" );
+idCVar g_thinkLOD(					"g_thinkLOD",				"0",			CVAR_GAME | CVAR_INTEGER, "0 = monsters think every frame, 1 = monsters far from the player or out of the player PVS think less often, 2 = also print the number of full, reduced and skipped thinks every frame", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar g_thinkLODDistance(			"g_thinkLODDistance",		"1024",			CVAR_GAME | CVAR_FLOAT, "monsters closer to the player than this distance think every frame when in the player PVS and every other frame otherwise" );
+idCVar g_thinkLODMaxInterval(		"g_thinkLODMaxInterval",	"4",			CVAR_GAME | CVAR_INTEGER, "number of frames between thinks of monsters far away and out of the player PVS", 2, 15 );
 idCVar g_maxShowDistance(			"g_maxShowDistance",		"128",			CVAR_GAME | CVAR_FLOAT, "" );
 idCVar g_showEntityInfo(			"g_showEntityInfo",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showviewpos(				"g_showviewpos",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -371,6 +382,9 @@ idCVar aas_pullPlayer(				"aas_pullPlayer",			"0",			CVAR_GAME | CVAR_INTEGER, "
 idCVar aas_randomPullPlayer(		"aas_randomPullPlayer",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar aas_goalArea(				"aas_goalArea",				"0",			CVAR_GAME | CVAR_INTEGER, "" );
 idCVar aas_showPushIntoArea(		"aas_showPushIntoArea",		"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar aas_routingCacheMemory(		"aas_routingCacheMemory",	"0",			CVAR_GAME | CVAR_INTEGER, "routing cache memory in KB including the routing tables, 0 = size it from the AAS file" );
+idCVar aas_routingTables(			"aas_routingTables",		"1",			CVAR_GAME | CVAR_BOOL, "fill the routing cache from the precomputed routing tables" );
+idCVar aas_cachePathQueries(		"aas_cachePathQueries",		"1",			CVAR_GAME | CVAR_BOOL, "reuse the results of identical route and path queries until the routing changes" );
 
 idCVar g_password(					"g_password",				"",				CVAR_GAME | CVAR_ARCHIVE, "game password" );
 idCVar password(					"password",					"",				CVAR_GAME | CVAR_NOCHEAT, "client password used when connecting" );
@@ -311,10 +311,6 @@ bool IsAllowedToChangedFromSaveGames( const char *varName, const char *varType,
 		if ( idStr::Icmp( varName, "frameBounds" ) == 0 ) {
 			return true;
 		}
-	} else if ( idStr::Icmp( scope, "idClipModel" ) == 0 ) {
-		if ( idStr::Icmp( varName, "touchCount" ) == 0 ) {
-			return true;
-		}
 	} else if ( idStr::Icmp( scope, "idEntity" ) == 0 ) {
 		if ( idStr::Icmp( varName, "numPVSAreas" ) == 0 ) {
 			return true;
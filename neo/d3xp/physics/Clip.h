@@ -129,7 +129,8 @@ private:
 	int						renderModelHandle;		// render model def handle
 
 	struct clipLink_s *		clipLinks;				// links into sectors
-	int						touchCount;
+	int						clipTreeNode;			// leaf in the clip tree, kept while unlinked so a relink can reuse it
+	bool					clipTreeLinked;			// true if linked into the clip tree
 
 	void					Init( void );			// initialize
 	void					Link_r( struct clipSector_s *node );
@@ -225,7 +226,7 @@ ID_INLINE bool idClipModel::IsTraceModel( void ) const {
 }
 
 ID_INLINE bool idClipModel::IsLinked( void ) const {
-	return ( clipLinks != NULL );
+	return ( clipLinks != NULL || clipTreeLinked );
 }
 
 ID_INLINE bool idClipModel::IsEnabled( void ) const {
@@ -250,6 +251,16 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel( void ) const {
 //
 //===============================================================
 
+// one trace of a batch of translations
+typedef struct clipTrace_s {
+	idVec3					start;
+	idVec3					end;
+	idBounds				bounds;					// cleared bounds for a point trace
+	int						contentMask;
+	const idEntity *		passEntity;
+	trace_t					results;				// set by idClip::TraceBatch
+} clipTrace_t;
+
 class idClip {
 
 	friend class idClipModel;
@@ -277,6 +288,9 @@ public:
 								int contentMask, const idEntity *passEntity );
 	bool					TraceBounds( trace_t &results, const idVec3 &start, const idVec3 &end, const idBounds &bounds,
 								int contentMask, const idEntity *passEntity );
+							// many independent point and box translations at once, the results are
+							// the same as calling Translation for every trace
+	void					TraceBatch( clipTrace_t *traces, int numTraces );
 
 	// clip versus a specific model
 	void					TranslationModel( trace_t &results, const idVec3 &start, const idVec3 &end,
@@ -301,7 +315,7 @@ public:
 
 	// get entities/clip models within or touching the given bounds
 	int						EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
-	int						ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
+	int						ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount, bool *overflowed = NULL ) const;
 
 	const idBounds &		GetWorldBounds( void ) const;
 	idClipModel *			DefaultClipModel( void );
@@ -314,10 +328,15 @@ public:
 private:
 	int						numClipSectors;
 	struct clipSector_s *	clipSectors;
+	bool					useClipTree;			// g_clipTree when the map was loaded
+	struct clipTreeNode_s *	treeNodes;				// dynamic bounding volume tree used instead of the sectors with g_clipTree
+	int						numTreeNodes;
+	int						maxTreeNodes;
+	int						freeTreeNode;
+	int						treeRoot;
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
-	mutable int				touchCount;
 							// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -325,11 +344,30 @@ private:
 	int						numRenderModelTraces;
 	int						numContents;
 	int						numContacts;
+	int						numTraceBatches;
+	int						numLinks;				// clip model links
+	int						numLinkNodes;			// sector links or tree leaf inserts
+	mutable int				numBoundsQueries;
+	mutable int				numQueryNodes;			// sectors or tree nodes visited
 
 private:
 	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	void					ClipModelsTouchingTree( struct listParms_s &parms ) const;
+	int						AllocTreeNode( void );
+	void					FreeTreeNode( int nodeNum );
+	void					InsertTreeLeaf( int leaf );
+	void					RemoveTreeLeaf( int leaf );
+	int						BalanceTreeNode( int nodeNum );
+	void					LinkTree( idClipModel *clipModel );
+	void					RemoveFromTree( idClipModel *clipModel );
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
+	const idTraceModel *	TraceModelForBatch( const idBounds &bounds, idBounds &loadedBounds );
+	static const idTraceModel *BatchTraceModel( const idBounds &bounds, idTraceModel &trm, idBounds &loadedBounds );
+	static void				TraceBatchWorldJob( void *data, int jobNum );
+	static void				TraceBatchModelsJob( void *data, int jobNum );
+	int						TraceBatchModels( clipTrace_t &tr, const idTraceModel *trm, idClipModel **clipModelList, int numClipModels, bool renderModels, int &hitModel ) const;
+	bool					IgnoreClipModel( const idClipModel *cm, const idEntity *passEntity, const idEntity *passOwner ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
 };
@@ -631,6 +631,10 @@ void idInterpreter::EnterFunction( const function_t *func, bool clearStack ) {
 		}
 	}
 
+	if ( gameLocal.program.IsProfiling() ) {
+		gameLocal.program.GetProfile( func ).calls++;
+	}
+
 	currentFunction = func;
 	assert( !func->eventdef );
 	NextInstruction( func->firstStatement );
@@ -971,20 +975,106 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 /*
 ====================
 idInterpreter::Execute
+
+Runs the pre-decoded instructions of the current function.  With GCC and clang each
+opcode handler jumps straight to the handler of the next instruction through a table
+of label addresses, other compilers go back through the switch.  The script debugger,
+g_debugScript and the profiler have to see every statement, so while one of them is
+active every instruction goes through the top of the loop and superinstructions are
+not used.
 ====================
 */
+#if defined( __GNUC__ )
+#define SCRIPT_THREADED_DISPATCH
+#endif
+
+#ifdef SCRIPT_THREADED_DISPATCH
+#define SCRIPT_OP( op )		L_##op:
+#define SCRIPT_DISPATCH()	goto *dispatchTable[ in->op[ fused ] ]
+#define SCRIPT_NEXT()		do {																			\
+								if ( slowPath || doneProcessing || threadDying || runaway <= 1 ) {			\
+									goto nextStatement;														\
+								}																			\
+								instructionPointer++;														\
+								runaway--;																	\
+								in = &gameLocal.program.GetInstruction( instructionPointer );				\
+								SCRIPT_DISPATCH();															\
+							} while( 0 )
+#else
+#define SCRIPT_OP( op )		case op:
+#define SCRIPT_DISPATCH()	goto dispatch
+#define SCRIPT_NEXT()		goto nextStatement
+#endif
+
 bool idInterpreter::Execute( void ) {
 	varEval_t	var_a;
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t	*st;
+	const scriptInstruction_t *in;
 	int			runaway;
+	int			fused;
+	bool		slowPath;
+	bool		profiling;
+	const function_t *profileFunction;
+	unsigned int profileTime;
+	unsigned int now;
 	idThread	*newThread;
 	float		floatVal;
 	idScriptObject *obj;
 	const function_t *func;
 
+#ifdef SCRIPT_THREADED_DISPATCH
+	// must be in the same order as the opcodes
+	static void * const dispatchTable[ NUM_SCRIPT_OPS ] = {
+		&&L_OP_RETURN, &&L_OP_UINC_F, &&L_OP_UINCP_F,
+		&&L_OP_UDEC_F, &&L_OP_UDECP_F, &&L_OP_COMP_F,
+		&&L_OP_MUL_F, &&L_OP_MUL_V, &&L_OP_MUL_FV,
+		&&L_OP_MUL_VF, &&L_OP_DIV_F, &&L_OP_MOD_F,
+		&&L_OP_ADD_F, &&L_OP_ADD_V, &&L_OP_ADD_S,
+		&&L_OP_ADD_FS, &&L_OP_ADD_SF, &&L_OP_ADD_VS,
+		&&L_OP_ADD_SV, &&L_OP_SUB_F, &&L_OP_SUB_V,
+		&&L_OP_EQ_F, &&L_OP_EQ_V, &&L_OP_EQ_S,
+		&&L_OP_EQ_E, &&L_OP_EQ_EO, &&L_OP_EQ_OE,
+		&&L_OP_EQ_OO, &&L_OP_NE_F, &&L_OP_NE_V,
+		&&L_OP_NE_S, &&L_OP_NE_E, &&L_OP_NE_EO,
+		&&L_OP_NE_OE, &&L_OP_NE_OO, &&L_OP_LE,
+		&&L_OP_GE, &&L_OP_LT, &&L_OP_GT,
+		&&L_OP_INDIRECT_F, &&L_OP_INDIRECT_V, &&L_OP_INDIRECT_S,
+		&&L_OP_INDIRECT_ENT, &&L_OP_INDIRECT_BOOL, &&L_OP_INDIRECT_OBJ,
+		&&L_OP_ADDRESS, &&L_OP_EVENTCALL, &&L_OP_OBJECTCALL,
+		&&L_OP_SYSCALL, &&L_OP_STORE_F, &&L_OP_STORE_V,
+		&&L_OP_STORE_S, &&L_OP_STORE_ENT, &&L_OP_STORE_BOOL,
+		&&L_OP_STORE_OBJENT, &&L_OP_STORE_OBJ, &&L_OP_STORE_ENTOBJ,
+		&&L_OP_STORE_FTOS, &&L_OP_STORE_BTOS, &&L_OP_STORE_VTOS,
+		&&L_OP_STORE_FTOBOOL, &&L_OP_STORE_BOOLTOF, &&L_OP_STOREP_F,
+		&&L_OP_STOREP_V, &&L_OP_STOREP_S, &&L_OP_STOREP_ENT,
+		&&L_OP_STOREP_FLD, &&L_OP_STOREP_BOOL, &&L_OP_STOREP_OBJ,
+		&&L_OP_STOREP_OBJENT, &&L_OP_STOREP_FTOS, &&L_OP_STOREP_BTOS,
+		&&L_OP_STOREP_VTOS, &&L_OP_STOREP_FTOBOOL, &&L_OP_STOREP_BOOLTOF,
+		&&L_OP_UMUL_F, &&L_OP_UMUL_V, &&L_OP_UDIV_F,
+		&&L_OP_UDIV_V, &&L_OP_UMOD_F, &&L_OP_UADD_F,
+		&&L_OP_UADD_V, &&L_OP_USUB_F, &&L_OP_USUB_V,
+		&&L_OP_UAND_F, &&L_OP_UOR_F, &&L_OP_NOT_BOOL,
+		&&L_OP_NOT_F, &&L_OP_NOT_V, &&L_OP_NOT_S,
+		&&L_OP_NOT_ENT, &&L_OP_NEG_F, &&L_OP_NEG_V,
+		&&L_OP_INT_F, &&L_OP_IF, &&L_OP_IFNOT,
+		&&L_OP_CALL, &&L_OP_THREAD, &&L_OP_OBJTHREAD,
+		&&L_OP_PUSH_F, &&L_OP_PUSH_V, &&L_OP_PUSH_S,
+		&&L_OP_PUSH_ENT, &&L_OP_PUSH_OBJ, &&L_OP_PUSH_OBJENT,
+		&&L_OP_PUSH_FTOS, &&L_OP_PUSH_BTOF, &&L_OP_PUSH_FTOB,
+		&&L_OP_PUSH_VTOS, &&L_OP_PUSH_BTOS, &&L_OP_GOTO,
+		&&L_OP_AND, &&L_OP_AND_BOOLF, &&L_OP_AND_FBOOL,
+		&&L_OP_AND_BOOLBOOL, &&L_OP_OR, &&L_OP_OR_BOOLF,
+		&&L_OP_OR_FBOOL, &&L_OP_OR_BOOLBOOL, &&L_OP_BITAND,
+		&&L_OP_BITOR, &&L_OP_BREAK, &&L_OP_CONTINUE,
+		&&L_OP_EQ_F_IFNOT, &&L_OP_NE_F_IFNOT, &&L_OP_LT_IFNOT,
+		&&L_OP_LE_IFNOT, &&L_OP_GT_IFNOT, &&L_OP_GE_IFNOT,
+		&&L_OP_ADDRESS_STOREP_F, &&L_OP_ADDRESS_STOREP_V, &&L_OP_ADDRESS_STOREP_ENT,
+		&&L_OP_ADDRESS_STOREP_BOOL, &&L_OP_PUSH_CALL
+	};
+#endif
+
 	if ( threadDying || !currentFunction ) {
 		return true;
 	}
@@ -994,19 +1084,31 @@ bool idInterpreter::Execute( void ) {
 		instructionPointer--;
 	}
 
+	profiling = gameLocal.program.IsProfiling();
+	slowPath = profiling || g_debugScript.GetBool() || cvarSystem->GetCVarBool( "com_enableDebuggerServer" );
+	fused = ( !slowPath && g_scriptSuperInstructions.GetBool() ) ? 1 : 0;
+	profileFunction = currentFunction;
+	profileTime = profiling ? idLib::sys->GetMicroseconds() : 0;
+
 	runaway = 5000000;
 
 	doneProcessing = false;
-	while( !doneProcessing && !threadDying ) {
-		instructionPointer++;
 
-		if ( !--runaway ) {
-			Error( "runaway loop error" );
+nextStatement:
+	if ( doneProcessing || threadDying ) {
+		if ( profiling ) {
+			gameLocal.program.GetProfile( profileFunction ).usec += idLib::sys->GetMicroseconds() - profileTime;
 		}
+		return threadDying;
+	}
+
+	instructionPointer++;
 
-		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+	if ( !--runaway ) {
+		Error( "runaway loop error" );
+	}
 
+	if ( slowPath ) {
 		if ( !updateGameDebugger( this, &gameLocal.program, instructionPointer )
 			&& g_debugScript.GetBool( ) ) 
 		{
@@ -1020,871 +1122,1022 @@ bool idInterpreter::Execute( void ) {
 			}
 		}
 
-		switch( st->op ) {
-		case OP_RETURN:
-			LeaveFunction( st->a );
-			break;
+		if ( profiling ) {
+			// charge the time since the last statement to the function it ran in
+			now = idLib::sys->GetMicroseconds();
+			gameLocal.program.GetProfile( profileFunction ).usec += now - profileTime;
+			profileTime = now;
+			profileFunction = currentFunction;
+			gameLocal.program.GetProfile( profileFunction ).instructions++;
+		}
+	}
 
-		case OP_THREAD:
-			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+	// next instruction
+	in = &gameLocal.program.GetInstruction( instructionPointer );
+
+#ifdef SCRIPT_THREADED_DISPATCH
+	SCRIPT_DISPATCH();
+#else
+dispatch:
+	switch( in->op[ fused ] ) {
+#endif
+	SCRIPT_OP( OP_RETURN )
+		LeaveFunction( gameLocal.program.GetStatement( instructionPointer ).a );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_THREAD )
+		newThread = new idThread( this, in->operand[ 0 ].functionPtr, in->operand[ 1 ].argSize );
+		newThread->Start();
+
+		// return the thread number to the script
+		gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
+		PopParms( in->operand[ 1 ].argSize );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_OBJTHREAD )
+		var_a = GetOperand( in, 0 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			func = obj->GetTypeDef()->GetFunction( in->operand[ 1 ].virtualFunction );
+			assert( in->operand[ 2 ].argSize == func->parmTotal );
+			newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
 			newThread->Start();
 
 			// return the thread number to the script
 			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			PopParms( st->b->value.argSize );
-			break;
-
-		case OP_OBJTHREAD:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				assert( st->c->value.argSize == func->parmTotal );
-				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
-				newThread->Start();
-
-				// return the thread number to the script
-				gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			} else {
-				// return a null thread to the script
-				gameLocal.program.ReturnFloat( 0.0f );
-			}
-			PopParms( st->c->value.argSize );
-			break;
-
-		case OP_CALL:
-			EnterFunction( st->a->value.functionPtr, false );
-			break;
-
-		case OP_EVENTCALL:
-			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
-
-		case OP_OBJECTCALL:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				EnterFunction( func, false );
-			} else {
-				// return a 'safe' value
-				gameLocal.program.ReturnVector( vec3_zero );
-				gameLocal.program.ReturnString( "" );
-				PopParms( st->c->value.argSize );
-			}
-			break;
-
-		case OP_SYSCALL:
-			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
-
-		case OP_IFNOT:
-			var_a = GetVariable( st->a );
-			if ( *var_a.intPtr == 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
-			}
-			break;
-
-		case OP_IF:
-			var_a = GetVariable( st->a );
-			if ( *var_a.intPtr != 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
-			}
-			break;
-
-		case OP_GOTO:
-			NextInstruction( instructionPointer + st->a->value.jumpOffset );
-			break;
-
-		case OP_ADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-			break;
-
-		case OP_ADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-			break;
-
-		case OP_ADD_S:
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_FS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, FloatToString( *var_a.floatPtr ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SF:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-			break;
-
-		case OP_ADD_VS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, var_a.vectorPtr->ToString() );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SV:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, var_b.vectorPtr->ToString() );
-			break;
-
-		case OP_SUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-			break;
-
-		case OP_SUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-			break;
-
-		case OP_MUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
-			break;
-
-		case OP_MUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
-			break;
-
-		case OP_MUL_FV:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
-			break;
-
-		case OP_MUL_VF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
-			break;
-
-		case OP_DIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-
-			if ( *var_b.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_c.floatPtr = idMath::INFINITY;
-			} else {
-				*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
-			}
-			break;
-
-		case OP_MOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable ( st->c );
-
-			if ( *var_b.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_c.floatPtr = *var_a.floatPtr;
-			} else {
-				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
-			}
-			break;
-
-		case OP_BITAND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-			break;
-
-		case OP_BITOR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-			break;
-
-		case OP_GE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-			break;
-
-		case OP_LE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-			break;
-
-		case OP_GT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-			break;
-
-		case OP_LT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-			break;
-
-		case OP_AND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-			break;
-
-		case OP_AND_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-			break;
-
-		case OP_AND_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-			break;
-
-		case OP_AND_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-			break;
-
-		case OP_OR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-			break;
-
-		case OP_OR_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-			break;
-
-		case OP_OR_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-			break;
-
-		case OP_OR_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-			break;
-
-		case OP_NOT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr == 0 );
-			break;
-
-		case OP_NOT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-			break;
-
-		case OP_NOT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-			break;
-
-		case OP_NOT_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-			break;
-
-		case OP_NOT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-			break;
-
-		case OP_NEG_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = -*var_a.floatPtr;
-			break;
-
-		case OP_NEG_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = -*var_a.vectorPtr;
-			break;
-
-		case OP_INT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-			break;
-
-		case OP_EQ_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-			break;
-
-		case OP_EQ_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-			break;
-
-		case OP_EQ_S:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-			break;
-
-		case OP_EQ_E:
-		case OP_EQ_EO:
-		case OP_EQ_OE:
-		case OP_EQ_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-			break;
-
-		case OP_NE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-			break;
-
-		case OP_NE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-			break;
-
-		case OP_NE_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-			break;
-
-		case OP_NE_E:
-		case OP_NE_EO:
-		case OP_NE_OE:
-		case OP_NE_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-			break;
-
-		case OP_UADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr += *var_a.floatPtr;
-			break;
-
-		case OP_UADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr += *var_a.vectorPtr;
-			break;
-
-		case OP_USUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr -= *var_a.floatPtr;
-			break;
-
-		case OP_USUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr -= *var_a.vectorPtr;
-			break;
-
-		case OP_UMUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr *= *var_a.floatPtr;
-			break;
-
-		case OP_UMUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr *= *var_a.floatPtr;
-			break;
-
-		case OP_UDIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-
-			if ( *var_a.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_b.floatPtr = idMath::INFINITY;
-			} else {
-				*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
-			}
-			break;
-
-		case OP_UDIV_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-
-			if ( *var_a.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				var_b.vectorPtr->Set( idMath::INFINITY, idMath::INFINITY, idMath::INFINITY );
-			} else {
-				*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
-			}
-			break;
-
-		case OP_UMOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		} else {
+			// return a null thread to the script
+			gameLocal.program.ReturnFloat( 0.0f );
+		}
+		PopParms( in->operand[ 2 ].argSize );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_CALL )
+		EnterFunction( in->operand[ 0 ].functionPtr, false );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_EVENTCALL )
+		CallEvent( in->operand[ 0 ].functionPtr, in->operand[ 1 ].argSize );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_OBJECTCALL )
+		var_a = GetOperand( in, 0 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			func = obj->GetTypeDef()->GetFunction( in->operand[ 1 ].virtualFunction );
+			EnterFunction( func, false );
+		} else {
+			// return a 'safe' value
+			gameLocal.program.ReturnVector( vec3_zero );
+			gameLocal.program.ReturnString( "" );
+			PopParms( in->operand[ 2 ].argSize );
+		}
+		SCRIPT_NEXT();
 
-			if ( *var_a.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_b.floatPtr = *var_a.floatPtr;
-			} else {
-				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
-			}
-			break;
+	SCRIPT_OP( OP_SYSCALL )
+		CallSysEvent( in->operand[ 0 ].functionPtr, in->operand[ 1 ].argSize );
+		SCRIPT_NEXT();
 
-		case OP_UOR_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-			break;
+	SCRIPT_OP( OP_IFNOT )
+		var_a = GetOperand( in, 0 );
+		if ( *var_a.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in->operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_UAND_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-			break;
+	SCRIPT_OP( OP_IF )
+		var_a = GetOperand( in, 0 );
+		if ( *var_a.intPtr != 0 ) {
+			NextInstruction( instructionPointer + in->operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_GOTO )
+		NextInstruction( instructionPointer + in->operand[ 0 ].jumpOffset );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_S )
+		SetString( in, 2, GetString( in, 0 ) );
+		AppendString( in, 2, GetString( in, 1 ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_FS )
+		var_a = GetOperand( in, 0 );
+		SetString( in, 2, FloatToString( *var_a.floatPtr ) );
+		AppendString( in, 2, GetString( in, 1 ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_SF )
+		var_b = GetOperand( in, 1 );
+		SetString( in, 2, GetString( in, 0 ) );
+		AppendString( in, 2, FloatToString( *var_b.floatPtr ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_VS )
+		var_a = GetOperand( in, 0 );
+		SetString( in, 2, var_a.vectorPtr->ToString() );
+		AppendString( in, 2, GetString( in, 1 ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADD_SV )
+		var_b = GetOperand( in, 1 );
+		SetString( in, 2, GetString( in, 0 ) );
+		AppendString( in, 2, var_b.vectorPtr->ToString() );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_SUB_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_SUB_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_MUL_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_MUL_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_MUL_FV )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_MUL_VF )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_DIV_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+
+		if ( *var_b.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_c.floatPtr = idMath::INFINITY;
+		} else {
+			*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_UINC_F:
-			var_a = GetVariable( st->a );
-			( *var_a.floatPtr )++;
-			break;
+	SCRIPT_OP( OP_MOD_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
 
-		case OP_UINCP_F:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				( *var.floatPtr )++;
-			}
-			break;
+		if ( *var_b.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_c.floatPtr = *var_a.floatPtr;
+		} else {
+			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_BITAND )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_BITOR )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_GE )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_LE )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_GT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_LT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_AND )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_AND_BOOLF )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_AND_FBOOL )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_AND_BOOLBOOL )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_OR )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_OR_BOOLF )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_OR_FBOOL )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_OR_BOOLBOOL )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NOT_BOOL )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.intPtr == 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NOT_F )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NOT_V )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NOT_S )
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( strlen( GetString( in, 0 ) ) == 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NOT_ENT )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NEG_F )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = -*var_a.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NEG_V )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.vectorPtr = -*var_a.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_INT_F )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_EQ_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_EQ_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_EQ_S )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( idStr::Cmp( GetString( in, 0 ), GetString( in, 1 ) ) == 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_EQ_E )
+	SCRIPT_OP( OP_EQ_EO )
+	SCRIPT_OP( OP_EQ_OE )
+	SCRIPT_OP( OP_EQ_OO )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NE_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NE_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NE_S )
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( idStr::Cmp( GetString( in, 0 ), GetString( in, 1 ) ) != 0 );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_NE_E )
+	SCRIPT_OP( OP_NE_EO )
+	SCRIPT_OP( OP_NE_OE )
+	SCRIPT_OP( OP_NE_OO )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UADD_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr += *var_a.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UADD_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.vectorPtr += *var_a.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_USUB_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr -= *var_a.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_USUB_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.vectorPtr -= *var_a.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UMUL_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr *= *var_a.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UMUL_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.vectorPtr *= *var_a.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UDIV_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+
+		if ( *var_a.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_b.floatPtr = idMath::INFINITY;
+		} else {
+			*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_UDEC_F:
-			var_a = GetVariable( st->a );
-			( *var_a.floatPtr )--;
-			break;
+	SCRIPT_OP( OP_UDIV_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
 
-		case OP_UDECP_F:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				( *var.floatPtr )--;
-			}
-			break;
+		if ( *var_a.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			var_b.vectorPtr->Set( idMath::INFINITY, idMath::INFINITY, idMath::INFINITY );
+		} else {
+			*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_COMP_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-			break;
+	SCRIPT_OP( OP_UMOD_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
 
-		case OP_STORE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		if ( *var_a.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
 			*var_b.floatPtr = *var_a.floatPtr;
-			break;
-
-		case OP_STORE_ENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		} else {
+			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UOR_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UAND_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UINC_F )
+		var_a = GetOperand( in, 0 );
+		( *var_a.floatPtr )++;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UINCP_F )
+		var_a = GetOperand( in, 0 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			( *var.floatPtr )++;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UDEC_F )
+		var_a = GetOperand( in, 0 );
+		( *var_a.floatPtr )--;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_UDECP_F )
+		var_a = GetOperand( in, 0 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			( *var.floatPtr )--;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_COMP_F )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_F )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr = *var_a.floatPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_ENT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_BOOL )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.intPtr = *var_a.intPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_OBJENT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( !obj ) {
+			*var_b.entityNumberPtr = 0;
+		} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).b->TypeDef() ) ) {
+			//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
+			*var_b.entityNumberPtr = 0;
+		} else {
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
-
-		case OP_STORE_BOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.intPtr = *var_a.intPtr;
-			break;
-
-		case OP_STORE_OBJENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( !obj ) {
-				*var_b.entityNumberPtr = 0;
-			} else if ( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) ) {
-				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
-				*var_b.entityNumberPtr = 0;
-			} else {
-				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			}
-			break;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_OBJ )
+	SCRIPT_OP( OP_STORE_ENTOBJ )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_S )
+		SetString( in, 1, GetString( in, 0 ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_V )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.vectorPtr = *var_a.vectorPtr;
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_FTOS )
+		var_a = GetOperand( in, 0 );
+		SetString( in, 1, FloatToString( *var_a.floatPtr ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_BTOS )
+		var_a = GetOperand( in, 0 );
+		SetString( in, 1, *var_a.intPtr ? "true" : "false" );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_VTOS )
+		var_a = GetOperand( in, 0 );
+		SetString( in, 1, var_a.vectorPtr->ToString() );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_FTOBOOL )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		if ( *var_a.floatPtr != 0.0f ) {
+			*var_b.intPtr = 1;
+		} else {
+			*var_b.intPtr = 0;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STORE_BOOLTOF )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_STOREP_F )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->floatPtr = *var_a.floatPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_OBJ:
-		case OP_STORE_ENTOBJ:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+	SCRIPT_OP( OP_STOREP_ENT )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_S:
-			SetString( st->b, GetString( st->a ) );
-			break;
+	SCRIPT_OP( OP_STOREP_FLD )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->intPtr = *var_a.intPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr = *var_a.vectorPtr;
-			break;
+	SCRIPT_OP( OP_STOREP_BOOL )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->intPtr = *var_a.intPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_FTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, FloatToString( *var_a.floatPtr ) );
-			break;
+	SCRIPT_OP( OP_STOREP_S )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
+			idStr::Copynz( var_b.evalPtr->stringPtr, GetString( in, 0 ), MAX_STRING_LEN );
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_BTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, *var_a.intPtr ? "true" : "false" );
-			break;
+	SCRIPT_OP( OP_STOREP_V )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_VTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, var_a.vectorPtr->ToString() );
-			break;
+	SCRIPT_OP( OP_STOREP_FTOS )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
+			var_a = GetOperand( in, 0 );
+			idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
+		}
+		SCRIPT_NEXT();
 
-		case OP_STORE_FTOBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+	SCRIPT_OP( OP_STOREP_BTOS )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
+			var_a = GetOperand( in, 0 );
 			if ( *var_a.floatPtr != 0.0f ) {
-				*var_b.intPtr = 1;
-			} else {
-				*var_b.intPtr = 0;
-			}
-			break;
-
-		case OP_STORE_BOOLTOF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-			break;
-
-		case OP_STOREP_F:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
-			}
-			break;
-
-		case OP_STOREP_ENT:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-			}
-			break;
-
-		case OP_STOREP_FLD:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->intPtr = *var_a.intPtr;
-			}
-			break;
-
-		case OP_STOREP_BOOL:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->intPtr = *var_a.intPtr;
-			}
-			break;
-
-		case OP_STOREP_S:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
-			}
-			break;
-
-		case OP_STOREP_V:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
-			}
-			break;
-
-		case OP_STOREP_FTOS:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
-				idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
-			}
-			break;
-
-		case OP_STOREP_BTOS:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
-				if ( *var_a.floatPtr != 0.0f ) {
-					idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
-				} else {
-					idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
-				}
-			}
-			break;
-
-		case OP_STOREP_VTOS:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
-				idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
-			}
-			break;
-
-		case OP_STOREP_FTOBOOL:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
-				if ( *var_a.floatPtr != 0.0f ) {
-					*var_b.evalPtr->intPtr = 1;
-				} else {
-					*var_b.evalPtr->intPtr = 0;
-				}
-			}
-			break;
-
-		case OP_STOREP_BOOLTOF:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
-			}
-			break;
-
-		case OP_STOREP_OBJ:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-			}
-			break;
-
-		case OP_STOREP_OBJENT:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if ( !obj ) {
-					*var_b.evalPtr->entityNumberPtr = 0;
-
-				// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
-				// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
-				// comes from an entity
-				} else if ( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) ) {
-					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
-					*var_b.evalPtr->entityNumberPtr = 0;
-				} else {
-					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-				}
-			}
-			break;
-
-		case OP_ADDRESS:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
-			} else {
-				var_c.evalPtr->bytePtr = NULL;
-			}
-			break;
-
-		case OP_INDIRECT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.floatPtr = *var.floatPtr;
+				idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
 			} else {
-				*var_c.floatPtr = 0.0f;
+				idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 			}
-			break;
+		}
+		SCRIPT_NEXT();
 
-		case OP_INDIRECT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.entityNumberPtr = *var.entityNumberPtr;
-			} else {
-				*var_c.entityNumberPtr = 0;
-			}
-			break;
+	SCRIPT_OP( OP_STOREP_VTOS )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
+			var_a = GetOperand( in, 0 );
+			idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
+		}
+		SCRIPT_NEXT();
 
-		case OP_INDIRECT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.intPtr = *var.intPtr;
+	SCRIPT_OP( OP_STOREP_FTOBOOL )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
+			var_a = GetOperand( in, 0 );
+			if ( *var_a.floatPtr != 0.0f ) {
+				*var_b.evalPtr->intPtr = 1;
 			} else {
-				*var_c.intPtr = 0;
+				*var_b.evalPtr->intPtr = 0;
 			}
-			break;
+		}
+		SCRIPT_NEXT();
 
-		case OP_INDIRECT_S:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				SetString( st->c, var.stringPtr );
-			} else {
-				SetString( st->c, "" );
-			}
-			break;
+	SCRIPT_OP( OP_STOREP_BOOLTOF )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
+		}
+		SCRIPT_NEXT();
 
-		case OP_INDIRECT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.vectorPtr = *var.vectorPtr;
-			} else {
-				var_c.vectorPtr->Zero();
-			}
-			break;
+	SCRIPT_OP( OP_STOREP_OBJ )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_INDIRECT_OBJ:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+	SCRIPT_OP( OP_STOREP_OBJENT )
+		var_b = GetOperand( in, 1 );
+		if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
+			var_a = GetOperand( in, 0 );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
-				*var_c.entityNumberPtr = 0;
+				*var_b.evalPtr->entityNumberPtr = 0;
+
+			// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
+			// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
+			// comes from an entity
+			} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).c->TypeDef() ) ) {
+				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
+				*var_b.evalPtr->entityNumberPtr = 0;
 			} else {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.entityNumberPtr = *var.entityNumberPtr;
+				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_ADDRESS )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var_c.evalPtr->bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+		} else {
+			var_c.evalPtr->bytePtr = NULL;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_INDIRECT_F )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			*var_c.floatPtr = *var.floatPtr;
+		} else {
+			*var_c.floatPtr = 0.0f;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_INDIRECT_ENT )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			*var_c.entityNumberPtr = *var.entityNumberPtr;
+		} else {
+			*var_c.entityNumberPtr = 0;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_INDIRECT_BOOL )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			*var_c.intPtr = *var.intPtr;
+		} else {
+			*var_c.intPtr = 0;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_INDIRECT_S )
+		var_a = GetOperand( in, 0 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			SetString( in, 2, var.stringPtr );
+		} else {
+			SetString( in, 2, "" );
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_INDIRECT_V )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			*var_c.vectorPtr = *var.vectorPtr;
+		} else {
+			var_c.vectorPtr->Zero();
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_F:
-			var_a = GetVariable( st->a );
-			Push( *var_a.intPtr );
-			break;
+	SCRIPT_OP( OP_INDIRECT_OBJ )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( !obj ) {
+			*var_c.entityNumberPtr = 0;
+		} else {
+			var.bytePtr = &obj->data[ in->operand[ 1 ].ptrOffset ];
+			*var_c.entityNumberPtr = *var.entityNumberPtr;
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_F )
+		var_a = GetOperand( in, 0 );
+		Push( *var_a.intPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_FTOS )
+		var_a = GetOperand( in, 0 );
+		PushString( FloatToString( *var_a.floatPtr ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_BTOF )
+		var_a = GetOperand( in, 0 );
+		floatVal = *var_a.intPtr;
+		Push( *reinterpret_cast<int *>( &floatVal ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_FTOB )
+		var_a = GetOperand( in, 0 );
+		if ( *var_a.floatPtr != 0.0f ) {
+			Push( 1 );
+		} else {
+			Push( 0 );
+		}
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_VTOS )
+		var_a = GetOperand( in, 0 );
+		PushString( var_a.vectorPtr->ToString() );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_BTOS )
+		var_a = GetOperand( in, 0 );
+		PushString( *var_a.intPtr ? "true" : "false" );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_ENT )
+		var_a = GetOperand( in, 0 );
+		Push( *var_a.entityNumberPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_S )
+		PushString( GetString( in, 0 ) );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_V )
+		var_a = GetOperand( in, 0 );
+		PushVector(*var_a.vectorPtr);
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_OBJ )
+		var_a = GetOperand( in, 0 );
+		Push( *var_a.entityNumberPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_PUSH_OBJENT )
+		var_a = GetOperand( in, 0 );
+		Push( *var_a.entityNumberPtr );
+		SCRIPT_NEXT();
+
+	SCRIPT_OP( OP_EQ_F_IFNOT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+		instructionPointer++;
+		if ( *var_c.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in[ 1 ].operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_FTOS:
-			var_a = GetVariable( st->a );
-			PushString( FloatToString( *var_a.floatPtr ) );
-			break;
+	SCRIPT_OP( OP_NE_F_IFNOT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+		instructionPointer++;
+		if ( *var_c.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in[ 1 ].operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_BTOF:
-			var_a = GetVariable( st->a );
-			floatVal = *var_a.intPtr;
-			Push( *reinterpret_cast<int *>( &floatVal ) );
-			break;
+	SCRIPT_OP( OP_LT_IFNOT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+		instructionPointer++;
+		if ( *var_c.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in[ 1 ].operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_FTOB:
-			var_a = GetVariable( st->a );
-			if ( *var_a.floatPtr != 0.0f ) {
-				Push( 1 );
-			} else {
-				Push( 0 );
-			}
-			break;
+	SCRIPT_OP( OP_LE_IFNOT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+		instructionPointer++;
+		if ( *var_c.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in[ 1 ].operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_VTOS:
-			var_a = GetVariable( st->a );
-			PushString( var_a.vectorPtr->ToString() );
-			break;
+	SCRIPT_OP( OP_GT_IFNOT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+		instructionPointer++;
+		if ( *var_c.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in[ 1 ].operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_BTOS:
-			var_a = GetVariable( st->a );
-			PushString( *var_a.intPtr ? "true" : "false" );
-			break;
+	SCRIPT_OP( OP_GE_IFNOT )
+		var_a = GetOperand( in, 0 );
+		var_b = GetOperand( in, 1 );
+		var_c = GetOperand( in, 2 );
+		*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+		instructionPointer++;
+		if ( *var_c.intPtr == 0 ) {
+			NextInstruction( instructionPointer + in[ 1 ].operand[ 1 ].jumpOffset );
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_ENT:
-			var_a = GetVariable( st->a );
-			Push( *var_a.entityNumberPtr );
-			break;
+	SCRIPT_OP( OP_ADDRESS_STOREP_F )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		var_c.evalPtr->bytePtr = obj ? &obj->data[ in->operand[ 1 ].ptrOffset ] : NULL;
+		instructionPointer++;
+		in++;
+		if ( var_c.evalPtr->floatPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_c.evalPtr->floatPtr = *var_a.floatPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_S:
-			PushString( GetString( st->a ) );
-			break;
+	SCRIPT_OP( OP_ADDRESS_STOREP_V )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		var_c.evalPtr->bytePtr = obj ? &obj->data[ in->operand[ 1 ].ptrOffset ] : NULL;
+		instructionPointer++;
+		in++;
+		if ( var_c.evalPtr->vectorPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_c.evalPtr->vectorPtr = *var_a.vectorPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_V:
-			var_a = GetVariable( st->a );
-			PushVector(*var_a.vectorPtr);
-			break;
+	SCRIPT_OP( OP_ADDRESS_STOREP_ENT )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		var_c.evalPtr->bytePtr = obj ? &obj->data[ in->operand[ 1 ].ptrOffset ] : NULL;
+		instructionPointer++;
+		in++;
+		if ( var_c.evalPtr->entityNumberPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_c.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_OBJ:
-			var_a = GetVariable( st->a );
-			Push( *var_a.entityNumberPtr );
-			break;
+	SCRIPT_OP( OP_ADDRESS_STOREP_BOOL )
+		var_a = GetOperand( in, 0 );
+		var_c = GetOperand( in, 2 );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		var_c.evalPtr->bytePtr = obj ? &obj->data[ in->operand[ 1 ].ptrOffset ] : NULL;
+		instructionPointer++;
+		in++;
+		if ( var_c.evalPtr->intPtr ) {
+			var_a = GetOperand( in, 0 );
+			*var_c.evalPtr->intPtr = *var_a.intPtr;
+		}
+		SCRIPT_NEXT();
 
-		case OP_PUSH_OBJENT:
-			var_a = GetVariable( st->a );
-			Push( *var_a.entityNumberPtr );
-			break;
+	SCRIPT_OP( OP_PUSH_CALL )
+		// push the last parm and go straight on to the call
+		var_a = GetOperand( in, 0 );
+		Push( *var_a.intPtr );
+		instructionPointer++;
+		in++;
+		SCRIPT_DISPATCH();
 
-		case OP_BREAK:
-		case OP_CONTINUE:
-		default:
-			Error( "Bad opcode %i", st->op );
-			break;
-		}
+	SCRIPT_OP( OP_BREAK )
+	SCRIPT_OP( OP_CONTINUE )
+#ifndef SCRIPT_THREADED_DISPATCH
+	default:
+#endif
+		Error( "Bad opcode %i", in->op[ fused ] );
+		SCRIPT_NEXT();
+#ifndef SCRIPT_THREADED_DISPATCH
 	}
+#endif
 
 	return threadDying;
 }
 
+#undef SCRIPT_OP
+#undef SCRIPT_DISPATCH
+#undef SCRIPT_NEXT
+
 
 bool idGameEditExt::CheckForBreakPointHit(const idInterpreter* interpreter, const function_t* function1, const function_t* function2, int depth) const
 {
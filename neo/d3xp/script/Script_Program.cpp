@@ -28,6 +28,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "sys/platform.h"
 #include "idlib/hashing/MD4.h"
+#include "idlib/Timer.h"
 #include "framework/FileSystem.h"
 
 #include "gamesys/Event.h"
@@ -1742,6 +1743,111 @@ void idProgram::Disassemble( void ) const {
 	fileSystem->CloseFile( file );
 }
 
+/*
+==============
+FuseStatements
+
+Returns the superinstruction that executes st together with the statement following it,
+or st's own opcode when the pair can't be fused.
+==============
+*/
+static unsigned short FuseStatements( const statement_t &st, const statement_t &next ) {
+	switch( st.op ) {
+	case OP_EQ_F :
+	case OP_NE_F :
+	case OP_LT :
+	case OP_LE :
+	case OP_GT :
+	case OP_GE :
+		// compare and branch on the result
+		if ( ( next.op == OP_IFNOT ) && ( next.a == st.c ) ) {
+			switch( st.op ) {
+			case OP_EQ_F :	return OP_EQ_F_IFNOT;
+			case OP_NE_F :	return OP_NE_F_IFNOT;
+			case OP_LT :	return OP_LT_IFNOT;
+			case OP_LE :	return OP_LE_IFNOT;
+			case OP_GT :	return OP_GT_IFNOT;
+			case OP_GE :	return OP_GE_IFNOT;
+			}
+		}
+		break;
+
+	case OP_ADDRESS :
+		// take the address of an object field and store through it
+		if ( next.b == st.c ) {
+			switch( next.op ) {
+			case OP_STOREP_F :		return OP_ADDRESS_STOREP_F;
+			case OP_STOREP_V :		return OP_ADDRESS_STOREP_V;
+			case OP_STOREP_ENT :	return OP_ADDRESS_STOREP_ENT;
+			case OP_STOREP_BOOL :	return OP_ADDRESS_STOREP_BOOL;
+			}
+		}
+		break;
+
+	case OP_PUSH_F :
+	case OP_PUSH_ENT :
+	case OP_PUSH_OBJ :
+	case OP_PUSH_OBJENT :
+		// push the last parm and make the call
+		switch( next.op ) {
+		case OP_CALL :
+		case OP_EVENTCALL :
+		case OP_SYSCALL :
+		case OP_OBJECTCALL :
+			return OP_PUSH_CALL;
+		}
+		break;
+	}
+
+	return st.op;
+}
+
+/*
+==============
+idProgram::DecodeStatements
+
+Decodes the statements compiled since the last call into instructions.
+==============
+*/
+void idProgram::DecodeStatements( void ) {
+	int					i, j, first;
+	const statement_t	*st;
+	scriptInstruction_t	*in;
+	const idVarDef		*def;
+
+	first = instructions.Num();
+	if ( first >= statements.Num() ) {
+		return;
+	}
+
+	instructions.SetNum( statements.Num(), false );
+	for( i = first; i < statements.Num(); i++ ) {
+		st = &statements[ i ];
+		in = &instructions[ i ];
+		in->op[ 0 ] = st->op;
+		in->op[ 1 ] = st->op;
+		in->stackOperands = 0;
+		for( j = 0; j < 3; j++ ) {
+			def = ( j == 0 ) ? st->a : ( ( j == 1 ) ? st->b : st->c );
+			in->operand[ j ].bytePtr = NULL;
+			if ( !def ) {
+				continue;
+			}
+			if ( def->initialized == idVarDef::stackVariable ) {
+				in->stackOperands |= 1 << j;
+				in->operand[ j ].stackOffset = def->value.stackOffset;
+			} else {
+				in->operand[ j ] = def->value;
+			}
+		}
+	}
+
+	// the second statement of a fused pair is left as it is, so jumping to it still works
+	for( i = first; i < statements.Num() - 1; i++ ) {
+		instructions[ i ].op[ 1 ] = FuseStatements( statements[ i ], statements[ i + 1 ] );
+	}
+}
+
 /*
 ==============
 idProgram::FinishCompilation
@@ -1764,6 +1870,8 @@ void idProgram::FinishCompilation( void ) {
 	for( i = 0; i < numVariables; i++ ) {
 		variableDefaults[ i ] = variables[ i ];
 	}
+
+	DecodeStatements();
 }
 
 /*
@@ -1806,12 +1914,14 @@ void idProgram::CompileStats( void ) {
 	memallocated = funcMem + memused + sizeof( idProgram );
 
 	memused += statements.MemoryUsed();
+	memused += instructions.MemoryUsed();
 	memused += functions.MemoryUsed();	// name and filename of functions are shared, so no need to include them
 	memused += sizeof( variables );
 
 	gameLocal.Printf( "Memory usage:\n" );
 	gameLocal.Printf( "     Strings: %d, %d bytes\n", fileList.Num(), stringspace );
 	gameLocal.Printf( "  Statements: %d, %zd bytes\n", statements.Num(), statements.MemoryUsed() );
+	gameLocal.Printf( "Instructions: %d, %zd bytes\n", instructions.Num(), instructions.MemoryUsed() );
 	gameLocal.Printf( "   Functions: %d, %d bytes\n", functions.Num(), funcMem );
 	gameLocal.Printf( "   Variables: %d bytes\n", numVariables );
 	gameLocal.Printf( "    Mem used: %d bytes\n", memused );
@@ -1858,6 +1968,8 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 		}
 	};
 
+	DecodeStatements();
+
 	if ( !console ) {
 		CompileStats();
 	}
@@ -1892,14 +2004,42 @@ idProgram::CompileFile
 ================
 */
 void idProgram::CompileFile( const char *filename ) {
-	char *src;
-	bool result;
+	scriptCacheMark_t	mark;
+	scriptCacheSnapshot_t	snapshot;
+	unsigned int		compileMsec;
+	idTimer				loadTimer, compileTimer;
+	char				*src;
+	bool				result, useCache;
+
+	useCache = g_scriptCache.GetBool();
+	if ( useCache ) {
+		loadTimer.Start();
+		GetCacheMark( mark );
+		result = ReadCache( filename, mark, compileMsec );
+		loadTimer.Stop();
+
+		if ( result ) {
+			CompileStats();
+			gameLocal.Printf( "Loaded %s from the script cache in %u msec, %d msec faster than compiling it\n", filename, loadTimer.Milliseconds(), ( int )compileMsec - ( int )loadTimer.Milliseconds() );
+
+			if ( g_disasm.GetBool() ) {
+				Disassemble();
+			}
+			return;
+		}
+	}
 
 	if ( fileSystem->ReadFile( filename, ( void ** )&src, NULL ) < 0 ) {
 		gameLocal.Error( "Couldn't load %s\n", filename );
 	}
 
+	if ( useCache ) {
+		GetCacheSnapshot( mark, snapshot );
+	}
+
+	compileTimer.Start();
 	result = CompileText( filename, src, false );
+	compileTimer.Stop();
 
 	fileSystem->FreeFile( src );
 
@@ -1910,6 +2050,698 @@ void idProgram::CompileFile( const char *filename ) {
 	if ( !result ) {
 		gameLocal.Error( "Compile failed in file %s.", filename );
 	}
+
+	gameLocal.Printf( "Compiled %s in %u msec\n", filename, compileTimer.Milliseconds() );
+
+	if ( useCache && !WriteCache( filename, mark, snapshot, compileTimer.Milliseconds() ) ) {
+		gameLocal.DPrintf( "Couldn't write the script cache for %s\n", filename );
+	}
+}
+
+/***********************************************************************
+
+  Script cache
+
+  Compiling a file mostly appends to the program, so the cache stores
+  what a file added on top of the program it was compiled into, with
+  pointers turned into indices.  It's only used when it was written on
+  top of the same program and none of the source files have changed.
+  The only older state the cache replays is the numUsers of older defs,
+  no cache is written for a file that changed anything else before the
+  mark, like the body of a function declared in an earlier file.
+
+***********************************************************************/
+
+#define SCRIPT_CACHE_IDENT		( ( 'C' << 24 ) + ( 'S' << 16 ) + ( 'D' << 8 ) + 'I' )
+#define SCRIPT_CACHE_VERSION	2
+
+// how a def's value is stored in the cache
+enum {
+	CACHE_VALUE_RAW,			// offset or index in the value itself
+	CACHE_VALUE_GLOBAL,			// points into the global variables
+	CACHE_VALUE_FUNCTION		// points to a function
+};
+
+// types and defs are stored as their index in the program, or as one of these
+enum {
+	CACHE_REF_NULL		= -1,
+	CACHE_REF_UNCHANGED	= -2,		// an older type's def that was freed by a Restart, left as it is
+	CACHE_REF_BUILTIN	= -3		// CACHE_REF_BUILTIN - index in the lists below
+};
+
+static idTypeDef *cacheBuiltinTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef *cacheBuiltinDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+static const int numCacheBuiltins = sizeof( cacheBuiltinTypes ) / sizeof( cacheBuiltinTypes[ 0 ] );
+
+/*
+================
+CacheFileName
+================
+*/
+static idStr CacheFileName( const char *filename ) {
+	idStr name;
+
+	name = "scriptcache/";
+	name += filename;
+	name.SetFileExtension( ".bin" );
+
+	return name;
+}
+
+/*
+================
+CacheSourceChecksum
+================
+*/
+static bool CacheSourceChecksum( const char *filename, int &length, unsigned int &checksum ) {
+	void *buffer;
+
+	length = fileSystem->ReadFile( filename, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	checksum = MD4_BlockChecksum( buffer, length );
+	fileSystem->FreeFile( buffer );
+
+	return true;
+}
+
+/*
+================
+CachePointerKey
+================
+*/
+static int CachePointerKey( const void *ptr ) {
+	return ( int )( ( intptr_t )ptr >> 4 );
+}
+
+/*
+================
+CacheTypeRef
+================
+*/
+static int CacheTypeRef( const idTypeDef *type, const idList<idTypeDef *> &types, const idHashIndex &typeHash, bool &valid ) {
+	int i;
+
+	if ( !type ) {
+		return CACHE_REF_NULL;
+	}
+
+	for( i = typeHash.First( CachePointerKey( type ) ); i != -1; i = typeHash.Next( i ) ) {
+		if ( types[ i ] == type ) {
+			return i;
+		}
+	}
+
+	for( i = 0; i < numCacheBuiltins; i++ ) {
+		if ( cacheBuiltinTypes[ i ] == type ) {
+			return CACHE_REF_BUILTIN - i;
+		}
+	}
+
+	valid = false;
+	return CACHE_REF_NULL;
+}
+
+/*
+================
+CacheDefRef
+================
+*/
+static int CacheDefRef( const idVarDef *def, const idList<idVarDef *> &varDefs, const idHashIndex &defHash, bool &valid ) {
+	int i;
+
+	if ( !def ) {
+		return CACHE_REF_NULL;
+	}
+
+	// def may have been freed already, so only compare the pointer
+	for( i = defHash.First( CachePointerKey( def ) ); i != -1; i = defHash.Next( i ) ) {
+		if ( varDefs[ i ] == def ) {
+			return i;
+		}
+	}
+
+	for( i = 0; i < numCacheBuiltins; i++ ) {
+		if ( cacheBuiltinDefs[ i ] == def ) {
+			return CACHE_REF_BUILTIN - i;
+		}
+	}
+
+	valid = false;
+	return CACHE_REF_NULL;
+}
+
+/*
+================
+CacheType
+================
+*/
+static idTypeDef *CacheType( int ref, const idList<idTypeDef *> &types ) {
+	if ( ref >= 0 ) {
+		return types[ ref ];
+	} else if ( ref == CACHE_REF_NULL ) {
+		return NULL;
+	}
+	return cacheBuiltinTypes[ CACHE_REF_BUILTIN - ref ];
+}
+
+/*
+================
+CacheDef
+================
+*/
+static idVarDef *CacheDef( int ref, const idList<idVarDef *> &varDefs ) {
+	if ( ref >= 0 ) {
+		return varDefs[ ref ];
+	} else if ( ref == CACHE_REF_NULL ) {
+		return NULL;
+	}
+	return cacheBuiltinDefs[ CACHE_REF_BUILTIN - ref ];
+}
+
+/*
+================
+idProgram::GetCacheMark
+================
+*/
+void idProgram::GetCacheMark( scriptCacheMark_t &mark ) const {
+	mark.types		= types.Num();
+	mark.defs		= varDefs.Num();
+	mark.functions	= functions.Num();
+	mark.statements	= statements.Num();
+	mark.variables	= numVariables;
+	mark.files		= fileList.Num();
+	mark.checksum	= CalculateChecksum( false );
+}
+
+/*
+================
+idProgram::GetCacheSnapshot
+
+Remembers the part of the program before mark that compiling a file could change.
+================
+*/
+void idProgram::GetCacheSnapshot( const scriptCacheMark_t &mark, scriptCacheSnapshot_t &snapshot ) const {
+	idFile_Memory		data( "scriptsnapshot" );
+	const idVarDef		*def;
+	const function_t	*func;
+	int					i, j;
+
+	snapshot.numUsers.SetNum( mark.defs );
+	for( i = 0; i < mark.defs; i++ ) {
+		def = varDefs[ i ];
+		snapshot.numUsers[ i ] = def->numUsers;
+		data.Write( &def, sizeof( def ) );
+		data.WriteInt( def->num );
+		data.WriteInt( def->initialized );
+		data.Write( &def->value, sizeof( def->value ) );
+	}
+
+	for( i = 0; i < mark.functions; i++ ) {
+		func = &functions[ i ];
+		data.Write( &func->def, sizeof( func->def ) );
+		data.WriteInt( func->firstStatement );
+		data.WriteInt( func->numStatements );
+		data.WriteInt( func->parmTotal );
+		data.WriteInt( func->locals );
+		data.WriteInt( func->parmSize.Num() );
+		for( j = 0; j < func->parmSize.Num(); j++ ) {
+			data.WriteInt( func->parmSize[ j ] );
+		}
+	}
+
+	if ( mark.statements ) {
+		data.WriteUnsignedInt( MD4_BlockChecksum( &statements[ 0 ], mark.statements * sizeof( statements[ 0 ] ) ) );
+	}
+
+	snapshot.checksum = MD4_BlockChecksum( data.GetDataPtr(), data.Length() );
+}
+
+/*
+================
+idProgram::WriteCache
+
+Stores everything compiling filename added to the program since mark.  Returns false
+if any of it can't be stored as an index, or if compiling changed more of the program
+before mark than the numUsers of the defs in snapshot, in which case no cache is written.
+================
+*/
+bool idProgram::WriteCache( const char *filename, const scriptCacheMark_t &mark, const scriptCacheSnapshot_t &snapshot, unsigned int compileMsec ) const {
+	idFile_Memory				data( "scriptcache" );
+	idFile						*file;
+	idHashIndex					typeHash, defHash;
+	idStrList					sources;
+	idList<const idEventDef *>	events;
+	const idTypeDef				*type;
+	const idVarDef				*def;
+	const function_t			*func;
+	const statement_t			*st;
+	varEval_t					raw;
+	int							i, j, kind, value, length;
+	unsigned int				checksum;
+	scriptCacheSnapshot_t		current;
+	idList<int>					changedDefs;
+	bool						valid, found;
+
+	// freeing an older def renumbers the defs after it
+	if ( ( varDefs.Num() < mark.defs ) || ( functions.Num() < mark.functions ) || ( statements.Num() < mark.statements ) ) {
+		return false;
+	}
+
+	// the cache can't replay a prototype getting its body or any other change to the older program
+	GetCacheSnapshot( mark, current );
+	if ( current.checksum != snapshot.checksum ) {
+		return false;
+	}
+
+	// older immediates the new code uses
+	for( i = 0; i < mark.defs; i++ ) {
+		if ( current.numUsers[ i ] != snapshot.numUsers[ i ] ) {
+			changedDefs.Append( i );
+		}
+	}
+
+	valid = true;
+
+	for( i = 0; i < types.Num(); i++ ) {
+		typeHash.Add( CachePointerKey( types[ i ] ), i );
+	}
+	for( i = 0; i < varDefs.Num(); i++ ) {
+		defHash.Add( CachePointerKey( varDefs[ i ] ), i );
+	}
+
+	// new types
+	for( i = mark.types; i < types.Num(); i++ ) {
+		type = types[ i ];
+		data.WriteInt( type->type );
+		data.WriteString( type->name );
+		data.WriteInt( type->size );
+		data.WriteInt( CacheTypeRef( type->auxType, types, typeHash, valid ) );
+		data.WriteInt( type->parmTypes.Num() );
+		for( j = 0; j < type->parmTypes.Num(); j++ ) {
+			data.WriteInt( CacheTypeRef( type->parmTypes[ j ], types, typeHash, valid ) );
+			data.WriteString( type->parmNames[ j ] );
+		}
+	}
+
+	// compiling can point older types at new defs and functions as well
+	for( i = 0; i < types.Num(); i++ ) {
+		type = types[ i ];
+		found = true;
+		value = CacheDefRef( type->def, varDefs, defHash, found );
+		if ( !found ) {
+			if ( i >= mark.types ) {
+				valid = false;
+			}
+			value = CACHE_REF_UNCHANGED;
+		}
+		data.WriteInt( value );
+		data.WriteInt( type->functions.Num() );
+		for( j = 0; j < type->functions.Num(); j++ ) {
+			data.WriteInt( ( int )( type->functions[ j ] - &functions[ 0 ] ) );
+		}
+	}
+
+	// new defs
+	for( i = mark.defs; i < varDefs.Num(); i++ ) {
+		def = varDefs[ i ];
+		data.WriteString( def->Name() );
+		data.WriteInt( CacheTypeRef( def->TypeDef(), types, typeHash, valid ) );
+		data.WriteInt( CacheDefRef( def->scope, varDefs, defHash, valid ) );
+		data.WriteInt( def->numUsers );
+		data.WriteInt( def->initialized );
+
+		if ( ( def->value.bytePtr >= variables ) && ( def->value.bytePtr <= &variables[ numVariables ] ) ) {
+			kind = CACHE_VALUE_GLOBAL;
+			value = ( int )( def->value.bytePtr - variables );
+		} else if ( ( def->Type() == ev_function ) && ( def->value.functionPtr != NULL ) ) {
+			kind = CACHE_VALUE_FUNCTION;
+			value = ( int )( def->value.functionPtr - &functions[ 0 ] );
+			if ( ( value < 0 ) || ( value >= functions.Num() ) ) {
+				valid = false;
+			}
+		} else {
+			// anything else has to survive being stored as an int
+			kind = CACHE_VALUE_RAW;
+			value = def->value.ptrOffset;
+			memset( &raw, 0, sizeof( raw ) );
+			raw.ptrOffset = value;
+			if ( memcmp( &raw, &def->value, sizeof( raw ) ) ) {
+				valid = false;
+			}
+		}
+		data.WriteInt( kind );
+		data.WriteInt( value );
+	}
+
+	// new functions
+	for( i = mark.functions; i < functions.Num(); i++ ) {
+		func = &functions[ i ];
+		data.WriteString( func->Name() );
+		data.WriteInt( func->eventdef ? events.AddUnique( func->eventdef ) : -1 );
+		data.WriteInt( CacheDefRef( func->def, varDefs, defHash, valid ) );
+		data.WriteInt( CacheTypeRef( func->type, types, typeHash, valid ) );
+		data.WriteInt( func->firstStatement );
+		data.WriteInt( func->numStatements );
+		data.WriteInt( func->parmTotal );
+		data.WriteInt( func->locals );
+		data.WriteInt( func->filenum );
+		data.WriteInt( func->parmSize.Num() );
+		for( j = 0; j < func->parmSize.Num(); j++ ) {
+			data.WriteInt( func->parmSize[ j ] );
+		}
+	}
+
+	// new statements
+	for( i = mark.statements; i < statements.Num(); i++ ) {
+		st = &statements[ i ];
+		data.WriteUnsignedShort( st->op );
+		data.WriteUnsignedShort( st->flags );
+		data.WriteUnsignedShort( st->linenumber );
+		data.WriteUnsignedShort( st->file );
+		data.WriteInt( CacheDefRef( st->a, varDefs, defHash, valid ) );
+		data.WriteInt( CacheDefRef( st->b, varDefs, defHash, valid ) );
+		data.WriteInt( CacheDefRef( st->c, varDefs, defHash, valid ) );
+	}
+
+	// new globals
+	data.Write( &variables[ mark.variables ], numVariables - mark.variables );
+
+	// new files
+	for( i = mark.files; i < fileList.Num(); i++ ) {
+		data.WriteString( fileList[ i ] );
+	}
+
+	// older defs with more or fewer users
+	data.WriteInt( changedDefs.Num() );
+	for( i = 0; i < changedDefs.Num(); i++ ) {
+		data.WriteInt( changedDefs[ i ] );
+		data.WriteInt( current.numUsers[ changedDefs[ i ] ] );
+	}
+
+	if ( !valid ) {
+		return false;
+	}
+
+	sources.AddUnique( filename );
+	for( i = mark.files; i < fileList.Num(); i++ ) {
+		sources.AddUnique( fileList[ i ] );
+	}
+
+	file = fileSystem->OpenFileWrite( CacheFileName( filename ) );
+	if ( !file ) {
+		return false;
+	}
+
+	file->WriteInt( SCRIPT_CACHE_IDENT );
+	file->WriteInt( SCRIPT_CACHE_VERSION );
+	file->WriteInt( NUM_OPCODES );
+	file->WriteUnsignedInt( compileMsec );
+	file->Write( &mark, sizeof( mark ) );
+
+	file->WriteInt( sources.Num() );
+	for( i = 0; i < sources.Num(); i++ ) {
+		if ( !CacheSourceChecksum( sources[ i ], length, checksum ) ) {
+			valid = false;
+			break;
+		}
+		file->WriteString( sources[ i ] );
+		file->WriteInt( length );
+		file->WriteUnsignedInt( checksum );
+	}
+
+	file->WriteInt( events.Num() );
+	for( i = 0; i < events.Num(); i++ ) {
+		file->WriteString( events[ i ]->GetName() );
+		file->WriteString( events[ i ]->GetArgFormat() );
+		file->WriteInt( events[ i ]->GetReturnType() );
+	}
+
+	file->WriteInt( types.Num() - mark.types );
+	file->WriteInt( varDefs.Num() - mark.defs );
+	file->WriteInt( functions.Num() - mark.functions );
+	file->WriteInt( statements.Num() - mark.statements );
+	file->WriteInt( numVariables - mark.variables );
+	file->WriteInt( fileList.Num() - mark.files );
+
+	file->WriteInt( data.Length() );
+	file->WriteUnsignedInt( MD4_BlockChecksum( data.GetDataPtr(), data.Length() ) );
+	file->Write( data.GetDataPtr(), data.Length() );
+
+	fileSystem->CloseFile( file );
+
+	if ( !valid ) {
+		// a source file couldn't be read back, so don't leave a cache that can never match
+		fileSystem->RemoveFile( CacheFileName( filename ) );
+		return false;
+	}
+
+	return true;
+}
+
+/*
+================
+idProgram::ReadCacheData
+
+Everything that can make the cache unusable is checked before the program is touched.
+================
+*/
+bool idProgram::ReadCacheData( const char *data, int length, const scriptCacheMark_t &mark, unsigned int &compileMsec ) {
+	idFile_Memory				file( "scriptcache", data, length );
+	scriptCacheMark_t			cacheMark;
+	idList<const idEventDef *>	events;
+	idStr						name, format;
+	const idEventDef			*ev;
+	idTypeDef					*type;
+	idVarDef					*def;
+	function_t					*func;
+	statement_t					*st;
+	int							i, j, num, kind, value, ident, version, numOpcodes;
+	int							numTypes, numDefs, numFunctions, numStatements, numVars, numFiles;
+	int							sourceLength, payloadLength;
+	unsigned int				checksum, sourceChecksum;
+
+	file.ReadInt( ident );
+	file.ReadInt( version );
+	file.ReadInt( numOpcodes );
+	if ( ( ident != SCRIPT_CACHE_IDENT ) || ( version != SCRIPT_CACHE_VERSION ) || ( numOpcodes != NUM_OPCODES ) ) {
+		return false;
+	}
+
+	file.ReadUnsignedInt( compileMsec );
+
+	// the cache only applies on top of the same program it was compiled into
+	file.Read( &cacheMark, sizeof( cacheMark ) );
+	if ( memcmp( &cacheMark, &mark, sizeof( mark ) ) ) {
+		return false;
+	}
+
+	file.ReadInt( num );
+	for( i = 0; i < num; i++ ) {
+		file.ReadString( name );
+		file.ReadInt( sourceLength );
+		file.ReadUnsignedInt( sourceChecksum );
+		if ( !CacheSourceChecksum( name, value, checksum ) || ( value != sourceLength ) || ( checksum != sourceChecksum ) ) {
+			return false;
+		}
+	}
+
+	file.ReadInt( num );
+	for( i = 0; i < num; i++ ) {
+		file.ReadString( name );
+		file.ReadString( format );
+		file.ReadInt( value );
+		ev = idEventDef::FindEvent( name );
+		if ( !ev || ( format != ev->GetArgFormat() ) || ( value != ev->GetReturnType() ) ) {
+			return false;
+		}
+		events.Append( ev );
+	}
+
+	file.ReadInt( numTypes );
+	file.ReadInt( numDefs );
+	file.ReadInt( numFunctions );
+	file.ReadInt( numStatements );
+	file.ReadInt( numVars );
+	file.ReadInt( numFiles );
+	if ( ( functions.Num() + numFunctions > functions.Max() ) || ( statements.Num() + numStatements > statements.Max() ) || ( numVariables + numVars > ( int )sizeof( variables ) ) ) {
+		return false;
+	}
+
+	file.ReadInt( payloadLength );
+	file.ReadUnsignedInt( checksum );
+	if ( ( file.Tell() + payloadLength != length ) || ( MD4_BlockChecksum( data + file.Tell(), payloadLength ) != checksum ) ) {
+		return false;
+	}
+
+	// allocate everything up front so references can be resolved in any order
+	for( i = 0; i < numTypes; i++ ) {
+		types.Append( new idTypeDef( ev_void, NULL, "", 0, NULL ) );
+	}
+	for( i = 0; i < numDefs; i++ ) {
+		def = new idVarDef();
+		def->num = varDefs.Append( def );
+	}
+	for( i = 0; i < numFunctions; i++ ) {
+		func = functions.Alloc();
+		func->Clear();
+		func->parmSize.SetGranularity( 1 );
+	}
+
+	for( i = mark.types; i < types.Num(); i++ ) {
+		type = types[ i ];
+		file.ReadInt( value );
+		type->type = ( etype_t )value;
+		file.ReadString( type->name );
+		file.ReadInt( type->size );
+		file.ReadInt( value );
+		type->auxType = CacheType( value, types );
+		file.ReadInt( num );
+		type->parmTypes.SetNum( num );
+		type->parmNames.SetNum( num );
+		for( j = 0; j < num; j++ ) {
+			file.ReadInt( value );
+			type->parmTypes[ j ] = CacheType( value, types );
+			file.ReadString( type->parmNames[ j ] );
+		}
+	}
+
+	for( i = 0; i < types.Num(); i++ ) {
+		type = types[ i ];
+		file.ReadInt( value );
+		if ( value != CACHE_REF_UNCHANGED ) {
+			type->def = CacheDef( value, varDefs );
+		}
+		file.ReadInt( num );
+		type->functions.SetNum( num );
+		for( j = 0; j < num; j++ ) {
+			file.ReadInt( value );
+			type->functions[ j ] = &functions[ value ];
+		}
+	}
+
+	for( i = mark.defs; i < varDefs.Num(); i++ ) {
+		def = varDefs[ i ];
+		file.ReadString( name );
+		AddDefToNameList( def, name );
+		file.ReadInt( value );
+		def->SetTypeDef( CacheType( value, types ) );
+		file.ReadInt( value );
+		def->scope = CacheDef( value, varDefs );
+		file.ReadInt( def->numUsers );
+		file.ReadInt( value );
+		def->initialized = ( idVarDef::initialized_t )value;
+		file.ReadInt( kind );
+		file.ReadInt( value );
+		switch( kind ) {
+			case CACHE_VALUE_GLOBAL:
+				def->value.bytePtr = &variables[ value ];
+				break;
+			case CACHE_VALUE_FUNCTION:
+				def->value.functionPtr = &functions[ value ];
+				break;
+			default:
+				def->value.ptrOffset = value;
+				break;
+		}
+	}
+
+	for( i = mark.functions; i < functions.Num(); i++ ) {
+		func = &functions[ i ];
+		file.ReadString( name );
+		func->SetName( name );
+		file.ReadInt( value );
+		func->eventdef = ( value >= 0 ) ? events[ value ] : NULL;
+		file.ReadInt( value );
+		func->def = CacheDef( value, varDefs );
+		file.ReadInt( value );
+		func->type = CacheType( value, types );
+		file.ReadInt( func->firstStatement );
+		file.ReadInt( func->numStatements );
+		file.ReadInt( func->parmTotal );
+		file.ReadInt( func->locals );
+		file.ReadInt( func->filenum );
+		file.ReadInt( num );
+		func->parmSize.SetNum( num );
+		for( j = 0; j < num; j++ ) {
+			file.ReadInt( func->parmSize[ j ] );
+		}
+	}
+
+	for( i = 0; i < numStatements; i++ ) {
+		st = statements.Alloc();
+		file.ReadUnsignedShort( st->op );
+		file.ReadUnsignedShort( st->flags );
+		file.ReadUnsignedShort( st->linenumber );
+		file.ReadUnsignedShort( st->file );
+		file.ReadInt( value );
+		st->a = CacheDef( value, varDefs );
+		file.ReadInt( value );
+		st->b = CacheDef( value, varDefs );
+		file.ReadInt( value );
+		st->c = CacheDef( value, varDefs );
+	}
+
+	file.Read( &variables[ numVariables ], numVars );
+	numVariables += numVars;
+
+	for( i = 0; i < numFiles; i++ ) {
+		file.ReadString( name );
+		fileList.Append( name );
+	}
+
+	file.ReadInt( num );
+	for( i = 0; i < num; i++ ) {
+		file.ReadInt( j );
+		file.ReadInt( value );
+		varDefs[ j ]->numUsers = value;
+	}
+
+	return true;
+}
+
+/*
+================
+idProgram::ReadCache
+
+Loads what compiling filename on top of mark would add to the program, if the cache is still valid.
+================
+*/
+bool idProgram::ReadCache( const char *filename, const scriptCacheMark_t &mark, unsigned int &compileMsec ) {
+	void	*buffer;
+	int		length;
+	bool	result;
+
+	length = fileSystem->ReadFile( CacheFileName( filename ), &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	result = ReadCacheData( ( const char * )buffer, length, mark, compileMsec );
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !result ) {
+		gameLocal.DPrintf( "Script cache for %s is out of date\n", filename );
+		return false;
+	}
+
+	// leave the same file number behind as compiling it would
+	filenum = GetFilenum( fileSystem->RelativePathToOSPath( filename ) );
+
+	DecodeStatements();
+
+	return true;
 }
 
 /*
@@ -1945,7 +2777,9 @@ void idProgram::FreeData( void ) {
 	filename.Clear();
 	fileList.Clear();
 	statements.Clear();
+	instructions.Clear();
 	functions.Clear();
+	profile.Clear();
 
 	top_functions	= 0;
 	top_statements	= 0;
@@ -2156,7 +2990,11 @@ void idProgram::Restart( void ) {
 	functions.SetNum( top_functions	);
 
 	statements.SetNum( top_statements );
+	instructions.SetNum( top_statements, false );
 	fileList.SetNum( top_files, false );
+
+	// function numbers past top_functions are reused by the next map
+	profile.SetNum( Min( profile.Num(), top_functions ), false );
 	filename.Clear();
 
 	// reset the variables to their default values
@@ -2191,12 +3029,97 @@ int idProgram::GetFilenum( const char *name ) {
 	return filenum;
 }
 
+/*
+================
+idProgram::StartProfile
+================
+*/
+void idProgram::StartProfile( void ) {
+	profile.Clear();
+	profiling = true;
+}
+
+/*
+================
+idProgram::StopProfile
+================
+*/
+void idProgram::StopProfile( void ) {
+	profiling = false;
+}
+
+/*
+================
+idProgram::GetProfile
+================
+*/
+scriptProfile_t &idProgram::GetProfile( const function_t *func ) {
+	int i, num;
+
+	num = GetFunctionIndex( func );
+	if ( num >= profile.Num() ) {
+		i = profile.Num();
+		profile.SetNum( num + 1 );
+		for( ; i < profile.Num(); i++ ) {
+			memset( &profile[ i ], 0, sizeof( profile[ i ] ) );
+			profile[ i ].function = i;
+		}
+	}
+	return profile[ num ];
+}
+
+/*
+================
+SortProfileByTime
+================
+*/
+static int SortProfileByTime( const scriptProfile_t *a, const scriptProfile_t *b ) {
+	if ( a->usec != b->usec ) {
+		return ( a->usec > b->usec ) ? -1 : 1;
+	}
+	return b->instructions - a->instructions;
+}
+
+/*
+================
+idProgram::PrintProfile
+
+Lists the functions that took the most time since the profile was started.
+================
+*/
+void idProgram::PrintProfile( int numFunctions ) {
+	idList<scriptProfile_t>	sorted;
+	int						i, totalInstructions;
+	unsigned int			totalUsec;
+
+	totalInstructions = 0;
+	totalUsec = 0;
+	for( i = 0; i < profile.Num(); i++ ) {
+		if ( profile[ i ].instructions ) {
+			sorted.Append( profile[ i ] );
+			totalInstructions += profile[ i ].instructions;
+			totalUsec += profile[ i ].usec;
+		}
+	}
+
+	sorted.Sort( SortProfileByTime );
+
+	gameLocal.Printf( "%s, %d functions, %d instructions, %u usec\n", profiling ? "profiling" : "not profiling", sorted.Num(), totalInstructions, totalUsec );
+	gameLocal.Printf( "   usec    pct   instructions   calls  function\n" );
+	for( i = 0; i < sorted.Num() && i < numFunctions; i++ ) {
+		const scriptProfile_t &p = sorted[ i ];
+		gameLocal.Printf( "%7u  %5.1f  %13d  %6d  %s\n", p.usec, totalUsec ? p.usec * 100.0f / totalUsec : 0.0f,
+			p.instructions, p.calls, functions[ p.function ].Name() );
+	}
+}
+
 /*
 ================
 idProgram::idProgram
 ================
 */
 idProgram::idProgram() {
+	profiling = false;
 	FreeData();
 }
 
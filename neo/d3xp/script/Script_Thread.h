@@ -79,6 +79,8 @@ extern const idEventDef EV_Thread_FadeTo;
 extern const idEventDef EV_Thread_Restart;
 
 class idThread : public idClass {
+	friend class idThreadSleepQueue;
+
 private:
 	static idThread				*currentThread;
 
@@ -97,6 +99,15 @@ private:
 
 	bool						manualControl;
 
+								// scheduler state, see idThread::ServiceNextThread
+	int							wakeTime;				// -1 when the thread isn't scheduled to run
+	int64_t						wakeSequence;
+	int							sleepIndex;				// index in the sleep queue, -1 if not sleeping
+	idLinkList<idThread>		waitNode;				// in the wait list of the entity waitingFor
+
+	uint64_t					executeUsec;			// total time spent executing script code
+	int							executeCount;
+
 	static int					threadIndex;
 	static idList<idThread *>	threadList;
 
@@ -104,6 +115,8 @@ private:
 
 	void						Init( void );
 	void						Pause( void );
+	void						Schedule( int time );
+	void						Unschedule( void );
 
 	void						Event_Execute( void );
 	void						Event_SetThreadName( const char *name );
@@ -235,6 +248,7 @@ public:
 	static void					ListThreads_f( const idCmdArgs &args );
 	static void					Restart( void );
 	static void					ObjectMoveDone( int threadnum, idEntity *obj );
+	static bool					ServiceNextThread( int time, int64_t sequence );
 
 	static idList<idThread*>&	GetThreads ( void );
 
@@ -245,7 +259,7 @@ public:
 	static void					KillThread( const char *name );
 	static void					KillThread( int num );
 	bool						Execute( void );
-	void						ManualControl( void ) { manualControl = true; CancelEvents( &EV_Thread_Execute ); };
+	void						ManualControl( void ) { manualControl = true; Unschedule(); };
 	void						DoneProcessing( void ) { interpreter.doneProcessing = true; };
 	void						ContinueProcessing( void ) { interpreter.doneProcessing = false; };
 	bool						ThreadDying( void ) { return interpreter.threadDying; };
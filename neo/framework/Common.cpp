@@ -42,6 +42,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "framework/Game.h"
 #include "framework/KeyInput.h"
 #include "framework/EventLoop.h"
+#include "framework/JobSystem.h"
 #include "renderer/Image.h"
 #include "renderer/Model.h"
 #include "renderer/ModelManager.h"
@@ -2692,6 +2693,7 @@ void idCommonLocal::LoadGameDLL( void ) {
 	gameImport.declManager				= ::declManager;
 	gameImport.AASFileManager			= ::AASFileManager;
 	gameImport.collisionModelManager	= ::collisionModelManager;
+	gameImport.jobSystem				= ::jobSystem;
 
 	gameExport							= *GetGameAPI( &gameImport);
 
@@ -2999,6 +3001,9 @@ void idCommonLocal::Init( int argc, char **argv ) {
 		// initialize processor specific SIMD implementation
 		InitSIMD();
 
+		// start the job worker threads
+		jobSystem->Init();
+
 		// init commands
 		InitCommands();
 
@@ -3068,6 +3073,9 @@ void idCommonLocal::Shutdown( void ) {
 	// game specific shut down
 	ShutdownGame( false );
 
+	// stop the job worker threads
+	jobSystem->Shutdown();
+
 	// shut down non-portable system services
 	Sys_Shutdown();
 
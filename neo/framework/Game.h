@@ -43,6 +43,7 @@ class idRenderModelManager;
 class idUserInterface;
 class idUserInterfaceManager;
 class idNetworkSystem;
+class idJobSystem;
 
 /*
 ===============================================================================
@@ -368,7 +369,7 @@ public:
 ===============================================================================
 */
 
-const int GAME_API_VERSION		= 9;
+const int GAME_API_VERSION		= 10;
 
 typedef struct {
 
@@ -386,6 +387,7 @@ typedef struct {
 	idDeclManager *				declManager;			// declaration manager
 	idAASFileManager *			AASFileManager;			// AAS file manager
 	idCollisionModelManager *	collisionModelManager;	// collision model manager
+	idJobSystem *				jobSystem;				// job system
 
 } gameImport_t;
 
@@ -0,0 +1,308 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code ("Doom 3 Source Code").
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include <SDL_cpuinfo.h>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+
+#include "sys/platform.h"
+#include "sys/sys_public.h"
+#include "framework/Common.h"
+#include "framework/CVarSystem.h"
+
+#include "framework/JobSystem.h"
+
+idCVar com_jobThreads( "com_jobThreads", "-1", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_INTEGER, "number of worker threads for parallel jobs, -1 = one per additional CPU core, 0 = run all jobs on the main thread, takes effect on restart", -1, MAX_JOB_THREADS - 1 );
+
+/*
+===============================================================================
+
+	idJobSystemLocal
+
+===============================================================================
+*/
+
+class idJobSystemLocal : public idJobSystem {
+public:
+							idJobSystemLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+	virtual int				GetNumThreads( void ) const;
+	virtual int				GetThreadIndex( void ) const;
+	virtual void			RunJobs( jobRun_t function, void *data, int numJobs );
+	virtual bool			IsRunningJobs( void ) const;
+
+private:
+	SDL_mutex *				mutex;
+	SDL_cond *				jobsAvailable;		// signaled when a batch starts or on shutdown
+	SDL_cond *				jobsDone;			// signaled when the last job of a batch completes
+	xthreadInfo				threads[MAX_JOB_THREADS];
+	unsigned int			threadIds[MAX_JOB_THREADS];
+	int						numWorkers;
+	bool					shutdown;
+
+	// the batch currently being executed
+	jobRun_t				function;
+	void *					data;
+	int						numJobs;
+	int						nextJob;
+	int						numJobsDone;
+	bool					running;
+
+	void					ExecuteJobs( void );
+	static int				WorkerThread( void *parm );
+};
+
+idJobSystemLocal			jobSystemLocal;
+idJobSystem *				jobSystem = &jobSystemLocal;
+
+/*
+==================
+idJobSystemLocal::idJobSystemLocal
+==================
+*/
+idJobSystemLocal::idJobSystemLocal( void ) {
+	mutex = NULL;
+	jobsAvailable = NULL;
+	jobsDone = NULL;
+	memset( threads, 0, sizeof( threads ) );
+	memset( threadIds, 0, sizeof( threadIds ) );
+	numWorkers = 0;
+	shutdown = false;
+	function = NULL;
+	data = NULL;
+	numJobs = 0;
+	nextJob = 0;
+	numJobsDone = 0;
+	running = false;
+}
+
+/*
+==================
+idJobSystemLocal::Init
+==================
+*/
+void idJobSystemLocal::Init( void ) {
+	int count = com_jobThreads.GetInteger();
+	if ( count < 0 ) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		count = SDL_GetCPUCount() - 1;
+#else
+		count = 0;
+#endif
+	}
+	count = idMath::ClampInt( 0, MAX_JOB_THREADS - 1, count );
+
+	numWorkers = 0;
+	shutdown = false;
+
+	if ( count > 0 ) {
+		mutex = SDL_CreateMutex();
+		jobsAvailable = SDL_CreateCond();
+		jobsDone = SDL_CreateCond();
+		if ( !mutex || !jobsAvailable || !jobsDone ) {
+			common->Warning( "idJobSystem: couldn't create synchronization objects, running jobs on the main thread" );
+			Shutdown();
+			return;
+		}
+
+		static const char *threadNames[MAX_JOB_THREADS] = {
+			"main", "job1", "job2", "job3", "job4", "job5", "job6", "job7"
+		};
+		for ( int i = 1; i <= count; i++ ) {
+			Sys_CreateThread( WorkerThread, this, threads[i], threadNames[i] );
+			if ( !threads[i].threadHandle ) {
+				break;
+			}
+			threadIds[i] = threads[i].threadId;
+			numWorkers = i;
+		}
+	}
+
+	common->Printf( "job system: %d worker thread%s\n", numWorkers, numWorkers == 1 ? "" : "s" );
+}
+
+/*
+==================
+idJobSystemLocal::Shutdown
+==================
+*/
+void idJobSystemLocal::Shutdown( void ) {
+	if ( mutex ) {
+		SDL_LockMutex( mutex );
+		shutdown = true;
+		SDL_CondBroadcast( jobsAvailable );
+		SDL_UnlockMutex( mutex );
+	}
+
+	for ( int i = 1; i <= numWorkers; i++ ) {
+		Sys_DestroyThread( threads[i] );
+		threadIds[i] = 0;
+	}
+	numWorkers = 0;
+
+	if ( jobsDone ) {
+		SDL_DestroyCond( jobsDone );
+		jobsDone = NULL;
+	}
+	if ( jobsAvailable ) {
+		SDL_DestroyCond( jobsAvailable );
+		jobsAvailable = NULL;
+	}
+	if ( mutex ) {
+		SDL_DestroyMutex( mutex );
+		mutex = NULL;
+	}
+}
+
+/*
+==================
+idJobSystemLocal::GetNumThreads
+==================
+*/
+int idJobSystemLocal::GetNumThreads( void ) const {
+	return numWorkers + 1;
+}
+
+/*
+==================
+idJobSystemLocal::GetThreadIndex
+==================
+*/
+int idJobSystemLocal::GetThreadIndex( void ) const {
+	if ( numWorkers == 0 ) {
+		return 0;
+	}
+	unsigned int id = SDL_ThreadID();
+	for ( int i = 1; i <= numWorkers; i++ ) {
+		if ( threadIds[i] == id ) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+/*
+==================
+idJobSystemLocal::IsRunningJobs
+==================
+*/
+bool idJobSystemLocal::IsRunningJobs( void ) const {
+	return running;
+}
+
+/*
+==================
+idJobSystemLocal::ExecuteJobs
+
+Executes jobs of the current batch until there are none left.
+The mutex must be locked by the caller.
+==================
+*/
+void idJobSystemLocal::ExecuteJobs( void ) {
+	while ( nextJob < numJobs ) {
+		int jobNum = nextJob++;
+
+		SDL_UnlockMutex( mutex );
+		function( data, jobNum );
+		SDL_LockMutex( mutex );
+
+		if ( ++numJobsDone == numJobs ) {
+			SDL_CondSignal( jobsDone );
+		}
+	}
+}
+
+/*
+==================
+idJobSystemLocal::WorkerThread
+==================
+*/
+int idJobSystemLocal::WorkerThread( void *parm ) {
+	idJobSystemLocal *js = static_cast<idJobSystemLocal *>( parm );
+
+	SDL_LockMutex( js->mutex );
+	while ( !js->shutdown ) {
+		if ( js->nextJob < js->numJobs ) {
+			js->ExecuteJobs();
+		} else {
+			SDL_CondWait( js->jobsAvailable, js->mutex );
+		}
+	}
+	SDL_UnlockMutex( js->mutex );
+
+	return 0;
+}
+
+/*
+==================
+idJobSystemLocal::RunJobs
+==================
+*/
+void idJobSystemLocal::RunJobs( jobRun_t function, void *data, int numJobs ) {
+	if ( numJobs <= 0 ) {
+		return;
+	}
+
+	// without workers, for single jobs and for jobs started from inside
+	// another job or from another thread just run everything right here
+	if ( numWorkers == 0 || numJobs == 1 || running || !Sys_IsMainThread() ) {
+		for ( int i = 0; i < numJobs; i++ ) {
+			function( data, i );
+		}
+		return;
+	}
+
+	SDL_LockMutex( mutex );
+
+	this->function = function;
+	this->data = data;
+	this->numJobs = numJobs;
+	this->nextJob = 0;
+	this->numJobsDone = 0;
+	running = true;
+
+	SDL_CondBroadcast( jobsAvailable );
+
+	// the calling thread works on the batch as well
+	ExecuteJobs();
+
+	while ( numJobsDone < numJobs ) {
+		SDL_CondWait( jobsDone, mutex );
+	}
+
+	this->function = NULL;
+	this->data = NULL;
+	this->numJobs = 0;
+	this->nextJob = 0;
+	this->numJobsDone = 0;
+	running = false;
+
+	SDL_UnlockMutex( mutex );
+}
@@ -0,0 +1,80 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code ("Doom 3 Source Code").
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __JOBSYSTEM_H__
+#define __JOBSYSTEM_H__
+
+/*
+===============================================================================
+
+	Job system.
+
+	A small pool of worker threads that executes batches of independent jobs.
+	A batch is started with RunJobs, which also executes jobs on the calling
+	thread and returns once every job of the batch has completed.
+
+	Jobs are handed out in increasing job number order, but may complete in
+	any order, so anything that needs a deterministic result should write to
+	per job output and merge it after RunJobs returns.
+
+	Job functions must not call back into systems that are not thread safe
+	(the heap, the vertex cache, OpenGL, the game code).  Nested RunJobs calls
+	made from inside a job execute serially on the calling thread.
+
+===============================================================================
+*/
+
+// maximum number of threads executing jobs, including the main thread
+#define MAX_JOB_THREADS				8
+
+typedef void (*jobRun_t)( void *data, int jobNum );
+
+class idJobSystem {
+public:
+	virtual					~idJobSystem( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+							// number of threads executing jobs, including the calling thread
+	virtual int				GetNumThreads( void ) const = 0;
+
+							// 0 for the main thread and any thread that is not a job worker,
+							// 1 to GetNumThreads() - 1 for the workers
+	virtual int				GetThreadIndex( void ) const = 0;
+
+							// calls function( data, jobNum ) for every jobNum in [0, numJobs)
+	virtual void			RunJobs( jobRun_t function, void *data, int numJobs ) = 0;
+
+							// true while a batch of jobs is being executed
+	virtual bool			IsRunningJobs( void ) const = 0;
+};
+
+extern idJobSystem *		jobSystem;
+
+#endif /* !__JOBSYSTEM_H__ */
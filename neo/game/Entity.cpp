@@ -450,6 +450,8 @@ idEntity::idEntity() {
 
 	thinkFlags		= 0;
 	dormantStart	= 0;
+	thinkLODFrame	= 0;
+	thinkLODTime	= -1;
 	cinematic		= false;
 	renderView		= NULL;
 	cameraTarget	= NULL;
@@ -577,6 +579,7 @@ void idEntity::Spawn( void ) {
 
 	fl.solidForTeam = spawnArgs.GetBool( "solidForTeam", "0" );
 	fl.neverDormant = spawnArgs.GetBool( "neverDormant", "0" );
+	fl.noThinkLOD = spawnArgs.GetBool( "noThinkLOD", "0" );
 	fl.hidden = spawnArgs.GetBool( "hide", "0" );
 	if ( fl.hidden ) {
 		// make sure we're hidden, since a spawn function might not set it up right
@@ -801,6 +804,10 @@ void idEntity::Restore( idRestoreGame *savefile ) {
 
 	// spawnNode and activeNode are restored by gameLocal
 
+	// the think LOD isn't saved, it starts over after a load
+	thinkLODFrame = 0;
+	thinkLODTime = -1;
+
 	savefile->ReadInt( snapshotSequence );
 	savefile->ReadInt( snapshotBits );
 
@@ -1071,6 +1078,8 @@ void idEntity::BecomeActive( int flags ) {
 	if ( thinkFlags ) {
 		if ( !IsActive() ) {
 			activeNode.AddToEnd( gameLocal.activeEntities );
+			// time skipped by the think LOD before the entity went inactive doesn't carry over
+			thinkLODTime = -1;
 		} else if ( !oldFlags ) {
 			// we became inactive this frame, so we have to decrease the count of entities to deactivate
 			gameLocal.numEntitiesToDeactivate--;
@@ -3090,75 +3099,54 @@ explosions and melee attacks.
 ============
 */
 bool idEntity::CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const {
-	idVec3	dest;
+	int		i;
 	trace_t	tr;
-	idVec3	midpoint;
-
-	// use the midpoint of the bounds instead of the origin, because
-	// bmodels may have their origin at 0,0,0
-	midpoint = ( GetPhysics()->GetAbsBounds()[0] + GetPhysics()->GetAbsBounds()[1] ) * 0.5;
 
-	dest = midpoint;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
+	for ( i = 0; i < NUM_DAMAGE_TEST_POINTS; i++ ) {
+		gameLocal.clip.TracePoint( tr, origin, GetDamageTestPoint( i ), MASK_SOLID, NULL );
+		if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
+			damagePoint = tr.endpos;
+			return true;
+		}
 	}
 
-	// this should probably check in the plane of projection, rather than in world coordinate
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	return false;
+}
 
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+/*
+============
+idEntity::GetDamageTestPoint
 
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+Points CanDamage traces to, in the order they are tested.
+============
+*/
+idVec3 idEntity::GetDamageTestPoint( int index ) const {
+	idVec3	dest;
 
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	// use the midpoint of the bounds instead of the origin, because
+	// bmodels may have their origin at 0,0,0
+	dest = ( GetPhysics()->GetAbsBounds()[0] + GetPhysics()->GetAbsBounds()[1] ) * 0.5;
 
-	dest = midpoint;
-	dest[2] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
+	// this should probably check in the plane of projection, rather than in world coordinate
+	switch( index ) {
+		case 1:		dest[0] += 15.0; dest[1] += 15.0; break;
+		case 2:		dest[0] += 15.0; dest[1] -= 15.0; break;
+		case 3:		dest[0] -= 15.0; dest[1] += 15.0; break;
+		case 4:		dest[0] -= 15.0; dest[1] -= 15.0; break;
+		case 5:		dest[2] += 15.0; break;
+		case 6:		dest[2] -= 15.0; break;
 	}
 
-	dest = midpoint;
-	dest[2] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	return dest;
+}
 
-	return false;
+/*
+============
+idEntity::UsesDamageTestPoints
+============
+*/
+bool idEntity::UsesDamageTestPoints( void ) const {
+	return true;
 }
 
 /*
@@ -133,6 +133,7 @@ typedef struct entDamageEffect_s {
 class idEntity : public idClass {
 public:
 	static const int		MAX_PVS_AREAS = 4;
+	static const int		NUM_DAMAGE_TEST_POINTS = 7;
 
 	int						entityNumber;			// index into the entity list
 	int						entityDefNumber;		// index into the entity def list
@@ -150,6 +151,8 @@ public:
 
 	int						thinkFlags;				// TH_? flags
 	int						dormantStart;			// time that the entity was first closed off from player
+	int						thinkLODFrame;			// last frame the entity thought, see idGameLocal::RunEntityThink
+	int						thinkLODTime;			// start of the time the entity skipped thinking, -1 if it did not skip
 	bool					cinematic;				// during cinematics, entity will only think if cinematic is set
 
 	renderView_t			*renderView;			// for camera views from this entity
@@ -179,6 +182,7 @@ public:
 		bool				grabbed				:1;	// if true object is currently being grabbed
 		
 		bool				invisible			:1; // if true this entity is currently invisible and cannot be seen by other entities
+		bool				noThinkLOD			:1;	// if true the entity always thinks every frame
 	} fl;
 
 	int						timeGroup;
@@ -338,6 +342,11 @@ public:
 	// damage
 							// returns true if this entity can be damaged from the given origin
 	virtual bool			CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const;
+							// point CanDamage traces to, 0 is the center of the bounds
+	idVec3					GetDamageTestPoint( int index ) const;
+							// true if CanDamage only traces to the damage test points so the traces can be batched,
+							// entities that override CanDamage have to override this as well
+	virtual bool			UsesDamageTestPoints( void ) const;
 							// applies damage to this entity
 	virtual	void			Damage( idEntity *inflictor, idEntity *attacker, const idVec3 &dir, const char *damageDefName, const float damageScale, const int location );
 
@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "idlib/containers/LinkList.h"
 #include "idlib/BitMsg.h"
 #include "framework/Game.h"
+#include "framework/JobSystem.h"
 
 #include "gamesys/SaveGame.h"
 #include "physics/Clip.h"
@@ -415,6 +416,7 @@ public:
 	int						NumAAS( void ) const;
 	idAAS					*GetAAS( int num ) const;
 	idAAS					*GetAAS( const char *name ) const;
+	void					BuildAASRoutingTables( void );
 	void					SetAASAreaState( const idBounds &bounds, const int areaContents, bool closed );
 	aasHandle_t				AddAASObstacle( const idBounds &bounds );
 	void					RemoveAASObstacle( const aasHandle_t handle );
@@ -503,7 +505,7 @@ public:
 
 private:
 	const static int		INITIAL_SPAWN_COUNT = 1;
-	const static int		INTERNAL_SAVEGAME_VERSION = 1; // DG: added this for >= 1305 savegames
+	const static int		INTERNAL_SAVEGAME_VERSION = 2; // DG: added this for >= 1305 savegames; 2: script threads save their wake time, events and threads their sequence
 
 	idStr					mapFileName;			// name of the map, empty string if no map loaded
 	idMapFile				*mapFile;				// will be NULL during the game unless in-game editing is used
@@ -544,6 +546,15 @@ private:
 	idEventQueue			eventQueue;
 	idEventQueue			savedEventQueue;
 
+	// animators that get their frame built on the job workers this frame, see RunParallelThink
+	idList<idAnimator*>	thinkAnimators;
+	int						numThinkJobs;
+
+	// think LOD counters of the current frame, see RunEntityThink
+	int						numFullThinks;
+	int						numReducedThinks;
+	int						numSkippedThinks;
+
 	idStaticList<spawnSpot_t, MAX_GENTITIES> spawnSpots;
 	idStaticList<idEntity*, MAX_GENTITIES> initialSpots;
 	int						currentInitialSpot;
@@ -572,6 +583,11 @@ private:
 	void					FreePlayerPVS( void );
 	void					UpdateGravity( void );
 	void					SortActiveEntityList( void );
+	void					RunParallelThink( void );
+	static void				ParallelThinkJob( void *data, int jobNum );
+	int						GetThinkInterval( idEntity *ent ) const;
+	bool					ThinkLODSkips( const idEntity *ent, int interval ) const;
+	bool					RunEntityThink( idEntity *ent );
 	void					ShowTargets( void );
 	void					RunDebugInfo( void );
 
@@ -608,6 +624,7 @@ private:
 
 extern idGameLocal			gameLocal;
 extern idAnimManager		animationLib;
+extern idAnimPoseCache		animPoseCache;
 
 //============================================================================
 
@@ -3518,6 +3518,8 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 	idBounds		ownerBounds, projBounds;
 	bool			barrelLaunch;
 	bool			tracer, beam;
+	idList<idVec3>	dirs;
+	idList<clipTrace_t>	traces;
 
 	assert( owner != NULL );
 
@@ -3621,17 +3623,33 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 		}
 	}
 	
-	idVec3 &launch_pos = view_pos;
+	idVec3 launch_pos;
 	const float tracer_speed = projectileDict.GetFloat( "tracer_speed", "0.0f" ); 
 
+	// pick the directions of all projectiles first so the traces from the view can be done in one batch
+	dirs.SetNum( num_projectiles );
+	traces.SetNum( num_projectiles );
 	for ( i = 0; i < num_projectiles; i++ ) {
 		ang = idMath::Sin( spreadRad * gameLocal.random.RandomFloat() );
 		spin = ( float )DEG2RAD( 360.0f ) * gameLocal.random.RandomFloat();
 		dir = playerViewAxis[0] + playerViewAxis[2] * ( ang * idMath::Sin( spin ) ) - playerViewAxis[1] * ( ang * idMath::Cos( spin ) );
 		dir.Normalize();
+		dirs[i] = dir;
+		traces[i].start = view_pos;
+		traces[i].end = view_pos + dir * 4096.0f;
+		traces[i].bounds.Clear();
+		traces[i].contentMask = MASK_SHOT_RENDERMODEL;
+		traces[i].passEntity = owner;
+	}
+	if ( barrelLaunch || tracer || beam || isPrediction ) {
+		gameLocal.clip.TraceBatch( traces.Ptr(), traces.Num() );
+	}
+
+	for ( i = 0; i < num_projectiles; i++ ) {
+		dir = dirs[i];
+		tr = traces[i].results;
 		if ( barrelLaunch || tracer || beam ) { // Do not execute this part unless projectile is barrel launched or has a tracer effect.
 
-			gameLocal.clip.Translation( tr, view_pos, view_pos + dir * 4096.0f, NULL, mat3_identity, MASK_SHOT_RENDERMODEL, owner );
 			traceDist = ( tr.endpos - view_pos ).LengthSqr(); // This is faster
 	
 			if ( traceDist > muzzleDistFromView ) { // make sure the muzzle is not to close to walls etc
@@ -3658,8 +3676,6 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 			if ( tr.fraction < 1.0f ) {
 				if ( barrelLaunch ) {	//a new trace should be made for multiplayer prediction of barrel launched projectiles
 					gameLocal.clip.Translation( tr, muzzle_pos, muzzle_pos + dir * 4096.0f, NULL, mat3_identity, MASK_SHOT_RENDERMODEL, owner ); 
-				} else {
-					gameLocal.clip.Translation( tr, view_pos, view_pos + dir * 4096.0f, NULL, mat3_identity, MASK_SHOT_RENDERMODEL, owner );
 				}
 				idProjectile::ClientPredictionCollide( this, projectileDict, tr, vec3_origin, true );
 			}
@@ -3685,9 +3701,7 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 				ent->fl.networkSync = false;
 			}
 			
-			if ( barrelLaunch ) {
-				launch_pos = muzzle_pos;		
-			}
+			launch_pos = barrelLaunch ? muzzle_pos : view_pos;
 			proj = static_cast<idProjectile*>( ent );
 			proj->Create( owner, launch_pos, dir );
 
@@ -54,6 +54,18 @@ typedef struct aasPath_s {
 	const idReachability		*reachability;	// reachability used for navigation
 } aasPath_t;
 
+typedef struct aasPathCache_s {
+	int							routingState;	// routing state the path was found in, zero if the cache is empty
+	bool						fly;			// fly path instead of walk path
+	int							areaNum;		// query the path was found for
+	idVec3						origin;
+	int							goalAreaNum;
+	idVec3						goalOrigin;
+	int							travelFlags;
+	bool						result;			// true if a path was found
+	aasPath_t					path;			// the path
+} aasPathCache_t;
+
 typedef struct aasGoal_s {
 	int							areaNum;		// area the goal is in
 	idVec3						origin;			// position of goal
@@ -143,12 +155,17 @@ public:
 	virtual bool				FlyPathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags ) const = 0;
 								// Returns true if one can fly along a straight line from the origin to the goal origin.
 	virtual bool				FlyPathValid( int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, idVec3 &endPos, int &endAreaNum ) const = 0;
+								// Creates a walk or fly path towards the goal, a query repeated with the same arguments is answered from the cache
+								// until areas are enabled or disabled, or obstacles are added or removed.
+	virtual bool				PathToGoal( aasPathCache_t &cache, aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, bool fly ) const = 0;
 								// Show the walk path from the origin towards the area.
 	virtual void				ShowWalkPath( const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin ) const = 0;
 								// Show the fly path from the origin towards the area.
 	virtual void				ShowFlyPath( const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin ) const = 0;
 								// Find the nearest goal which satisfies the callback.
 	virtual bool				FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 origin, const idVec3 &target, int travelFlags, aasObstacle_t *obstacles, int numObstacles, idAASCallback &callback ) const = 0;
+								// Build the routing tables of the AAS file, they are used the next time it is loaded.
+	virtual void				BuildRoutingTables( void ) = 0;
 };
 
 #endif /* !__AAS_H__ */
\ No newline at end of file
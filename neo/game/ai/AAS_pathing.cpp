@@ -29,6 +29,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "sys/platform.h"
 #include "framework/Common.h"
 
+#include "gamesys/SysCvar.h"
+
 #include "ai/AAS_local.h"
 
 #define SUBSAMPLE_WALK_PATH		1
@@ -537,6 +539,41 @@ bool idAASLocal::FlyPathToGoal( aasPath_t &path, int areaNum, const idVec3 &orig
 	return true;
 }
 
+/*
+============
+idAASLocal::PathToGoal
+
+  The path found last time is returned when nothing changed since.
+============
+*/
+bool idAASLocal::PathToGoal( aasPathCache_t &cache, aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, bool fly ) const {
+	numPathQueries++;
+
+	if ( aas_cachePathQueries.GetBool() && cache.routingState == routingState && cache.fly == fly &&
+			cache.areaNum == areaNum && cache.goalAreaNum == goalAreaNum && cache.travelFlags == travelFlags &&
+			cache.origin == origin && cache.goalOrigin == goalOrigin ) {
+		numPathCacheHits++;
+		path = cache.path;
+		return cache.result;
+	}
+
+	if ( fly ) {
+		cache.result = FlyPathToGoal( path, areaNum, origin, goalAreaNum, goalOrigin, travelFlags );
+	} else {
+		cache.result = WalkPathToGoal( path, areaNum, origin, goalAreaNum, goalOrigin, travelFlags );
+	}
+	cache.routingState = routingState;
+	cache.fly = fly;
+	cache.areaNum = areaNum;
+	cache.origin = origin;
+	cache.goalAreaNum = goalAreaNum;
+	cache.goalOrigin = goalOrigin;
+	cache.travelFlags = travelFlags;
+	cache.path = path;
+
+	return cache.result;
+}
+
 typedef struct wallEdge_s {
 	int					edgeNum;
 	int					verts[2];
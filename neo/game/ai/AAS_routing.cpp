@@ -28,6 +28,10 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "sys/platform.h"
 
+#include "idlib/Timer.h"
+#include "framework/FileSystem.h"
+#include "gamesys/SysCvar.h"
+
 #include "Game_local.h"
 
 #include "ai/AAS_local.h"
@@ -35,7 +39,20 @@ If you have questions concerning this license or the applicable additional terms
 #define CACHETYPE_AREA				1
 #define CACHETYPE_PORTAL			2
 
-#define MAX_ROUTING_CACHE_MEMORY	( 2 * 1024 * 1024 )
+#define MIN_ROUTING_CACHE_MEMORY	( 2 * 1024 * 1024 )
+#define MAX_ROUTING_CACHE_MEMORY	( 32 * 1024 * 1024 )
+
+#define ROUTING_TABLE_IDENT			( ( 'T' << 24 ) + ( 'R' << 16 ) + ( 'S' << 8 ) + 'A' )
+#define ROUTING_TABLE_VERSION		2
+#define ROUTING_TABLE_EXTENSION		".routes"
+
+#define ROUTE_QUERY_HASH_SIZE		4096
+
+// the routing tables are built for the travel flags used by walking and flying monsters
+static const int routingTableTravelFlags[] = {
+	TFL_WALK | TFL_AIR,
+	TFL_WALK | TFL_AIR | TFL_FLY
+};
 
 #define LEDGE_TRAVELTIME_PANALTY	250
 
@@ -187,7 +204,7 @@ idAASLocal::SetupRoutingCache
 ============
 */
 void idAASLocal::SetupRoutingCache( void ) {
-	int i;
+	int i, offset, numClusterTravelTimes;
 	byte *bytePtr;
 
 	areaCacheIndexSize = 0;
@@ -210,8 +227,32 @@ void idAASLocal::SetupRoutingCache( void ) {
 
 	goalAreaTravelTimes = ( unsigned short* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( unsigned short ) );
 
+	// the routing tables store a row for every reachable area in every cluster
+	// followed by a row for every area in the world
+	clusterTableOffset.SetNum( file->GetNumClusters() );
+	clusterChanges.SetNum( file->GetNumClusters() );
+	offset = 0;
+	numClusterTravelTimes = 0;
+	for ( i = 0; i < file->GetNumClusters(); i++ ) {
+		clusterTableOffset[i] = offset;
+		offset += file->GetCluster( i ).numReachableAreas;
+		numClusterTravelTimes += file->GetCluster( i ).numReachableAreas * file->GetCluster( i ).numReachableAreas;
+		clusterChanges[i] = 0;
+	}
+	numChangedClusters = 0;
+
+	// by default the cache may grow until it could hold the area cache of every area once
+	defaultCacheMemory = numClusterTravelTimes * ( sizeof( unsigned short ) + sizeof( byte ) ) + areaCacheIndexSize * sizeof( idRoutingCache );
+	defaultCacheMemory = idMath::ClampInt( MIN_ROUTING_CACHE_MEMORY, MAX_ROUTING_CACHE_MEMORY, defaultCacheMemory );
+
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	numCacheHits = numCacheMisses = numCacheTableFills = numCacheEvictions = 0;
+
+	routeQueries = ( idRouteQuery* ) Mem_ClearedAlloc( ROUTE_QUERY_HASH_SIZE * sizeof( idRouteQuery ) );
+	routingState = 1;
+	numRouteQueries = numRouteQueriesDeduped = 0;
+	numPathQueries = numPathCacheHits = 0;
 }
 
 /*
@@ -297,6 +338,12 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 		goalAreaTravelTimes = NULL;
 	}
 
+	clusterTableOffset.Clear();
+	clusterChanges.Clear();
+
+	Mem_Free( routeQueries );
+	routeQueries = NULL;
+
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
 }
@@ -313,9 +360,14 @@ bool idAASLocal::SetupRouting( void ) {
 	areaUpdate = NULL;
 	portalUpdate = NULL;
 	goalAreaTravelTimes = NULL;
+	routingTableData = NULL;
+	routingTableSize = 0;
+	routeQueries = NULL;
 
 	CalculateAreaTravelTimes();
 	SetupRoutingCache();
+
+	LoadRoutingTables();
 	return true;
 }
 
@@ -327,6 +379,7 @@ idAASLocal::ShutdownRouting
 void idAASLocal::ShutdownRouting( void ) {
 	DeleteAreaTravelTimes();
 	ShutdownRoutingCache();
+	FreeRoutingTables();
 }
 
 /*
@@ -344,21 +397,44 @@ void idAASLocal::RoutingStats( void ) const {
 	for ( cache = cacheListStart; cache; cache = cache->time_next ) {
 		if ( cache->type == CACHETYPE_AREA ) {
 			numAreaCache++;
-			totalAreaCacheMemory += sizeof( idRoutingCache ) + cache->size * ( sizeof( unsigned short ) + sizeof( byte ) );
+			totalAreaCacheMemory += cache->Size();
 		} else {
 			numPortalCache++;
-			totalPortalCacheMemory += sizeof( idRoutingCache ) + cache->size * ( sizeof( unsigned short ) + sizeof( byte ) );
+			totalPortalCacheMemory += cache->Size();
 		}
 	}
 
 	gameLocal.Printf( "%6d area cache (%d KB)\n", numAreaCache, totalAreaCacheMemory >> 10 );
 	gameLocal.Printf( "%6d portal cache (%d KB)\n", numPortalCache, totalPortalCacheMemory >> 10 );
 	gameLocal.Printf( "%6d total cache (%d KB)\n", numAreaCache + numPortalCache, totalCacheMemory >> 10 );
+	gameLocal.Printf( "%6d KB cache memory limit (%d KB used by the routing tables)\n", RoutingCacheMemory() >> 10, routingTableSize >> 10 );
+	gameLocal.Printf( "%6d cache hits\n", numCacheHits );
+	gameLocal.Printf( "%6d cache misses\n", numCacheMisses );
+	gameLocal.Printf( "%6d cache fills from routing tables\n", numCacheTableFills );
+	gameLocal.Printf( "%6d cache evictions\n", numCacheEvictions );
+	gameLocal.Printf( "%6d routing tables (%d KB, %d clusters changed)\n", routingTables.Num(), routingTableSize >> 10, numChangedClusters );
+	gameLocal.Printf( "%6d route queries (%d deduped)\n", numRouteQueries, numRouteQueriesDeduped );
+	gameLocal.Printf( "%6d path queries (%d from path cache)\n", numPathQueries, numPathCacheHits );
 	gameLocal.Printf( "%6d area travel times (%zd KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%zd KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache* ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%zd KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache* ) ) >> 10 );
 }
 
+/*
+============
+idAASLocal::RoutingCacheMemory
+
+The routing tables are part of the memory used for routing so they count
+towards the limit, by default they are added on top of the cache.
+============
+*/
+int idAASLocal::RoutingCacheMemory( void ) const {
+	if ( aas_routingCacheMemory.GetInteger() > 0 ) {
+		return aas_routingCacheMemory.GetInteger() << 10;
+	}
+	return defaultCacheMemory + routingTableSize;
+}
+
 /*
 ============
 idAASLocal::RemoveRoutingCacheUsingArea
@@ -377,6 +453,9 @@ void idAASLocal::RemoveRoutingCacheUsingArea( int areaNum ) {
 		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[1] );
 	}
 	DeletePortalCache();
+
+	// all route queries and paths found so far are no longer valid
+	routingState++;
 }
 
 /*
@@ -393,6 +472,7 @@ void idAASLocal::DisableArea( int areaNum ) {
 
 	file->SetAreaTravelFlag( areaNum, TFL_INVALID );
 	RemoveRoutingCacheUsingArea( areaNum );
+	ChangeRoutingTableState( areaNum, 1 );
 }
 
 /*
@@ -409,6 +489,7 @@ void idAASLocal::EnableArea( int areaNum ) {
 
 	file->RemoveAreaTravelFlag( areaNum, TFL_INVALID );
 	RemoveRoutingCacheUsingArea( areaNum );
+	ChangeRoutingTableState( areaNum, -1 );
 }
 
 /*
@@ -510,6 +591,7 @@ void idAASLocal::SetObstacleState( const idRoutingObstacle *obstacle, bool enabl
 
 	for ( i = 0; i < obstacle->areas.Num(); i++ ) {
 		RemoveRoutingCacheUsingArea( obstacle->areas[i] );
+		ChangeRoutingTableState( obstacle->areas[i], enable ? 1 : -1 );
 
 		area = &file->GetArea( obstacle->areas[i] );
 		for ( rev_reach = area->rev_reach; rev_reach; rev_reach = rev_reach->rev_next ) {
@@ -693,6 +775,7 @@ void idAASLocal::DeleteOldestCache( void ) const {
 	}
 
 	delete cache;
+	numCacheEvictions++;
 }
 
 /*
@@ -849,6 +932,7 @@ idAASLocal::GetAreaRoutingCache
 idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const {
 	int clusterAreaNum;
 	idRoutingCache *cache, *clusterCache;
+	const idRoutingTable *table;
 
 	// number of the area in the cluster
 	clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
@@ -877,7 +961,16 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 			clusterCache->prev = cache;
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
+		table = GetAreaRoutingTable( clusterNum, travelFlags );
+		if ( table ) {
+			FillRoutingCache( cache, table, clusterTableOffset[clusterNum] + clusterAreaNum );
+			numCacheTableFills++;
+		} else {
+			UpdateAreaRoutingCache( cache );
+			numCacheMisses++;
+		}
+	} else {
+		numCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -980,6 +1073,7 @@ idAASLocal::GetPortalRoutingCache
 */
 idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const {
 	idRoutingCache *cache;
+	const idRoutingTable *table;
 
 	// check if cache without undesired travel flags already exists
 	for ( cache = portalCacheIndex[areaNum]; cache; cache = cache->next ) {
@@ -1002,18 +1096,564 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 			portalCacheIndex[areaNum]->prev = cache;
 		}
 		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache( cache );
+		table = GetPortalRoutingTable( travelFlags );
+		if ( table ) {
+			FillRoutingCache( cache, table, areaCacheIndexSize + areaNum );
+			numCacheTableFills++;
+		} else {
+			UpdatePortalRoutingCache( cache );
+			numCacheMisses++;
+		}
+	} else {
+		numCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
 }
 
+/*
+============
+idAASLocal::RoutingTableFileName
+============
+*/
+idStr idAASLocal::RoutingTableFileName( void ) const {
+	idStr fileName;
+
+	fileName = file->GetName();
+	fileName += ROUTING_TABLE_EXTENSION;
+	return fileName;
+}
+
+/*
+============
+RoutingTableDataSize
+
+Size of a routing table in the file and in memory, each table is padded so the
+next one starts aligned.
+============
+*/
+static int RoutingTableDataSize( int numRows, int numRuns, int numEntries ) {
+	int size;
+
+	size = 2 * ( numRows + 1 ) * sizeof( int ) + numRuns * 2 * sizeof( unsigned short ) + numEntries * ( sizeof( unsigned short ) + sizeof( byte ) );
+	return ( size + 3 ) & ~3;
+}
+
+typedef struct routingTableBuild_s {
+	idList<int>				rowRuns;
+	idList<int>				rowEntries;
+	idList<unsigned short>	runs;
+	idList<unsigned short>	travelTimes;
+	idList<byte>			reachabilities;
+} routingTableBuild_t;
+
+/*
+============
+AppendRoutingTableRow
+
+Stores the runs of consecutive areas or portals a routing cache can reach,
+everything it can't reach is left out of the table.
+============
+*/
+static void AppendRoutingTableRow( routingTableBuild_t &build, const unsigned short *travelTimes, const byte *reachabilities, int size ) {
+	int i, j;
+
+	build.rowRuns.Append( build.runs.Num() / 2 );
+	build.rowEntries.Append( build.travelTimes.Num() );
+
+	for ( i = 0; i < size; i = j ) {
+		if ( !travelTimes[i] ) {
+			j = i + 1;
+			continue;
+		}
+		for ( j = i + 1; j < size && travelTimes[j]; j++ ) {
+		}
+		build.runs.Append( i );
+		build.runs.Append( j - i );
+		for ( ; i < j; i++ ) {
+			build.travelTimes.Append( travelTimes[i] );
+			build.reachabilities.Append( reachabilities[i] );
+		}
+	}
+}
+
+/*
+============
+idAASLocal::BuildRoutingTables
+
+Calculates the area cache of every reachable area in every cluster and the portal
+cache of every area for each of the routing table travel flags, and writes the
+reachable part of them to a file next to the AAS file.  The AAS has to be freshly
+loaded without disabled areas or obstacles, the tables are used from the next
+time the AAS file is loaded.
+============
+*/
+void idAASLocal::BuildRoutingTables( void ) {
+	int i, j, n, clusterNum, clusterAreaNum, numReachableAreas, numTables, numRows, numRuns, numEntries;
+	idList<int> rowAreas;
+	idList<routingTableBuild_t> tables;
+	idRoutingCache *cache;
+	idStr fileName;
+	idFile *f;
+	idTimer timer;
+
+	if ( !file ) {
+		return;
+	}
+
+	fileName = RoutingTableFileName();
+
+	// the tables have to describe the routing of the AAS file as it is stored
+	if ( numChangedClusters != 0 ) {
+		gameLocal.Warning( "can't build %s while areas are disabled or obstacles are present", fileName.c_str() );
+		return;
+	}
+	// the runs store the area and portal numbers in 16 bits
+	if ( file->GetNumPortals() > 0xFFFF ) {
+		gameLocal.Warning( "can't build %s, the AAS file has too many portals", fileName.c_str() );
+		return;
+	}
+	for ( i = 0; i < file->GetNumClusters(); i++ ) {
+		if ( file->GetCluster( i ).numReachableAreas > 0xFFFF ) {
+			gameLocal.Warning( "can't build %s, cluster %d has too many areas", fileName.c_str(), i );
+			return;
+		}
+	}
+
+	timer.Start();
+
+	FreeRoutingTables();
+
+	// area of each area cache row, portal areas are in two clusters
+	rowAreas.SetNum( areaCacheIndexSize );
+	for ( i = 0; i < areaCacheIndexSize; i++ ) {
+		rowAreas[i] = 0;
+	}
+	for ( n = 1; n < file->GetNumAreas(); n++ ) {
+		if ( file->GetArea( n ).cluster == 0 ) {
+			continue;
+		}
+		for ( j = 0; j < 2; j++ ) {
+			clusterNum = file->GetArea( n ).cluster;
+			if ( clusterNum > 0 ) {
+				if ( j ) {
+					break;
+				}
+			} else {
+				clusterNum = file->GetPortal( -clusterNum ).clusters[j];
+			}
+
+			clusterAreaNum = ClusterAreaNum( clusterNum, n );
+			if ( clusterAreaNum < file->GetCluster( clusterNum ).numReachableAreas ) {
+				rowAreas[clusterTableOffset[clusterNum] + clusterAreaNum] = n;
+			}
+		}
+	}
+
+	numTables = sizeof( routingTableTravelFlags ) / sizeof( routingTableTravelFlags[0] );
+	numRows = areaCacheIndexSize + file->GetNumAreas();
+	tables.SetNum( numTables );
+
+	for ( i = 0; i < numTables; i++ ) {
+		routingTableBuild_t &build = tables[i];
+
+		build.rowRuns.Resize( numRows + 1 );
+		build.rowEntries.Resize( numRows + 1 );
+		build.runs.SetGranularity( 4096 );
+		build.travelTimes.SetGranularity( 16384 );
+		build.reachabilities.SetGranularity( 16384 );
+
+		// area cache for every reachable area in every cluster
+		for ( clusterNum = 0; clusterNum < file->GetNumClusters(); clusterNum++ ) {
+			numReachableAreas = file->GetCluster( clusterNum ).numReachableAreas;
+			for ( clusterAreaNum = 0; clusterAreaNum < numReachableAreas; clusterAreaNum++ ) {
+				n = rowAreas[clusterTableOffset[clusterNum] + clusterAreaNum];
+				if ( !n ) {
+					AppendRoutingTableRow( build, NULL, NULL, 0 );
+					continue;
+				}
+
+				cache = new idRoutingCache( numReachableAreas );
+				cache->type = CACHETYPE_AREA;
+				cache->cluster = clusterNum;
+				cache->areaNum = n;
+				cache->startTravelTime = 1;
+				cache->travelFlags = routingTableTravelFlags[i];
+				UpdateAreaRoutingCache( cache );
+				AppendRoutingTableRow( build, cache->travelTimes, cache->reachabilities, cache->size );
+				delete cache;
+			}
+		}
+
+		// portal cache for every area
+		for ( n = 0; n < file->GetNumAreas(); n++ ) {
+			clusterNum = file->GetArea( n ).cluster;
+			if ( n == 0 || clusterNum == 0 ) {
+				AppendRoutingTableRow( build, NULL, NULL, 0 );
+				continue;
+			}
+			// same as RouteToGoalArea, assume a portal goal area is part of the front cluster
+			if ( clusterNum < 0 ) {
+				clusterNum = file->GetPortal( -clusterNum ).clusters[0];
+			}
+
+			cache = new idRoutingCache( file->GetNumPortals() );
+			cache->type = CACHETYPE_PORTAL;
+			cache->cluster = clusterNum;
+			cache->areaNum = n;
+			cache->startTravelTime = 1;
+			cache->travelFlags = routingTableTravelFlags[i];
+			UpdatePortalRoutingCache( cache );
+			AppendRoutingTableRow( build, cache->travelTimes, cache->reachabilities, cache->size );
+			delete cache;
+
+			// the portal cache is calculated from the regular area cache
+			while ( totalCacheMemory > RoutingCacheMemory() && cacheListStart ) {
+				DeleteOldestCache();
+			}
+		}
+
+		build.rowRuns.Append( build.runs.Num() / 2 );
+		build.rowEntries.Append( build.travelTimes.Num() );
+	}
+
+	numCacheHits = numCacheMisses = numCacheTableFills = numCacheEvictions = 0;
+
+	f = fileSystem->OpenFileWrite( fileName );
+	if ( !f ) {
+		gameLocal.Warning( "couldn't open %s for writing", fileName.c_str() );
+		return;
+	}
+
+	f->WriteInt( ROUTING_TABLE_IDENT );
+	f->WriteInt( ROUTING_TABLE_VERSION );
+	f->WriteUnsignedInt( file->GetCRC() );
+	f->WriteInt( file->GetNumAreas() );
+	f->WriteInt( file->GetNumClusters() );
+	f->WriteInt( file->GetNumPortals() );
+	f->WriteInt( numRows );
+	f->WriteInt( numTables );
+	for ( i = 0; i < numTables; i++ ) {
+		f->WriteInt( routingTableTravelFlags[i] );
+		f->WriteInt( tables[i].runs.Num() / 2 );
+		f->WriteInt( tables[i].travelTimes.Num() );
+	}
+
+	for ( i = 0; i < numTables; i++ ) {
+		routingTableBuild_t &build = tables[i];
+
+		numRuns = build.runs.Num() / 2;
+		numEntries = build.travelTimes.Num();
+
+		for ( j = 0; j <= numRows; j++ ) {
+			f->WriteInt( build.rowRuns[j] );
+		}
+		for ( j = 0; j <= numRows; j++ ) {
+			f->WriteInt( build.rowEntries[j] );
+		}
+		for ( j = 0; j < build.runs.Num(); j++ ) {
+			build.runs[j] = LittleShort( build.runs[j] );
+		}
+		f->Write( build.runs.Ptr(), build.runs.Num() * sizeof( unsigned short ) );
+		for ( j = 0; j < numEntries; j++ ) {
+			build.travelTimes[j] = LittleShort( build.travelTimes[j] );
+		}
+		f->Write( build.travelTimes.Ptr(), numEntries * sizeof( unsigned short ) );
+		f->Write( build.reachabilities.Ptr(), numEntries * sizeof( byte ) );
+
+		// pad the table so the next one starts aligned
+		for ( j = numRuns * 2 * sizeof( unsigned short ) + numEntries * ( sizeof( unsigned short ) + sizeof( byte ) ); j & 3; j++ ) {
+			f->WriteChar( 0 );
+		}
+	}
+
+	fileSystem->CloseFile( f );
+
+	timer.Stop();
+	gameLocal.Printf( "Built routing tables %s in %u msec\n", fileName.c_str(), timer.Milliseconds() );
+}
+
+/*
+============
+idAASLocal::LoadRoutingTables
+
+The routing tables are read into a single block and only the runs of reachable
+areas and portals are stored, the routing cache is filled from them when it is
+created.  The tables are only byte swapped on big endian systems.
+============
+*/
+bool idAASLocal::LoadRoutingTables( void ) {
+	int i, j, k, numTables, numRows, numRuns, numEntries, rowSize, headerSize, size, clusterNum, *header;
+	bool valid;
+	byte *data;
+	idRoutingTable *table;
+	idStr fileName;
+
+	fileName = RoutingTableFileName();
+	routingTableSize = fileSystem->ReadFile( fileName, &routingTableData );
+	if ( routingTableSize <= 0 || !routingTableData ) {
+		routingTableData = NULL;
+		routingTableSize = 0;
+		return false;
+	}
+
+	header = ( int* ) routingTableData;
+	numRows = areaCacheIndexSize + file->GetNumAreas();
+
+	// the tables have to match the AAS file exactly
+	valid = ( routingTableSize >= 8 * ( int ) sizeof( int ) );
+	valid = valid && LittleInt( header[0] ) == ROUTING_TABLE_IDENT && LittleInt( header[1] ) == ROUTING_TABLE_VERSION;
+	valid = valid && ( unsigned int ) LittleInt( header[2] ) == file->GetCRC();
+	valid = valid && LittleInt( header[3] ) == file->GetNumAreas() && LittleInt( header[4] ) == file->GetNumClusters() && LittleInt( header[5] ) == file->GetNumPortals();
+	valid = valid && LittleInt( header[6] ) == numRows;
+	numTables = valid ? LittleInt( header[7] ) : 0;
+	headerSize = ( 8 + numTables * 3 ) * sizeof( int );
+	valid = valid && numTables > 0 && numTables <= 32 && routingTableSize >= headerSize;
+
+	size = headerSize;
+	for ( i = 0; valid && i < numTables; i++ ) {
+		numRuns = LittleInt( header[8 + i * 3 + 1] );
+		numEntries = LittleInt( header[8 + i * 3 + 2] );
+		valid = numRuns >= 0 && numRuns <= routingTableSize / 4 && numEntries >= 0 && numEntries <= routingTableSize / 3;
+		size += valid ? RoutingTableDataSize( numRows, numRuns, numEntries ) : 0;
+		valid = valid && size <= routingTableSize;
+	}
+	valid = valid && size == routingTableSize;
+
+	if ( valid ) {
+		routingTables.SetNum( numTables );
+		data = ( byte* ) routingTableData + headerSize;
+		for ( i = 0; i < numTables; i++ ) {
+			table = &routingTables[i];
+			table->travelFlags = LittleInt( header[8 + i * 3] );
+			numRuns = LittleInt( header[8 + i * 3 + 1] );
+			numEntries = LittleInt( header[8 + i * 3 + 2] );
+			table->rowRuns = ( int* ) data;
+			table->rowEntries = table->rowRuns + numRows + 1;
+			table->runs = ( unsigned short* ) ( table->rowEntries + numRows + 1 );
+			table->travelTimes = table->runs + numRuns * 2;
+			table->reachabilities = ( byte* ) ( table->travelTimes + numEntries );
+			data += RoutingTableDataSize( numRows, numRuns, numEntries );
+
+			if ( Swap_IsBigEndian() ) {
+				for ( j = 0; j <= numRows; j++ ) {
+					table->rowRuns[j] = LittleInt( table->rowRuns[j] );
+					table->rowEntries[j] = LittleInt( table->rowEntries[j] );
+				}
+				for ( j = 0; j < numRuns * 2; j++ ) {
+					table->runs[j] = LittleShort( table->runs[j] );
+				}
+				for ( j = 0; j < numEntries; j++ ) {
+					table->travelTimes[j] = LittleShort( table->travelTimes[j] );
+				}
+			}
+
+			// make sure every run stays within the cache of its row
+			valid = valid && table->rowRuns[0] == 0 && table->rowEntries[0] == 0;
+			valid = valid && table->rowRuns[numRows] == numRuns && table->rowEntries[numRows] == numEntries;
+			clusterNum = 0;
+			for ( j = 0; valid && j < numRows; j++ ) {
+				if ( j < areaCacheIndexSize ) {
+					while ( j >= clusterTableOffset[clusterNum] + file->GetCluster( clusterNum ).numReachableAreas ) {
+						clusterNum++;
+					}
+					rowSize = file->GetCluster( clusterNum ).numReachableAreas;
+				} else {
+					rowSize = file->GetNumPortals();
+				}
+				valid = table->rowRuns[j] <= table->rowRuns[j + 1] && table->rowRuns[j + 1] <= numRuns;
+				valid = valid && table->rowEntries[j] <= table->rowEntries[j + 1] && table->rowEntries[j + 1] <= numEntries;
+				size = 0;
+				for ( k = table->rowRuns[j]; valid && k < table->rowRuns[j + 1]; k++ ) {
+					valid = table->runs[k * 2] + table->runs[k * 2 + 1] <= rowSize;
+					size += table->runs[k * 2 + 1];
+				}
+				valid = valid && size == table->rowEntries[j + 1] - table->rowEntries[j];
+			}
+			if ( !valid ) {
+				break;
+			}
+		}
+	}
+
+	if ( !valid ) {
+		gameLocal.Warning( "%s is out of date, rebuild it with aasBuildRoutingTables", fileName.c_str() );
+		FreeRoutingTables();
+		return false;
+	}
+
+	gameLocal.Printf( "Loaded routing tables %s (%d KB)\n", fileName.c_str(), routingTableSize >> 10 );
+	return true;
+}
+
+/*
+============
+idAASLocal::FreeRoutingTables
+============
+*/
+void idAASLocal::FreeRoutingTables( void ) {
+	if ( routingTableData ) {
+		fileSystem->FreeFile( routingTableData );
+		routingTableData = NULL;
+	}
+	routingTableSize = 0;
+	routingTables.Clear();
+}
+
+/*
+============
+idAASLocal::FillRoutingCache
+
+Copies the runs of a routing table row into a cleared routing cache.
+============
+*/
+void idAASLocal::FillRoutingCache( idRoutingCache *cache, const idRoutingTable *table, int row ) const {
+	int i, first, count, entry;
+
+	entry = table->rowEntries[row];
+	for ( i = table->rowRuns[row]; i < table->rowRuns[row + 1]; i++ ) {
+		first = table->runs[i * 2];
+		count = table->runs[i * 2 + 1];
+		memcpy( cache->travelTimes + first, table->travelTimes + entry, count * sizeof( unsigned short ) );
+		memcpy( cache->reachabilities + first, table->reachabilities + entry, count * sizeof( byte ) );
+		entry += count;
+	}
+}
+
+/*
+============
+idAASLocal::GetAreaRoutingTable
+
+Returns the routing table for the area cache if the routing state of the cluster
+is still the same as when the tables were built.
+============
+*/
+const idRoutingTable *idAASLocal::GetAreaRoutingTable( int clusterNum, int travelFlags ) const {
+	int i;
+
+	if ( !aas_routingTables.GetBool() || clusterChanges[clusterNum] != 0 ) {
+		return NULL;
+	}
+	for ( i = 0; i < routingTables.Num(); i++ ) {
+		if ( routingTables[i].travelFlags == travelFlags ) {
+			return &routingTables[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+============
+idAASLocal::GetPortalRoutingTable
+
+The portal cache goes through all clusters so none of them may have changed.
+============
+*/
+const idRoutingTable *idAASLocal::GetPortalRoutingTable( int travelFlags ) const {
+	int i;
+
+	if ( !aas_routingTables.GetBool() || numChangedClusters != 0 ) {
+		return NULL;
+	}
+	for ( i = 0; i < routingTables.Num(); i++ ) {
+		if ( routingTables[i].travelFlags == travelFlags ) {
+			return &routingTables[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+============
+idAASLocal::ChangeRoutingTableState
+
+Keeps track of the clusters that no longer match the routing tables because
+areas were disabled or obstacles were added.
+============
+*/
+void idAASLocal::ChangeRoutingTableState( int areaNum, int change ) {
+	int i, numClusters, clusters[2];
+
+	clusters[0] = file->GetArea( areaNum ).cluster;
+	numClusters = 1;
+	if ( clusters[0] <= 0 ) {
+		// a portal changes both the front and back cluster
+		clusters[1] = file->GetPortal( -clusters[0] ).clusters[1];
+		clusters[0] = file->GetPortal( -clusters[0] ).clusters[0];
+		numClusters = 2;
+	}
+
+	for ( i = 0; i < numClusters; i++ ) {
+		if ( clusterChanges[clusters[i]] == 0 ) {
+			numChangedClusters++;
+		}
+		clusterChanges[clusters[i]] += change;
+		if ( clusterChanges[clusters[i]] == 0 ) {
+			numChangedClusters--;
+		}
+	}
+}
+
+/*
+============
+RouteQueryHash
+============
+*/
+static ID_INLINE int RouteQueryHash( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags ) {
+	int hash;
+
+	hash = areaNum * 4099 + goalAreaNum * 65537 + travelFlags;
+	hash ^= reinterpret_cast<const int &>( origin.x ) ^ ( reinterpret_cast<const int &>( origin.y ) >> 7 ) ^ ( reinterpret_cast<const int &>( origin.z ) >> 13 );
+	hash ^= hash >> 16;
+	return hash & ( ROUTE_QUERY_HASH_SIZE - 1 );
+}
+
 /*
 ============
 idAASLocal::RouteToGoalArea
+
+Monsters chasing the same goal issue the same queries, especially while walking
+a path where every query after the first starts at the end of a reachability.
+Recent queries are kept in a hash table and an identical query is answered from
+it until the routing state changes.
 ============
 */
 bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const {
+	idRouteQuery *query;
+
+	if ( file == NULL || !aas_cachePathQueries.GetBool() ) {
+		return FindRouteToGoalArea( areaNum, origin, goalAreaNum, travelFlags, travelTime, reach );
+	}
+
+	numRouteQueries++;
+
+	query = &routeQueries[RouteQueryHash( areaNum, origin, goalAreaNum, travelFlags )];
+	if ( query->routingState == routingState && query->areaNum == areaNum && query->goalAreaNum == goalAreaNum &&
+			query->travelFlags == travelFlags && query->origin == origin ) {
+		numRouteQueriesDeduped++;
+		travelTime = query->travelTime;
+		*reach = query->reach;
+		return query->result;
+	}
+
+	query->result = FindRouteToGoalArea( areaNum, origin, goalAreaNum, travelFlags, query->travelTime, &query->reach );
+	query->routingState = routingState;
+	query->areaNum = areaNum;
+	query->origin = origin;
+	query->goalAreaNum = goalAreaNum;
+	query->travelFlags = travelFlags;
+
+	travelTime = query->travelTime;
+	*reach = query->reach;
+	return query->result;
+}
+
+/*
+============
+idAASLocal::FindRouteToGoalArea
+============
+*/
+bool idAASLocal::FindRouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const {
 	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum;
 	unsigned short int t, bestTime;
 	const aasPortal_t *portal;
@@ -1042,7 +1682,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		return false;
 	}
 
-	while ( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
+	while ( totalCacheMemory + routingTableSize > RoutingCacheMemory() && cacheListStart ) {
 		DeleteOldestCache();
 	}
 
@@ -315,6 +315,7 @@ protected:
 	// navigation
 	idAAS					*aas;
 	int						travelFlags;
+	mutable aasPathCache_t	pathCache;			// last path found, not saved
 
 	idMoveState				move;
 	idMoveState				savedMove;
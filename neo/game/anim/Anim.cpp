@@ -30,10 +30,14 @@ If you have questions concerning this license or the applicable additional terms
 #include "idlib/geometry/JointTransform.h"
 #include "idlib/math/Quat.h"
 
+#include "gamesys/SysCvar.h"
 #include "Game_local.h"
 
 #include "anim/Anim.h"
 
+// longest run of frames the compression interpolates between two key frames
+#define MAX_ANIM_KEY_SPAN		16
+
 bool idAnimManager::forceExport = false;
 
 /*
@@ -56,6 +60,8 @@ idMD5Anim::idMD5Anim() {
 	frameRate	= 24;
 	animLength	= 0;
 	totaldelta.Zero();
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
 }
 
 /*
@@ -84,6 +90,13 @@ void idMD5Anim::Free( void ) {
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	compressedFrames.Clear();
+	componentBase.Clear();
+	componentScale.Clear();
+	keyFrames.Clear();
+	frameKeys.Clear();
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
 }
 
 /*
@@ -152,6 +165,7 @@ idMD5Anim::Allocated
 */
 size_t idMD5Anim::Allocated( void ) const {
 	size_t size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += compressedFrames.Allocated() + componentBase.Allocated() + componentScale.Allocated() + keyFrames.Allocated() + frameKeys.Allocated();
 	return size;
 }
 
@@ -328,10 +342,381 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
+	if ( g_compressAnims.GetBool() ) {
+		Compress();
+	}
+
 	// done
 	return true;
 }
 
+/*
+====================
+idMD5Anim::IsCompressed
+====================
+*/
+bool idMD5Anim::IsCompressed( void ) const {
+	return ( compressedFrames.Num() != 0 );
+}
+
+/*
+====================
+idMD5Anim::MemorySaved
+
+Bytes saved compared to keeping every component of every frame as a float.
+====================
+*/
+size_t idMD5Anim::MemorySaved( void ) const {
+	size_t uncompressed;
+	size_t compressed;
+
+	if ( !IsCompressed() ) {
+		return 0;
+	}
+
+	uncompressed = numAnimatedComponents * numFrames * sizeof( float );
+	compressed = compressedFrames.Allocated() + componentBase.Allocated() + componentScale.Allocated() + keyFrames.Allocated() + frameKeys.Allocated();
+	if ( compressed >= uncompressed ) {
+		return 0;
+	}
+
+	return uncompressed - compressed;
+}
+
+/*
+====================
+idMD5Anim::GetCompressionError
+
+Largest difference between a decoded component and the float it was compressed from.
+====================
+*/
+void idMD5Anim::GetCompressionError( float &translationError, float &rotationError ) const {
+	translationError = maxTranslationError;
+	rotationError = maxRotationError;
+}
+
+/*
+====================
+idMD5Anim::Compress
+
+Quantizes every animated component to 16 bits within its range over the anim and only keeps the
+frames that can't be interpolated from the key frames around them within g_compressAnimsTranslationError
+or g_compressAnimsRotationError.  Every decoded frame is then checked against the float frames, and
+the anim stays uncompressed when a translation or a joint rotation is off by more than its tolerance
+or nothing is saved.
+====================
+*/
+void idMD5Anim::Compress( void ) {
+	int						i, j, c;
+	int						start, end;
+	float					minValue, maxValue;
+	float					error;
+	float					*decoded;
+	float					*buffer;
+	bool					fits;
+	idList<float>			tolerance;
+	idList<bool>			translation;
+	idList<unsigned short>	quantized;
+
+	if ( !numAnimatedComponents ) {
+		return;
+	}
+
+	// translations are checked per component, rotations by the angle between the joint quaternions
+	tolerance.SetNum( numAnimatedComponents );
+	translation.SetNum( numAnimatedComponents );
+	for ( c = 0; c < numAnimatedComponents; c++ ) {
+		tolerance[ c ] = idMath::INFINITY;
+		translation[ c ] = false;
+	}
+	for ( i = 0; i < numJoints; i++ ) {
+		c = jointInfo[ i ].firstComponent;
+		for ( j = 0; ( j < 3 ) && ( c < numAnimatedComponents ); j++ ) {
+			if ( jointInfo[ i ].animBits & BIT( j ) ) {
+				tolerance[ c ] = g_compressAnimsTranslationError.GetFloat();
+				translation[ c ] = true;
+				c++;
+			}
+		}
+	}
+
+	// quantize each component within its range
+	componentBase.SetGranularity( 1 );
+	componentBase.SetNum( numAnimatedComponents );
+	componentScale.SetGranularity( 1 );
+	componentScale.SetNum( numAnimatedComponents );
+	for ( c = 0; c < numAnimatedComponents; c++ ) {
+		minValue = maxValue = componentFrames[ c ];
+		for ( i = 1; i < numFrames; i++ ) {
+			const float value = componentFrames[ i * numAnimatedComponents + c ];
+			if ( value < minValue ) {
+				minValue = value;
+			} else if ( value > maxValue ) {
+				maxValue = value;
+			}
+		}
+		componentBase[ c ] = minValue;
+		componentScale[ c ] = ( maxValue - minValue ) / 65535.0f;
+	}
+
+	quantized.SetNum( numAnimatedComponents * numFrames );
+	for ( i = 0; i < numFrames; i++ ) {
+		for ( c = 0; c < numAnimatedComponents; c++ ) {
+			if ( componentScale[ c ] > 0.0f ) {
+				quantized[ i * numAnimatedComponents + c ] = idMath::ClampInt( 0, 65535, ( int )( ( componentFrames[ i * numAnimatedComponents + c ] - componentBase[ c ] ) / componentScale[ c ] + 0.5f ) );
+			} else {
+				quantized[ i * numAnimatedComponents + c ] = 0;
+			}
+		}
+	}
+
+	// extend each span between two key frames for as long as the frames inside it still fit
+	buffer = ( float* )_alloca16( numAnimatedComponents * sizeof( buffer[ 0 ] ) );
+	keyFrames.SetGranularity( 16 );
+	keyFrames.Clear();
+	keyFrames.Append( 0 );
+	for ( start = 0; start < numFrames - 1; start = end ) {
+		for ( end = start + 1; ( end < numFrames - 1 ) && ( end - start < MAX_ANIM_KEY_SPAN ); end++ ) {
+			if ( !KeySpanFits( quantized.Ptr(), tolerance.Ptr(), start, end + 1, buffer ) ) {
+				break;
+			}
+		}
+		keyFrames.Append( end );
+	}
+	keyFrames.Condense();
+
+	compressedFrames.SetGranularity( 1 );
+	compressedFrames.SetNum( keyFrames.Num() * numAnimatedComponents );
+	for ( i = 0; i < keyFrames.Num(); i++ ) {
+		memcpy( &compressedFrames[ i * numAnimatedComponents ], &quantized[ keyFrames[ i ] * numAnimatedComponents ], numAnimatedComponents * sizeof( compressedFrames[ 0 ] ) );
+	}
+
+	frameKeys.SetGranularity( 1 );
+	frameKeys.SetNum( numFrames );
+	for ( i = 0, j = 0; i < numFrames; i++ ) {
+		if ( ( j + 1 < keyFrames.Num() ) && ( keyFrames[ j + 1 ] <= i ) ) {
+			j++;
+		}
+		frameKeys[ i ] = j;
+	}
+
+	// check the decoded frames against the float frames
+	decoded = ( float* )_alloca16( numAnimatedComponents * sizeof( decoded[ 0 ] ) );
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
+	fits = true;
+	for ( i = 0; ( i < numFrames ) && fits; i++ ) {
+		DecodeComponents( i, 0, numAnimatedComponents, decoded );
+		for ( c = 0; c < numAnimatedComponents; c++ ) {
+			if ( !translation[ c ] ) {
+				continue;
+			}
+			error = idMath::Fabs( decoded[ c ] - componentFrames[ i * numAnimatedComponents + c ] );
+			if ( error > tolerance[ c ] ) {
+				fits = false;
+				break;
+			}
+			maxTranslationError = Max( maxTranslationError, error );
+		}
+		error = JointRotationError( decoded, &componentFrames[ i * numAnimatedComponents ] );
+		if ( error > g_compressAnimsRotationError.GetFloat() ) {
+			fits = false;
+		}
+		maxRotationError = Max( maxRotationError, error );
+	}
+
+	if ( !fits || !MemorySaved() ) {
+		compressedFrames.Clear();
+		componentBase.Clear();
+		componentScale.Clear();
+		keyFrames.Clear();
+		frameKeys.Clear();
+		maxTranslationError = 0.0f;
+		maxRotationError = 0.0f;
+		return;
+	}
+
+	componentFrames.Clear();
+}
+
+/*
+====================
+idMD5Anim::KeySpanFits
+
+Returns true if the frames between the key frames start and end all interpolate within tolerance and
+g_compressAnimsRotationError.  buffer holds the interpolated components of one frame.
+====================
+*/
+bool idMD5Anim::KeySpanFits( const unsigned short *quantized, const float *tolerance, int start, int end, float *buffer ) const {
+	int		i, c;
+
+	const unsigned short *q1 = quantized + start * numAnimatedComponents;
+	const unsigned short *q2 = quantized + end * numAnimatedComponents;
+
+	for ( i = start + 1; i < end; i++ ) {
+		const float lerp = ( i - start ) / ( float )( end - start );
+		const float *original = &componentFrames[ i * numAnimatedComponents ];
+		for ( c = 0; c < numAnimatedComponents; c++ ) {
+			buffer[ c ] = componentBase[ c ] + ( ( float )q1[ c ] + ( ( float )q2[ c ] - ( float )q1[ c ] ) * lerp ) * componentScale[ c ];
+			if ( idMath::Fabs( buffer[ c ] - original[ c ] ) > tolerance[ c ] ) {
+				return false;
+			}
+		}
+		if ( JointRotationError( buffer, original ) > g_compressAnimsRotationError.GetFloat() ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+====================
+idMD5Anim::JointRotationError
+
+Returns the largest angle in degrees between the joint rotations given by two sets of animated
+components.  The quaternions are completed from the base frame and w is rebuilt with CalcW just like
+when a frame is used, so the error in w of joints rotated close to 180 degrees is included.
+====================
+*/
+float idMD5Anim::JointRotationError( const float *components1, const float *components2 ) const {
+	int			i, c, animBits;
+	float		chord, maxAngle;
+	idQuat		q1, q2;
+
+	maxAngle = 0.0f;
+	for ( i = 0; i < numJoints; i++ ) {
+		animBits = jointInfo[ i ].animBits;
+		if ( !( animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) ) {
+			continue;
+		}
+
+		// skip the translation components
+		c = jointInfo[ i ].firstComponent;
+		c += ( ( animBits & ANIM_TX ) != 0 ) + ( ( animBits & ANIM_TY ) != 0 ) + ( ( animBits & ANIM_TZ ) != 0 );
+
+		q1 = q2 = baseFrame[ i ].q;
+		if ( animBits & ANIM_QX ) {
+			q1.x = components1[ c ];
+			q2.x = components2[ c ];
+			c++;
+		}
+		if ( animBits & ANIM_QY ) {
+			q1.y = components1[ c ];
+			q2.y = components2[ c ];
+			c++;
+		}
+		if ( animBits & ANIM_QZ ) {
+			q1.z = components1[ c ];
+			q2.z = components2[ c ];
+		}
+		q1.w = q1.CalcW();
+		q2.w = q2.CalcW();
+
+		// q and -q are the same rotation, and the chord between the two is more precise than
+		// the arc cosine of their dot product for small angles
+		if ( q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w < 0.0f ) {
+			q2 = -q2;
+		}
+		chord = ( q1 - q2 ).Length();
+		maxAngle = Max( maxAngle, RAD2DEG( 4.0f * idMath::ASin( Min( chord * 0.5f, 1.0f ) ) ) );
+	}
+
+	return maxAngle;
+}
+
+/*
+====================
+idMD5Anim::DecodeComponents
+
+Interpolates the quantized key frames around framenum.  The loops only walk contiguous arrays
+so the compiler can vectorize them.
+====================
+*/
+void idMD5Anim::DecodeComponents( int framenum, int firstComponent, int numComponents, float *dst ) const {
+	int i;
+
+	const int key = frameKeys[ framenum ];
+	const float *base = componentBase.Ptr() + firstComponent;
+	const float *scale = componentScale.Ptr() + firstComponent;
+	const unsigned short *q1 = compressedFrames.Ptr() + key * numAnimatedComponents + firstComponent;
+
+	if ( keyFrames[ key ] == framenum ) {
+		for ( i = 0; i < numComponents; i++ ) {
+			dst[ i ] = base[ i ] + ( float )q1[ i ] * scale[ i ];
+		}
+		return;
+	}
+
+	const unsigned short *q2 = q1 + numAnimatedComponents;
+	const float lerp = ( framenum - keyFrames[ key ] ) / ( float )( keyFrames[ key + 1 ] - keyFrames[ key ] );
+
+	for ( i = 0; i < numComponents; i++ ) {
+		dst[ i ] = base[ i ] + ( ( float )q1[ i ] + ( ( float )q2[ i ] - ( float )q1[ i ] ) * lerp ) * scale[ i ];
+	}
+}
+
+/*
+====================
+idMD5Anim::GetFrameComponents
+
+Returns the animated components of a frame starting at firstComponent.  Compressed anims decode
+at most numComponents of them into buffer.
+====================
+*/
+const float *idMD5Anim::GetFrameComponents( int framenum, int firstComponent, int numComponents, float *buffer ) const {
+	if ( !IsCompressed() ) {
+		return &componentFrames[ framenum * numAnimatedComponents + firstComponent ];
+	}
+
+	if ( numComponents > numAnimatedComponents - firstComponent ) {
+		numComponents = numAnimatedComponents - firstComponent;
+	}
+	DecodeComponents( framenum, firstComponent, numComponents, buffer );
+
+	return buffer;
+}
+
+/*
+====================
+idMD5Anim::GetJointComponents
+
+Returns all animated components of a frame, but compressed anims only decode the components of
+the joints in index.  They're written to their place in buffer, runs of joints with adjacent
+components are decoded together.
+====================
+*/
+const float *idMD5Anim::GetJointComponents( int framenum, const int *index, int numIndexes, float *buffer ) const {
+	int						i;
+	int						runStart;
+	int						runEnd;
+	const jointAnimInfo_t	*infoPtr;
+
+	if ( !IsCompressed() ) {
+		return GetFrameComponents( framenum, 0, numAnimatedComponents, buffer );
+	}
+
+	runStart = runEnd = 0;
+	for ( i = 0; i < numIndexes; i++ ) {
+		infoPtr = &jointInfo[ index[ i ] ];
+		if ( !infoPtr->animBits ) {
+			continue;
+		}
+		if ( infoPtr->firstComponent != runEnd ) {
+			if ( runEnd > runStart ) {
+				DecodeComponents( framenum, runStart, runEnd - runStart, buffer + runStart );
+			}
+			runStart = infoPtr->firstComponent;
+		}
+		runEnd = Min( infoPtr->firstComponent + idMath::BitCount( infoPtr->animBits ), numAnimatedComponents );
+	}
+	if ( runEnd > runStart ) {
+		DecodeComponents( framenum, runStart, runEnd - runStart, buffer + runStart );
+	}
+
+	return buffer;
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -438,6 +823,8 @@ idMD5Anim::GetOrigin
 */
 void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 	frameBlend_t frame;
+	float components1[ 6 ];
+	float components2[ 6 ];
 
 	offset = baseFrame[ 0 ].t;
 	if ( !( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) ) {
@@ -447,8 +834,8 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	const float *componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, 6, components1 );
+	const float *componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, 6, components2 );
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -479,6 +866,8 @@ idMD5Anim::GetOriginRotation
 void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount ) const {
 	frameBlend_t	frame;
 	int				animBits;
+	float			components1[ 6 ];
+	float			components2[ 6 ];
 
 	animBits = jointInfo[ 0 ].animBits;
 	if ( !( animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) ) {
@@ -489,8 +878,8 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	const float	*jointframe1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, 6, components1 );
+	const float	*jointframe2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, 6, components2 );
 
 	if ( animBits & ANIM_TX ) {
 		jointframe1++;
@@ -594,6 +983,8 @@ idMD5Anim::GetBounds
 void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	frameBlend_t	frame;
 	idVec3			offset;
+	float			components1[ 6 ];
+	float			components2[ 6 ];
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
@@ -603,8 +994,8 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		const float *componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, 6, components1 );
+		const float *componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, 6, components2 );
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -638,6 +1029,8 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	const float				*frame2;
 	const float				*jointframe1;
 	const float				*jointframe2;
+	float					*components1;
+	float					*components2;
 	const jointAnimInfo_t	*infoPtr;
 	int						animBits;
 	idJointQuat				*blendJoints;
@@ -657,8 +1050,14 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	lerpIndex = ( int* )_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 	numLerpJoints = 0;
 
-	frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
-	frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
+	components1 = components2 = NULL;
+	if ( IsCompressed() ) {
+		components1 = ( float* )_alloca16( numAnimatedComponents * sizeof( components1[ 0 ] ) );
+		components2 = ( float* )_alloca16( numAnimatedComponents * sizeof( components2[ 0 ] ) );
+	}
+
+	frame1 = GetJointComponents( frame.frame1, index, numIndexes, components1 );
+	frame2 = GetJointComponents( frame.frame2, index, numIndexes, components2 );
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -826,6 +1225,7 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 	int						i;
 	const float				*frame;
 	const float				*jointframe;
+	float					*components;
 	int						animBits;
 	idJointQuat				*jointPtr;
 	const jointAnimInfo_t	*infoPtr;
@@ -838,7 +1238,12 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		return;
 	}
 
-	frame = &componentFrames[ framenum * numAnimatedComponents ];
+	components = NULL;
+	if ( IsCompressed() ) {
+		components = ( float* )_alloca16( numAnimatedComponents * sizeof( components[ 0 ] ) );
+	}
+
+	frame = GetJointComponents( framenum, index, numIndexes, components );
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -1041,17 +1446,30 @@ void idAnimManager::ListAnims( void ) const {
 	size_t		size;
 	size_t		s;
 	size_t		namesize;
+	size_t		saved;
+	int			numCompressed;
+	float		translationError;
+	float		rotationError;
 	idMD5Anim	**animptr;
 	idMD5Anim	*anim;
 
 	num = 0;
 	size = 0;
+	saved = 0;
+	numCompressed = 0;
 	for ( i = 0; i < animations.Num(); i++ ) {
 		animptr = animations.GetIndex( i );
 		if ( animptr != NULL && *animptr != NULL ) {
 			anim = *animptr;
 			s = anim->Size();
-			gameLocal.Printf( "%8zd bytes : %2d refs : %s\n", s, anim->NumRefs(), anim->Name() );
+			if ( anim->IsCompressed() ) {
+				anim->GetCompressionError( translationError, rotationError );
+				gameLocal.Printf( "%8zd bytes : %2d refs : %s (%zd bytes saved, max error %.3f / %.3f deg)\n", s, anim->NumRefs(), anim->Name(), anim->MemorySaved(), translationError, rotationError );
+				saved += anim->MemorySaved();
+				numCompressed++;
+			} else {
+				gameLocal.Printf( "%8zd bytes : %2d refs : %s\n", s, anim->NumRefs(), anim->Name() );
+			}
 			size += s;
 			num++;
 		}
@@ -1063,6 +1481,9 @@ void idAnimManager::ListAnims( void ) const {
 	}
 
 	gameLocal.Printf( "\n%zd memory used in %d anims\n", size, num );
+	if ( numCompressed ) {
+		gameLocal.Printf( "%zd memory saved by compressing %d anims\n", saved, numCompressed );
+	}
 	gameLocal.Printf( "%zd memory used in %d joint names\n", namesize, jointnames.Num() );
 }
 
@@ -215,6 +215,164 @@ void idTypeInfo::Shutdown() {
 	lastChild = 0;
 }
 
+/*
+===============================================================================
+
+	Event call thunks
+
+	One small function per argument signature that casts the event callback
+	back to its real member function type and calls it with the unpacked args.
+	The thunk for each event is looked up once in idClass::Init, so dispatching
+	an event is a single indirect call instead of a switch over every formatspec.
+
+===============================================================================
+*/
+
+typedef void ( *eventThunk_t )( idClass *obj, eventCallback_t callback, const intptr_t *data );
+
+template< int isFloat >
+struct idEventThunkArg {
+	typedef intptr_t type;
+	static type Get( const intptr_t &data ) { return data; }
+};
+
+template<>
+struct idEventThunkArg< 1 > {
+	typedef float type;
+	static type Get( const intptr_t &data ) { return *( const float * )&data; }
+};
+
+#define THUNK_TYPE( n )		typename idEventThunkArg< ( bits >> n ) & 1 >::type
+#define THUNK_ARG( n )		idEventThunkArg< ( bits >> n ) & 1 >::Get( data[ n ] )
+
+template< int numargs, int bits >
+struct idEventThunk;
+
+template< int bits >
+struct idEventThunk< 0, bits > {
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*callback )();
+	}
+};
+
+template< int bits >
+struct idEventThunk< 1, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 2, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 3, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ), THUNK_TYPE( 2 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ), THUNK_ARG( 2 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 4, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ), THUNK_TYPE( 2 ), THUNK_TYPE( 3 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ), THUNK_ARG( 2 ), THUNK_ARG( 3 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 5, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ), THUNK_TYPE( 2 ), THUNK_TYPE( 3 ), THUNK_TYPE( 4 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ), THUNK_ARG( 2 ), THUNK_ARG( 3 ), THUNK_ARG( 4 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 6, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ), THUNK_TYPE( 2 ), THUNK_TYPE( 3 ), THUNK_TYPE( 4 ), THUNK_TYPE( 5 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ), THUNK_ARG( 2 ), THUNK_ARG( 3 ), THUNK_ARG( 4 ), THUNK_ARG( 5 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 7, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ), THUNK_TYPE( 2 ), THUNK_TYPE( 3 ), THUNK_TYPE( 4 ), THUNK_TYPE( 5 ), THUNK_TYPE( 6 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ), THUNK_ARG( 2 ), THUNK_ARG( 3 ), THUNK_ARG( 4 ), THUNK_ARG( 5 ), THUNK_ARG( 6 ) );
+	}
+};
+
+template< int bits >
+struct idEventThunk< 8, bits > {
+	typedef void ( idClass::*func_t )( THUNK_TYPE( 0 ), THUNK_TYPE( 1 ), THUNK_TYPE( 2 ), THUNK_TYPE( 3 ), THUNK_TYPE( 4 ), THUNK_TYPE( 5 ), THUNK_TYPE( 6 ), THUNK_TYPE( 7 ) );
+	static void Call( idClass *obj, eventCallback_t callback, const intptr_t *data ) {
+		( obj->*( func_t )callback )( THUNK_ARG( 0 ), THUNK_ARG( 1 ), THUNK_ARG( 2 ), THUNK_ARG( 3 ), THUNK_ARG( 4 ), THUNK_ARG( 5 ), THUNK_ARG( 6 ), THUNK_ARG( 7 ) );
+	}
+};
+
+#undef THUNK_TYPE
+#undef THUNK_ARG
+
+// fills table[ 0 .. bits ] with the thunks for every float/int combination of numargs args
+template< int numargs, int bits >
+struct idEventThunkTable {
+	static void Fill( eventThunk_t *table ) {
+		table[ bits ] = idEventThunk< numargs, bits >::Call;
+		idEventThunkTable< numargs, bits - 1 >::Fill( table );
+	}
+};
+
+template< int numargs >
+struct idEventThunkTable< numargs, -1 > {
+	static void Fill( eventThunk_t * ) {
+	}
+};
+
+// indexed by number of args and the float bits of the formatspec index
+static eventThunk_t		eventThunkTable[ D_EVENT_MAXARGS + 1 ][ 1 << D_EVENT_MAXARGS ];
+
+// indexed by event number, set up in idClass::Init
+static eventThunk_t		eventThunks[ MAX_EVENTS ];
+
+/*
+================
+InitEventThunks
+================
+*/
+static void InitEventThunks( void ) {
+	const idEventDef	*ev;
+	int					i;
+
+	idEventThunkTable< 0, 0 >::Fill( eventThunkTable[ 0 ] );
+	idEventThunkTable< 1, ( 1 << 1 ) - 1 >::Fill( eventThunkTable[ 1 ] );
+	idEventThunkTable< 2, ( 1 << 2 ) - 1 >::Fill( eventThunkTable[ 2 ] );
+	idEventThunkTable< 3, ( 1 << 3 ) - 1 >::Fill( eventThunkTable[ 3 ] );
+	idEventThunkTable< 4, ( 1 << 4 ) - 1 >::Fill( eventThunkTable[ 4 ] );
+	idEventThunkTable< 5, ( 1 << 5 ) - 1 >::Fill( eventThunkTable[ 5 ] );
+	idEventThunkTable< 6, ( 1 << 6 ) - 1 >::Fill( eventThunkTable[ 6 ] );
+	idEventThunkTable< 7, ( 1 << 7 ) - 1 >::Fill( eventThunkTable[ 7 ] );
+	idEventThunkTable< 8, ( 1 << 8 ) - 1 >::Fill( eventThunkTable[ 8 ] );
+
+	for ( i = 0; i < idEventDef::NumEventCommands(); i++ ) {
+		ev = idEventDef::GetEventCommand( i );
+		// an index that doesn't match the number of args has no thunk
+		if ( ( ev->GetNumArgs() > D_EVENT_MAXARGS ) || ( ( ev->GetFormatspecIndex() >> D_EVENT_MAXARGS ) != ( 1u << ev->GetNumArgs() ) ) ) {
+			eventThunks[ i ] = NULL;
+			continue;
+		}
+		eventThunks[ i ] = eventThunkTable[ ev->GetNumArgs() ][ ev->GetFormatspecIndex() & ( ( 1 << D_EVENT_MAXARGS ) - 1 ) ];
+	}
+}
+
 /*
 ===============================================================================
 
@@ -385,6 +543,9 @@ void idClass::Init( void ) {
 		return;
 	}
 
+	// set up the call thunk for every event
+	InitEventThunks();
+
 	// init the event callback tables for all the classes
 	for ( c = typelist; c != NULL; c = c->next ) {
 		c->Init();
@@ -962,18 +1123,11 @@ bool idClass::ProcessEventArgPtr( const idEventDef *ev, intptr_t *data ) {
 
 	callback = c->eventMap[ num ];
 
-	switch ( ev->GetFormatspecIndex() ) {
-	case 1 << D_EVENT_MAXARGS :
-		( this->*callback )();
-		break;
-
-// generated file - see CREATE_EVENT_CODE
-#include "Callbacks.cpp"
-
-	default:
+	if ( !eventThunks[ num ] ) {
 		gameLocal.Warning( "Invalid formatspec on event '%s'", ev->GetName() );
-		break;
+		return true;
 	}
+	eventThunks[ num ]( this, callback, data );
 
 	return true;
 }
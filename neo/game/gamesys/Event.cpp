@@ -29,13 +29,13 @@ If you have questions concerning this license or the applicable additional terms
 #include "sys/platform.h"
 
 #include "script/Script_Program.h"
+#include "script/Script_Thread.h"
 #include "Entity.h"
 #include "Game_local.h"
 
 #include "Event.h"
 
 #define MAX_EVENTSPERFRAME			8192
-// #define CREATE_EVENT_CODE
 
 /*
 ===============================================================================
@@ -48,6 +48,7 @@ If you have questions concerning this license or the applicable additional terms
 */
 
 idEventDef *idEventDef::eventDefList[MAX_EVENTS];
+idEventDef *idEventDef::eventDefHash[EVENT_HASH_SIZE];
 int idEventDef::numEventDefs = 0;
 
 static bool eventError = false;
@@ -62,6 +63,7 @@ idEventDef::idEventDef( const char *command, const char *formatspec, char return
 	idEventDef		*ev;
 	int				i;
 	unsigned int	bits;
+	int				hash;
 
 	assert( command );
 	assert( !idEvent::initialized );
@@ -75,6 +77,7 @@ idEventDef::idEventDef( const char *command, const char *formatspec, char return
 	this->name = command;
 	this->formatspec = formatspec;
 	this->returnType = returnType;
+	this->nextHash = NULL;
 
 	numargs = strlen( formatspec );
 	assert( numargs <= D_EVENT_MAXARGS );
@@ -122,14 +125,20 @@ idEventDef::idEventDef( const char *command, const char *formatspec, char return
 		}
 	}
 
+	if ( argsize > D_EVENT_MAX_DATA ) {
+		eventError = true;
+		sprintf( eventErrorMsg, "idEventDef::idEventDef : Args for '%s' event are larger than %d bytes.", name, D_EVENT_MAX_DATA );
+		return;
+	}
+
 	// calculate the formatspecindex
 	formatspecIndex = ( 1 << ( numargs + D_EVENT_MAXARGS ) ) | bits;
 
-	// go through the list of defined events and check for duplicates
+	// go through the events with the same name hash and check for duplicates
 	// and mismatched format strings
 	eventnum = numEventDefs;
-	for ( i = 0; i < eventnum; i++ ) {
-		ev = eventDefList[ i ];
+	hash = idStr::Hash( command ) & ( EVENT_HASH_SIZE - 1 );
+	for ( ev = eventDefHash[ hash ]; ev != NULL; ev = ev->nextHash ) {
 		if ( strcmp( command, ev->name ) == 0 ) {
 			if ( strcmp( formatspec, ev->formatspec ) != 0 ) {
 				eventError = true;
@@ -159,6 +168,9 @@ idEventDef::idEventDef( const char *command, const char *formatspec, char return
 	}
 	eventDefList[numEventDefs] = ev;
 	numEventDefs++;
+
+	nextHash = eventDefHash[ hash ];
+	eventDefHash[ hash ] = this;
 }
 
 /*
@@ -186,14 +198,10 @@ idEventDef::FindEvent
 */
 const idEventDef *idEventDef::FindEvent( const char *name ) {
 	idEventDef	*ev;
-	int			num;
-	int			i;
 
 	assert( name );
 
-	num = numEventDefs;
-	for ( i = 0; i < num; i++ ) {
-		ev = eventDefList[ i ];
+	for ( ev = eventDefHash[ idStr::Hash( name ) & ( EVENT_HASH_SIZE - 1 ) ]; ev != NULL; ev = ev->nextHash ) {
 		if ( strcmp( name, ev->name ) == 0 ) {
 			return ev;
 		}
@@ -202,6 +210,175 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 	return NULL;
 }
 
+/*
+===============================================================================
+
+	idEventHeap
+
+	Binary min-heap of scheduled events ordered by time.  Events scheduled for
+	the same time are serviced in the order they were scheduled.
+
+===============================================================================
+*/
+
+class idEventHeap {
+public:
+	void					Clear( void );
+	int						Num( void ) const { return num; }
+	idEvent					*Top( void ) const { return num ? events[ 0 ] : NULL; }
+	void					Add( idEvent *event );
+	void					Remove( idEvent *event );
+							// all events in the order they will be serviced
+	void					GetSorted( idList<idEvent *> &list ) const;
+
+private:
+	idEvent					*events[ MAX_EVENTS ];
+	int						num;
+
+	static bool				Before( const idEvent *a, const idEvent *b );
+	static int				SortCompare( idEvent * const *a, idEvent * const *b );
+	void					MoveUp( idEvent *event, int index );
+	void					MoveDown( idEvent *event, int index );
+};
+
+/*
+================
+idEventHeap::Before
+================
+*/
+ID_INLINE bool idEventHeap::Before( const idEvent *a, const idEvent *b ) {
+	return ( a->time < b->time ) || ( ( a->time == b->time ) && ( a->sequence < b->sequence ) );
+}
+
+/*
+================
+idEventHeap::SortCompare
+================
+*/
+int idEventHeap::SortCompare( idEvent * const *a, idEvent * const *b ) {
+	if ( Before( *a, *b ) ) {
+		return -1;
+	}
+	if ( Before( *b, *a ) ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idEventHeap::Clear
+================
+*/
+void idEventHeap::Clear( void ) {
+	num = 0;
+}
+
+/*
+================
+idEventHeap::MoveUp
+================
+*/
+void idEventHeap::MoveUp( idEvent *event, int index ) {
+	int parent;
+
+	while ( index > 0 ) {
+		parent = ( index - 1 ) >> 1;
+		if ( !Before( event, events[ parent ] ) ) {
+			break;
+		}
+		events[ index ] = events[ parent ];
+		events[ index ]->queueIndex = index;
+		index = parent;
+	}
+	events[ index ] = event;
+	event->queueIndex = index;
+}
+
+/*
+================
+idEventHeap::MoveDown
+================
+*/
+void idEventHeap::MoveDown( idEvent *event, int index ) {
+	int child;
+
+	while ( 1 ) {
+		child = index * 2 + 1;
+		if ( child >= num ) {
+			break;
+		}
+		if ( child + 1 < num && Before( events[ child + 1 ], events[ child ] ) ) {
+			child++;
+		}
+		if ( !Before( events[ child ], event ) ) {
+			break;
+		}
+		events[ index ] = events[ child ];
+		events[ index ]->queueIndex = index;
+		index = child;
+	}
+	events[ index ] = event;
+	event->queueIndex = index;
+}
+
+/*
+================
+idEventHeap::Add
+================
+*/
+void idEventHeap::Add( idEvent *event ) {
+	assert( event->queue == NULL );
+	assert( num < MAX_EVENTS );
+
+	event->queue = this;
+	MoveUp( event, num++ );
+}
+
+/*
+================
+idEventHeap::Remove
+================
+*/
+void idEventHeap::Remove( idEvent *event ) {
+	int			index;
+	idEvent		*last;
+
+	assert( event->queue == this && events[ event->queueIndex ] == event );
+
+	index = event->queueIndex;
+	event->queue = NULL;
+	event->queueIndex = -1;
+
+	num--;
+	if ( index == num ) {
+		return;
+	}
+
+	// move the last event into the hole
+	last = events[ num ];
+	if ( index > 0 && Before( last, events[ ( index - 1 ) >> 1 ] ) ) {
+		MoveUp( last, index );
+	} else {
+		MoveDown( last, index );
+	}
+}
+
+/*
+================
+idEventHeap::GetSorted
+================
+*/
+void idEventHeap::GetSorted( idList<idEvent *> &list ) const {
+	int i;
+
+	list.SetNum( num );
+	for ( i = 0; i < num; i++ ) {
+		list[ i ] = events[ i ];
+	}
+	list.Sort( SortCompare );
+}
+
 /*
 ===============================================================================
 
@@ -210,14 +387,24 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 ===============================================================================
 */
 
-static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
-static idLinkList<idEvent> FastEventQueue;
+static idEventHeap EventQueue;
+static idEventHeap FastEventQueue;
+static idEvent *FreeEvents[ MAX_EVENTS ];
+static int numFreeEvents;
+static int64_t eventSequence;
 static idEvent EventPool[ MAX_EVENTS ];
 
 bool idEvent::initialized = false;
 
-idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
+// event args that don't fit in the event itself
+template< int size >
+struct eventDataBlock_t {
+	intptr_t				data[ size / sizeof( intptr_t ) ];
+};
+
+static idBlockAlloc<eventDataBlock_t<256>, 64>				eventData256;
+static idBlockAlloc<eventDataBlock_t<1024>, 16>				eventData1024;
+static idBlockAlloc<eventDataBlock_t<D_EVENT_MAX_DATA>, 8>	eventData2048;
 
 /*
 ================
@@ -242,13 +429,11 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 	int			i;
 	const char	*materialName;
 
-	if ( FreeEvents.IsListEmpty() ) {
+	if ( !numFreeEvents ) {
 		gameLocal.Error( "idEvent::Alloc : No more free events for '%s' event.", evdef->GetName() );
 	}
 
-	ev = FreeEvents.Next();
-	ev->eventNode.Remove();
-
+	ev = FreeEvents[ --numFreeEvents ];
 	ev->eventdef = evdef;
 
 	if ( numargs != evdef->GetNumArgs() ) {
@@ -257,7 +442,7 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 
 	size = evdef->GetArgSize();
 	if ( size ) {
-		ev->data = eventDataAllocator.Alloc( size );
+		ev->AllocData( size );
 		memset( ev->data, 0, size );
 	} else {
 		ev->data = NULL;
@@ -353,24 +538,124 @@ void idEvent::CopyArgs( const idEventDef *evdef, int numargs, va_list args, intp
 	}
 }
 
+/*
+================
+idEvent::AllocData
+
+Small event args are stored in the event itself, larger ones come from the smallest pool
+of fixed size blocks they fit in.
+================
+*/
+void idEvent::AllocData( size_t size ) {
+	assert( size <= D_EVENT_MAX_DATA );
+
+	if ( size <= sizeof( smallData ) ) {
+		data = reinterpret_cast<byte *>( smallData );
+		dataBlockSize = 0;
+	} else if ( size <= sizeof( eventDataBlock_t<256> ) ) {
+		data = reinterpret_cast<byte *>( eventData256.Alloc() );
+		dataBlockSize = sizeof( eventDataBlock_t<256> );
+	} else if ( size <= sizeof( eventDataBlock_t<1024> ) ) {
+		data = reinterpret_cast<byte *>( eventData1024.Alloc() );
+		dataBlockSize = sizeof( eventDataBlock_t<1024> );
+	} else {
+		data = reinterpret_cast<byte *>( eventData2048.Alloc() );
+		dataBlockSize = sizeof( eventDataBlock_t<D_EVENT_MAX_DATA> );
+	}
+}
+
 /*
 ================
 idEvent::Free
 ================
 */
 void idEvent::Free( void ) {
+	if ( queue ) {
+		queue->Remove( this );
+	}
+	objectNode.Remove();
+
 	if ( data ) {
-		eventDataAllocator.Free( data );
+		switch( dataBlockSize ) {
+			case 0:
+				break;
+			case sizeof( eventDataBlock_t<256> ):
+				eventData256.Free( reinterpret_cast<eventDataBlock_t<256> *>( data ) );
+				break;
+			case sizeof( eventDataBlock_t<1024> ):
+				eventData1024.Free( reinterpret_cast<eventDataBlock_t<1024> *>( data ) );
+				break;
+			default:
+				eventData2048.Free( reinterpret_cast<eventDataBlock_t<D_EVENT_MAX_DATA> *>( data ) );
+				break;
+		}
 		data = NULL;
+		dataBlockSize = 0;
+	}
+
+	// return the event to the pool if it was in use
+	if ( eventdef ) {
+		assert( numFreeEvents < MAX_EVENTS );
+		FreeEvents[ numFreeEvents++ ] = this;
 	}
 
 	eventdef	= NULL;
 	time		= 0;
 	object		= NULL;
 	typeinfo	= NULL;
+}
+
+/*
+================
+idEvent::AddToQueue
+================
+*/
+void idEvent::AddToQueue( idEventHeap &eventQueue ) {
+	eventQueue.Add( this );
+	if ( object ) {
+		objectNode.AddToEnd( object->scheduledEvents );
+	}
+}
+
+/*
+================
+idEvent::NextSequence
 
-	eventNode.SetOwner( this );
-	eventNode.AddToEnd( FreeEvents );
+Events and sleeping script threads share the sequence, so everything due at the
+same time runs in the order it was scheduled.
+================
+*/
+int64_t idEvent::NextSequence( void ) {
+	return eventSequence++;
+}
+
+/*
+================
+idEvent::SaveSequence
+================
+*/
+void idEvent::SaveSequence( idSaveGame *savefile, int64_t sequence ) {
+	savefile->WriteInt( ( int )( sequence >> 32 ) );
+	savefile->WriteInt( ( int )( sequence & 0xffffffff ) );
+}
+
+/*
+================
+idEvent::RestoreSequence
+
+Sequences handed out later sort after the restored one.
+================
+*/
+void idEvent::RestoreSequence( idRestoreGame *savefile, int64_t &sequence ) {
+	int high, low;
+
+	savefile->ReadInt( high );
+	savefile->ReadInt( low );
+	sequence = ( ( int64_t )high << 32 ) | ( unsigned int )low;
+
+	if ( sequence >= eventSequence ) {
+		eventSequence = sequence + 1;
+	}
 }
 
 /*
@@ -379,53 +664,38 @@ idEvent::Schedule
 ================
 */
 void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
-	idEvent *event;
-
 	assert( initialized );
 	if ( !initialized ) {
 		return;
 	}
 
+	if ( queue ) {
+		queue->Remove( this );
+	}
+	objectNode.Remove();
+
 	object = obj;
 	typeinfo = type;
+	sequence = NextSequence();
 
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
 
-	eventNode.Remove();
-
 	if ( obj->IsType( idEntity::Type ) && ( ( ( idEntity* )( obj ) )->timeGroup == TIME_GROUP2 ) ) {
-		event = FastEventQueue.Next();
-		while ( ( event != NULL ) && ( this->time >= event->time ) ) {
-			event = event->eventNode.Next();
-		}
-
-		if ( event ) {
-			eventNode.InsertBefore( event->eventNode );
-		} else {
-			eventNode.AddToEnd( FastEventQueue );
-		}
-
+		AddToQueue( FastEventQueue );
 		return;
 	} else {
 		this->time = gameLocal.slow.time + time;
 	}
 
-	event = EventQueue.Next();
-	while ( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
-	}
-
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
-	} else {
-		eventNode.AddToEnd( EventQueue );
-	}
+	AddToQueue( EventQueue );
 }
 
 /*
 ================
 idEvent::CancelEvents
+
+Only walks the events scheduled for the object.
 ================
 */
 void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
@@ -436,21 +706,10 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for ( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
-		}
-	}
-
-	for ( event = FastEventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
+	for ( event = obj->scheduledEvents.Next(); event != NULL; event = next ) {
+		next = event->objectNode.Next();
+		if ( !evdef || ( evdef == event->eventdef ) ) {
+			event->Free();
 		}
 	}
 }
@@ -464,16 +723,22 @@ void idEvent::ClearEventList( void ) {
 	int i;
 
 	//
-	// initialize lists
+	// free all events
 	//
-	FreeEvents.Clear();
-	EventQueue.Clear();
+	for ( i = 0; i < MAX_EVENTS; i++ ) {
+		EventPool[ i ].objectNode.SetOwner( &EventPool[ i ] );
+		EventPool[ i ].Free();
+	}
 
 	//
-	// add the events to the free list
+	// initialize the queues and put all events in the pool
 	//
-	for ( i = 0; i < MAX_EVENTS; i++ ) {
-		EventPool[ i ].Free();
+	EventQueue.Clear();
+	FastEventQueue.Clear();
+	eventSequence = 0;
+	numFreeEvents = 0;
+	for ( i = MAX_EVENTS - 1; i >= 0; i-- ) {
+		FreeEvents[ numFreeEvents++ ] = &EventPool[ i ];
 	}
 }
 
@@ -496,11 +761,24 @@ void idEvent::ServiceEvents( void ) {
 	const char			*materialName;
 
 	num = 0;
-	while ( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
-		assert( event );
+	while ( 1 ) {
+		event = EventQueue.Top();
+		if ( event != NULL && event->time > gameLocal.time ) {
+			event = NULL;
+		}
 
-		if ( event->time > gameLocal.time ) {
+		// script threads used to be resumed by events, so a thread that went to sleep
+		// before this event was posted still runs first.  Without a due event every
+		// thread that is due this frame sorts before gameLocal.time + 1.
+		if ( event != NULL ? idThread::ServiceNextThread( event->time, event->sequence ) : idThread::ServiceNextThread( gameLocal.time + 1, 0 ) ) {
+			num++;
+			if ( num > MAX_EVENTSPERFRAME ) {
+				gameLocal.Error( "Event overflow.  Possible infinite loop in script." );
+			}
+			continue;
+		}
+
+		if ( event == NULL ) {
 			break;
 		}
 
@@ -550,9 +828,10 @@ void idEvent::ServiceEvents( void ) {
 			}
 		}
 
-		// the event is removed from its list so that if then object
-		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		// the event is removed from its queue and object so that if the
+		// object is deleted, the event won't be freed twice
+		event->queue->Remove( event );
+		event->objectNode.Remove();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -587,8 +866,8 @@ void idEvent::ServiceFastEvents() {
 	const char			*materialName;
 
 	num = 0;
-	while ( !FastEventQueue.IsListEmpty() ) {
-		event = FastEventQueue.Next();
+	while ( FastEventQueue.Num() ) {
+		event = FastEventQueue.Top();
 		assert( event );
 
 		if ( event->time > gameLocal.fast.time ) {
@@ -641,9 +920,10 @@ void idEvent::ServiceFastEvents() {
 			}
 		}
 
-		// the event is removed from its list so that if then object
-		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		// the event is removed from its queue and object so that if the
+		// object is deleted, the event won't be freed twice
+		event->queue->Remove( event );
+		event->objectNode.Remove();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -671,12 +951,6 @@ void idEvent::Init( void ) {
 		gameLocal.Error( "%s", eventErrorMsg );
 	}
 
-#ifdef CREATE_EVENT_CODE
-	void CreateEventCallbackHandler();
-	CreateEventCallbackHandler();
-	gameLocal.Error( "Wrote event callback handler" );
-#endif
-
 	if ( initialized ) {
 		gameLocal.Printf( "...already initialized\n" );
 		ClearEventList();
@@ -685,8 +959,6 @@ void idEvent::Init( void ) {
 
 	ClearEventList();
 
-	eventDataAllocator.Init();
-
 	gameLocal.Printf( "...%i event definitions\n", idEventDef::NumEventCommands() );
 
 	// the event system has started
@@ -708,7 +980,9 @@ void idEvent::Shutdown( void ) {
 
 	ClearEventList();
 
-	eventDataAllocator.Shutdown();
+	eventData256.Shutdown();
+	eventData1024.Shutdown();
+	eventData2048.Shutdown();
 
 	// say it is now shutdown
 	initialized = false;
@@ -721,18 +995,22 @@ idEvent::Save
 */
 void idEvent::Save( idSaveGame *savefile ) {
 	char		*str;
-	int			i, size;
+	int			i, j, size;
 	idEvent		*event;
 	byte		*dataPtr;
 	bool		validTrace;
 	const char	*format;
 	idStr		s;
+	idList<idEvent *> events;
 
-	savefile->WriteInt( EventQueue.Num() );
+	// write the events in the order they will be serviced so the restored queue is the same
+	EventQueue.GetSorted( events );
+	savefile->WriteInt( events.Num() );
 
-	event = EventQueue.Next();
-	while ( event != NULL ) {
+	for ( j = 0; j < events.Num(); j++ ) {
+		event = events[ j ];
 		savefile->WriteInt( event->time );
+		SaveSequence( savefile, event->sequence );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
 		savefile->WriteObject( event->object );
@@ -784,22 +1062,21 @@ void idEvent::Save( idSaveGame *savefile ) {
 			}
 		}
 		assert( size == ( int )event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 
 	// Save the Fast EventQueue
-	savefile->WriteInt( FastEventQueue.Num() );
+	FastEventQueue.GetSorted( events );
+	savefile->WriteInt( events.Num() );
 
-	event = FastEventQueue.Next();
-	while ( event != NULL ) {
+	for ( j = 0; j < events.Num(); j++ ) {
+		event = events[ j ];
 		savefile->WriteInt( event->time );
+		SaveSequence( savefile, event->sequence );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
 		savefile->WriteObject( event->object );
 		savefile->WriteInt( event->eventdef->GetArgSize() );
 		savefile->Write( event->data, event->eventdef->GetArgSize() );
-
-		event = event->eventNode.Next();
 	}
 }
 
@@ -820,15 +1097,18 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( num );
 
 	for ( i = 0; i < num; i++ ) {
-		if ( FreeEvents.IsListEmpty() ) {
+		if ( !numFreeEvents ) {
 			gameLocal.Error( "idEvent::Restore : No more free events" );
 		}
 
-		event = FreeEvents.Next();
-		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
+		event = FreeEvents[ --numFreeEvents ];
 
 		savefile->ReadInt( event->time );
+		if ( savefile->GetInternalSavegameVersion() >= 2 ) {
+			RestoreSequence( savefile, event->sequence );
+		} else {
+			event->sequence = NextSequence();
+		}
 
 		// read the event name
 		savefile->ReadString( name );
@@ -847,6 +1127,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 		}
 
 		savefile->ReadObject( event->object );
+		event->AddToQueue( EventQueue );
 
 		// read the args
 		savefile->ReadInt( argsize );
@@ -854,7 +1135,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 			savefile->Error( "idEvent::Restore: arg size (%zd) doesn't match saved arg size(%d) on event '%s'", event->eventdef->GetArgSize(), argsize, event->eventdef->GetName() );
 		}
 		if ( argsize ) {
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->AllocData( argsize );
 			format = event->eventdef->GetArgFormat();
 			assert( format );
 			for ( j = 0, size = 0; j < event->eventdef->GetNumArgs(); ++j ) {
@@ -910,15 +1191,18 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( num );
 
 	for ( i = 0; i < num; i++ ) {
-		if ( FreeEvents.IsListEmpty() ) {
+		if ( !numFreeEvents ) {
 			gameLocal.Error( "idEvent::Restore : No more free events" );
 		}
 
-		event = FreeEvents.Next();
-		event->eventNode.Remove();
-		event->eventNode.AddToEnd( FastEventQueue );
+		event = FreeEvents[ --numFreeEvents ];
 
 		savefile->ReadInt( event->time );
+		if ( savefile->GetInternalSavegameVersion() >= 2 ) {
+			RestoreSequence( savefile, event->sequence );
+		} else {
+			event->sequence = NextSequence();
+		}
 
 		// read the event name
 		savefile->ReadString( name );
@@ -937,6 +1221,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 		}
 
 		savefile->ReadObject( event->object );
+		event->AddToQueue( FastEventQueue );
 
 		// read the args
 		savefile->ReadInt( argsize );
@@ -944,7 +1229,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 			savefile->Error( "idEvent::Restore: arg size (%zd) doesn't match saved arg size(%d) on event '%s'", event->eventdef->GetArgSize(), argsize, event->eventdef->GetName() );
 		}
 		if ( argsize ) {
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->AllocData( argsize );
 			savefile->Read( event->data, argsize );
 		} else {
 			event->data = NULL;
@@ -999,59 +1284,3 @@ void idEvent::SaveTrace( idSaveGame *savefile, const trace_t &trace ) {
 	savefile->WriteInt( trace.c.trmFeature );
 	savefile->WriteInt( trace.c.id );
 }
-
-#ifdef CREATE_EVENT_CODE
-/*
-================
-CreateEventCallbackHandler
-================
-*/
-void CreateEventCallbackHandler( void ) {
-	int i, j, k;
-	char argString[ D_EVENT_MAXARGS + 1 ];
-	idStr string1;
-	idStr string2;
-	idFile *file;
-
-	file = fileSystem->OpenFileWrite( "Callbacks.cpp" );
-
-	file->Printf( "// generated file - see CREATE_EVENT_CODE\n\n" );
-
-	for ( i = 1; i <= D_EVENT_MAXARGS; i++ ) {
-
-		file->Printf( "\t/*******************************************************\n\n\t\t%d args\n\n\t*******************************************************/\n\n", i );
-
-		for ( j = 0; j < ( 1 << i ); j++ ) {
-			for ( k = 0; k < i; k++ ) {
-				argString[ k ] = j & ( 1 << k ) ? 'f' : 'i';
-			}
-			argString[ i ] = '\0';
-
-			string1.Empty();
-			string2.Empty();
-
-			for ( k = 0; k < i; k++ ) {
-				if ( j & ( 1 << k ) ) {
-					string1 += "const float";
-					string2 += va( "*( float * )&data[ %d ]", k );
-				} else {
-					string1 += "const intptr_t";
-					string2 += va( "data[ %d ]", k );
-				}
-
-				if ( k < i - 1 ) {
-					string1 += ", ";
-					string2 += ", ";
-				}
-			}
-
-			file->Printf( "\tcase %d :\n\t\ttypedef void ( idClass::*eventCallback_%s_t )( %s );\n", ( 1 << ( i + D_EVENT_MAXARGS ) ) + j, argString, string1.c_str() );
-			file->Printf( "\t\t( this->*( eventCallback_%s_t )callback )( %s );\n\t\tbreak;\n\n", argString, string2.c_str() );
-
-		}
-	}
-
-	fileSystem->CloseFile( file );
-}
-
-#endif
@@ -34,8 +34,7 @@ If you have questions concerning this license or the applicable additional terms
 
 // Event are used for scheduling tasks and for linking script commands.
 
-#define D_EVENT_MAXARGS			8			// if changed, enable the CREATE_EVENT_CODE define in Event.cpp to generate switch statement for idClass::ProcessEventArgPtr.
-											// running the game will then generate c:\doom\base\events.txt, the contents of which should be copied into the switch statement.
+#define D_EVENT_MAXARGS			8			// if changed, add the matching idEventThunk specialization in Class.cpp
 
 // stack size of idVec3, aligned to native pointer size
 #define E_EVENT_SIZEOF_VEC		( ( sizeof( idVec3 ) + ( sizeof( intptr_t ) - 1 ) ) & ~( sizeof( intptr_t ) - 1 ) )
@@ -50,6 +49,9 @@ If you have questions concerning this license or the applicable additional terms
 #define D_EVENT_TRACE			't'
 
 #define MAX_EVENTS				8192
+#define EVENT_HASH_SIZE			1024		// must be a power of two
+#define D_EVENT_SMALL_DATA		64			// event args up to this size are stored in the event itself
+#define D_EVENT_MAX_DATA		2048		// largest event args, larger ones come from pools of fixed size blocks
 
 class idClass;
 class idTypeInfo;
@@ -65,8 +67,10 @@ private:
 	int							argOffset[ D_EVENT_MAXARGS ];
 	int							eventnum;
 	const idEventDef			*next;
+	idEventDef					*nextHash;
 
 	static idEventDef			*eventDefList[MAX_EVENTS];
+	static idEventDef			*eventDefHash[EVENT_HASH_SIZE];
 	static int					numEventDefs;
 
 public:
@@ -88,18 +92,28 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventHeap;
 
 class idEvent {
 private:
 	const idEventDef			*eventdef;
 	byte						*data;
 	int							time;
+	int64_t						sequence;				// orders events and script threads scheduled for the same time
 	idClass						*object;
 	const idTypeInfo			*typeinfo;
 
-	idLinkList<idEvent>			eventNode;
+	idEventHeap					*queue;					// queue the event is scheduled in, NULL if not scheduled
+	int							queueIndex;				// index in the queue heap
+	idLinkList<idEvent>			objectNode;				// for the list of events scheduled for the object
 
-	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
+	intptr_t					smallData[ D_EVENT_SMALL_DATA / sizeof( intptr_t ) ];
+	int							dataBlockSize;			// size of the pooled block data points to, 0 for smallData
+
+	friend class				idEventHeap;
+
+	void						AllocData( size_t size );
+	void						AddToQueue( idEventHeap &eventQueue );
 
 public:
 	static bool					initialized;
@@ -116,6 +130,7 @@ public:
 	static void					CancelEvents( const idClass *obj, const idEventDef *evdef = NULL );
 	static void					ClearEventList( void );
 	static void					ServiceEvents( void );
+	static int64_t				NextSequence( void );
 	static void					ServiceFastEvents();
 	static void					Init( void );
 	static void					Shutdown( void );
@@ -125,6 +140,8 @@ public:
 	static void					Restore( idRestoreGame *savefile );				// unarchives object from save game file
 	static void					SaveTrace( idSaveGame *savefile, const trace_t &trace );
 	static void					RestoreTrace( idRestoreGame *savefile, trace_t &trace );
+	static void					SaveSequence( idSaveGame *savefile, int64_t sequence );
+	static void					RestoreSequence( idRestoreGame *savefile, int64_t &sequence );
 };
 
 /*
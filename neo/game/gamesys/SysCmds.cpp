@@ -28,6 +28,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "sys/platform.h"
 #include "idlib/LangDict.h"
+#include "idlib/Timer.h"
 #include "framework/async/NetworkSystem.h"
 #include "framework/FileSystem.h"
 
@@ -214,6 +215,32 @@ void Cmd_Script_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+===================
+Cmd_ScriptProfile_f
+===================
+*/
+void Cmd_ScriptProfile_f( const idCmdArgs &args ) {
+	const char *cmd;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	cmd = args.Argv( 1 );
+	if ( !idStr::Icmp( cmd, "start" ) ) {
+		gameLocal.program.StartProfile();
+		gameLocal.Printf( "script profiling started\n" );
+	} else if ( !idStr::Icmp( cmd, "stop" ) ) {
+		gameLocal.program.StopProfile();
+		gameLocal.Printf( "script profiling stopped\n" );
+	} else if ( !idStr::Icmp( cmd, "print" ) ) {
+		gameLocal.program.PrintProfile( ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 20 );
+	} else {
+		gameLocal.Printf( "usage: scriptProfile start|stop|print [numFunctions]\n" );
+	}
+}
+
 /*
 ==================
 KillEntities
@@ -1477,6 +1504,15 @@ static void Cmd_ReloadAnims_f( const idCmdArgs &args ) {
 	animationLib.ReloadAnims();
 }
 
+/*
+==================
+Cmd_AnimPoseCacheStats_f
+==================
+*/
+static void Cmd_AnimPoseCacheStats_f( const idCmdArgs &args ) {
+	animPoseCache.PrintStats();
+}
+
 /*
 ==================
 Cmd_ListAnims_f
@@ -1549,6 +1585,15 @@ static void Cmd_AASStats_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_AASBuildRoutingTables_f
+==================
+*/
+static void Cmd_AASBuildRoutingTables_f( const idCmdArgs &args ) {
+	gameLocal.BuildAASRoutingTables();
+}
+
 /*
 ==================
 Cmd_TestDamage_f
@@ -1633,6 +1678,125 @@ static void Cmd_TestDeath_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_TestTraceBatch_f
+
+  compares point traces from the player view done one by one with the same traces done in one batch
+==================
+*/
+static void Cmd_TestTraceBatch_f( const idCmdArgs &args ) {
+	idPlayer *player;
+	idList<clipTrace_t> traces;
+	idList<trace_t> single;
+	idTimer timerSingle, timerBatch;
+	int i, numRays, numDiff;
+
+	player = gameLocal.GetLocalPlayer();
+	if ( !player || !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	numRays = 64;
+	if ( args.Argc() > 1 ) {
+		numRays = Max( 1, atoi( args.Argv( 1 ) ) );
+	}
+
+	const idVec3 start = player->GetEyePosition();
+	const idMat3 axis = player->viewAngles.ToMat3();
+
+	traces.SetNum( numRays );
+	single.SetNum( numRays );
+	for ( i = 0; i < numRays; i++ ) {
+		idVec3 dir = axis[0] + axis[1] * gameLocal.random.CRandomFloat() * 0.5f + axis[2] * gameLocal.random.CRandomFloat() * 0.5f;
+		dir.Normalize();
+		traces[i].start = start;
+		traces[i].end = start + dir * 4096.0f;
+		traces[i].bounds.Clear();
+		traces[i].contentMask = MASK_SHOT_RENDERMODEL;
+		traces[i].passEntity = player;
+	}
+
+	timerSingle.Start();
+	for ( i = 0; i < numRays; i++ ) {
+		gameLocal.clip.TracePoint( single[i], traces[i].start, traces[i].end, traces[i].contentMask, traces[i].passEntity );
+	}
+	timerSingle.Stop();
+
+	timerBatch.Start();
+	gameLocal.clip.TraceBatch( traces.Ptr(), numRays );
+	timerBatch.Stop();
+
+	numDiff = 0;
+	for ( i = 0; i < numRays; i++ ) {
+		if ( single[i].fraction != traces[i].results.fraction || single[i].c.entityNum != traces[i].results.c.entityNum ) {
+			numDiff++;
+		}
+	}
+
+	gameLocal.Printf( "%d rays: single %u msec, batch %u msec, %d different results\n",
+						numRays, timerSingle.Milliseconds(), timerBatch.Milliseconds(), numDiff );
+}
+
+/*
+==================
+Cmd_TestEventDispatch_f
+
+  times event lookups by name and calls through idClass::ProcessEventArgPtr
+==================
+*/
+static void Cmd_TestEventDispatch_f( const idCmdArgs &args ) {
+	const idEventDef *getName, *getKey;
+	unsigned int startUsec, findUsec, call0Usec, call1Usec;
+	intptr_t data[ D_EVENT_MAXARGS ];
+	int i, j, count, numEvents;
+
+	if ( !gameLocal.world || !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	count = 100000;
+	if ( args.Argc() > 1 ) {
+		count = Max( 1, atoi( args.Argv( 1 ) ) );
+	}
+
+	getName = idEventDef::FindEvent( "getName" );
+	getKey = idEventDef::FindEvent( "getKey" );
+	if ( !getName || !getKey ) {
+		gameLocal.Printf( "missing test events\n" );
+		return;
+	}
+
+	numEvents = idEventDef::NumEventCommands();
+	startUsec = idLib::sys->GetMicroseconds();
+	for ( i = 0; i < count; i += numEvents ) {
+		for ( j = 0; j < numEvents; j++ ) {
+			idEventDef::FindEvent( idEventDef::GetEventCommand( j )->GetName() );
+		}
+	}
+	findUsec = idLib::sys->GetMicroseconds() - startUsec;
+
+	memset( data, 0, sizeof( data ) );
+	startUsec = idLib::sys->GetMicroseconds();
+	for ( i = 0; i < count; i++ ) {
+		gameLocal.world->ProcessEventArgPtr( getName, data );
+	}
+	call0Usec = idLib::sys->GetMicroseconds() - startUsec;
+
+	data[ 0 ] = ( intptr_t )"classname";
+	startUsec = idLib::sys->GetMicroseconds();
+	for ( i = 0; i < count; i++ ) {
+		gameLocal.world->ProcessEventArgPtr( getKey, data );
+	}
+	call1Usec = idLib::sys->GetMicroseconds() - startUsec;
+
+	const int numFinds = ( ( count + numEvents - 1 ) / numEvents ) * numEvents;
+	gameLocal.Printf( "%d events: FindEvent %1.3f msec (%1.1f ns per lookup)\n", numEvents, findUsec * 0.001, findUsec * 1000.0 / numFinds );
+	gameLocal.Printf( "%d calls: getName %1.3f msec (%1.1f ns per call), getKey %1.3f msec (%1.1f ns per call)\n", count,
+						call0Usec * 0.001, call0Usec * 1000.0 / count,
+						call1Usec * 0.001, call1Usec * 1000.0 / count );
+}
+
 /*
 ==================
 Cmd_WeaponSplat_f
@@ -2473,13 +2637,18 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "testBlend",				idTestModel::TestBlend_f,				CMD_FL_GAME | CMD_FL_CHEAT,		"tests animation blending" );
 	cmdSystem->AddCommand( "reloadScript",			Cmd_ReloadScript_f,						CMD_FL_GAME | CMD_FL_CHEAT,		"reloads scripts" );
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,							CMD_FL_GAME | CMD_FL_CHEAT,		"executes a line of script" );
+	cmdSystem->AddCommand( "scriptProfile",			Cmd_ScriptProfile_f,					CMD_FL_GAME | CMD_FL_CHEAT,		"profiles the script interpreter: scriptProfile start|stop|print [numFunctions]" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,				CMD_FL_GAME,					"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,				CMD_FL_GAME,					"shows collision model info" );
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,					CMD_FL_GAME | CMD_FL_CHEAT,		"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,						CMD_FL_GAME | CMD_FL_CHEAT,		"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,						CMD_FL_GAME,					"lists all animations" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,							CMD_FL_GAME,					"shows AAS stats" );
+	cmdSystem->AddCommand( "aasBuildRoutingTables",	Cmd_AASBuildRoutingTables_f,			CMD_FL_GAME,					"builds the routing tables of the AAS files of the current map" );
+	cmdSystem->AddCommand( "animPoseCacheStats",	Cmd_AnimPoseCacheStats_f,				CMD_FL_GAME,					"shows how often animators shared a pose" );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,						CMD_FL_GAME | CMD_FL_CHEAT,		"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
+	cmdSystem->AddCommand( "testTraceBatch",		Cmd_TestTraceBatch_f,					CMD_FL_GAME | CMD_FL_CHEAT,		"compares single point traces with a trace batch: testTraceBatch [numRays]" );
+	cmdSystem->AddCommand( "testEventDispatch",		Cmd_TestEventDispatch_f,				CMD_FL_GAME | CMD_FL_CHEAT,		"times event lookups and event calls: testEventDispatch [count]" );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,						CMD_FL_GAME | CMD_FL_CHEAT,		"projects a blood splat on the player weapon" );
 	cmdSystem->AddCommand( "saveSelected",			Cmd_SaveSelected_f,						CMD_FL_GAME | CMD_FL_CHEAT,		"saves the selected entity to the .map file" );
 	cmdSystem->AddCommand( "deleteSelected",		Cmd_DeleteSelected_f,					CMD_FL_GAME | CMD_FL_CHEAT,		"deletes selected entity" );
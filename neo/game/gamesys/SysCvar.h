@@ -57,6 +57,8 @@ extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
 extern idCVar	g_debugScript;
+extern idCVar	g_scriptSuperInstructions;
+extern idCVar	g_scriptCache;
 extern idCVar	g_debugMover;
 extern idCVar	g_debugTriggers;
 extern idCVar	g_debugCinematic;
@@ -75,6 +77,15 @@ extern idCVar	g_showTriggers;
 extern idCVar	g_showCollisionWorld;
 extern idCVar	g_showCollisionModels;
 extern idCVar	g_showCollisionTraces;
+extern idCVar	g_clipTree;
+extern idCVar	g_parallelThink;
+extern idCVar	g_animPoseCache;
+extern idCVar	g_compressAnims;
+extern idCVar	g_compressAnimsTranslationError;
+extern idCVar	g_compressAnimsRotationError;
+extern idCVar	g_thinkLOD;
+extern idCVar	g_thinkLODDistance;
+extern idCVar	g_thinkLODMaxInterval;
 extern idCVar	g_maxShowDistance;
 extern idCVar	g_showEntityInfo;
 extern idCVar	g_showviewpos;
@@ -255,6 +266,9 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_routingCacheMemory;
+extern idCVar	aas_routingTables;
+extern idCVar	aas_cachePathQueries;
 
 extern idCVar	net_clientPredictGUI;
 
@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "Entity.h"
 #include "Game_local.h"
 
+#include "gamesys/SysCvar.h"
+
 #include "physics/Clip.h"
 
 #define	MAX_SECTOR_DEPTH			12
@@ -52,6 +54,21 @@ typedef struct clipLink_s {
 	struct clipLink_s		*nextLink;
 } clipLink_t;
 
+#define CLIP_TREE_MARGIN			8.0f		// leaf bounds are this much larger than the clip model
+#define CLIP_TREE_MAX_PREDICTION	128.0f		// moves further than this are not extrapolated
+#define MAX_CLIP_TREE_STACK			128
+
+#define TRACE_BATCH_JOB_SIZE		32			// batches are split over the job workers in ranges of at least this many traces
+#define MAX_TRACE_BATCH_JOBS		32
+
+typedef struct clipTreeNode_s {
+	idBounds				bounds;			// leaf bounds are a margin larger than the clip model
+	int						parent;			// next free node for free nodes
+	int						children[2];	// -1 for leaves
+	int						height;			// 0 for leaves, -1 for free nodes
+	idClipModel				*clipModel;		// clip model of a leaf
+} clipTreeNode_t;
+
 typedef struct trmCache_s {
 	idTraceModel			trm;
 	int						refCount;
@@ -60,6 +77,17 @@ typedef struct trmCache_s {
 	idMat3					inertiaTensor;
 } trmCache_t;
 
+typedef struct clipTraceBatch_s {
+	idClip					*clip;
+	clipTrace_t				*traces;
+	int						numTraces;
+	int						numJobs;
+	idClipModel				**clipModelList;		// candidates for the whole batch
+	int						numClipModels;
+	int						*hitModels;				// per trace candidate that stopped it, -1 for the world
+	int						numTranslations[MAX_TRACE_BATCH_JOBS];
+} clipTraceBatch_t;
+
 idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
 idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
@@ -286,7 +314,8 @@ void idClipModel::Init( void ) {
 	renderModelHandle = -1;
 	traceModelIndex = -1;
 	clipLinks = NULL;
-	touchCount = -1;
+	clipTreeNode = -1;
+	clipTreeLinked = false;
 }
 
 /*
@@ -352,7 +381,8 @@ idClipModel::idClipModel( const idClipModel *model ) {
 	}
 	renderModelHandle = model->renderModelHandle;
 	clipLinks = NULL;
-	touchCount = -1;
+	clipTreeNode = -1;
+	clipTreeLinked = false;
 }
 
 /*
@@ -363,6 +393,9 @@ idClipModel::~idClipModel
 idClipModel::~idClipModel( void ) {
 	// make sure the clip model is no longer linked
 	Unlink();
+	if ( clipTreeNode != -1 ) {
+		gameLocal.clip.RemoveFromTree( this );
+	}
 	if ( traceModelIndex != -1 ) {
 		FreeTraceModel( traceModelIndex );
 		traceModelIndex = -1;
@@ -392,8 +425,8 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
-	savefile->WriteInt( touchCount );
+	savefile->WriteBool( IsLinked() );
+	savefile->WriteInt( -1 );				// was touchCount
 }
 
 /*
@@ -404,6 +437,7 @@ idClipModel::Restore
 void idClipModel::Restore( idRestoreGame *savefile ) {
 	idStr collisionModelName;
 	bool linked;
+	int unused;
 
 	savefile->ReadBool( enabled );
 	savefile->ReadObject( reinterpret_cast<idClass*&>( entity ) );
@@ -427,12 +461,11 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 	}
 	savefile->ReadInt( renderModelHandle );
 	savefile->ReadBool( linked );
-	savefile->ReadInt( touchCount );
+	savefile->ReadInt( unused );			// was touchCount
 
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
 	clipLinks = NULL;
-	touchCount = -1;
 
 	if ( linked ) {
 		Link( gameLocal.clip, entity, id, origin, axis, renderModelHandle );
@@ -445,7 +478,7 @@ idClipModel::SetPosition
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
-	if ( clipLinks ) {
+	if ( IsLinked() ) {
 		Unlink();	// unlink from old position
 	}
 	origin = newOrigin;
@@ -506,6 +539,7 @@ void idClipModel::Unlink( void ) {
 		}
 		clipLinkAllocator.Free( link );
 	}
+	clipTreeLinked = false;
 }
 
 /*
@@ -552,7 +586,7 @@ void idClipModel::Link( idClip &clp ) {
 		return;
 	}
 
-	if ( clipLinks ) {
+	if ( IsLinked() ) {
 		Unlink();	// unlink from old position
 	}
 
@@ -575,7 +609,16 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	clp.numLinks++;
+
+	if ( clp.useClipTree ) {
+		clp.LinkTree( this );
+	} else {
+		Link_r( clp.clipSectors );
+		for ( clipLink_t *link = clipLinks; link; link = link->nextLink ) {
+			clp.numLinkNodes++;
+		}
+	}
 }
 
 /*
@@ -623,8 +666,13 @@ idClip::idClip
 idClip::idClip( void ) {
 	numClipSectors = 0;
 	clipSectors = NULL;
+	useClipTree = false;
+	treeNodes = NULL;
+	numTreeNodes = maxTreeNodes = 0;
+	freeTreeNode = treeRoot = -1;
 	worldBounds.Zero();
-	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = numTraceBatches = 0;
+	numLinks = numLinkNodes = numBoundsQueries = numQueryNodes = 0;
 }
 
 /*
@@ -686,28 +734,38 @@ void idClip::Init( void ) {
 	cmHandle_t h;
 	idVec3 size, maxSector = vec3_origin;
 
-	// clear clip sectors
-	clipSectors = new clipSector_t[MAX_SECTORS];
-	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
-	numClipSectors = 0;
-	touchCount = -1;
-
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap", false );
 	collisionModelManager->GetModelBounds( h, worldBounds );
 
-	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
-
 	size = worldBounds[1] - worldBounds[0];
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
-	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
+
+	useClipTree = g_clipTree.GetBool();
+	if ( useClipTree ) {
+		// the tree grows as clip models are linked
+		treeNodes = NULL;
+		numTreeNodes = maxTreeNodes = 0;
+		freeTreeNode = treeRoot = -1;
+		gameLocal.Printf( "using a dynamic clip tree\n" );
+	} else {
+		// clear clip sectors
+		clipSectors = new clipSector_t[MAX_SECTORS];
+		memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
+		numClipSectors = 0;
+
+		// create world sectors
+		CreateClipSectors_r( 0, worldBounds, maxSector );
+
+		gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
+	}
 
 	// initialize a default clip model
 	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
 
 	// set counters to zero
-	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = numTraceBatches = 0;
+	numLinks = numLinkNodes = numBoundsQueries = numQueryNodes = 0;
 }
 
 /*
@@ -719,6 +777,19 @@ void idClip::Shutdown( void ) {
 	delete[] clipSectors;
 	clipSectors = NULL;
 
+	// clip models still in the tree forget their leaf
+	for ( int i = 0; i < maxTreeNodes; i++ ) {
+		if ( treeNodes[i].height == 0 && treeNodes[i].clipModel ) {
+			treeNodes[i].clipModel->clipTreeNode = -1;
+			treeNodes[i].clipModel->clipTreeLinked = false;
+		}
+	}
+	delete[] treeNodes;
+	treeNodes = NULL;
+	numTreeNodes = maxTreeNodes = 0;
+	freeTreeNode = treeRoot = -1;
+	useClipTree = false;
+
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
 		idClipModel::FreeTraceModel( temporaryClipModel.traceModelIndex );
@@ -734,12 +805,31 @@ void idClip::Shutdown( void ) {
 	clipLinkAllocator.Shutdown();
 }
 
+/*
+====================
+ClipSectorForPoint
+
+  returns the leaf sector a point ends up in when descending the tree the way Link_r does
+====================
+*/
+static const clipSector_t *ClipSectorForPoint( const clipSector_t *node, const idVec3 &point ) {
+	while ( node->axis != -1 ) {
+		if ( point[node->axis] > node->dist ) {
+			node = node->children[0];
+		} else {
+			node = node->children[1];
+		}
+	}
+	return node;
+}
+
 typedef struct listParms_s {
 	idBounds		bounds;
 	int				contentMask;
 	idClipModel		**list;
 	int				count;
 	int				maxCount;
+	bool			*overflowed;	// set instead of printing a warning when the list is full
 } listParms_t;
 
 /*
@@ -748,6 +838,8 @@ idClip::ClipModelsTouchingBounds_r
 ====================
 */
 void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listParms_t &parms ) const {
+	numQueryNodes++;
+
 	while ( node->axis != -1 ) {
 		if ( parms.bounds[0][node->axis] > node->dist ) {
 			node = node->children[0];
@@ -767,8 +859,436 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listPa
 			continue;
 		}
 
-		// avoid duplicates in the list
-		if ( check->touchCount == touchCount ) {
+		// if the clip model does not have any contents we are looking for
+		if ( !( check->contents & parms.contentMask ) ) {
+			continue;
+		}
+
+		// if the bounds really do overlap
+		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
+				check->absBounds[1][0] < parms.bounds[0][0] ||
+				check->absBounds[0][1] > parms.bounds[1][1] ||
+				check->absBounds[1][1] < parms.bounds[0][1] ||
+				check->absBounds[0][2] > parms.bounds[1][2] ||
+				check->absBounds[1][2] < parms.bounds[0][2] ) {
+			continue;
+		}
+
+		// avoid duplicates in the list, a clip model linked into several sectors is only
+		// listed from the sector that holds the minimum corner of the overlap with the bounds
+		if ( check->clipLinks->nextLink != NULL ) {
+			idVec3 corner;
+
+			corner[0] = Max( check->absBounds[0][0], parms.bounds[0][0] );
+			corner[1] = Max( check->absBounds[0][1], parms.bounds[0][1] );
+			corner[2] = Max( check->absBounds[0][2], parms.bounds[0][2] );
+			if ( ClipSectorForPoint( clipSectors, corner ) != node ) {
+				continue;
+			}
+		}
+
+		if ( parms.count >= parms.maxCount ) {
+			if ( parms.overflowed ) {
+				*parms.overflowed = true;
+			} else {
+				gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
+			}
+			return;
+		}
+
+		parms.list[parms.count] = check;
+		parms.count++;
+	}
+}
+
+/*
+===============================================================
+
+	idClip dynamic bounding volume tree
+
+	Every linked clip model is a leaf with bounds that are a margin
+	larger than the clip model. A clip model that is relinked within
+	those bounds stays where it is in the tree. Otherwise the leaf is
+	removed and reinserted where it adds the least surface area, and
+	the nodes on the way back to the root are rotated to keep the
+	tree balanced.
+
+===============================================================
+*/
+
+/*
+================
+ClipTreeCost
+
+  half the surface area of the bounds
+================
+*/
+static ID_INLINE float ClipTreeCost( const idBounds &bounds ) {
+	idVec3 size = bounds[1] - bounds[0];
+	return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+}
+
+/*
+================
+idClip::AllocTreeNode
+================
+*/
+int idClip::AllocTreeNode( void ) {
+	int nodeNum;
+
+	if ( freeTreeNode == -1 ) {
+		clipTreeNode_t *newNodes;
+
+		maxTreeNodes = maxTreeNodes ? maxTreeNodes * 2 : 1024;
+		newNodes = new clipTreeNode_t[maxTreeNodes];
+		if ( treeNodes ) {
+			memcpy( newNodes, treeNodes, numTreeNodes * sizeof( clipTreeNode_t ) );
+			delete[] treeNodes;
+		}
+		treeNodes = newNodes;
+
+		// chain the new nodes into the free list
+		for ( nodeNum = numTreeNodes; nodeNum < maxTreeNodes; nodeNum++ ) {
+			treeNodes[nodeNum].parent = nodeNum + 1 < maxTreeNodes ? nodeNum + 1 : -1;
+			treeNodes[nodeNum].height = -1;
+		}
+		freeTreeNode = numTreeNodes;
+	}
+
+	nodeNum = freeTreeNode;
+	freeTreeNode = treeNodes[nodeNum].parent;
+
+	clipTreeNode_t &node = treeNodes[nodeNum];
+	node.bounds.Clear();
+	node.parent = -1;
+	node.children[0] = node.children[1] = -1;
+	node.height = 0;
+	node.clipModel = NULL;
+
+	numTreeNodes++;
+
+	return nodeNum;
+}
+
+/*
+================
+idClip::FreeTreeNode
+================
+*/
+void idClip::FreeTreeNode( int nodeNum ) {
+	assert( nodeNum >= 0 && nodeNum < maxTreeNodes );
+	treeNodes[nodeNum].parent = freeTreeNode;
+	treeNodes[nodeNum].height = -1;
+	treeNodes[nodeNum].clipModel = NULL;
+	freeTreeNode = nodeNum;
+	numTreeNodes--;
+}
+
+/*
+================
+idClip::BalanceTreeNode
+
+  rotates the higher child of an unbalanced node up, returns the node now in its place
+================
+*/
+int idClip::BalanceTreeNode( int nodeNum ) {
+	int iA, iB, iC, iHigh, iLow, iOther, side, keep, grandChild0, grandChild1, parent, balance;
+
+	iA = nodeNum;
+	clipTreeNode_t &a = treeNodes[iA];
+	if ( a.children[0] == -1 || a.height < 2 ) {
+		return iA;
+	}
+
+	iB = a.children[0];
+	iC = a.children[1];
+	balance = treeNodes[iC].height - treeNodes[iB].height;
+
+	if ( balance > 1 ) {
+		iHigh = iC;
+		iOther = iB;
+		side = 1;
+	} else if ( balance < -1 ) {
+		iHigh = iB;
+		iOther = iC;
+		side = 0;
+	} else {
+		return iA;
+	}
+
+	clipTreeNode_t &high = treeNodes[iHigh];
+	grandChild0 = high.children[0];
+	grandChild1 = high.children[1];
+
+	// the higher child takes the place of the node
+	parent = a.parent;
+	high.children[0] = iA;
+	high.parent = parent;
+	a.parent = iHigh;
+	if ( parent != -1 ) {
+		if ( treeNodes[parent].children[0] == iA ) {
+			treeNodes[parent].children[0] = iHigh;
+		} else {
+			treeNodes[parent].children[1] = iHigh;
+		}
+	} else {
+		treeRoot = iHigh;
+	}
+
+	// the higher grandchild stays with the rotated child, the lower one moves to the node
+	if ( treeNodes[grandChild0].height > treeNodes[grandChild1].height ) {
+		keep = grandChild0;
+		iLow = grandChild1;
+	} else {
+		keep = grandChild1;
+		iLow = grandChild0;
+	}
+	high.children[1] = keep;
+	a.children[side] = iLow;
+	treeNodes[iLow].parent = iA;
+
+	a.bounds = treeNodes[iOther].bounds + treeNodes[iLow].bounds;
+	a.height = 1 + Max( treeNodes[iOther].height, treeNodes[iLow].height );
+	high.bounds = a.bounds + treeNodes[keep].bounds;
+	high.height = 1 + Max( a.height, treeNodes[keep].height );
+
+	return iHigh;
+}
+
+/*
+================
+idClip::InsertTreeLeaf
+================
+*/
+void idClip::InsertTreeLeaf( int leaf ) {
+	int nodeNum, sibling, oldParent, newParent, child0, child1;
+	float cost, inheritanceCost, cost0, cost1, combinedCost;
+	idBounds leafBounds, combined;
+
+	if ( treeRoot == -1 ) {
+		treeRoot = leaf;
+		treeNodes[leaf].parent = -1;
+		return;
+	}
+
+	// find the best sibling for the leaf
+	leafBounds = treeNodes[leaf].bounds;
+	nodeNum = treeRoot;
+	while ( treeNodes[nodeNum].children[0] != -1 ) {
+		const clipTreeNode_t &node = treeNodes[nodeNum];
+
+		child0 = node.children[0];
+		child1 = node.children[1];
+
+		combined = node.bounds + leafBounds;
+		combinedCost = ClipTreeCost( combined );
+
+		// cost of creating a new parent for this node and the new leaf
+		cost = 2.0f * combinedCost;
+
+		// minimum cost of pushing the leaf further down the tree
+		inheritanceCost = 2.0f * ( combinedCost - ClipTreeCost( node.bounds ) );
+
+		cost0 = ClipTreeCost( treeNodes[child0].bounds + leafBounds ) + inheritanceCost;
+		if ( treeNodes[child0].children[0] != -1 ) {
+			cost0 -= ClipTreeCost( treeNodes[child0].bounds );
+		}
+		cost1 = ClipTreeCost( treeNodes[child1].bounds + leafBounds ) + inheritanceCost;
+		if ( treeNodes[child1].children[0] != -1 ) {
+			cost1 -= ClipTreeCost( treeNodes[child1].bounds );
+		}
+
+		if ( cost < cost0 && cost < cost1 ) {
+			break;
+		}
+
+		nodeNum = cost0 < cost1 ? child0 : child1;
+	}
+	sibling = nodeNum;
+
+	// create a new parent for the sibling and the leaf
+	newParent = AllocTreeNode();
+	oldParent = treeNodes[sibling].parent;
+	treeNodes[newParent].parent = oldParent;
+	treeNodes[newParent].bounds = leafBounds + treeNodes[sibling].bounds;
+	treeNodes[newParent].height = treeNodes[sibling].height + 1;
+	treeNodes[newParent].children[0] = sibling;
+	treeNodes[newParent].children[1] = leaf;
+	treeNodes[sibling].parent = newParent;
+	treeNodes[leaf].parent = newParent;
+
+	if ( oldParent != -1 ) {
+		if ( treeNodes[oldParent].children[0] == sibling ) {
+			treeNodes[oldParent].children[0] = newParent;
+		} else {
+			treeNodes[oldParent].children[1] = newParent;
+		}
+	} else {
+		treeRoot = newParent;
+	}
+
+	// walk back up the tree fixing heights and bounds
+	for ( nodeNum = treeNodes[leaf].parent; nodeNum != -1; nodeNum = treeNodes[nodeNum].parent ) {
+		nodeNum = BalanceTreeNode( nodeNum );
+
+		clipTreeNode_t &node = treeNodes[nodeNum];
+		node.height = 1 + Max( treeNodes[node.children[0]].height, treeNodes[node.children[1]].height );
+		node.bounds = treeNodes[node.children[0]].bounds + treeNodes[node.children[1]].bounds;
+	}
+}
+
+/*
+================
+idClip::RemoveTreeLeaf
+================
+*/
+void idClip::RemoveTreeLeaf( int leaf ) {
+	int nodeNum, parent, grandParent, sibling;
+
+	if ( leaf == treeRoot ) {
+		treeRoot = -1;
+		return;
+	}
+
+	parent = treeNodes[leaf].parent;
+	grandParent = treeNodes[parent].parent;
+	sibling = treeNodes[parent].children[0] == leaf ? treeNodes[parent].children[1] : treeNodes[parent].children[0];
+
+	FreeTreeNode( parent );
+
+	if ( grandParent == -1 ) {
+		treeRoot = sibling;
+		treeNodes[sibling].parent = -1;
+		return;
+	}
+
+	// connect the sibling to the grandparent
+	if ( treeNodes[grandParent].children[0] == parent ) {
+		treeNodes[grandParent].children[0] = sibling;
+	} else {
+		treeNodes[grandParent].children[1] = sibling;
+	}
+	treeNodes[sibling].parent = grandParent;
+
+	for ( nodeNum = grandParent; nodeNum != -1; nodeNum = treeNodes[nodeNum].parent ) {
+		nodeNum = BalanceTreeNode( nodeNum );
+
+		clipTreeNode_t &node = treeNodes[nodeNum];
+		node.height = 1 + Max( treeNodes[node.children[0]].height, treeNodes[node.children[1]].height );
+		node.bounds = treeNodes[node.children[0]].bounds + treeNodes[node.children[1]].bounds;
+	}
+}
+
+/*
+================
+idClip::LinkTree
+================
+*/
+void idClip::LinkTree( idClipModel *clipModel ) {
+	int i, leaf;
+	idVec3 displacement;
+	idBounds fatBounds;
+
+	clipModel->clipTreeLinked = true;
+
+	leaf = clipModel->clipTreeNode;
+	if ( leaf != -1 ) {
+		const idBounds &bounds = treeNodes[leaf].bounds;
+		const idBounds &absBounds = clipModel->absBounds;
+
+		// nothing to do if the clip model is still within the leaf bounds
+		if (	absBounds[0][0] >= bounds[0][0] && absBounds[1][0] <= bounds[1][0] &&
+				absBounds[0][1] >= bounds[0][1] && absBounds[1][1] <= bounds[1][1] &&
+				absBounds[0][2] >= bounds[0][2] && absBounds[1][2] <= bounds[1][2] ) {
+			return;
+		}
+
+		// extend the new leaf bounds in the direction the clip model moved
+		displacement = absBounds.GetCenter() - bounds.GetCenter();
+		if ( displacement.LengthSqr() > Square( CLIP_TREE_MAX_PREDICTION ) ) {
+			displacement.Zero();
+		}
+
+		RemoveTreeLeaf( leaf );
+	} else {
+		leaf = AllocTreeNode();
+		treeNodes[leaf].clipModel = clipModel;
+		clipModel->clipTreeNode = leaf;
+		displacement.Zero();
+	}
+
+	fatBounds = clipModel->absBounds.Expand( CLIP_TREE_MARGIN );
+	for ( i = 0; i < 3; i++ ) {
+		if ( displacement[i] < 0.0f ) {
+			fatBounds[0][i] += displacement[i];
+		} else {
+			fatBounds[1][i] += displacement[i];
+		}
+	}
+	treeNodes[leaf].bounds = fatBounds;
+
+	InsertTreeLeaf( leaf );
+
+	numLinkNodes++;
+}
+
+/*
+================
+idClip::RemoveFromTree
+================
+*/
+void idClip::RemoveFromTree( idClipModel *clipModel ) {
+	int leaf = clipModel->clipTreeNode;
+
+	assert( leaf >= 0 && leaf < maxTreeNodes && treeNodes[leaf].clipModel == clipModel );
+
+	RemoveTreeLeaf( leaf );
+	FreeTreeNode( leaf );
+	clipModel->clipTreeNode = -1;
+	clipModel->clipTreeLinked = false;
+}
+
+/*
+================
+idClip::ClipModelsTouchingTree
+================
+*/
+void idClip::ClipModelsTouchingTree( listParms_t &parms ) const {
+	int stack[MAX_CLIP_TREE_STACK];
+	int stackDepth;
+
+	if ( treeRoot == -1 ) {
+		return;
+	}
+
+	stack[0] = treeRoot;
+	stackDepth = 1;
+
+	while ( stackDepth > 0 ) {
+		const clipTreeNode_t &node = treeNodes[stack[--stackDepth]];
+
+		numQueryNodes++;
+
+		if (	node.bounds[0][0] > parms.bounds[1][0] ||
+				node.bounds[1][0] < parms.bounds[0][0] ||
+				node.bounds[0][1] > parms.bounds[1][1] ||
+				node.bounds[1][1] < parms.bounds[0][1] ||
+				node.bounds[0][2] > parms.bounds[1][2] ||
+				node.bounds[1][2] < parms.bounds[0][2] ) {
+			continue;
+		}
+
+		if ( node.children[0] != -1 ) {
+			assert( stackDepth + 2 <= MAX_CLIP_TREE_STACK );
+			stack[stackDepth++] = node.children[1];
+			stack[stackDepth++] = node.children[0];
+			continue;
+		}
+
+		idClipModel *check = node.clipModel;
+
+		// if the clip model is linked and enabled
+		if ( !check->clipTreeLinked || !check->enabled ) {
 			continue;
 		}
 
@@ -788,11 +1308,14 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listPa
 		}
 
 		if ( parms.count >= parms.maxCount ) {
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
+			if ( parms.overflowed ) {
+				*parms.overflowed = true;
+			} else {
+				gameLocal.Warning( "idClip::ClipModelsTouchingTree: max count" );
+			}
 			return;
 		}
 
-		check->touchCount = touchCount;
 		parms.list[parms.count] = check;
 		parms.count++;
 	}
@@ -801,9 +1324,11 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listPa
 /*
 ================
 idClip::ClipModelsTouchingBounds
+
+  Callers that handle a full list themselves pass overflowed, which is set instead of printing a warning.
 ================
 */
-int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
+int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount, bool *overflowed ) const {
 	if (	bounds[0][0] > bounds[1][0] ||
 			bounds[0][1] > bounds[1][1] ||
 			bounds[0][2] > bounds[1][2] ) {
@@ -819,9 +1344,18 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.list = clipModelList;
 	parms.count = 0;
 	parms.maxCount = maxCount;
+	parms.overflowed = overflowed;
+	if ( overflowed ) {
+		*overflowed = false;
+	}
 
-	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	numBoundsQueries++;
+
+	if ( useClipTree ) {
+		ClipModelsTouchingTree( parms );
+	} else {
+		ClipModelsTouchingBounds_r( clipSectors, parms );
+	}
 
 	return parms.count;
 }
@@ -870,7 +1404,6 @@ An ent will be excluded from testing if:
 */
 int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const {
 	int i, num;
-	idClipModel	*cm;
 	idEntity *passOwner;
 
 	num = ClipModelsTouchingBounds( bounds, contentMask, clipModelList, MAX_GENTITIES );
@@ -886,25 +1419,36 @@ int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const i
 	}
 
 	for ( i = 0; i < num; i++ ) {
-		cm = clipModelList[i];
-
-		// check if we should ignore this entity
-		if ( cm->entity == passEntity ) {
-			clipModelList[i] = NULL;			// don't clip against the pass entity
-		} else if ( cm->entity == passOwner ) {
-			clipModelList[i] = NULL;			// missiles don't clip with their owner
-		} else if ( cm->owner ) {
-			if ( cm->owner == passEntity ) {
-				clipModelList[i] = NULL;		// don't clip against own missiles
-			} else if ( cm->owner == passOwner ) {
-				clipModelList[i] = NULL;		// don't clip against other missiles from same owner
-			}
+		if ( IgnoreClipModel( clipModelList[i], passEntity, passOwner ) ) {
+			clipModelList[i] = NULL;
 		}
 	}
 
 	return num;
 }
 
+/*
+====================
+idClip::IgnoreClipModel
+
+  true if the clip model is excluded from traces with the given pass entity and owner
+====================
+*/
+bool idClip::IgnoreClipModel( const idClipModel *cm, const idEntity *passEntity, const idEntity *passOwner ) const {
+	if ( cm->entity == passEntity ) {
+		return true;			// don't clip against the pass entity
+	} else if ( cm->entity == passOwner ) {
+		return true;			// missiles don't clip with their owner
+	} else if ( cm->owner ) {
+		if ( cm->owner == passEntity ) {
+			return true;		// don't clip against own missiles
+		} else if ( cm->owner == passOwner ) {
+			return true;		// don't clip against other missiles from same owner
+		}
+	}
+	return false;
+}
+
 /*
 ============
 idClip::TraceRenderModel
@@ -1131,6 +1675,279 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+idClip::TraceModelForBatch
+
+  loads the temporary clip model with the bounds of a box trace, a cleared bounds is a point trace
+============
+*/
+const idTraceModel *idClip::TraceModelForBatch( const idBounds &bounds, idBounds &loadedBounds ) {
+	if ( bounds.IsCleared() ) {
+		return NULL;
+	}
+	if ( bounds != loadedBounds ) {
+		temporaryClipModel.LoadModel( idTraceModel( bounds ) );
+		loadedBounds = bounds;
+	}
+	return TraceModelForClipModel( &temporaryClipModel );
+}
+
+/*
+============
+idClip::BatchTraceModel
+============
+*/
+const idTraceModel *idClip::BatchTraceModel( const idBounds &bounds, idTraceModel &trm, idBounds &loadedBounds ) {
+	if ( bounds.IsCleared() ) {
+		return NULL;
+	}
+	if ( bounds != loadedBounds ) {
+		trm.SetupBox( bounds );
+		loadedBounds = bounds;
+	}
+	return &trm;
+}
+
+/*
+============
+idClip::TraceBatchWorldJob
+
+  Traces a range of the batch against the world.
+============
+*/
+void idClip::TraceBatchWorldJob( void *data, int jobNum ) {
+	clipTraceBatch_t *batch = static_cast<clipTraceBatch_t *>( data );
+	const idTraceModel *trm;
+	idTraceModel boxModel;
+	idBounds loadedBounds;
+	int i, last;
+
+	loadedBounds.Clear();
+
+	last = ( jobNum + 1 ) * batch->numTraces / batch->numJobs;
+	for ( i = jobNum * batch->numTraces / batch->numJobs; i < last; i++ ) {
+		clipTrace_t &tr = batch->traces[i];
+		trace_t &results = tr.results;
+
+		trm = BatchTraceModel( tr.bounds, boxModel, loadedBounds );
+
+		if ( TestHugeTranslation( results, trm != NULL ? &batch->clip->temporaryClipModel : NULL, tr.start, tr.end, mat3_identity ) ) {
+			continue;
+		}
+
+		if ( !tr.passEntity || tr.passEntity->entityNumber != ENTITYNUM_WORLD ) {
+			// test world
+			batch->numTranslations[jobNum]++;
+			collisionModelManager->Translation( &results, tr.start, tr.end, trm, mat3_identity, tr.contentMask, 0, vec3_origin, mat3_default );
+			results.c.entityNum = results.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+		} else {
+			memset( &results, 0, sizeof( results ) );
+			results.fraction = 1.0f;
+			results.endpos = tr.end;
+			results.endAxis = mat3_identity;
+		}
+	}
+}
+
+/*
+============
+idClip::TraceBatchModelsJob
+
+  Clips a range of the batch against the candidate collision models. Render models are
+  left to the calling thread because tracing them is not thread safe.
+============
+*/
+void idClip::TraceBatchModelsJob( void *data, int jobNum ) {
+	clipTraceBatch_t *batch = static_cast<clipTraceBatch_t *>( data );
+	const idTraceModel *trm;
+	idTraceModel boxModel;
+	idBounds loadedBounds;
+	int i, last;
+
+	loadedBounds.Clear();
+
+	last = ( jobNum + 1 ) * batch->numTraces / batch->numJobs;
+	for ( i = jobNum * batch->numTraces / batch->numJobs; i < last; i++ ) {
+		clipTrace_t &tr = batch->traces[i];
+
+		trm = BatchTraceModel( tr.bounds, boxModel, loadedBounds );
+
+		batch->hitModels[i] = -1;
+		batch->numTranslations[jobNum] += batch->clip->TraceBatchModels( tr, trm, batch->clipModelList, batch->numClipModels, false, batch->hitModels[i] );
+	}
+}
+
+/*
+============
+idClip::TraceBatchModels
+
+  Clips one translation of a batch against either the collision models or the render models
+  in the candidate list and returns the number of models traced. hitModel is the index of
+  the candidate that stopped the trace, -1 for the world. The first candidate with the
+  smallest fraction wins just like in Translation, no matter which of the two passes it is
+  found in.
+============
+*/
+int idClip::TraceBatchModels( clipTrace_t &tr, const idTraceModel *trm, idClipModel **clipModelList, int numClipModels, bool renderModels, int &hitModel ) const {
+	int j, numModelTraces;
+	idClipModel *touch;
+	idBounds traceBounds;
+	const idEntity *passOwner;
+	float radius;
+	trace_t trace;
+	trace_t &results = tr.results;
+
+	if ( tr.bounds.IsCleared() ) {
+		traceBounds.FromPointTranslation( tr.start, results.endpos - tr.start );
+		radius = 0.0f;
+	} else {
+		traceBounds.FromBoundsTranslation( tr.bounds, tr.start, mat3_identity, results.endpos - tr.start );
+		radius = tr.bounds.GetRadius();
+	}
+	traceBounds[0] -= vec3_boxEpsilon;
+	traceBounds[1] += vec3_boxEpsilon;
+
+	passOwner = NULL;
+	if ( tr.passEntity && tr.passEntity->GetPhysics()->GetNumClipModels() > 0 ) {
+		passOwner = tr.passEntity->GetPhysics()->GetClipModel()->GetOwner();
+	}
+
+	numModelTraces = 0;
+	for ( j = 0; j < numClipModels; j++ ) {
+		if ( results.fraction == 0.0f && j > hitModel ) {
+			break;
+		}
+
+		touch = clipModelList[j];
+
+		if ( ( touch->renderModelHandle != -1 ) != renderModels ) {
+			continue;
+		}
+
+		if ( !( touch->contents & tr.contentMask ) ) {
+			continue;
+		}
+
+		if ( !touch->absBounds.IntersectsBounds( traceBounds ) ) {
+			continue;
+		}
+
+		if ( tr.passEntity && IgnoreClipModel( touch, tr.passEntity, passOwner ) ) {
+			continue;
+		}
+
+		numModelTraces++;
+		if ( renderModels ) {
+			TraceRenderModel( trace, tr.start, tr.end, radius, mat3_identity, touch );
+		} else {
+			collisionModelManager->Translation( &trace, tr.start, tr.end, trm, mat3_identity, tr.contentMask,
+									touch->Handle(), touch->origin, touch->axis );
+		}
+
+		if ( trace.fraction < results.fraction || ( trace.fraction == results.fraction && j < hitModel ) ) {
+			results = trace;
+			results.c.entityNum = touch->entity->entityNumber;
+			results.c.id = touch->id;
+			hitModel = j;
+		}
+	}
+
+	return numModelTraces;
+}
+
+/*
+============
+idClip::TraceBatch
+
+  The world is traced per translation but the clip sectors are only walked once for the
+  bounds of the whole batch. Every translation then only tests the candidates that touch
+  its own trace bounds. Large batches are split over the job workers.
+============
+*/
+void idClip::TraceBatch( clipTrace_t *traces, int numTraces ) {
+	int i, num, contentMask;
+	idClipModel *clipModelList[MAX_GENTITIES];
+	idBounds traceBounds, batchBounds, loadedBounds;
+	idList<int> hitModels;
+	clipTraceBatch_t batch;
+	const idTraceModel *trm;
+	bool overflowed;
+
+	if ( numTraces <= 0 ) {
+		return;
+	}
+
+	idClip::numTraceBatches++;
+
+	batch.clip = this;
+	batch.traces = traces;
+	batch.numTraces = numTraces;
+	batch.numJobs = 1;
+	if ( numTraces >= 2 * TRACE_BATCH_JOB_SIZE ) {
+		batch.numJobs = Min( numTraces / TRACE_BATCH_JOB_SIZE, Min( jobSystem->GetNumThreads() * 4, MAX_TRACE_BATCH_JOBS ) );
+	}
+	memset( batch.numTranslations, 0, sizeof( batch.numTranslations ) );
+
+	// test the world
+	if ( batch.numJobs > 1 ) {
+		jobSystem->RunJobs( TraceBatchWorldJob, &batch, batch.numJobs );
+	} else {
+		TraceBatchWorldJob( &batch, 0 );
+	}
+
+	// gather the bounds of all translations that are not blocked immediately
+	batchBounds.Clear();
+	contentMask = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		clipTrace_t &tr = traces[i];
+		if ( tr.results.fraction == 0.0f ) {
+			continue;
+		}
+		if ( tr.bounds.IsCleared() ) {
+			traceBounds.FromPointTranslation( tr.start, tr.results.endpos - tr.start );
+		} else {
+			traceBounds.FromBoundsTranslation( tr.bounds, tr.start, mat3_identity, tr.results.endpos - tr.start );
+		}
+		batchBounds += traceBounds;
+		contentMask |= tr.contentMask;
+	}
+
+	if ( !batchBounds.IsCleared() ) {
+		num = ClipModelsTouchingBounds( batchBounds, contentMask, clipModelList, MAX_GENTITIES, &overflowed );
+		if ( overflowed ) {
+			// too many candidates for the whole batch, fall back to tracing one by one
+			loadedBounds.Clear();
+			for ( i = 0; i < numTraces; i++ ) {
+				clipTrace_t &tr = traces[i];
+				if ( tr.results.fraction == 0.0f ) {
+					continue;
+				}
+				trm = TraceModelForBatch( tr.bounds, loadedBounds );
+				Translation( tr.results, tr.start, tr.end, trm != NULL ? &temporaryClipModel : NULL, mat3_identity, tr.contentMask, tr.passEntity );
+			}
+		} else {
+			// clip each translation against the candidates that touch its own trace bounds
+			hitModels.SetNum( numTraces, false );
+			batch.hitModels = hitModels.Ptr();
+			batch.clipModelList = clipModelList;
+			batch.numClipModels = num;
+			if ( batch.numJobs > 1 ) {
+				jobSystem->RunJobs( TraceBatchModelsJob, &batch, batch.numJobs );
+			} else {
+				TraceBatchModelsJob( &batch, 0 );
+			}
+			for ( i = 0; i < numTraces; i++ ) {
+				idClip::numRenderModelTraces += TraceBatchModels( traces[i], NULL, clipModelList, num, true, hitModels[i] );
+			}
+		}
+	}
+
+	for ( i = 0; i < batch.numJobs; i++ ) {
+		idClip::numTranslations += batch.numTranslations[i];
+	}
+}
+
 /*
 ============
 idClip::Rotation
@@ -1613,10 +2430,13 @@ idClip::PrintStatistics
 ============
 */
 void idClip::PrintStatistics( void ) {
-	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
-					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
+	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d, batches = %-3d\n",
+					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts, numTraceBatches );
+	gameLocal.Printf( "%s: links = %-3d, %s = %-3d, queries = %-3d, nodes visited = %-3d\n",
+					useClipTree ? "tree" : "sectors", numLinks, useClipTree ? "inserts" : "sector links", numLinkNodes, numBoundsQueries, numQueryNodes );
 
-	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = numTraceBatches = 0;
+	numLinks = numLinkNodes = numBoundsQueries = numQueryNodes = 0;
 }
 
 /*
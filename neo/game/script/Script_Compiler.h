@@ -198,6 +198,26 @@ enum {
 	NUM_OPCODES
 };
 
+// superinstructions fuse a statement with the one following it.  they are never
+// emitted by the compiler, only set up when the statements are decoded.
+enum {
+	OP_EQ_F_IFNOT = NUM_OPCODES,
+	OP_NE_F_IFNOT,
+	OP_LT_IFNOT,
+	OP_LE_IFNOT,
+	OP_GT_IFNOT,
+	OP_GE_IFNOT,
+
+	OP_ADDRESS_STOREP_F,
+	OP_ADDRESS_STOREP_V,
+	OP_ADDRESS_STOREP_ENT,
+	OP_ADDRESS_STOREP_BOOL,
+
+	OP_PUSH_CALL,
+
+	NUM_SCRIPT_OPS
+};
+
 class idCompiler {
 private:
 	static bool			punctuationValid[ 256 ];
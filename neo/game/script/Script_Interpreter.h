@@ -69,9 +69,11 @@ private:
 	void				PushVector( const idVec3 &vector );
 	void				Push( intptr_t value );
 	const char			*FloatToString( float value );
-	void				AppendString( idVarDef *def, const char *from );
-	void				SetString( idVarDef *def, const char *from );
+	void				AppendString( const scriptInstruction_t *in, int operand, const char *from );
+	void				SetString( const scriptInstruction_t *in, int operand, const char *from );
+	const char			*GetString( const scriptInstruction_t *in, int operand );
 	const char			*GetString( idVarDef *def );
+	varEval_t			GetOperand( const scriptInstruction_t *in, int operand );
 	varEval_t			GetVariable( idVarDef *def );
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
@@ -194,28 +196,44 @@ ID_INLINE const char *idInterpreter::FloatToString( float value ) {
 
 /*
 ====================
-idInterpreter::AppendString
+idInterpreter::GetOperand
 ====================
 */
-ID_INLINE void idInterpreter::AppendString( idVarDef *def, const char *from ) {
-	if ( def->initialized == idVarDef::stackVariable ) {
-		idStr::Append( ( char* )&localstack[ localstackBase + def->value.stackOffset ], MAX_STRING_LEN, from );
+ID_INLINE varEval_t idInterpreter::GetOperand( const scriptInstruction_t *in, int operand ) {
+	if ( in->stackOperands & ( 1 << operand ) ) {
+		varEval_t val;
+		val.intPtr = ( int* )&localstack[ localstackBase + in->operand[ operand ].stackOffset ];
+		return val;
 	} else {
-		idStr::Append( def->value.stringPtr, MAX_STRING_LEN, from );
+		return in->operand[ operand ];
 	}
 }
 
+/*
+====================
+idInterpreter::AppendString
+====================
+*/
+ID_INLINE void idInterpreter::AppendString( const scriptInstruction_t *in, int operand, const char *from ) {
+	idStr::Append( GetOperand( in, operand ).stringPtr, MAX_STRING_LEN, from );
+}
+
 /*
 ====================
 idInterpreter::SetString
 ====================
 */
-ID_INLINE void idInterpreter::SetString( idVarDef *def, const char *from ) {
-	if ( def->initialized == idVarDef::stackVariable ) {
-		idStr::Copynz( ( char* )&localstack[ localstackBase + def->value.stackOffset ], from, MAX_STRING_LEN );
-	} else {
-		idStr::Copynz( def->value.stringPtr, from, MAX_STRING_LEN );
-	}
+ID_INLINE void idInterpreter::SetString( const scriptInstruction_t *in, int operand, const char *from ) {
+	idStr::Copynz( GetOperand( in, operand ).stringPtr, from, MAX_STRING_LEN );
+}
+
+/*
+====================
+idInterpreter::GetString
+====================
+*/
+ID_INLINE const char *idInterpreter::GetString( const scriptInstruction_t *in, int operand ) {
+	return GetOperand( in, operand ).stringPtr;
 }
 
 /*
@@ -96,6 +96,8 @@ typedef union eval_s {
 */
 
 class idTypeDef {
+	friend class idProgram;
+
 private:
 	etype_t						type;
 	idStr						name;
@@ -449,6 +451,51 @@ typedef struct statement_s {
 	idVarDef		*c;
 } statement_t;
 
+/*
+========================================================================
+
+	scriptInstruction_t
+
+	Statements are decoded into instructions once they are compiled.  The
+	operands are resolved to the address of a global, an immediate value or
+	an offset into the thread's local stack, so the interpreter doesn't have
+	to look at the idVarDefs while running.  Instructions parallel the
+	statements index for index, so instruction pointers and jump offsets
+	mean the same thing for both.
+
+========================================================================
+*/
+
+typedef struct scriptInstruction_s {
+	unsigned short	op[ 2 ];			// plain opcode, and the superinstruction starting here if any
+	unsigned short	stackOperands;		// bit n is set when operand n is an offset into the local stack
+	varEval_t		operand[ 3 ];
+} scriptInstruction_t;
+
+typedef struct scriptProfile_s {
+	int				function;			// function number
+	int				calls;
+	int				instructions;
+	unsigned int	usec;
+} scriptProfile_t;
+
+// how much of the program existed before a file was compiled, the script cache only stores what came after it
+typedef struct scriptCacheMark_s {
+	int				types;
+	int				defs;
+	int				functions;
+	int				statements;
+	int				variables;
+	int				files;
+	int				checksum;
+} scriptCacheMark_t;
+
+// what compiling a file could change in the program before its cache mark
+typedef struct scriptCacheSnapshot_s {
+	unsigned int	checksum;			// the older defs, functions and statements, apart from numUsers
+	idList<int>		numUsers;			// numUsers of the older defs, the cache replays changes to these
+} scriptCacheSnapshot_t;
+
 /*
 ========================================================================
 
@@ -473,6 +520,7 @@ private:
 	idStaticList<byte,MAX_GLOBALS>				variableDefaults;
 	idStaticList<function_t,MAX_FUNCS>			functions;
 	idStaticList<statement_t,MAX_STATEMENTS>	statements;
+	idList<scriptInstruction_t>					instructions;
 	idList<idTypeDef*>							types;
 	idList<idVarDefName*>						varDefNames;
 	idHashIndex									varDefNameHash;
@@ -486,7 +534,16 @@ private:
 	int											top_defs;
 	int											top_files;
 
+	bool										profiling;
+	idList<scriptProfile_t>						profile;			// indexed by function number
+
 	void										CompileStats( void );
+	void										DecodeStatements( void );
+	void										GetCacheMark( scriptCacheMark_t &mark ) const;
+	void										GetCacheSnapshot( const scriptCacheMark_t &mark, scriptCacheSnapshot_t &snapshot ) const;
+	bool										ReadCache( const char *filename, const scriptCacheMark_t &mark, unsigned int &compileMsec );
+	bool										ReadCacheData( const char *data, int length, const scriptCacheMark_t &mark, unsigned int &compileMsec );
+	bool										WriteCache( const char *filename, const scriptCacheMark_t &mark, const scriptCacheSnapshot_t &snapshot, unsigned int compileMsec ) const;
 	byte										*ReserveMem(int size);
 	idVarDef									*AllocVarDef(idTypeDef *type, const char *name, idVarDef *scope);
 
@@ -542,6 +599,13 @@ public:
 	statement_t									*AllocStatement( void );
 	statement_t									&GetStatement( int index );
 	int											NumStatements( void ) { return statements.Num(); }
+	const scriptInstruction_t					&GetInstruction( int index ) const;
+
+	void										StartProfile( void );
+	void										StopProfile( void );
+	bool										IsProfiling( void ) const { return profiling; }
+	scriptProfile_t								&GetProfile( const function_t *func );
+	void										PrintProfile( int numFunctions );
 
 	int											GetReturnedInteger( void );
 
@@ -563,6 +627,15 @@ ID_INLINE statement_t &idProgram::GetStatement( int index ) {
 	return statements[ index ];
 }
 
+/*
+================
+idProgram::GetInstruction
+================
+*/
+ID_INLINE const scriptInstruction_t &idProgram::GetInstruction( int index ) const {
+	return instructions[ index ];
+}
+
 /*
 ================
 idProgram::GetFunction
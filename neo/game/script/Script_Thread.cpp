@@ -210,6 +210,156 @@ int					idThread::threadIndex = 0;
 idList<idThread*>	idThread::threadList;
 trace_t				idThread::trace;
 
+/*
+========================================================================
+
+  Script scheduler
+
+  Threads that wait for a time are kept in a sleep queue ordered by wake time.
+  Going to sleep takes a sequence number from the event system, and
+  idEvent::ServiceEvents runs each due thread through idThread::ServiceNextThread
+  at the point its EV_Thread_Execute event used to be, so threads and events
+  still run in the order they were scheduled.  Threads waiting for an entity are
+  linked into that entity's wait list so a finished move only looks at its own
+  waiters.
+
+========================================================================
+*/
+
+class idThreadSleepQueue {
+public:
+	void					Clear( void );
+	int						Num( void ) const { return threads.Num(); }
+	idThread				*Top( void ) const { return threads.Num() ? threads[ 0 ] : NULL; }
+	void					Add( idThread *thread );
+	void					Remove( idThread *thread );
+
+private:
+	idList<idThread *>		threads;
+
+	static bool				Before( const idThread *a, const idThread *b );
+	void					MoveUp( idThread *thread, int index );
+	void					MoveDown( idThread *thread, int index );
+};
+
+static idThreadSleepQueue		sleepingThreads;
+static idLinkList<idThread>		entityWaitThreads[ MAX_GENTITIES ];
+
+/*
+================
+idThreadSleepQueue::Before
+================
+*/
+ID_INLINE bool idThreadSleepQueue::Before( const idThread *a, const idThread *b ) {
+	return ( a->wakeTime < b->wakeTime ) || ( ( a->wakeTime == b->wakeTime ) && ( a->wakeSequence < b->wakeSequence ) );
+}
+
+/*
+================
+idThreadSleepQueue::Clear
+================
+*/
+void idThreadSleepQueue::Clear( void ) {
+	int i;
+
+	for( i = 0; i < threads.Num(); i++ ) {
+		threads[ i ]->sleepIndex = -1;
+	}
+	threads.Clear();
+}
+
+/*
+================
+idThreadSleepQueue::MoveUp
+================
+*/
+void idThreadSleepQueue::MoveUp( idThread *thread, int index ) {
+	int parent;
+
+	while ( index > 0 ) {
+		parent = ( index - 1 ) >> 1;
+		if ( !Before( thread, threads[ parent ] ) ) {
+			break;
+		}
+		threads[ index ] = threads[ parent ];
+		threads[ index ]->sleepIndex = index;
+		index = parent;
+	}
+	threads[ index ] = thread;
+	thread->sleepIndex = index;
+}
+
+/*
+================
+idThreadSleepQueue::MoveDown
+================
+*/
+void idThreadSleepQueue::MoveDown( idThread *thread, int index ) {
+	int child;
+	int num;
+
+	num = threads.Num();
+	while ( 1 ) {
+		child = index * 2 + 1;
+		if ( child >= num ) {
+			break;
+		}
+		if ( child + 1 < num && Before( threads[ child + 1 ], threads[ child ] ) ) {
+			child++;
+		}
+		if ( !Before( threads[ child ], thread ) ) {
+			break;
+		}
+		threads[ index ] = threads[ child ];
+		threads[ index ]->sleepIndex = index;
+		index = child;
+	}
+	threads[ index ] = thread;
+	thread->sleepIndex = index;
+}
+
+/*
+================
+idThreadSleepQueue::Add
+================
+*/
+void idThreadSleepQueue::Add( idThread *thread ) {
+	assert( thread->sleepIndex == -1 );
+
+	threads.Append( thread );
+	MoveUp( thread, threads.Num() - 1 );
+}
+
+/*
+================
+idThreadSleepQueue::Remove
+================
+*/
+void idThreadSleepQueue::Remove( idThread *thread ) {
+	int			index;
+	int			num;
+	idThread	*last;
+
+	assert( thread->sleepIndex >= 0 && threads[ thread->sleepIndex ] == thread );
+
+	index = thread->sleepIndex;
+	thread->sleepIndex = -1;
+
+	num = threads.Num() - 1;
+	last = threads[ num ];
+	threads.SetNum( num, false );
+	if ( index == num ) {
+		return;
+	}
+
+	// move the last thread into the hole
+	if ( index > 0 && Before( last, threads[ ( index - 1 ) >> 1 ] ) ) {
+		MoveUp( last, index );
+	} else {
+		MoveDown( last, index );
+	}
+}
+
 /*
 ================
 idThread::CurrentThread
@@ -354,6 +504,9 @@ idThread::~idThread() {
 		}
 	}
 
+	Unschedule();
+	waitNode.Remove();
+
 	if ( currentThread == this ) {
 		currentThread = NULL;
 	}
@@ -392,6 +545,9 @@ void idThread::Save( idSaveGame *savefile ) const {
 	savefile->WriteInt( creationTime );
 
 	savefile->WriteBool( manualControl );
+
+	savefile->WriteInt( wakeTime );
+	idEvent::SaveSequence( savefile, wakeSequence );
 }
 
 /*
@@ -407,6 +563,10 @@ void idThread::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( waitingFor );
 	savefile->ReadInt( waitingUntil );
 
+	if ( ( waitingFor != ENTITYNUM_NONE ) && ( waitingFor >= 0 ) && ( waitingFor < MAX_GENTITIES ) ) {
+		waitNode.AddToEnd( entityWaitThreads[ waitingFor ] );
+	}
+
 	interpreter.Restore( savefile );
 
 	savefile->ReadDict( &spawnArgs );
@@ -416,6 +576,18 @@ void idThread::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( creationTime );
 
 	savefile->ReadBool( manualControl );
+
+	// older save games have an EV_Thread_Execute event pending instead
+	if ( savefile->GetInternalSavegameVersion() >= 2 ) {
+		int time;
+
+		savefile->ReadInt( time );
+		idEvent::RestoreSequence( savefile, wakeSequence );
+		if ( time >= 0 ) {
+			wakeTime = time;
+			sleepingThreads.Add( this );
+		}
+	}
 }
 
 /*
@@ -439,6 +611,14 @@ void idThread::Init( void ) {
 	lastExecuteTime = 0;
 	manualControl = false;
 
+	wakeTime = -1;
+	wakeSequence = 0;
+	sleepIndex = -1;
+	waitNode.SetOwner( this );
+
+	executeUsec = 0;
+	executeCount = 0;
+
 	ClearWaitFor();
 
 	interpreter.SetThread( this );
@@ -510,15 +690,40 @@ idThread::ListThreads_f
 ================
 */
 void idThread::ListThreads_f( const idCmdArgs &args ) {
-	int	i;
-	int	n;
+	int			i;
+	int			n;
+	int			numRunnable;
+	int			numSleeping;
+	int			numWaiting;
+	int			numManual;
+	const char	*state;
+	idThread	*thread;
+
+	numRunnable = numSleeping = numWaiting = numManual = 0;
 
 	n = threadList.Num();
 	for( i = 0; i < n; i++ ) {
-		//threadList[ i ]->DisplayInfo();
-		gameLocal.Printf( "%3i: %-20s : %s(%d)\n", threadList[ i ]->threadNum, threadList[ i ]->threadName.c_str(), threadList[ i ]->interpreter.CurrentFile(), threadList[ i ]->interpreter.CurrentLine() );
+		thread = threadList[ i ];
+		//thread->DisplayInfo();
+		if ( thread->wakeTime >= 0 && thread->wakeTime <= gameLocal.time ) {
+			state = "ready";
+			numRunnable++;
+		} else if ( thread->wakeTime >= 0 ) {
+			state = "sleeping";
+			numSleeping++;
+		} else if ( thread->waitingForThread || ( thread->waitingFor != ENTITYNUM_NONE ) ) {
+			state = "waiting";
+			numWaiting++;
+		} else if ( thread->manualControl ) {
+			state = "manual";
+			numManual++;
+		} else {
+			state = "idle";
+		}
+		gameLocal.Printf( "%3i: %-20s : %-8s %8.2f ms %6d runs : %s(%d)\n", thread->threadNum, thread->threadName.c_str(), state,
+			thread->executeUsec * 0.001f, thread->executeCount, thread->interpreter.CurrentFile(), thread->interpreter.CurrentLine() );
 	}
-	gameLocal.Printf( "%d active threads\n\n", n );
+	gameLocal.Printf( "%d active threads, %d runnable, %d sleeping, %d waiting, %d manual\n\n", n, numRunnable, numSleeping, numWaiting, numManual );
 }
 
 /*
@@ -540,6 +745,11 @@ void idThread::Restart( void ) {
 	}
 	threadList.Clear();
 
+	sleepingThreads.Clear();
+	for( i = 0; i < MAX_GENTITIES; i++ ) {
+		entityWaitThreads[ i ].Clear();
+	}
+
 	memset( &trace, 0, sizeof( trace ) );
 	trace.c.entityNum = ENTITYNUM_NONE;
 }
@@ -550,11 +760,11 @@ idThread::DelayedStart
 ================
 */
 void idThread::DelayedStart( int delay ) {
-	CancelEvents( &EV_Thread_Execute );
 	if ( gameLocal.time <= 0 ) {
 		delay++;
 	}
-	PostEventMS( &EV_Thread_Execute, delay );
+	// same time base as the EV_Thread_Execute event this replaces
+	Schedule( gameLocal.slow.time + delay );
 }
 
 /*
@@ -565,7 +775,7 @@ idThread::Start
 bool idThread::Start( void ) {
 	bool result;
 
-	CancelEvents( &EV_Thread_Execute );
+	Unschedule();
 	result = Execute();
 
 	return result;
@@ -592,10 +802,61 @@ void idThread::ObjectMoveDone( int threadnum, idEntity *obj ) {
 		return;
 	}
 
-	thread = GetThread( threadnum );
-	if ( thread ) {
-		thread->ObjectMoveDone( obj );
+	// only the threads waiting for obj can be woken up by it
+	for( thread = entityWaitThreads[ obj->entityNumber ].Next(); thread != NULL; thread = thread->waitNode.Next() ) {
+		if ( thread->threadNum == threadnum ) {
+			thread->ObjectMoveDone( obj );
+			break;
+		}
+	}
+}
+
+/*
+================
+idThread::Schedule
+================
+*/
+void idThread::Schedule( int time ) {
+	Unschedule();
+	wakeTime = time;
+	wakeSequence = idEvent::NextSequence();
+	sleepingThreads.Add( this );
+}
+
+/*
+================
+idThread::Unschedule
+================
+*/
+void idThread::Unschedule( void ) {
+	if ( sleepIndex >= 0 ) {
+		sleepingThreads.Remove( this );
+	}
+	wakeTime = -1;
+}
+
+/*
+================
+idThread::ServiceNextThread
+
+Runs the first sleeping thread if it went to sleep before an event scheduled for
+time with the given sequence.  Returns false if there is no such thread.
+================
+*/
+bool idThread::ServiceNextThread( int time, int64_t sequence ) {
+	idThread *thread;
+
+	thread = sleepingThreads.Top();
+	if ( thread == NULL ) {
+		return false;
+	}
+	if ( ( thread->wakeTime > time ) || ( ( thread->wakeTime == time ) && ( thread->wakeSequence >= sequence ) ) ) {
+		return false;
 	}
+
+	thread->Unschedule();
+	thread->Execute();
+	return true;
 }
 
 /*
@@ -660,19 +921,25 @@ idThread::Execute
 ================
 */
 bool idThread::Execute( void ) {
-	idThread	*oldThread;
-	bool		done;
+	idThread		*oldThread;
+	bool			done;
+	unsigned int	startUsec;
 
 	if ( manualControl && ( waitingUntil > gameLocal.time ) ) {
 		return false;
 	}
 
+	Unschedule();
+
 	oldThread = currentThread;
 	currentThread = this;
 
 	lastExecuteTime = gameLocal.time;
 	ClearWaitFor();
+	startUsec = idLib::sys->GetMicroseconds();
 	done = interpreter.Execute();
+	executeUsec += idLib::sys->GetMicroseconds() - startUsec;
+	executeCount++;
 	if ( done ) {
 		End();
 		if ( interpreter.terminateOnExit ) {
@@ -680,9 +947,9 @@ bool idThread::Execute( void ) {
 		}
 	} else if ( !manualControl ) {
 		if ( waitingUntil > lastExecuteTime ) {
-			PostEventMS( &EV_Thread_Execute, waitingUntil - lastExecuteTime );
+			Schedule( gameLocal.slow.time + waitingUntil - lastExecuteTime );
 		} else if ( interpreter.MultiFrameEventInProgress() ) {
-			PostEventMS( &EV_Thread_Execute, gameLocal.msec );
+			Schedule( gameLocal.slow.time + gameLocal.msec );
 		}
 	}
 
@@ -744,6 +1011,7 @@ void idThread::ClearWaitFor( void ) {
 	waitingFor			= ENTITYNUM_NONE;
 	waitingForThread	= NULL;
 	waitingUntil		= 0;
+	waitNode.Remove();
 }
 
 /*
@@ -877,6 +1145,8 @@ void idThread::ReturnEntity( idEntity *ent ) {
 /*
 ================
 idThread::Event_Execute
+
+Threads are resumed by the scheduler now, this is only posted by older save games.
 ================
 */
 void idThread::Event_Execute( void ) {
@@ -983,6 +1253,7 @@ void idThread::Event_WaitFor( idEntity *ent ) {
 		if ( gameLocal.program.GetReturnedInteger() ) {
 			Pause();
 			waitingFor = ent->entityNumber;
+			waitNode.AddToEnd( entityWaitThreads[ waitingFor ] );
 		}
 	}
 }
@@ -44,6 +44,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "idlib/math/Simd_SSE2.h"
 #include "idlib/math/Simd_SSE3.h"
 #include "idlib/math/Simd_AltiVec.h"
+#include "idlib/math/Simd_Intrin.h"
 #include "idlib/math/Plane.h"
 #include "idlib/bv/Bounds.h"
 #include "idlib/Lib.h"
@@ -88,6 +89,14 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 		if ( !processor ) {
 			if ( ( cpuid & CPUID_ALTIVEC ) ) {
 				processor = new idSIMD_AltiVec;
+#ifdef ID_SIMD_INTRIN
+			} else if ( ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE41 ) && ( cpuid & CPUID_AVX2 ) ) {
+				processor = new idSIMD_AVX2_Intrin;
+			} else if ( ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE41 ) ) {
+				processor = new idSIMD_SSE41_Intrin;
+			} else if ( ( cpuid & CPUID_SSE2 ) ) {
+				processor = new idSIMD_SSE2_Intrin;
+#endif
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) ) {
 				processor = new idSIMD_SSE3;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) ) {
@@ -187,6 +196,22 @@ double ticksPerNanosecond;
 #define StopRecordTime( end )				\
 	end = mach_absolute_time();
 
+#elif defined(__GNUC__) && ( defined(__i386__) || defined(__x86_64__) )
+
+#include <x86intrin.h>
+
+#define TIME_TYPE int
+
+#define StartRecordTime( start )			\
+	_mm_lfence();							\
+	start = (int) __rdtsc();				\
+	_mm_lfence();
+
+#define StopRecordTime( end )				\
+	_mm_lfence();							\
+	end = (int) __rdtsc();					\
+	_mm_lfence();
+
 #else
 
 #define TIME_TYPE int
@@ -2758,6 +2783,12 @@ void TestDeriveTriPlanes( void ) {
 		drawVerts2[i] = drawVerts1[i];
 	}
 
+	// collapse every 16th vertex onto the previous one so some triangles have no area
+	for ( i = 1; i < COUNT; i += 16 ) {
+		drawVerts1[i].xyz = drawVerts1[i-1].xyz;
+		drawVerts2[i].xyz = drawVerts1[i].xyz;
+	}
+
 	for ( i = 0; i < COUNT; i++ ) {
 		indexes[i*3+0] = ( i + 0 ) % COUNT;
 		indexes[i*3+1] = ( i + 1 ) % COUNT;
@@ -2782,6 +2813,9 @@ void TestDeriveTriPlanes( void ) {
 	}
 
 	for ( i = 0; i < COUNT; i++ ) {
+		if ( FLOAT_IS_NAN( planes2[i][0] ) || FLOAT_IS_NAN( planes2[i][3] ) ) {
+			break;
+		}
 		if ( !planes1[i].Compare( planes2[i], 1e-1f, 1e-1f ) ) {
 			break;
 		}
@@ -2817,6 +2851,12 @@ void TestDeriveTangents( void ) {
 		drawVerts2[i] = drawVerts1[i];
 	}
 
+	// collapse every 16th vertex onto the previous one so some triangles have no area
+	for ( i = 1; i < COUNT; i += 16 ) {
+		drawVerts1[i].xyz = drawVerts1[i-1].xyz;
+		drawVerts2[i].xyz = drawVerts1[i].xyz;
+	}
+
 	for ( i = 0; i < COUNT; i++ ) {
 		indexes[i*3+0] = ( i + 0 ) % COUNT;
 		indexes[i*3+1] = ( i + 1 ) % COUNT;
@@ -2843,6 +2883,10 @@ void TestDeriveTangents( void ) {
 	for ( i = 0; i < COUNT; i++ ) {
 		idVec3 v1, v2;
 
+		if ( FLOAT_IS_NAN( drawVerts2[i].normal[0] ) || FLOAT_IS_NAN( drawVerts2[i].tangents[0][0] ) || FLOAT_IS_NAN( drawVerts2[i].tangents[1][0] ) ) {
+			idLib::common->Printf( "DeriveTangents: NaN at vertex %i\n", i );
+			break;
+		}
 		v1 = drawVerts1[i].normal;
 		v1.Normalize();
 		v2 = drawVerts2[i].normal;
@@ -2975,6 +3019,12 @@ void TestNormalizeTangents( void ) {
 		drawVerts2[i] = drawVerts1[i];
 	}
 
+	// zero length normals, as left behind by triangles without area
+	for ( i = 0; i < COUNT; i += 16 ) {
+		drawVerts1[i].normal.Zero();
+		drawVerts2[i].normal.Zero();
+	}
+
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
@@ -2993,6 +3043,9 @@ void TestNormalizeTangents( void ) {
 	}
 
 	for ( i = 0; i < COUNT; i++ ) {
+		if ( FLOAT_IS_NAN( drawVerts2[i].normal[0] ) ) {
+			break;
+		}
 		if ( !drawVerts1[i].normal.Compare( drawVerts2[i].normal, 1e-2f ) ) {
 			break;
 		}
@@ -4044,8 +4097,32 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 				return;
 			}
 			p_simd = new idSIMD_AltiVec();
+#ifdef ID_SIMD_INTRIN
+		} else if ( idStr::Icmp( argString, "SSE2Intrin" ) == 0 ) {
+			if ( !( cpuid & CPUID_SSE2 ) ) {
+				common->Printf( "CPU does not support SSE2\n" );
+				return;
+			}
+			p_simd = new idSIMD_SSE2_Intrin();
+		} else if ( idStr::Icmp( argString, "SSE41Intrin" ) == 0 ) {
+			if ( !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE41 ) ) {
+				common->Printf( "CPU does not support SSE2 & SSE4.1\n" );
+				return;
+			}
+			p_simd = new idSIMD_SSE41_Intrin();
+		} else if ( idStr::Icmp( argString, "AVX2Intrin" ) == 0 ) {
+			if ( !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE41 ) || !( cpuid & CPUID_AVX2 ) ) {
+				common->Printf( "CPU does not support SSE2 & SSE4.1 & AVX2\n" );
+				return;
+			}
+			p_simd = new idSIMD_AVX2_Intrin();
+#endif
 		} else {
-			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n" );
+			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec"
+#ifdef ID_SIMD_INTRIN
+							", SSE2Intrin, SSE41Intrin, AVX2Intrin"
+#endif
+							"\n" );
 			return;
 		}
 	}
@@ -0,0 +1,2752 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code ("Doom 3 Source Code").
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "sys/platform.h"
+#include "idlib/geometry/DrawVert.h"
+#include "idlib/geometry/JointTransform.h"
+#include "idlib/math/Vector.h"
+#include "idlib/math/Plane.h"
+#include "idlib/math/Matrix.h"
+#include "renderer/Model.h"
+
+#include "idlib/math/Simd_Intrin.h"
+
+//===============================================================
+//
+//	x86 intrinsics implementation of idSIMDProcessor
+//
+//===============================================================
+
+#ifdef ID_SIMD_INTRIN
+
+#include <float.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__)
+#define ID_TARGET_SSE41		__attribute__ ((target ("sse4.1")))
+#define ID_TARGET_AVX2		__attribute__ ((target ("avx2")))
+#else
+#define ID_TARGET_SSE41
+#define ID_TARGET_AVX2
+#endif
+
+#define SPLAT( x, i )		_mm_shuffle_ps( x, x, _MM_SHUFFLE( i, i, i, i ) )
+
+// process four floats at a time and the remainder one at a time
+#define UNROLL_SSE( OPER4, OPER1 )		{ int _IX, _NM = count & ~3; for ( _IX = 0; _IX < _NM; _IX += 4 ) { OPER4( _IX ) } for ( ; _IX < count; _IX++ ) { OPER1( _IX ) } }
+#define UNROLL_AVX( OPER8, OPER1 )		{ int _IX, _NM = count & ~7; for ( _IX = 0; _IX < _NM; _IX += 8 ) { OPER8( _IX ) } for ( ; _IX < count; _IX++ ) { OPER1( _IX ) } }
+
+ALIGN16( static const unsigned int SIMD_SP_signBit[4] ) = { 0x80000000, 0x80000000, 0x80000000, 0x80000000 };
+ALIGN16( static const unsigned int SIMD_SP_absMask[4] ) = { 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF };
+ALIGN16( static const unsigned int SIMD_SP_lastOne[4] ) = { 0x00000000, 0x00000000, 0x00000000, 0x3F800000 };
+
+/*
+============
+LoadVec3
+
+  loads x, y, z without reading past the vector, w is set to zero
+============
+*/
+static ID_INLINE __m128 LoadVec3( const float *p ) {
+	return _mm_movelh_ps( _mm_castpd_ps( _mm_load_sd( (const double *)p ) ), _mm_load_ss( p + 2 ) );
+}
+
+/*
+============
+StoreVec3
+============
+*/
+static ID_INLINE void StoreVec3( float *p, const __m128 v ) {
+	_mm_storel_pi( (__m64 *)p, v );
+	_mm_store_ss( p + 2, _mm_movehl_ps( v, v ) );
+}
+
+/*
+============
+LoadVec3x4
+
+  loads four vectors from an array of structures and transposes them
+============
+*/
+static ID_INLINE void LoadVec3x4( const float *p0, const float *p1, const float *p2, const float *p3, __m128 &x, __m128 &y, __m128 &z ) {
+	__m128 r0 = LoadVec3( p0 );
+	__m128 r1 = LoadVec3( p1 );
+	__m128 r2 = LoadVec3( p2 );
+	__m128 r3 = LoadVec3( p3 );
+	_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+	x = r0;
+	y = r1;
+	z = r2;
+}
+
+/*
+============
+StoreVec3x4
+
+  transposes x, y, z and stores four vectors into an array of structures
+============
+*/
+static ID_INLINE void StoreVec3x4( float *p0, float *p1, float *p2, float *p3, const __m128 &x, const __m128 &y, const __m128 &z ) {
+	__m128 r0 = x;
+	__m128 r1 = y;
+	__m128 r2 = z;
+	__m128 r3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+	StoreVec3( p0, r0 );
+	StoreVec3( p1, r1 );
+	StoreVec3( p2, r2 );
+	StoreVec3( p3, r3 );
+}
+
+/*
+============
+LoadPackedVec3x4
+
+  loads four tightly packed idVec3 and converts them to x, y, z
+============
+*/
+static ID_INLINE void LoadPackedVec3x4( const float *p, __m128 &x, __m128 &y, __m128 &z ) {
+	__m128 v0 = _mm_loadu_ps( p + 0 );		// x0 y0 z0 x1
+	__m128 v1 = _mm_loadu_ps( p + 4 );		// y1 z1 x2 y2
+	__m128 v2 = _mm_loadu_ps( p + 8 );		// z2 x3 y3 z3
+	__m128 t0, t1;
+
+	t0 = _mm_shuffle_ps( v1, v2, _MM_SHUFFLE( 1, 1, 2, 2 ) );
+	x = _mm_shuffle_ps( v0, t0, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+	t0 = _mm_shuffle_ps( v0, v1, _MM_SHUFFLE( 0, 0, 1, 1 ) );
+	t1 = _mm_shuffle_ps( v1, v2, _MM_SHUFFLE( 2, 2, 3, 3 ) );
+	y = _mm_shuffle_ps( t0, t1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+	t0 = _mm_shuffle_ps( v0, v1, _MM_SHUFFLE( 1, 1, 2, 2 ) );
+	t1 = _mm_shuffle_ps( v2, v2, _MM_SHUFFLE( 3, 3, 0, 0 ) );
+	z = _mm_shuffle_ps( t0, t1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+}
+
+/*
+============
+HorizontalSum
+
+  returns the sum of all four components in the lowest component
+============
+*/
+static ID_INLINE __m128 HorizontalSum( const __m128 v ) {
+	__m128 t = _mm_add_ps( v, _mm_movehl_ps( v, v ) );
+	return _mm_add_ss( t, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+}
+
+/*
+============
+ReciprocalSqrt
+
+  one Newton-Raphson iteration on top of the hardware estimate,
+  zero is clamped to FLT_MIN so it gives a huge finite value like idMath::RSqrt instead of NaN
+============
+*/
+static ID_INLINE __m128 ReciprocalSqrt( const __m128 v ) {
+	__m128 x = _mm_max_ps( v, _mm_set1_ps( FLT_MIN ) );
+	__m128 r = _mm_rsqrt_ps( x );
+	__m128 rr = _mm_mul_ps( _mm_mul_ps( x, r ), r );
+	return _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5f ), r ), _mm_sub_ps( _mm_set1_ps( 3.0f ), rr ) );
+}
+
+/*
+============
+DotArray
+
+  dot product of two arrays of floats
+============
+*/
+static ID_INLINE float DotArray( const float *src0, const float *src1, const int count ) {
+	__m128 s0 = _mm_setzero_ps();
+	__m128 s1 = _mm_setzero_ps();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( src0 + i + 0 ), _mm_loadu_ps( src1 + i + 0 ) ) );
+		s1 = _mm_add_ps( s1, _mm_mul_ps( _mm_loadu_ps( src0 + i + 4 ), _mm_loadu_ps( src1 + i + 4 ) ) );
+	}
+	if ( i + 4 <= count ) {
+		s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) );
+		i += 4;
+	}
+	float sum = _mm_cvtss_f32( HorizontalSum( _mm_add_ps( s0, s1 ) ) );
+	for ( ; i < count; i++ ) {
+		sum += src0[i] * src1[i];
+	}
+	return sum;
+}
+
+/*
+============
+MultiplyAdd
+
+  dst[i] += constant * src[i];
+============
+*/
+static ID_INLINE void MultiplyAdd( float *dst, const float constant, const float *src, const int count ) {
+	__m128 c = _mm_set1_ps( constant );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( c, _mm_loadu_ps( src + (X) ) ) ) );
+#define OPER1(X) dst[(X)] += constant * src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::GetName
+============
+*/
+const char * idSIMD_SSE2_Intrin::GetName( void ) const {
+	return "SSE2 (intrinsics)";
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Add
+
+  dst[i] = constant + src[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Add( float *dst, const float constant, const float *src, const int count ) {
+	__m128 c = _mm_set1_ps( constant );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( src + (X) ), c ) );
+#define OPER1(X) dst[(X)] = src[(X)] + constant;
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Add
+
+  dst[i] = src0[i] + src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Add( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] + src1[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Sub
+
+  dst[i] = constant - src[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Sub( float *dst, const float constant, const float *src, const int count ) {
+	__m128 c = _mm_set1_ps( constant );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( c, _mm_loadu_ps( src + (X) ) ) );
+#define OPER1(X) dst[(X)] = constant - src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Sub
+
+  dst[i] = src0[i] - src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Sub( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] - src1[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Mul
+
+  dst[i] = constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Mul( float *dst, const float constant, const float *src, const int count ) {
+	__m128 c = _mm_set1_ps( constant );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_mul_ps( c, _mm_loadu_ps( src + (X) ) ) );
+#define OPER1(X) dst[(X)] = constant * src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Mul
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Mul( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_mul_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] * src1[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Div
+
+  dst[i] = constant / divisor[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Div( float *dst, const float constant, const float *divisor, const int count ) {
+	__m128 c = _mm_set1_ps( constant );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_div_ps( c, _mm_loadu_ps( divisor + (X) ) ) );
+#define OPER1(X) dst[(X)] = constant / divisor[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Div
+
+  dst[i] = src0[i] / src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Div( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_div_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] / src1[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MulAdd
+
+  dst[i] += constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MulAdd( float *dst, const float constant, const float *src, const int count ) {
+	MultiplyAdd( dst, constant, src, count );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MulAdd
+
+  dst[i] += src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MulAdd( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) ) );
+#define OPER1(X) dst[(X)] += src0[(X)] * src1[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MulSub
+
+  dst[i] -= constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MulSub( float *dst, const float constant, const float *src, const int count ) {
+	__m128 c = _mm_set1_ps( constant );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( c, _mm_loadu_ps( src + (X) ) ) ) );
+#define OPER1(X) dst[(X)] -= constant * src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MulSub
+
+  dst[i] -= src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MulSub( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) ) );
+#define OPER1(X) dst[(X)] -= src0[(X)] * src1[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idVec3 &constant, const idVec3 *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant.x );
+	const __m128 cy = _mm_set1_ps( constant.y );
+	const __m128 cz = _mm_set1_ps( constant.z );
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x, y, z;
+		LoadPackedVec3x4( src[i].ToFloatPtr(), x, y, z );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = constant * src[i].Normal() + src[i][3];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idVec3 &constant, const idPlane *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant.x );
+	const __m128 cy = _mm_set1_ps( constant.y );
+	const __m128 cz = _mm_set1_ps( constant.z );
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x = _mm_loadu_ps( src[i+0].ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( src[i+1].ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( src[i+2].ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( src[i+3].ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), w );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].Normal() + src[i][3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = constant * src[i].xyz;
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idVec3 &constant, const idDrawVert *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant.x );
+	const __m128 cy = _mm_set1_ps( constant.y );
+	const __m128 cz = _mm_set1_ps( constant.z );
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x, y, z;
+		LoadVec3x4( src[i+0].xyz.ToFloatPtr(), src[i+1].xyz.ToFloatPtr(), src[i+2].xyz.ToFloatPtr(), src[i+3].xyz.ToFloatPtr(), x, y, z );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].xyz;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = constant.Normal() * src[i] + constant[3];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idPlane &constant, const idVec3 *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x, y, z;
+		LoadPackedVec3x4( src[i].ToFloatPtr(), x, y, z );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), cw );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i] + constant[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idPlane &constant, const idPlane *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x = _mm_loadu_ps( src[i+0].ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( src[i+1].ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( src[i+2].ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( src[i+3].ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), _mm_mul_ps( cw, w ) );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = constant.Normal() * src[i].xyz + constant[3];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idPlane &constant, const idDrawVert *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x, y, z;
+		LoadVec3x4( src[i+0].xyz.ToFloatPtr(), src[i+1].xyz.ToFloatPtr(), src[i+2].xyz.ToFloatPtr(), src[i+3].xyz.ToFloatPtr(), x, y, z );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), cw );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i].xyz + constant[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float *dst, const idVec3 *src0, const idVec3 *src1, const int count ) {
+	const int count4 = count & ~3;
+	int i;
+
+	for ( i = 0; i < count4; i += 4 ) {
+		__m128 x0, y0, z0, x1, y1, z1;
+		LoadPackedVec3x4( src0[i].ToFloatPtr(), x0, y0, z0 );
+		LoadPackedVec3x4( src1[i].ToFloatPtr(), x1, y1, z1 );
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x0, x1 ), _mm_mul_ps( y0, y1 ) ), _mm_mul_ps( z0, z1 ) );
+		_mm_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] * src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Dot
+
+  dot = src1[0] * src2[0] + src1[1] * src2[1] + src1[2] * src2[2] + ...
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Dot( float &dot, const float *src1, const float *src2, const int count ) {
+	dot = DotArray( src1, src2, count );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::CmpGT
+
+  dst[i] = src0[i] > constant;
+  dst[i] |= ( src0[i] > constant ) << bitNum;
+
+  The comparison masks of 16 floats are packed to 16 bytes at a time.
+============
+*/
+#define COMPARE16( CMPPS, OP )																		\
+	const __m128 c = _mm_set1_ps( constant );														\
+	const int count16 = count & ~15;																\
+	int i;																							\
+	for ( i = 0; i < count16; i += 16 ) {															\
+		__m128i m0 = _mm_castps_si128( CMPPS( _mm_loadu_ps( src0 + i +  0 ), c ) );				\
+		__m128i m1 = _mm_castps_si128( CMPPS( _mm_loadu_ps( src0 + i +  4 ), c ) );				\
+		__m128i m2 = _mm_castps_si128( CMPPS( _mm_loadu_ps( src0 + i +  8 ), c ) );				\
+		__m128i m3 = _mm_castps_si128( CMPPS( _mm_loadu_ps( src0 + i + 12 ), c ) );				\
+		__m128i m = _mm_packs_epi16( _mm_packs_epi32( m0, m1 ), _mm_packs_epi32( m2, m3 ) );		\
+		STORE16( i, m )																				\
+	}																								\
+	for ( ; i < count; i++ ) {																		\
+		STORE1( i, src0[i] OP constant )															\
+	}
+
+#define STORE16( X, M )		_mm_storeu_si128( (__m128i *)( dst + (X) ), _mm_and_si128( (M), _mm_set1_epi8( 1 ) ) );
+#define STORE1( X, B )		dst[(X)] = (B);
+
+void VPCALL idSIMD_SSE2_Intrin::CmpGT( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmpgt_ps, > )
+}
+
+void VPCALL idSIMD_SSE2_Intrin::CmpGE( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmpge_ps, >= )
+}
+
+void VPCALL idSIMD_SSE2_Intrin::CmpLT( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmplt_ps, < )
+}
+
+void VPCALL idSIMD_SSE2_Intrin::CmpLE( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmple_ps, <= )
+}
+
+#undef STORE1
+#undef STORE16
+
+#define STORE16( X, M )		_mm_storeu_si128( (__m128i *)( dst + (X) ), _mm_or_si128( _mm_loadu_si128( (__m128i *)( dst + (X) ) ), _mm_and_si128( (M), _mm_set1_epi8( (char)( 1 << bitNum ) ) ) ) );
+#define STORE1( X, B )		dst[(X)] |= (B) << bitNum;
+
+void VPCALL idSIMD_SSE2_Intrin::CmpGT( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmpgt_ps, > )
+}
+
+void VPCALL idSIMD_SSE2_Intrin::CmpGE( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmpge_ps, >= )
+}
+
+void VPCALL idSIMD_SSE2_Intrin::CmpLT( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmplt_ps, < )
+}
+
+void VPCALL idSIMD_SSE2_Intrin::CmpLE( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPARE16( _mm_cmple_ps, <= )
+}
+
+#undef STORE1
+#undef STORE16
+#undef COMPARE16
+
+/*
+============
+idSIMD_SSE2_Intrin::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MinMax( float &min, float &max, const float *src, const int count ) {
+	__m128 vmin = _mm_set1_ps( idMath::INFINITY );
+	__m128 vmax = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 v = _mm_loadu_ps( src + i );
+		vmin = _mm_min_ps( vmin, v );
+		vmax = _mm_max_ps( vmax, v );
+	}
+	for ( ; i < count; i++ ) {
+		__m128 v = _mm_load_ss( src + i );
+		vmin = _mm_min_ss( vmin, v );
+		vmax = _mm_max_ss( vmax, v );
+	}
+	vmin = _mm_min_ps( vmin, _mm_movehl_ps( vmin, vmin ) );
+	vmax = _mm_max_ps( vmax, _mm_movehl_ps( vmax, vmax ) );
+	vmin = _mm_min_ss( vmin, SPLAT( vmin, 1 ) );
+	vmax = _mm_max_ss( vmax, SPLAT( vmax, 1 ) );
+	_mm_store_ss( &min, vmin );
+	_mm_store_ss( &max, vmax );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MinMax( idVec2 &min, idVec2 &max, const idVec2 *src, const int count ) {
+	__m128 vmin = _mm_set1_ps( idMath::INFINITY );
+	__m128 vmax = _mm_set1_ps( -idMath::INFINITY );
+	const float *p = src->ToFloatPtr();
+	int i;
+
+	for ( i = 0; i + 2 <= count; i += 2 ) {
+		__m128 v = _mm_loadu_ps( p + i * 2 );
+		vmin = _mm_min_ps( vmin, v );
+		vmax = _mm_max_ps( vmax, v );
+	}
+	if ( i < count ) {
+		__m128 v = _mm_castpd_ps( _mm_load_sd( (const double *)( p + i * 2 ) ) );
+		v = _mm_movelh_ps( v, v );
+		vmin = _mm_min_ps( vmin, v );
+		vmax = _mm_max_ps( vmax, v );
+	}
+	vmin = _mm_min_ps( vmin, _mm_movehl_ps( vmin, vmin ) );
+	vmax = _mm_max_ps( vmax, _mm_movehl_ps( vmax, vmax ) );
+	_mm_storel_pi( (__m64 *)min.ToFloatPtr(), vmin );
+	_mm_storel_pi( (__m64 *)max.ToFloatPtr(), vmax );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MinMax( idVec3 &min, idVec3 &max, const idVec3 *src, const int count ) {
+	__m128 vmin = _mm_set1_ps( idMath::INFINITY );
+	__m128 vmax = _mm_set1_ps( -idMath::INFINITY );
+
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = LoadVec3( src[i].ToFloatPtr() );
+		vmin = _mm_min_ps( vmin, v );
+		vmax = _mm_max_ps( vmax, v );
+	}
+	StoreVec3( min.ToFloatPtr(), vmin );
+	StoreVec3( max.ToFloatPtr(), vmax );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int count ) {
+	__m128 vmin = _mm_set1_ps( idMath::INFINITY );
+	__m128 vmax = _mm_set1_ps( -idMath::INFINITY );
+
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = LoadVec3( src[i].xyz.ToFloatPtr() );
+		vmin = _mm_min_ps( vmin, v );
+		vmax = _mm_max_ps( vmax, v );
+	}
+	StoreVec3( min.ToFloatPtr(), vmin );
+	StoreVec3( max.ToFloatPtr(), vmax );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int *indexes, const int count ) {
+	__m128 vmin = _mm_set1_ps( idMath::INFINITY );
+	__m128 vmax = _mm_set1_ps( -idMath::INFINITY );
+
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = LoadVec3( src[indexes[i]].xyz.ToFloatPtr() );
+		vmin = _mm_min_ps( vmin, v );
+		vmax = _mm_max_ps( vmax, v );
+	}
+	StoreVec3( min.ToFloatPtr(), vmin );
+	StoreVec3( max.ToFloatPtr(), vmax );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Clamp
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Clamp( float *dst, const float *src, const float min, const float max, const int count ) {
+	const __m128 vmin = _mm_set1_ps( min );
+	const __m128 vmax = _mm_set1_ps( max );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + (X) ), vmin ), vmax ) );
+#define OPER1(X) dst[(X)] = src[(X)] < min ? min : src[(X)] > max ? max : src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::ClampMin
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::ClampMin( float *dst, const float *src, const float min, const int count ) {
+	const __m128 vmin = _mm_set1_ps( min );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_max_ps( _mm_loadu_ps( src + (X) ), vmin ) );
+#define OPER1(X) dst[(X)] = src[(X)] < min ? min : src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::ClampMax
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::ClampMax( float *dst, const float *src, const float max, const int count ) {
+	const __m128 vmax = _mm_set1_ps( max );
+#define OPER4(X) _mm_storeu_ps( dst + (X), _mm_min_ps( _mm_loadu_ps( src + (X) ), vmax ) );
+#define OPER1(X) dst[(X)] = src[(X)] > max ? max : src[(X)];
+	UNROLL_SSE( OPER4, OPER1 )
+#undef OPER1
+#undef OPER4
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Zero16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Zero16( float *dst, const int count ) {
+	const __m128 zero = _mm_setzero_ps();
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, zero );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Negate16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Negate16( float *dst, const int count ) {
+	const __m128 signBit = _mm_load_ps( (const float *)SIMD_SP_signBit );
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_xor_ps( _mm_load_ps( dst + i ), signBit ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Copy16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Copy16( float *dst, const float *src, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_load_ps( src + i ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Add16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Add16( float *dst, const float *src1, const float *src2, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_add_ps( _mm_load_ps( src1 + i ), _mm_load_ps( src2 + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Sub16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Sub16( float *dst, const float *src1, const float *src2, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_sub_ps( _mm_load_ps( src1 + i ), _mm_load_ps( src2 + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::Mul16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::Mul16( float *dst, const float *src1, const float constant, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_mul_ps( _mm_load_ps( src1 + i ), c ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::AddAssign16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::AddAssign16( float *dst, const float *src, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_add_ps( _mm_load_ps( dst + i ), _mm_load_ps( src + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::SubAssign16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::SubAssign16( float *dst, const float *src, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_sub_ps( _mm_load_ps( dst + i ), _mm_load_ps( src + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MulAssign16
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MulAssign16( float *dst, const float constant, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_mul_ps( _mm_load_ps( dst + i ), c ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_MultiplyVecX
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_MultiplyVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	const float *mPtr = mat.ToFloatPtr();
+	const float *vPtr = vec.ToFloatPtr();
+	float *dstPtr = dst.ToFloatPtr();
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+
+	for ( int i = 0; i < numRows; i++ ) {
+		dstPtr[i] = DotArray( mPtr, vPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_MultiplyAddVecX
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_MultiplyAddVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	const float *mPtr = mat.ToFloatPtr();
+	const float *vPtr = vec.ToFloatPtr();
+	float *dstPtr = dst.ToFloatPtr();
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+
+	for ( int i = 0; i < numRows; i++ ) {
+		dstPtr[i] += DotArray( mPtr, vPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_MultiplySubVecX
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_MultiplySubVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	const float *mPtr = mat.ToFloatPtr();
+	const float *vPtr = vec.ToFloatPtr();
+	float *dstPtr = dst.ToFloatPtr();
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+
+	for ( int i = 0; i < numRows; i++ ) {
+		dstPtr[i] -= DotArray( mPtr, vPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_TransposeMultiplyVecX
+
+  accumulates the rows of the matrix scaled by the vector components,
+  which keeps all memory accesses sequential
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_TransposeMultiplyVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	const float *mPtr = mat.ToFloatPtr();
+	const float *vPtr = vec.ToFloatPtr();
+	float *dstPtr = dst.ToFloatPtr();
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+
+	if ( numRows <= 0 ) {
+		return;
+	}
+	Mul( dstPtr, vPtr[0], mPtr, numColumns );
+	for ( int i = 1; i < numRows; i++ ) {
+		mPtr += numColumns;
+		MultiplyAdd( dstPtr, vPtr[i], mPtr, numColumns );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_TransposeMultiplyAddVecX
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_TransposeMultiplyAddVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	const float *mPtr = mat.ToFloatPtr();
+	const float *vPtr = vec.ToFloatPtr();
+	float *dstPtr = dst.ToFloatPtr();
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+
+	for ( int i = 0; i < numRows; i++ ) {
+		MultiplyAdd( dstPtr, vPtr[i], mPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_TransposeMultiplySubVecX
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_TransposeMultiplySubVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	const float *mPtr = mat.ToFloatPtr();
+	const float *vPtr = vec.ToFloatPtr();
+	float *dstPtr = dst.ToFloatPtr();
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+
+	for ( int i = 0; i < numRows; i++ ) {
+		MultiplyAdd( dstPtr, -vPtr[i], mPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_MultiplyMatX
+
+  every row of the destination is a linear combination of the rows of m2
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_MultiplyMatX( idMatX &dst, const idMatX &m1, const idMatX &m2 ) {
+	assert( m1.GetNumColumns() == m2.GetNumRows() );
+
+	float *dstPtr = dst.ToFloatPtr();
+	const float *m1Ptr = m1.ToFloatPtr();
+	const int k = m1.GetNumRows();
+	const int n = m1.GetNumColumns();
+	const int l = m2.GetNumColumns();
+
+	for ( int i = 0; i < k; i++ ) {
+		const float *m2Ptr = m2.ToFloatPtr();
+		if ( n <= 0 ) {
+			memset( dstPtr, 0, l * sizeof( float ) );
+		} else {
+			Mul( dstPtr, m1Ptr[0], m2Ptr, l );
+			for ( int j = 1; j < n; j++ ) {
+				m2Ptr += l;
+				MultiplyAdd( dstPtr, m1Ptr[j], m2Ptr, l );
+			}
+		}
+		m1Ptr += n;
+		dstPtr += l;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_TransposeMultiplyMatX
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_TransposeMultiplyMatX( idMatX &dst, const idMatX &m1, const idMatX &m2 ) {
+	assert( m1.GetNumRows() == m2.GetNumRows() );
+
+	float *dstPtr = dst.ToFloatPtr();
+	const int n = m1.GetNumRows();
+	const int k = m1.GetNumColumns();
+	const int l = m2.GetNumColumns();
+
+	for ( int i = 0; i < k; i++ ) {
+		const float *m1Ptr = m1.ToFloatPtr() + i;
+		const float *m2Ptr = m2.ToFloatPtr();
+		if ( n <= 0 ) {
+			memset( dstPtr, 0, l * sizeof( float ) );
+		} else {
+			Mul( dstPtr, m1Ptr[0], m2Ptr, l );
+			for ( int j = 1; j < n; j++ ) {
+				m1Ptr += k;
+				m2Ptr += l;
+				MultiplyAdd( dstPtr, m1Ptr[0], m2Ptr, l );
+			}
+		}
+		dstPtr += l;
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_LowerTriangularSolve
+
+  solves x in Lx = b for the n * n sub-matrix of L
+  if skip > 0 the first skip elements of x are assumed to be valid already
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_LowerTriangularSolve( const idMatX &L, float *x, const float *b, const int n, int skip ) {
+	const float *lptr = L.ToFloatPtr();
+	const int nc = L.GetNumColumns();
+
+	for ( int i = skip; i < n; i++ ) {
+		x[i] = b[i] - DotArray( lptr + i * nc, x, i );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_LowerTriangularSolveTranspose
+
+  solves x in L'x = b for the n * n sub-matrix of L
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+
+  once x[i] is known it is removed from all the preceding equations by
+  subtracting a scaled row of L, so L is only ever read along its rows
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MatX_LowerTriangularSolveTranspose( const idMatX &L, float *x, const float *b, const int n ) {
+	const float *lptr = L.ToFloatPtr();
+	const int nc = L.GetNumColumns();
+
+	if ( x != b ) {
+		memcpy( x, b, n * sizeof( float ) );
+	}
+	for ( int i = n - 1; i > 0; i-- ) {
+		MultiplyAdd( x, -x[i], lptr + i * nc, i );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MatX_LDLTFactor
+
+  in-place factorization LDL' of the n * n sub-matrix of mat
+  the reciprocal of the diagonal elements are stored in invDiag
+============
+*/
+bool VPCALL idSIMD_SSE2_Intrin::MatX_LDLTFactor( idMatX &mat, idVecX &invDiag, const int n ) {
+	float *v, *diag, *ptr;
+	float sum, d;
+	int i, j;
+
+	v = (float *) _alloca16( n * sizeof( float ) );
+	diag = (float *) _alloca16( n * sizeof( float ) );
+
+	for ( i = 0; i < n; i++ ) {
+
+		ptr = mat[i];
+		Mul( v, ptr, diag, i );
+		sum = ptr[i] - DotArray( v, ptr, i );
+
+		if ( sum == 0.0f ) {
+			return false;
+		}
+
+		diag[i] = sum;
+		ptr[i] = sum;
+		invDiag[i] = d = 1.0f / sum;
+
+		for ( j = i + 1; j < n; j++ ) {
+			ptr = mat[j];
+			ptr[i] = ( ptr[i] - DotArray( ptr, v, i ) ) * d;
+		}
+	}
+
+	return true;
+}
+
+/*
+============
+ATan16
+
+  arctangent of y / x for non-negative x and y
+============
+*/
+static ID_INLINE __m128 ATan16( const __m128 y, const __m128 x ) {
+	const __m128 swap = _mm_cmpgt_ps( y, x );
+	const __m128 num = _mm_or_ps( _mm_and_ps( swap, x ), _mm_andnot_ps( swap, y ) );
+	const __m128 den = _mm_or_ps( _mm_and_ps( swap, y ), _mm_andnot_ps( swap, x ) );
+	__m128 a = _mm_div_ps( num, _mm_max_ps( den, _mm_set1_ps( 1e-30f ) ) );
+	__m128 s = _mm_mul_ps( a, a );
+	__m128 r = _mm_set1_ps( 0.0028662257f );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0161657367f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0429096138f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0752896400f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1065626393f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1420889944f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1999355085f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.3333314528f ) );
+	r = _mm_add_ps( _mm_mul_ps( _mm_mul_ps( r, s ), a ), a );
+	const __m128 flipped = _mm_sub_ps( _mm_set1_ps( idMath::HALF_PI ), r );
+	return _mm_or_ps( _mm_and_ps( swap, flipped ), _mm_andnot_ps( swap, r ) );
+}
+
+/*
+============
+Sin16
+
+  sine of angles in the range [0, PI/2]
+============
+*/
+static ID_INLINE __m128 Sin16( const __m128 a ) {
+	__m128 s = _mm_mul_ps( a, a );
+	__m128 r = _mm_set1_ps( -2.39e-08f );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 2.7526e-06f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.98409e-04f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 8.3333315e-03f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.666666664e-01f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.0f ) );
+	return _mm_mul_ps( r, a );
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::BlendJoints
+
+  four joints at a time are converted to a structure of arrays and
+  interpolated with polynomial approximations of the trigonometric functions
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			int j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+
+	const __m128 vlerp = _mm_set1_ps( lerp );
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 signBit = _mm_load_ps( (const float *)SIMD_SP_signBit );
+	const int numJoints4 = numJoints & ~3;
+
+	for ( i = 0; i < numJoints4; i += 4 ) {
+		const int n0 = index[i+0];
+		const int n1 = index[i+1];
+		const int n2 = index[i+2];
+		const int n3 = index[i+3];
+
+		__m128 jx = _mm_loadu_ps( joints[n0].q.ToFloatPtr() );
+		__m128 jy = _mm_loadu_ps( joints[n1].q.ToFloatPtr() );
+		__m128 jz = _mm_loadu_ps( joints[n2].q.ToFloatPtr() );
+		__m128 jw = _mm_loadu_ps( joints[n3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( jx, jy, jz, jw );
+
+		__m128 bx = _mm_loadu_ps( blendJoints[n0].q.ToFloatPtr() );
+		__m128 by = _mm_loadu_ps( blendJoints[n1].q.ToFloatPtr() );
+		__m128 bz = _mm_loadu_ps( blendJoints[n2].q.ToFloatPtr() );
+		__m128 bw = _mm_loadu_ps( blendJoints[n3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( bx, by, bz, bw );
+
+		__m128 cosom = _mm_add_ps( _mm_add_ps( _mm_mul_ps( jx, bx ), _mm_mul_ps( jy, by ) ), _mm_add_ps( _mm_mul_ps( jz, bz ), _mm_mul_ps( jw, bw ) ) );
+		const __m128 sign = _mm_and_ps( cosom, signBit );
+		cosom = _mm_xor_ps( cosom, sign );
+
+		// scale0 = 1 - lerp, scale1 = lerp unless the quaternions are far enough apart to slerp
+		__m128 scale0 = _mm_sub_ps( one, vlerp );
+		__m128 scale1 = vlerp;
+		const __m128 doSlerp = _mm_cmpgt_ps( _mm_sub_ps( one, cosom ), _mm_set1_ps( 1e-6f ) );
+		if ( _mm_movemask_ps( doSlerp ) ) {
+			const __m128 sinSqr = _mm_max_ps( _mm_sub_ps( one, _mm_mul_ps( cosom, cosom ) ), _mm_set1_ps( 1e-30f ) );
+			const __m128 invSinom = ReciprocalSqrt( sinSqr );
+			const __m128 sinom = _mm_mul_ps( sinSqr, invSinom );
+			const __m128 omega = ATan16( sinom, cosom );
+			const __m128 s0 = _mm_mul_ps( Sin16( _mm_mul_ps( scale0, omega ) ), invSinom );
+			const __m128 s1 = _mm_mul_ps( Sin16( _mm_mul_ps( scale1, omega ) ), invSinom );
+			scale0 = _mm_or_ps( _mm_and_ps( doSlerp, s0 ), _mm_andnot_ps( doSlerp, scale0 ) );
+			scale1 = _mm_or_ps( _mm_and_ps( doSlerp, s1 ), _mm_andnot_ps( doSlerp, scale1 ) );
+		}
+		scale1 = _mm_xor_ps( scale1, sign );
+
+		jx = _mm_add_ps( _mm_mul_ps( scale0, jx ), _mm_mul_ps( scale1, bx ) );
+		jy = _mm_add_ps( _mm_mul_ps( scale0, jy ), _mm_mul_ps( scale1, by ) );
+		jz = _mm_add_ps( _mm_mul_ps( scale0, jz ), _mm_mul_ps( scale1, bz ) );
+		jw = _mm_add_ps( _mm_mul_ps( scale0, jw ), _mm_mul_ps( scale1, bw ) );
+		_MM_TRANSPOSE4_PS( jx, jy, jz, jw );
+
+		_mm_storeu_ps( joints[n0].q.ToFloatPtr(), jx );
+		_mm_storeu_ps( joints[n1].q.ToFloatPtr(), jy );
+		_mm_storeu_ps( joints[n2].q.ToFloatPtr(), jz );
+		_mm_storeu_ps( joints[n3].q.ToFloatPtr(), jw );
+
+		joints[n0].t.Lerp( joints[n0].t, blendJoints[n0].t, lerp );
+		joints[n1].t.Lerp( joints[n1].t, blendJoints[n1].t, lerp );
+		joints[n2].t.Lerp( joints[n2].t, blendJoints[n2].t, lerp );
+		joints[n3].t.Lerp( joints[n3].t, blendJoints[n3].t, lerp );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		int j = index[i];
+		joints[j].q.Slerp( joints[j].q, blendJoints[j].q, lerp );
+		joints[j].t.Lerp( joints[j].t, blendJoints[j].t, lerp );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::ConvertJointQuatsToJointMats
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) {
+	const int numJoints4 = numJoints & ~3;
+	const __m128 one = _mm_set1_ps( 1.0f );
+	int i;
+
+	for ( i = 0; i < numJoints4; i += 4 ) {
+		__m128 x = _mm_loadu_ps( jointQuats[i+0].q.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( jointQuats[i+1].q.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( jointQuats[i+2].q.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( jointQuats[i+3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128 tx, ty, tz;
+		LoadVec3x4( jointQuats[i+0].t.ToFloatPtr(), jointQuats[i+1].t.ToFloatPtr(), jointQuats[i+2].t.ToFloatPtr(), jointQuats[i+3].t.ToFloatPtr(), tx, ty, tz );
+
+		const __m128 x2 = _mm_add_ps( x, x );
+		const __m128 y2 = _mm_add_ps( y, y );
+		const __m128 z2 = _mm_add_ps( z, z );
+
+		const __m128 xx = _mm_mul_ps( x, x2 );
+		const __m128 xy = _mm_mul_ps( x, y2 );
+		const __m128 xz = _mm_mul_ps( x, z2 );
+		const __m128 yy = _mm_mul_ps( y, y2 );
+		const __m128 yz = _mm_mul_ps( y, z2 );
+		const __m128 zz = _mm_mul_ps( z, z2 );
+		const __m128 wx = _mm_mul_ps( w, x2 );
+		const __m128 wy = _mm_mul_ps( w, y2 );
+		const __m128 wz = _mm_mul_ps( w, z2 );
+
+		__m128 m00 = _mm_sub_ps( one, _mm_add_ps( yy, zz ) );
+		__m128 m01 = _mm_add_ps( xy, wz );
+		__m128 m02 = _mm_sub_ps( xz, wy );
+		__m128 m03 = tx;
+		_MM_TRANSPOSE4_PS( m00, m01, m02, m03 );
+
+		__m128 m10 = _mm_sub_ps( xy, wz );
+		__m128 m11 = _mm_sub_ps( one, _mm_add_ps( xx, zz ) );
+		__m128 m12 = _mm_add_ps( yz, wx );
+		__m128 m13 = ty;
+		_MM_TRANSPOSE4_PS( m10, m11, m12, m13 );
+
+		__m128 m20 = _mm_add_ps( xz, wy );
+		__m128 m21 = _mm_sub_ps( yz, wx );
+		__m128 m22 = _mm_sub_ps( one, _mm_add_ps( xx, yy ) );
+		__m128 m23 = tz;
+		_MM_TRANSPOSE4_PS( m20, m21, m22, m23 );
+
+		float *m = jointMats[i].ToFloatPtr();
+		_mm_storeu_ps( m + 0 * 12 + 0, m00 );
+		_mm_storeu_ps( m + 0 * 12 + 4, m10 );
+		_mm_storeu_ps( m + 0 * 12 + 8, m20 );
+		_mm_storeu_ps( m + 1 * 12 + 0, m01 );
+		_mm_storeu_ps( m + 1 * 12 + 4, m11 );
+		_mm_storeu_ps( m + 1 * 12 + 8, m21 );
+		_mm_storeu_ps( m + 2 * 12 + 0, m02 );
+		_mm_storeu_ps( m + 2 * 12 + 4, m12 );
+		_mm_storeu_ps( m + 2 * 12 + 8, m22 );
+		_mm_storeu_ps( m + 3 * 12 + 0, m03 );
+		_mm_storeu_ps( m + 3 * 12 + 4, m13 );
+		_mm_storeu_ps( m + 3 * 12 + 8, m23 );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		jointMats[i].SetRotation( jointQuats[i].q.ToMat3() );
+		jointMats[i].SetTranslation( jointQuats[i].t );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::TransformJoints
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	const __m128 lastOne = _mm_load_ps( (const float *)SIMD_SP_lastOne );
+
+	for ( int i = firstJoint; i <= lastJoint; i++ ) {
+		assert( parents[i] < i );
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+		float *m = jointMats[i].ToFloatPtr();
+
+		const __m128 m0 = _mm_loadu_ps( m + 0 );
+		const __m128 m1 = _mm_loadu_ps( m + 4 );
+		const __m128 m2 = _mm_loadu_ps( m + 8 );
+
+		for ( int r = 0; r < 3; r++ ) {
+			const __m128 ar = _mm_loadu_ps( a + r * 4 );
+			__m128 t = _mm_add_ps( _mm_add_ps( _mm_mul_ps( SPLAT( ar, 0 ), m0 ), _mm_mul_ps( SPLAT( ar, 1 ), m1 ) ), _mm_mul_ps( SPLAT( ar, 2 ), m2 ) );
+			t = _mm_add_ps( t, _mm_mul_ps( SPLAT( ar, 3 ), lastOne ) );
+			_mm_storeu_ps( m + r * 4, t );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::UntransformJoints
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	const __m128 lastOne = _mm_load_ps( (const float *)SIMD_SP_lastOne );
+
+	for ( int i = lastJoint; i >= firstJoint; i-- ) {
+		assert( parents[i] < i );
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+		float *m = jointMats[i].ToFloatPtr();
+
+		const __m128 a0 = _mm_loadu_ps( a + 0 );
+		const __m128 a1 = _mm_loadu_ps( a + 4 );
+		const __m128 a2 = _mm_loadu_ps( a + 8 );
+
+		const __m128 m0 = _mm_sub_ps( _mm_loadu_ps( m + 0 ), _mm_mul_ps( SPLAT( a0, 3 ), lastOne ) );
+		const __m128 m1 = _mm_sub_ps( _mm_loadu_ps( m + 4 ), _mm_mul_ps( SPLAT( a1, 3 ), lastOne ) );
+		const __m128 m2 = _mm_sub_ps( _mm_loadu_ps( m + 8 ), _mm_mul_ps( SPLAT( a2, 3 ), lastOne ) );
+
+		_mm_storeu_ps( m + 0, _mm_add_ps( _mm_add_ps( _mm_mul_ps( SPLAT( a0, 0 ), m0 ), _mm_mul_ps( SPLAT( a1, 0 ), m1 ) ), _mm_mul_ps( SPLAT( a2, 0 ), m2 ) ) );
+		_mm_storeu_ps( m + 4, _mm_add_ps( _mm_add_ps( _mm_mul_ps( SPLAT( a0, 1 ), m0 ), _mm_mul_ps( SPLAT( a1, 1 ), m1 ) ), _mm_mul_ps( SPLAT( a2, 1 ), m2 ) ) );
+		_mm_storeu_ps( m + 8, _mm_add_ps( _mm_add_ps( _mm_mul_ps( SPLAT( a0, 2 ), m0 ), _mm_mul_ps( SPLAT( a1, 2 ), m1 ) ), _mm_mul_ps( SPLAT( a2, 2 ), m2 ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::TransformVerts
+
+  the weighted joint rows are accumulated as whole vectors and summed
+  horizontally once per vertex
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights ) {
+	const byte *jointsPtr = (const byte *)joints;
+	int i, j;
+
+	for ( j = i = 0; i < numVerts; i++ ) {
+		__m128 r0 = _mm_setzero_ps();
+		__m128 r1 = _mm_setzero_ps();
+		__m128 r2 = _mm_setzero_ps();
+
+		for ( ; ; j++ ) {
+			const float *m = (const float *)( jointsPtr + index[j*2+0] );
+			const __m128 w = _mm_loadu_ps( weights[j].ToFloatPtr() );
+			r0 = _mm_add_ps( r0, _mm_mul_ps( _mm_loadu_ps( m + 0 ), w ) );
+			r1 = _mm_add_ps( r1, _mm_mul_ps( _mm_loadu_ps( m + 4 ), w ) );
+			r2 = _mm_add_ps( r2, _mm_mul_ps( _mm_loadu_ps( m + 8 ), w ) );
+			if ( index[j*2+1] != 0 ) {
+				j++;
+				break;
+			}
+		}
+
+		__m128 r3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		StoreVec3( verts[i].xyz.ToFloatPtr(), _mm_add_ps( _mm_add_ps( r0, r1 ), _mm_add_ps( r2, r3 ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::TracePointCull
+
+  the planes are transposed once so every vertex takes a single pass,
+  the distances are summed in the same order as idPlane::Distance to get
+  identical cull bits
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	__m128 px = _mm_loadu_ps( planes[0].ToFloatPtr() );
+	__m128 py = _mm_loadu_ps( planes[1].ToFloatPtr() );
+	__m128 pz = _mm_loadu_ps( planes[2].ToFloatPtr() );
+	__m128 pd = _mm_loadu_ps( planes[3].ToFloatPtr() );
+	_MM_TRANSPOSE4_PS( px, py, pz, pd );
+
+	const __m128 r = _mm_set1_ps( radius );
+	int tOr = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = LoadVec3( verts[i].xyz.ToFloatPtr() );
+		const __m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( px, SPLAT( v, 0 ) ), _mm_mul_ps( py, SPLAT( v, 1 ) ) ), _mm_mul_ps( pz, SPLAT( v, 2 ) ) ), pd );
+		int bits = _mm_movemask_ps( _mm_add_ps( d, r ) ) | ( _mm_movemask_ps( _mm_sub_ps( d, r ) ) << 4 );
+		bits ^= 0x0F;		// flip lower four bits
+		tOr |= bits;
+		cullBits[i] = bits;
+	}
+
+	totalOr = tOr;
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::DecalPointCull
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::DecalPointCull( byte *cullBits, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	__m128 p0x = _mm_loadu_ps( planes[0].ToFloatPtr() );
+	__m128 p0y = _mm_loadu_ps( planes[1].ToFloatPtr() );
+	__m128 p0z = _mm_loadu_ps( planes[2].ToFloatPtr() );
+	__m128 p0d = _mm_loadu_ps( planes[3].ToFloatPtr() );
+	_MM_TRANSPOSE4_PS( p0x, p0y, p0z, p0d );
+
+	__m128 p1x = _mm_loadu_ps( planes[4].ToFloatPtr() );
+	__m128 p1y = _mm_loadu_ps( planes[5].ToFloatPtr() );
+	__m128 p1z = _mm_setzero_ps();
+	__m128 p1d = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS( p1x, p1y, p1z, p1d );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = LoadVec3( verts[i].xyz.ToFloatPtr() );
+		const __m128 x = SPLAT( v, 0 );
+		const __m128 y = SPLAT( v, 1 );
+		const __m128 z = SPLAT( v, 2 );
+		const __m128 d0 = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( p0x, x ), _mm_mul_ps( p0y, y ) ), _mm_mul_ps( p0z, z ) ), p0d );
+		const __m128 d1 = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( p1x, x ), _mm_mul_ps( p1y, y ) ), _mm_mul_ps( p1z, z ) ), p1d );
+		const int bits = _mm_movemask_ps( d0 ) | ( ( _mm_movemask_ps( d1 ) & 3 ) << 4 );
+		cullBits[i] = bits ^ 0x3F;		// flip lower 6 bits
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::OverlayPointCull
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::OverlayPointCull( byte *cullBits, idVec2 *texCoords, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	__m128 px = _mm_loadu_ps( planes[0].ToFloatPtr() );
+	__m128 py = _mm_loadu_ps( planes[1].ToFloatPtr() );
+	__m128 pz = _mm_setzero_ps();
+	__m128 pd = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS( px, py, pz, pd );
+
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = LoadVec3( verts[i].xyz.ToFloatPtr() );
+		const __m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( px, SPLAT( v, 0 ) ), _mm_mul_ps( py, SPLAT( v, 1 ) ) ), _mm_mul_ps( pz, SPLAT( v, 2 ) ) ), pd );
+		_mm_storel_pi( (__m64 *)texCoords[i].ToFloatPtr(), d );
+		// ( d0, d1, 1 - d0, 1 - d1 )
+		cullBits[i] = _mm_movemask_ps( _mm_movelh_ps( d, _mm_sub_ps( one, d ) ) );
+	}
+}
+
+/*
+============
+LoadTriangles4
+
+  loads the vertices of four triangles, the triangles past numTris repeat the first one
+============
+*/
+static ID_INLINE void LoadTriangles4( const idDrawVert *verts, const int *indexes, const int numTris, const idDrawVert *tri[4][3] ) {
+	for ( int k = 0; k < 4; k++ ) {
+		const int *idx = indexes + ( k < numTris ? k : 0 ) * 3;
+		tri[k][0] = verts + idx[0];
+		tri[k][1] = verts + idx[1];
+		tri[k][2] = verts + idx[2];
+	}
+}
+
+/*
+============
+StorePlanes4
+============
+*/
+static ID_INLINE void StorePlanes4( idPlane *planes, const int numPlanes, __m128 nx, __m128 ny, __m128 nz, __m128 d ) {
+	_MM_TRANSPOSE4_PS( nx, ny, nz, d );
+	_mm_storeu_ps( planes[0].ToFloatPtr(), nx );
+	if ( numPlanes > 1 ) {
+		_mm_storeu_ps( planes[1].ToFloatPtr(), ny );
+	}
+	if ( numPlanes > 2 ) {
+		_mm_storeu_ps( planes[2].ToFloatPtr(), nz );
+	}
+	if ( numPlanes > 3 ) {
+		_mm_storeu_ps( planes[3].ToFloatPtr(), d );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::DeriveTriPlanes
+
+	Derives a plane equation for each triangle, four triangles at a time.
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	const idDrawVert *tri[4][3];
+	const __m128 signBit = _mm_load_ps( (const float *)SIMD_SP_signBit );
+	const int numTris = numIndexes / 3;
+
+	for ( int i = 0; i < numTris; i += 4 ) {
+		LoadTriangles4( verts, indexes + i * 3, numTris - i, tri );
+
+		__m128 ax, ay, az, bx, by, bz, cx, cy, cz;
+		LoadVec3x4( tri[0][0]->xyz.ToFloatPtr(), tri[1][0]->xyz.ToFloatPtr(), tri[2][0]->xyz.ToFloatPtr(), tri[3][0]->xyz.ToFloatPtr(), ax, ay, az );
+		LoadVec3x4( tri[0][1]->xyz.ToFloatPtr(), tri[1][1]->xyz.ToFloatPtr(), tri[2][1]->xyz.ToFloatPtr(), tri[3][1]->xyz.ToFloatPtr(), bx, by, bz );
+		LoadVec3x4( tri[0][2]->xyz.ToFloatPtr(), tri[1][2]->xyz.ToFloatPtr(), tri[2][2]->xyz.ToFloatPtr(), tri[3][2]->xyz.ToFloatPtr(), cx, cy, cz );
+
+		const __m128 d0x = _mm_sub_ps( bx, ax );
+		const __m128 d0y = _mm_sub_ps( by, ay );
+		const __m128 d0z = _mm_sub_ps( bz, az );
+		const __m128 d1x = _mm_sub_ps( cx, ax );
+		const __m128 d1y = _mm_sub_ps( cy, ay );
+		const __m128 d1z = _mm_sub_ps( cz, az );
+
+		__m128 nx = _mm_sub_ps( _mm_mul_ps( d1y, d0z ), _mm_mul_ps( d1z, d0y ) );
+		__m128 ny = _mm_sub_ps( _mm_mul_ps( d1z, d0x ), _mm_mul_ps( d1x, d0z ) );
+		__m128 nz = _mm_sub_ps( _mm_mul_ps( d1x, d0y ), _mm_mul_ps( d1y, d0x ) );
+
+		const __m128 f = ReciprocalSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+
+		const __m128 d = _mm_xor_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, ax ), _mm_mul_ps( ny, ay ) ), _mm_mul_ps( nz, az ) ), signBit );
+
+		StorePlanes4( planes + i, numTris - i, nx, ny, nz, d );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::DeriveTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from all triangles
+	using the vertex which results in smooth tangents across the mesh.
+	In the process the triangle planes are calculated as well.
+
+	The per triangle vectors are calculated for four triangles at a time and
+	are then accumulated on the vertices in triangle order.
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	ALIGN16( float n[3][4] );
+	ALIGN16( float t0[3][4] );
+	ALIGN16( float t1[3][4] );
+	const idDrawVert *tri[4][3];
+	const __m128 signBit = _mm_load_ps( (const float *)SIMD_SP_signBit );
+	const int numTris = numIndexes / 3;
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( int i = 0; i < numTris; i += 4 ) {
+		LoadTriangles4( verts, indexes + i * 3, numTris - i, tri );
+
+		__m128 ax, ay, az, bx, by, bz, cx, cy, cz;
+		LoadVec3x4( tri[0][0]->xyz.ToFloatPtr(), tri[1][0]->xyz.ToFloatPtr(), tri[2][0]->xyz.ToFloatPtr(), tri[3][0]->xyz.ToFloatPtr(), ax, ay, az );
+		LoadVec3x4( tri[0][1]->xyz.ToFloatPtr(), tri[1][1]->xyz.ToFloatPtr(), tri[2][1]->xyz.ToFloatPtr(), tri[3][1]->xyz.ToFloatPtr(), bx, by, bz );
+		LoadVec3x4( tri[0][2]->xyz.ToFloatPtr(), tri[1][2]->xyz.ToFloatPtr(), tri[2][2]->xyz.ToFloatPtr(), tri[3][2]->xyz.ToFloatPtr(), cx, cy, cz );
+
+		const __m128 as = _mm_setr_ps( tri[0][0]->st[0], tri[1][0]->st[0], tri[2][0]->st[0], tri[3][0]->st[0] );
+		const __m128 at = _mm_setr_ps( tri[0][0]->st[1], tri[1][0]->st[1], tri[2][0]->st[1], tri[3][0]->st[1] );
+		const __m128 bs = _mm_setr_ps( tri[0][1]->st[0], tri[1][1]->st[0], tri[2][1]->st[0], tri[3][1]->st[0] );
+		const __m128 bt = _mm_setr_ps( tri[0][1]->st[1], tri[1][1]->st[1], tri[2][1]->st[1], tri[3][1]->st[1] );
+		const __m128 cs = _mm_setr_ps( tri[0][2]->st[0], tri[1][2]->st[0], tri[2][2]->st[0], tri[3][2]->st[0] );
+		const __m128 ct = _mm_setr_ps( tri[0][2]->st[1], tri[1][2]->st[1], tri[2][2]->st[1], tri[3][2]->st[1] );
+
+		const __m128 d0x = _mm_sub_ps( bx, ax );
+		const __m128 d0y = _mm_sub_ps( by, ay );
+		const __m128 d0z = _mm_sub_ps( bz, az );
+		const __m128 d0s = _mm_sub_ps( bs, as );
+		const __m128 d0t = _mm_sub_ps( bt, at );
+		const __m128 d1x = _mm_sub_ps( cx, ax );
+		const __m128 d1y = _mm_sub_ps( cy, ay );
+		const __m128 d1z = _mm_sub_ps( cz, az );
+		const __m128 d1s = _mm_sub_ps( cs, as );
+		const __m128 d1t = _mm_sub_ps( ct, at );
+
+		// normal
+		__m128 nx = _mm_sub_ps( _mm_mul_ps( d1y, d0z ), _mm_mul_ps( d1z, d0y ) );
+		__m128 ny = _mm_sub_ps( _mm_mul_ps( d1z, d0x ), _mm_mul_ps( d1x, d0z ) );
+		__m128 nz = _mm_sub_ps( _mm_mul_ps( d1x, d0y ), _mm_mul_ps( d1y, d0x ) );
+
+		__m128 f = ReciprocalSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+
+		const __m128 d = _mm_xor_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, ax ), _mm_mul_ps( ny, ay ) ), _mm_mul_ps( nz, az ) ), signBit );
+		StorePlanes4( planes + i, numTris - i, nx, ny, nz, d );
+
+		// area sign bit
+		const __m128 area = _mm_sub_ps( _mm_mul_ps( d0s, d1t ), _mm_mul_ps( d0t, d1s ) );
+		const __m128 areaSign = _mm_and_ps( area, signBit );
+
+		// first tangent
+		__m128 t0x = _mm_sub_ps( _mm_mul_ps( d0x, d1t ), _mm_mul_ps( d0t, d1x ) );
+		__m128 t0y = _mm_sub_ps( _mm_mul_ps( d0y, d1t ), _mm_mul_ps( d0t, d1y ) );
+		__m128 t0z = _mm_sub_ps( _mm_mul_ps( d0z, d1t ), _mm_mul_ps( d0t, d1z ) );
+
+		f = _mm_xor_ps( ReciprocalSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( t0x, t0x ), _mm_mul_ps( t0y, t0y ) ), _mm_mul_ps( t0z, t0z ) ) ), areaSign );
+		t0x = _mm_mul_ps( t0x, f );
+		t0y = _mm_mul_ps( t0y, f );
+		t0z = _mm_mul_ps( t0z, f );
+
+		// second tangent
+		__m128 t1x = _mm_sub_ps( _mm_mul_ps( d0s, d1x ), _mm_mul_ps( d0x, d1s ) );
+		__m128 t1y = _mm_sub_ps( _mm_mul_ps( d0s, d1y ), _mm_mul_ps( d0y, d1s ) );
+		__m128 t1z = _mm_sub_ps( _mm_mul_ps( d0s, d1z ), _mm_mul_ps( d0z, d1s ) );
+
+		f = _mm_xor_ps( ReciprocalSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( t1x, t1x ), _mm_mul_ps( t1y, t1y ) ), _mm_mul_ps( t1z, t1z ) ) ), areaSign );
+		t1x = _mm_mul_ps( t1x, f );
+		t1y = _mm_mul_ps( t1y, f );
+		t1z = _mm_mul_ps( t1z, f );
+
+		_mm_store_ps( n[0], nx );
+		_mm_store_ps( n[1], ny );
+		_mm_store_ps( n[2], nz );
+		_mm_store_ps( t0[0], t0x );
+		_mm_store_ps( t0[1], t0y );
+		_mm_store_ps( t0[2], t0z );
+		_mm_store_ps( t1[0], t1x );
+		_mm_store_ps( t1[1], t1y );
+		_mm_store_ps( t1[2], t1z );
+
+		const int numLanes = Min( 4, numTris - i );
+		for ( int k = 0; k < numLanes; k++ ) {
+			const idVec3 tn( n[0][k], n[1][k], n[2][k] );
+			const idVec3 tt0( t0[0][k], t0[1][k], t0[2][k] );
+			const idVec3 tt1( t1[0][k], t1[1][k], t1[2][k] );
+
+			for ( int j = 0; j < 3; j++ ) {
+				const int v = indexes[( i + k ) * 3 + j];
+				idDrawVert *a = verts + v;
+				if ( used[v] ) {
+					a->normal += tn;
+					a->tangents[0] += tt0;
+					a->tangents[1] += tt1;
+				} else {
+					a->normal = tn;
+					a->tangents[0] = tt0;
+					a->tangents[1] = tt1;
+					used[v] = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::DeriveUnsmoothedTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from a single dominant triangle.
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_s *dominantTris, const int numVerts ) {
+	const idDrawVert *a[4], *b[4], *c[4];
+
+	for ( int i = 0; i < numVerts; i += 4 ) {
+		const int numLanes = Min( 4, numVerts - i );
+		for ( int k = 0; k < 4; k++ ) {
+			const int vi = i + ( k < numLanes ? k : 0 );
+			a[k] = verts + vi;
+			b[k] = verts + dominantTris[vi].v2;
+			c[k] = verts + dominantTris[vi].v3;
+		}
+
+		__m128 ax, ay, az, bx, by, bz, cx, cy, cz;
+		LoadVec3x4( a[0]->xyz.ToFloatPtr(), a[1]->xyz.ToFloatPtr(), a[2]->xyz.ToFloatPtr(), a[3]->xyz.ToFloatPtr(), ax, ay, az );
+		LoadVec3x4( b[0]->xyz.ToFloatPtr(), b[1]->xyz.ToFloatPtr(), b[2]->xyz.ToFloatPtr(), b[3]->xyz.ToFloatPtr(), bx, by, bz );
+		LoadVec3x4( c[0]->xyz.ToFloatPtr(), c[1]->xyz.ToFloatPtr(), c[2]->xyz.ToFloatPtr(), c[3]->xyz.ToFloatPtr(), cx, cy, cz );
+
+		const __m128 at = _mm_setr_ps( a[0]->st[1], a[1]->st[1], a[2]->st[1], a[3]->st[1] );
+		const __m128 bt = _mm_setr_ps( b[0]->st[1], b[1]->st[1], b[2]->st[1], b[3]->st[1] );
+		const __m128 ct = _mm_setr_ps( c[0]->st[1], c[1]->st[1], c[2]->st[1], c[3]->st[1] );
+
+		__m128 s0, s1, s2;
+		LoadVec3x4( dominantTris[a[0] - verts].normalizationScale, dominantTris[a[1] - verts].normalizationScale,
+					dominantTris[a[2] - verts].normalizationScale, dominantTris[a[3] - verts].normalizationScale, s0, s1, s2 );
+
+		const __m128 d0 = _mm_sub_ps( bx, ax );
+		const __m128 d1 = _mm_sub_ps( by, ay );
+		const __m128 d2 = _mm_sub_ps( bz, az );
+		const __m128 d4 = _mm_sub_ps( bt, at );
+		const __m128 d5 = _mm_sub_ps( cx, ax );
+		const __m128 d6 = _mm_sub_ps( cy, ay );
+		const __m128 d7 = _mm_sub_ps( cz, az );
+		const __m128 d9 = _mm_sub_ps( ct, at );
+
+		const __m128 n0 = _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d6, d2 ), _mm_mul_ps( d7, d1 ) ) );
+		const __m128 n1 = _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d7, d0 ), _mm_mul_ps( d5, d2 ) ) );
+		const __m128 n2 = _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d5, d1 ), _mm_mul_ps( d6, d0 ) ) );
+
+		const __m128 t0 = _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d0, d9 ), _mm_mul_ps( d4, d5 ) ) );
+		const __m128 t1 = _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d1, d9 ), _mm_mul_ps( d4, d6 ) ) );
+		const __m128 t2 = _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d2, d9 ), _mm_mul_ps( d4, d7 ) ) );
+
+		const __m128 t3 = _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( n2, t1 ), _mm_mul_ps( n1, t2 ) ) );
+		const __m128 t4 = _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( n0, t2 ), _mm_mul_ps( n2, t0 ) ) );
+		const __m128 t5 = _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( n1, t0 ), _mm_mul_ps( n0, t1 ) ) );
+
+		if ( numLanes == 4 ) {
+			StoreVec3x4( verts[i+0].normal.ToFloatPtr(), verts[i+1].normal.ToFloatPtr(), verts[i+2].normal.ToFloatPtr(), verts[i+3].normal.ToFloatPtr(), n0, n1, n2 );
+			StoreVec3x4( verts[i+0].tangents[0].ToFloatPtr(), verts[i+1].tangents[0].ToFloatPtr(), verts[i+2].tangents[0].ToFloatPtr(), verts[i+3].tangents[0].ToFloatPtr(), t0, t1, t2 );
+			StoreVec3x4( verts[i+0].tangents[1].ToFloatPtr(), verts[i+1].tangents[1].ToFloatPtr(), verts[i+2].tangents[1].ToFloatPtr(), verts[i+3].tangents[1].ToFloatPtr(), t3, t4, t5 );
+		} else {
+			ALIGN16( float tmp[9][4] );
+			_mm_store_ps( tmp[0], n0 );
+			_mm_store_ps( tmp[1], n1 );
+			_mm_store_ps( tmp[2], n2 );
+			_mm_store_ps( tmp[3], t0 );
+			_mm_store_ps( tmp[4], t1 );
+			_mm_store_ps( tmp[5], t2 );
+			_mm_store_ps( tmp[6], t3 );
+			_mm_store_ps( tmp[7], t4 );
+			_mm_store_ps( tmp[8], t5 );
+			for ( int k = 0; k < numLanes; k++ ) {
+				idDrawVert &v = verts[i+k];
+				v.normal.Set( tmp[0][k], tmp[1][k], tmp[2][k] );
+				v.tangents[0].Set( tmp[3][k], tmp[4][k], tmp[5][k] );
+				v.tangents[1].Set( tmp[6][k], tmp[7][k], tmp[8][k] );
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::NormalizeTangents
+
+	Normalizes each vertex normal and projects and normalizes the
+	tangent vectors onto the plane orthogonal to the vertex normal.
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::NormalizeTangents( idDrawVert *verts, const int numVerts ) {
+	const int numVerts4 = numVerts & ~3;
+	int i;
+
+	for ( i = 0; i < numVerts4; i += 4 ) {
+		idDrawVert *v = verts + i;
+
+		__m128 nx, ny, nz;
+		LoadVec3x4( v[0].normal.ToFloatPtr(), v[1].normal.ToFloatPtr(), v[2].normal.ToFloatPtr(), v[3].normal.ToFloatPtr(), nx, ny, nz );
+
+		__m128 f = ReciprocalSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+
+		StoreVec3x4( v[0].normal.ToFloatPtr(), v[1].normal.ToFloatPtr(), v[2].normal.ToFloatPtr(), v[3].normal.ToFloatPtr(), nx, ny, nz );
+
+		for ( int j = 0; j < 2; j++ ) {
+			__m128 tx, ty, tz;
+			LoadVec3x4( v[0].tangents[j].ToFloatPtr(), v[1].tangents[j].ToFloatPtr(), v[2].tangents[j].ToFloatPtr(), v[3].tangents[j].ToFloatPtr(), tx, ty, tz );
+
+			const __m128 dot = _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, nx ), _mm_mul_ps( ty, ny ) ), _mm_mul_ps( tz, nz ) );
+			tx = _mm_sub_ps( tx, _mm_mul_ps( dot, nx ) );
+			ty = _mm_sub_ps( ty, _mm_mul_ps( dot, ny ) );
+			tz = _mm_sub_ps( tz, _mm_mul_ps( dot, nz ) );
+
+			f = ReciprocalSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) );
+			tx = _mm_mul_ps( tx, f );
+			ty = _mm_mul_ps( ty, f );
+			tz = _mm_mul_ps( tz, f );
+
+			StoreVec3x4( v[0].tangents[j].ToFloatPtr(), v[1].tangents[j].ToFloatPtr(), v[2].tangents[j].ToFloatPtr(), v[3].tangents[j].ToFloatPtr(), tx, ty, tz );
+		}
+	}
+
+	for ( ; i < numVerts; i++ ) {
+		idVec3 &v = verts[i].normal;
+		float f;
+
+		f = idMath::RSqrt( v.x * v.x + v.y * v.y + v.z * v.z );
+		v.x *= f; v.y *= f; v.z *= f;
+
+		for ( int j = 0; j < 2; j++ ) {
+			idVec3 &t = verts[i].tangents[j];
+
+			t -= ( t * v ) * v;
+			f = idMath::RSqrt( t.x * t.x + t.y * t.y + t.z * t.z );
+			t.x *= f; t.y *= f; t.z *= f;
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::CreateTextureSpaceLightVectors
+
+	Calculates light vectors in texture space for the given triangle vertices.
+	For each vertex the direction towards the light origin is projected onto texture space.
+	The light vectors are only calculated for the vertices referenced by the indexes.
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::CreateTextureSpaceLightVectors( idVec3 *lightVectors, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( int i = numIndexes - 1; i >= 0; i-- ) {
+		used[indexes[i]] = true;
+	}
+
+	const __m128 origin = LoadVec3( lightOrigin.ToFloatPtr() );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( !used[i] ) {
+			continue;
+		}
+
+		const idDrawVert *v = &verts[i];
+
+		const __m128 lightDir = _mm_sub_ps( origin, LoadVec3( v->xyz.ToFloatPtr() ) );
+
+		__m128 r0 = _mm_mul_ps( lightDir, LoadVec3( v->tangents[0].ToFloatPtr() ) );
+		__m128 r1 = _mm_mul_ps( lightDir, LoadVec3( v->tangents[1].ToFloatPtr() ) );
+		__m128 r2 = _mm_mul_ps( lightDir, LoadVec3( v->normal.ToFloatPtr() ) );
+		__m128 r3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+		StoreVec3( lightVectors[i].ToFloatPtr(), _mm_add_ps( _mm_add_ps( r0, r1 ), r2 ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::CreateSpecularTextureCoords
+
+	Calculates specular texture coordinates for the given triangle vertices.
+	For each vertex the normalized direction towards the light origin is added to the
+	normalized direction towards the view origin and the result is projected onto texture space.
+	The texture coordinates are only calculated for the vertices referenced by the indexes.
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::CreateSpecularTextureCoords( idVec4 *texCoords, const idVec3 &lightOrigin, const idVec3 &viewOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( int i = numIndexes - 1; i >= 0; i-- ) {
+		used[indexes[i]] = true;
+	}
+
+	const __m128 lightPos = LoadVec3( lightOrigin.ToFloatPtr() );
+	const __m128 viewPos = LoadVec3( viewOrigin.ToFloatPtr() );
+	const __m128 lastOne = _mm_load_ps( (const float *)SIMD_SP_lastOne );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( !used[i] ) {
+			continue;
+		}
+
+		const idDrawVert *v = &verts[i];
+		const __m128 xyz = LoadVec3( v->xyz.ToFloatPtr() );
+
+		__m128 lightDir = _mm_sub_ps( lightPos, xyz );
+		__m128 viewDir = _mm_sub_ps( viewPos, xyz );
+
+		// both lengths are calculated at once
+		__m128 l = _mm_mul_ps( lightDir, lightDir );
+		__m128 w = _mm_mul_ps( viewDir, viewDir );
+		__m128 t0 = _mm_setzero_ps();
+		__m128 t1 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( l, w, t0, t1 );
+		const __m128 ilength = ReciprocalSqrt( _mm_add_ps( _mm_add_ps( l, w ), t0 ) );
+
+		lightDir = _mm_add_ps( _mm_mul_ps( lightDir, SPLAT( ilength, 0 ) ), _mm_mul_ps( viewDir, SPLAT( ilength, 1 ) ) );
+
+		__m128 r0 = _mm_mul_ps( lightDir, LoadVec3( v->tangents[0].ToFloatPtr() ) );
+		__m128 r1 = _mm_mul_ps( lightDir, LoadVec3( v->tangents[1].ToFloatPtr() ) );
+		__m128 r2 = _mm_mul_ps( lightDir, LoadVec3( v->normal.ToFloatPtr() ) );
+		__m128 r3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+		_mm_storeu_ps( texCoords[i].ToFloatPtr(), _mm_or_ps( _mm_add_ps( _mm_add_ps( r0, r1 ), r2 ), lastOne ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::CreateShadowCache
+
+  the w component of the vertex is zero after loading, or-ing in the bits
+  of 1.0f gives the near cap vertex and subtracting the light origin with
+  a zero w gives the projected far cap vertex
+============
+*/
+int VPCALL idSIMD_SSE2_Intrin::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	const __m128 origin = LoadVec3( lightOrigin.ToFloatPtr() );
+	const __m128 lastOne = _mm_load_ps( (const float *)SIMD_SP_lastOne );
+	int outVerts = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( vertRemap[i] ) {
+			continue;
+		}
+		const __m128 v = LoadVec3( verts[i].xyz.ToFloatPtr() );
+		_mm_storeu_ps( vertexCache[outVerts+0].ToFloatPtr(), _mm_or_ps( v, lastOne ) );
+		_mm_storeu_ps( vertexCache[outVerts+1].ToFloatPtr(), _mm_sub_ps( v, origin ) );
+		vertRemap[i] = outVerts;
+		outVerts += 2;
+	}
+	return outVerts;
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::CreateVertexProgramShadowCache
+============
+*/
+int VPCALL idSIMD_SSE2_Intrin::CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) {
+	const __m128 lastOne = _mm_load_ps( (const float *)SIMD_SP_lastOne );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = LoadVec3( verts[i].xyz.ToFloatPtr() );
+		_mm_storeu_ps( vertexCache[i*2+0].ToFloatPtr(), _mm_or_ps( v, lastOne ) );
+		_mm_storeu_ps( vertexCache[i*2+1].ToFloatPtr(), v );
+	}
+	return numVerts * 2;
+}
+
+/*
+============
+UPSAMPLE_PCM
+
+  Duplicates samples for 44kHz output, CONVERT8 turns eight shorts into two
+  vectors of floats. Shared between the SSE2 and SSE4.1 processors which only
+  differ in the way the shorts are sign extended.
+============
+*/
+#define UPSAMPLE_PCM( CONVERT8 )																		\
+	int i = 0;																							\
+	__m128 f0, f1;																						\
+	if ( kHz == 11025 ) {																				\
+		if ( numChannels == 1 ) {																		\
+			for ( ; i + 8 <= numSamples; i += 8 ) {														\
+				CONVERT8( src + i, f0, f1 );															\
+				_mm_storeu_ps( dest + i*4+ 0, SPLAT( f0, 0 ) );											\
+				_mm_storeu_ps( dest + i*4+ 4, SPLAT( f0, 1 ) );											\
+				_mm_storeu_ps( dest + i*4+ 8, SPLAT( f0, 2 ) );											\
+				_mm_storeu_ps( dest + i*4+12, SPLAT( f0, 3 ) );											\
+				_mm_storeu_ps( dest + i*4+16, SPLAT( f1, 0 ) );											\
+				_mm_storeu_ps( dest + i*4+20, SPLAT( f1, 1 ) );											\
+				_mm_storeu_ps( dest + i*4+24, SPLAT( f1, 2 ) );											\
+				_mm_storeu_ps( dest + i*4+28, SPLAT( f1, 3 ) );											\
+			}																							\
+			for ( ; i < numSamples; i++ ) {																\
+				dest[i*4+0] = dest[i*4+1] = dest[i*4+2] = dest[i*4+3] = (float) src[i+0];				\
+			}																							\
+		} else {																						\
+			for ( ; i + 8 <= numSamples; i += 8 ) {														\
+				CONVERT8( src + i, f0, f1 );															\
+				const __m128 p0 = _mm_movelh_ps( f0, f0 );												\
+				const __m128 p1 = _mm_movehl_ps( f0, f0 );												\
+				const __m128 p2 = _mm_movelh_ps( f1, f1 );												\
+				const __m128 p3 = _mm_movehl_ps( f1, f1 );												\
+				_mm_storeu_ps( dest + i*4+ 0, p0 );														\
+				_mm_storeu_ps( dest + i*4+ 4, p0 );														\
+				_mm_storeu_ps( dest + i*4+ 8, p1 );														\
+				_mm_storeu_ps( dest + i*4+12, p1 );														\
+				_mm_storeu_ps( dest + i*4+16, p2 );														\
+				_mm_storeu_ps( dest + i*4+20, p2 );														\
+				_mm_storeu_ps( dest + i*4+24, p3 );														\
+				_mm_storeu_ps( dest + i*4+28, p3 );														\
+			}																							\
+			for ( ; i < numSamples; i += 2 ) {															\
+				dest[i*4+0] = dest[i*4+2] = dest[i*4+4] = dest[i*4+6] = (float) src[i+0];				\
+				dest[i*4+1] = dest[i*4+3] = dest[i*4+5] = dest[i*4+7] = (float) src[i+1];				\
+			}																							\
+		}																								\
+	} else if ( kHz == 22050 ) {																		\
+		if ( numChannels == 1 ) {																		\
+			for ( ; i + 8 <= numSamples; i += 8 ) {														\
+				CONVERT8( src + i, f0, f1 );															\
+				_mm_storeu_ps( dest + i*2+ 0, _mm_unpacklo_ps( f0, f0 ) );								\
+				_mm_storeu_ps( dest + i*2+ 4, _mm_unpackhi_ps( f0, f0 ) );								\
+				_mm_storeu_ps( dest + i*2+ 8, _mm_unpacklo_ps( f1, f1 ) );								\
+				_mm_storeu_ps( dest + i*2+12, _mm_unpackhi_ps( f1, f1 ) );								\
+			}																							\
+			for ( ; i < numSamples; i++ ) {																\
+				dest[i*2+0] = dest[i*2+1] = (float) src[i+0];											\
+			}																							\
+		} else {																						\
+			for ( ; i + 8 <= numSamples; i += 8 ) {														\
+				CONVERT8( src + i, f0, f1 );															\
+				_mm_storeu_ps( dest + i*2+ 0, _mm_movelh_ps( f0, f0 ) );								\
+				_mm_storeu_ps( dest + i*2+ 4, _mm_movehl_ps( f0, f0 ) );								\
+				_mm_storeu_ps( dest + i*2+ 8, _mm_movelh_ps( f1, f1 ) );								\
+				_mm_storeu_ps( dest + i*2+12, _mm_movehl_ps( f1, f1 ) );								\
+			}																							\
+			for ( ; i < numSamples; i += 2 ) {															\
+				dest[i*2+0] = dest[i*2+2] = (float) src[i+0];											\
+				dest[i*2+1] = dest[i*2+3] = (float) src[i+1];											\
+			}																							\
+		}																								\
+	} else if ( kHz == 44100 ) {																		\
+		for ( ; i + 8 <= numSamples; i += 8 ) {															\
+			CONVERT8( src + i, f0, f1 );																\
+			_mm_storeu_ps( dest + i + 0, f0 );															\
+			_mm_storeu_ps( dest + i + 4, f1 );															\
+		}																								\
+		for ( ; i < numSamples; i++ ) {																	\
+			dest[i] = (float) src[i];																	\
+		}																								\
+	} else {																							\
+		assert( 0 );																					\
+	}
+
+#define CONVERT8_SSE2( p, f0, f1 ) {																	\
+	const __m128i s = _mm_loadu_si128( (const __m128i *)( p ) );										\
+	f0 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 ) );							\
+	f1 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 ) );							\
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::UpSamplePCMTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+void idSIMD_SSE2_Intrin::UpSamplePCMTo44kHz( float *dest, const short *src, const int numSamples, const int kHz, const int numChannels ) {
+	UPSAMPLE_PCM( CONVERT8_SSE2 )
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::UpSampleOGGTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+void idSIMD_SSE2_Intrin::UpSampleOGGTo44kHz( float *dest, const float * const *ogg, const int numSamples, const int kHz, const int numChannels ) {
+	const __m128 scale = _mm_set1_ps( 32768.0f );
+	int i = 0;
+
+	if ( kHz == 11025 ) {
+		if ( numChannels == 1 ) {
+			for ( ; i + 4 <= numSamples; i += 4 ) {
+				const __m128 f = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+				_mm_storeu_ps( dest + i*4+ 0, SPLAT( f, 0 ) );
+				_mm_storeu_ps( dest + i*4+ 4, SPLAT( f, 1 ) );
+				_mm_storeu_ps( dest + i*4+ 8, SPLAT( f, 2 ) );
+				_mm_storeu_ps( dest + i*4+12, SPLAT( f, 3 ) );
+			}
+			for ( ; i < numSamples; i++ ) {
+				dest[i*4+0] = dest[i*4+1] = dest[i*4+2] = dest[i*4+3] = ogg[0][i] * 32768.0f;
+			}
+		} else {
+			for ( ; i + 4 <= numSamples >> 1; i += 4 ) {
+				const __m128 l = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+				const __m128 r = _mm_mul_ps( _mm_loadu_ps( ogg[1] + i ), scale );
+				const __m128 lo = _mm_unpacklo_ps( l, r );
+				const __m128 hi = _mm_unpackhi_ps( l, r );
+				const __m128 p0 = _mm_movelh_ps( lo, lo );
+				const __m128 p1 = _mm_movehl_ps( lo, lo );
+				const __m128 p2 = _mm_movelh_ps( hi, hi );
+				const __m128 p3 = _mm_movehl_ps( hi, hi );
+				_mm_storeu_ps( dest + i*8+ 0, p0 );
+				_mm_storeu_ps( dest + i*8+ 4, p0 );
+				_mm_storeu_ps( dest + i*8+ 8, p1 );
+				_mm_storeu_ps( dest + i*8+12, p1 );
+				_mm_storeu_ps( dest + i*8+16, p2 );
+				_mm_storeu_ps( dest + i*8+20, p2 );
+				_mm_storeu_ps( dest + i*8+24, p3 );
+				_mm_storeu_ps( dest + i*8+28, p3 );
+			}
+			for ( ; i < numSamples >> 1; i++ ) {
+				dest[i*8+0] = dest[i*8+2] = dest[i*8+4] = dest[i*8+6] = ogg[0][i] * 32768.0f;
+				dest[i*8+1] = dest[i*8+3] = dest[i*8+5] = dest[i*8+7] = ogg[1][i] * 32768.0f;
+			}
+		}
+	} else if ( kHz == 22050 ) {
+		if ( numChannels == 1 ) {
+			for ( ; i + 4 <= numSamples; i += 4 ) {
+				const __m128 f = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+				_mm_storeu_ps( dest + i*2+0, _mm_unpacklo_ps( f, f ) );
+				_mm_storeu_ps( dest + i*2+4, _mm_unpackhi_ps( f, f ) );
+			}
+			for ( ; i < numSamples; i++ ) {
+				dest[i*2+0] = dest[i*2+1] = ogg[0][i] * 32768.0f;
+			}
+		} else {
+			for ( ; i + 4 <= numSamples >> 1; i += 4 ) {
+				const __m128 l = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+				const __m128 r = _mm_mul_ps( _mm_loadu_ps( ogg[1] + i ), scale );
+				const __m128 lo = _mm_unpacklo_ps( l, r );
+				const __m128 hi = _mm_unpackhi_ps( l, r );
+				_mm_storeu_ps( dest + i*4+ 0, _mm_movelh_ps( lo, lo ) );
+				_mm_storeu_ps( dest + i*4+ 4, _mm_movehl_ps( lo, lo ) );
+				_mm_storeu_ps( dest + i*4+ 8, _mm_movelh_ps( hi, hi ) );
+				_mm_storeu_ps( dest + i*4+12, _mm_movehl_ps( hi, hi ) );
+			}
+			for ( ; i < numSamples >> 1; i++ ) {
+				dest[i*4+0] = dest[i*4+2] = ogg[0][i] * 32768.0f;
+				dest[i*4+1] = dest[i*4+3] = ogg[1][i] * 32768.0f;
+			}
+		}
+	} else if ( kHz == 44100 ) {
+		if ( numChannels == 1 ) {
+			for ( ; i + 4 <= numSamples; i += 4 ) {
+				_mm_storeu_ps( dest + i, _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale ) );
+			}
+			for ( ; i < numSamples; i++ ) {
+				dest[i*1+0] = ogg[0][i] * 32768.0f;
+			}
+		} else {
+			for ( ; i + 4 <= numSamples >> 1; i += 4 ) {
+				const __m128 l = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+				const __m128 r = _mm_mul_ps( _mm_loadu_ps( ogg[1] + i ), scale );
+				_mm_storeu_ps( dest + i*2+0, _mm_unpacklo_ps( l, r ) );
+				_mm_storeu_ps( dest + i*2+4, _mm_unpackhi_ps( l, r ) );
+			}
+			for ( ; i < numSamples >> 1; i++ ) {
+				dest[i*2+0] = ogg[0][i] * 32768.0f;
+				dest[i*2+1] = ogg[1][i] * 32768.0f;
+			}
+		}
+	} else {
+		assert( 0 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MixSoundTwoSpeakerMono
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	// volumes for samples j+0, j+1 and j+2, j+3
+	__m128 v0 = _mm_setr_ps( lastV[0], lastV[1], lastV[0] + incL, lastV[1] + incR );
+	__m128 v1 = _mm_add_ps( v0, _mm_setr_ps( 2.0f * incL, 2.0f * incR, 2.0f * incL, 2.0f * incR ) );
+	const __m128 inc = _mm_setr_ps( 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR );
+
+	for ( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		const __m128 s = _mm_loadu_ps( samples + j );
+		_mm_storeu_ps( mixBuffer + j*2+0, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2+0 ), _mm_mul_ps( _mm_unpacklo_ps( s, s ), v0 ) ) );
+		_mm_storeu_ps( mixBuffer + j*2+4, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2+4 ), _mm_mul_ps( _mm_unpackhi_ps( s, s ), v1 ) ) );
+		v0 = _mm_add_ps( v0, inc );
+		v1 = _mm_add_ps( v1, inc );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MixSoundTwoSpeakerStereo
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	__m128 v = _mm_setr_ps( lastV[0], lastV[1], lastV[0] + incL, lastV[1] + incR );
+	const __m128 inc = _mm_setr_ps( 2.0f * incL, 2.0f * incR, 2.0f * incL, 2.0f * incR );
+
+	for ( int j = 0; j < MIXBUFFER_SAMPLES; j += 2 ) {
+		_mm_storeu_ps( mixBuffer + j*2, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2 ), _mm_mul_ps( _mm_loadu_ps( samples + j*2 ), v ) ) );
+		v = _mm_add_ps( v, inc );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MixSoundSixSpeakerMono
+
+  two samples are mixed at a time which covers exactly three vectors
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	float inc[6];
+
+	for ( int k = 0; k < 6; k++ ) {
+		inc[k] = ( currentV[k] - lastV[k] ) / MIXBUFFER_SAMPLES;
+	}
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	__m128 v0 = _mm_setr_ps( lastV[0], lastV[1], lastV[2], lastV[3] );
+	__m128 v1 = _mm_setr_ps( lastV[4], lastV[5], lastV[0] + inc[0], lastV[1] + inc[1] );
+	__m128 v2 = _mm_setr_ps( lastV[2] + inc[2], lastV[3] + inc[3], lastV[4] + inc[4], lastV[5] + inc[5] );
+	const __m128 inc0 = _mm_setr_ps( 2.0f * inc[0], 2.0f * inc[1], 2.0f * inc[2], 2.0f * inc[3] );
+	const __m128 inc1 = _mm_setr_ps( 2.0f * inc[4], 2.0f * inc[5], 2.0f * inc[0], 2.0f * inc[1] );
+	const __m128 inc2 = _mm_setr_ps( 2.0f * inc[2], 2.0f * inc[3], 2.0f * inc[4], 2.0f * inc[5] );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		__m128 s = _mm_castpd_ps( _mm_load_sd( (const double *)( samples + i ) ) );
+		s = _mm_unpacklo_ps( s, s );				// s0 s0 s1 s1
+		float *mix = mixBuffer + i * 6;
+		_mm_storeu_ps( mix + 0, _mm_add_ps( _mm_loadu_ps( mix + 0 ), _mm_mul_ps( SPLAT( s, 0 ), v0 ) ) );
+		_mm_storeu_ps( mix + 4, _mm_add_ps( _mm_loadu_ps( mix + 4 ), _mm_mul_ps( s, v1 ) ) );
+		_mm_storeu_ps( mix + 8, _mm_add_ps( _mm_loadu_ps( mix + 8 ), _mm_mul_ps( SPLAT( s, 3 ), v2 ) ) );
+		v0 = _mm_add_ps( v0, inc0 );
+		v1 = _mm_add_ps( v1, inc1 );
+		v2 = _mm_add_ps( v2, inc2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MixSoundSixSpeakerStereo
+
+  the left sample goes to speakers 0, 2, 3, 4 and the right sample to speakers 1, 5
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	float inc[6];
+
+	for ( int k = 0; k < 6; k++ ) {
+		inc[k] = ( currentV[k] - lastV[k] ) / MIXBUFFER_SAMPLES;
+	}
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	__m128 v0 = _mm_setr_ps( lastV[0], lastV[1], lastV[2], lastV[3] );
+	__m128 v1 = _mm_setr_ps( lastV[4], lastV[5], lastV[0] + inc[0], lastV[1] + inc[1] );
+	__m128 v2 = _mm_setr_ps( lastV[2] + inc[2], lastV[3] + inc[3], lastV[4] + inc[4], lastV[5] + inc[5] );
+	const __m128 inc0 = _mm_setr_ps( 2.0f * inc[0], 2.0f * inc[1], 2.0f * inc[2], 2.0f * inc[3] );
+	const __m128 inc1 = _mm_setr_ps( 2.0f * inc[4], 2.0f * inc[5], 2.0f * inc[0], 2.0f * inc[1] );
+	const __m128 inc2 = _mm_setr_ps( 2.0f * inc[2], 2.0f * inc[3], 2.0f * inc[4], 2.0f * inc[5] );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		const __m128 s = _mm_loadu_ps( samples + i * 2 );		// L0 R0 L1 R1
+		float *mix = mixBuffer + i * 6;
+		_mm_storeu_ps( mix + 0, _mm_add_ps( _mm_loadu_ps( mix + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 0, 0, 1, 0 ) ), v0 ) ) );
+		_mm_storeu_ps( mix + 4, _mm_add_ps( _mm_loadu_ps( mix + 4 ), _mm_mul_ps( s, v1 ) ) );
+		_mm_storeu_ps( mix + 8, _mm_add_ps( _mm_loadu_ps( mix + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 3, 2, 2, 2 ) ), v2 ) ) );
+		v0 = _mm_add_ps( v0, inc0 );
+		v1 = _mm_add_ps( v1, inc1 );
+		v2 = _mm_add_ps( v2, inc2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2_Intrin::MixedSoundToSamples
+============
+*/
+void VPCALL idSIMD_SSE2_Intrin::MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) {
+	const __m128 vmin = _mm_set1_ps( -32768.0f );
+	const __m128 vmax = _mm_set1_ps( 32767.0f );
+	int i;
+
+	for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+		const __m128i s0 = _mm_cvttps_epi32( _mm_min_ps( _mm_max_ps( _mm_loadu_ps( mixBuffer + i + 0 ), vmin ), vmax ) );
+		const __m128i s1 = _mm_cvttps_epi32( _mm_min_ps( _mm_max_ps( _mm_loadu_ps( mixBuffer + i + 4 ), vmin ), vmax ) );
+		_mm_storeu_si128( (__m128i *)( samples + i ), _mm_packs_epi32( s0, s1 ) );
+	}
+
+	for ( ; i < numSamples; i++ ) {
+		if ( mixBuffer[i] <= -32768.0f ) {
+			samples[i] = -32768;
+		} else if ( mixBuffer[i] >= 32767.0f ) {
+			samples[i] = 32767;
+		} else {
+			samples[i] = (short) mixBuffer[i];
+		}
+	}
+}
+
+//===============================================================
+//
+//	SSE4.1
+//
+//===============================================================
+
+/*
+============
+idSIMD_SSE41_Intrin::GetName
+============
+*/
+const char * idSIMD_SSE41_Intrin::GetName( void ) const {
+	return "SSE2 & SSE4.1 (intrinsics)";
+}
+
+/*
+============
+idSIMD_SSE41_Intrin::CreateShadowCache
+============
+*/
+ID_TARGET_SSE41 int VPCALL idSIMD_SSE41_Intrin::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	const __m128 origin = _mm_setr_ps( lightOrigin[0], lightOrigin[1], lightOrigin[2], 0.0f );
+	const __m128 one = _mm_set1_ps( 1.0f );
+	int outVerts = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( vertRemap[i] ) {
+			continue;
+		}
+		// the fourth component is read from the st of the vertex and replaced by the blends
+		const __m128 v = _mm_loadu_ps( verts[i].xyz.ToFloatPtr() );
+		_mm_storeu_ps( vertexCache[outVerts+0].ToFloatPtr(), _mm_blend_ps( v, one, 8 ) );
+		_mm_storeu_ps( vertexCache[outVerts+1].ToFloatPtr(), _mm_blend_ps( _mm_sub_ps( v, origin ), _mm_setzero_ps(), 8 ) );
+		vertRemap[i] = outVerts;
+		outVerts += 2;
+	}
+	return outVerts;
+}
+
+/*
+============
+idSIMD_SSE41_Intrin::CreateVertexProgramShadowCache
+============
+*/
+ID_TARGET_SSE41 int VPCALL idSIMD_SSE41_Intrin::CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) {
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = _mm_loadu_ps( verts[i].xyz.ToFloatPtr() );
+		_mm_storeu_ps( vertexCache[i*2+0].ToFloatPtr(), _mm_blend_ps( v, one, 8 ) );
+		_mm_storeu_ps( vertexCache[i*2+1].ToFloatPtr(), _mm_blend_ps( v, _mm_setzero_ps(), 8 ) );
+	}
+	return numVerts * 2;
+}
+
+#define CONVERT8_SSE41( p, f0, f1 ) {																	\
+	const __m128i s = _mm_loadu_si128( (const __m128i *)( p ) );										\
+	f0 = _mm_cvtepi32_ps( _mm_cvtepi16_epi32( s ) );													\
+	f1 = _mm_cvtepi32_ps( _mm_cvtepi16_epi32( _mm_srli_si128( s, 8 ) ) );								\
+}
+
+/*
+============
+idSIMD_SSE41_Intrin::UpSamplePCMTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+ID_TARGET_SSE41 void idSIMD_SSE41_Intrin::UpSamplePCMTo44kHz( float *dest, const short *src, const int numSamples, const int kHz, const int numChannels ) {
+	UPSAMPLE_PCM( CONVERT8_SSE41 )
+}
+
+//===============================================================
+//
+//	AVX2
+//
+//===============================================================
+
+/*
+============
+idSIMD_AVX2_Intrin::GetName
+============
+*/
+const char * idSIMD_AVX2_Intrin::GetName( void ) const {
+	return "SSE2 & SSE4.1 & AVX2 (intrinsics)";
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Add
+
+  dst[i] = constant + src[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Add( float *dst, const float constant, const float *src, const int count ) {
+	const __m256 c = _mm256_set1_ps( constant );
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_add_ps( _mm256_loadu_ps( src + (X) ), c ) );
+#define OPER1(X) dst[(X)] = src[(X)] + constant;
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Add
+
+  dst[i] = src0[i] + src1[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Add( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_add_ps( _mm256_loadu_ps( src0 + (X) ), _mm256_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] + src1[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Sub
+
+  dst[i] = constant - src[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Sub( float *dst, const float constant, const float *src, const int count ) {
+	const __m256 c = _mm256_set1_ps( constant );
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_sub_ps( c, _mm256_loadu_ps( src + (X) ) ) );
+#define OPER1(X) dst[(X)] = constant - src[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Sub
+
+  dst[i] = src0[i] - src1[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Sub( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_sub_ps( _mm256_loadu_ps( src0 + (X) ), _mm256_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] - src1[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Mul
+
+  dst[i] = constant * src[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Mul( float *dst, const float constant, const float *src, const int count ) {
+	const __m256 c = _mm256_set1_ps( constant );
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_mul_ps( c, _mm256_loadu_ps( src + (X) ) ) );
+#define OPER1(X) dst[(X)] = constant * src[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Mul
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Mul( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_mul_ps( _mm256_loadu_ps( src0 + (X) ), _mm256_loadu_ps( src1 + (X) ) ) );
+#define OPER1(X) dst[(X)] = src0[(X)] * src1[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MulAdd
+
+  dst[i] += constant * src[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MulAdd( float *dst, const float constant, const float *src, const int count ) {
+	const __m256 c = _mm256_set1_ps( constant );
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_add_ps( _mm256_loadu_ps( dst + (X) ), _mm256_mul_ps( c, _mm256_loadu_ps( src + (X) ) ) ) );
+#define OPER1(X) dst[(X)] += constant * src[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MulAdd
+
+  dst[i] += src0[i] * src1[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MulAdd( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_add_ps( _mm256_loadu_ps( dst + (X) ), _mm256_mul_ps( _mm256_loadu_ps( src0 + (X) ), _mm256_loadu_ps( src1 + (X) ) ) ) );
+#define OPER1(X) dst[(X)] += src0[(X)] * src1[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MulSub
+
+  dst[i] -= constant * src[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MulSub( float *dst, const float constant, const float *src, const int count ) {
+	const __m256 c = _mm256_set1_ps( constant );
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_sub_ps( _mm256_loadu_ps( dst + (X) ), _mm256_mul_ps( c, _mm256_loadu_ps( src + (X) ) ) ) );
+#define OPER1(X) dst[(X)] -= constant * src[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MulSub
+
+  dst[i] -= src0[i] * src1[i];
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MulSub( float *dst, const float *src0, const float *src1, const int count ) {
+#define OPER8(X) _mm256_storeu_ps( dst + (X), _mm256_sub_ps( _mm256_loadu_ps( dst + (X) ), _mm256_mul_ps( _mm256_loadu_ps( src0 + (X) ), _mm256_loadu_ps( src1 + (X) ) ) ) );
+#define OPER1(X) dst[(X)] -= src0[(X)] * src1[(X)];
+	UNROLL_AVX( OPER8, OPER1 )
+#undef OPER1
+#undef OPER8
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::Dot
+
+  dot = src1[0] * src2[0] + src1[1] * src2[1] + src1[2] * src2[2] + ...
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::Dot( float &dot, const float *src1, const float *src2, const int count ) {
+	__m256 s0 = _mm256_setzero_ps();
+	__m256 s1 = _mm256_setzero_ps();
+	int i;
+
+	for ( i = 0; i + 16 <= count; i += 16 ) {
+		s0 = _mm256_add_ps( s0, _mm256_mul_ps( _mm256_loadu_ps( src1 + i + 0 ), _mm256_loadu_ps( src2 + i + 0 ) ) );
+		s1 = _mm256_add_ps( s1, _mm256_mul_ps( _mm256_loadu_ps( src1 + i + 8 ), _mm256_loadu_ps( src2 + i + 8 ) ) );
+	}
+	if ( i + 8 <= count ) {
+		s0 = _mm256_add_ps( s0, _mm256_mul_ps( _mm256_loadu_ps( src1 + i ), _mm256_loadu_ps( src2 + i ) ) );
+		i += 8;
+	}
+	s0 = _mm256_add_ps( s0, s1 );
+	const __m128 s = _mm_add_ps( _mm256_castps256_ps128( s0 ), _mm256_extractf128_ps( s0, 1 ) );
+	float sum = _mm_cvtss_f32( HorizontalSum( s ) );
+	for ( ; i < count; i++ ) {
+		sum += src1[i] * src2[i];
+	}
+	dot = sum;
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MixSoundTwoSpeakerMono
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	// volumes for samples j+0 to j+3 and j+4 to j+7
+	__m256 v0 = _mm256_setr_ps( lastV[0], lastV[1], lastV[0] + incL, lastV[1] + incR,
+								lastV[0] + 2.0f * incL, lastV[1] + 2.0f * incR, lastV[0] + 3.0f * incL, lastV[1] + 3.0f * incR );
+	__m256 v1 = _mm256_add_ps( v0, _mm256_setr_ps( 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR ) );
+	const __m256 inc = _mm256_setr_ps( 8.0f * incL, 8.0f * incR, 8.0f * incL, 8.0f * incR, 8.0f * incL, 8.0f * incR, 8.0f * incL, 8.0f * incR );
+
+	for ( int j = 0; j < MIXBUFFER_SAMPLES; j += 8 ) {
+		const __m256 s = _mm256_loadu_ps( samples + j );
+		const __m256 lo = _mm256_unpacklo_ps( s, s );		// s0 s0 s1 s1 | s4 s4 s5 s5
+		const __m256 hi = _mm256_unpackhi_ps( s, s );		// s2 s2 s3 s3 | s6 s6 s7 s7
+		const __m256 s0 = _mm256_permute2f128_ps( lo, hi, 0x20 );
+		const __m256 s1 = _mm256_permute2f128_ps( lo, hi, 0x31 );
+		_mm256_storeu_ps( mixBuffer + j*2+0, _mm256_add_ps( _mm256_loadu_ps( mixBuffer + j*2+0 ), _mm256_mul_ps( s0, v0 ) ) );
+		_mm256_storeu_ps( mixBuffer + j*2+8, _mm256_add_ps( _mm256_loadu_ps( mixBuffer + j*2+8 ), _mm256_mul_ps( s1, v1 ) ) );
+		v0 = _mm256_add_ps( v0, inc );
+		v1 = _mm256_add_ps( v1, inc );
+	}
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MixSoundTwoSpeakerStereo
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	__m256 v = _mm256_setr_ps( lastV[0], lastV[1], lastV[0] + incL, lastV[1] + incR,
+								lastV[0] + 2.0f * incL, lastV[1] + 2.0f * incR, lastV[0] + 3.0f * incL, lastV[1] + 3.0f * incR );
+	const __m256 inc = _mm256_setr_ps( 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR );
+
+	for ( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		_mm256_storeu_ps( mixBuffer + j*2, _mm256_add_ps( _mm256_loadu_ps( mixBuffer + j*2 ), _mm256_mul_ps( _mm256_loadu_ps( samples + j*2 ), v ) ) );
+		v = _mm256_add_ps( v, inc );
+	}
+}
+
+/*
+============
+idSIMD_AVX2_Intrin::MixedSoundToSamples
+============
+*/
+ID_TARGET_AVX2 void VPCALL idSIMD_AVX2_Intrin::MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) {
+	const __m256 vmin = _mm256_set1_ps( -32768.0f );
+	const __m256 vmax = _mm256_set1_ps( 32767.0f );
+	int i;
+
+	for ( i = 0; i + 16 <= numSamples; i += 16 ) {
+		const __m256i s0 = _mm256_cvttps_epi32( _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( mixBuffer + i + 0 ), vmin ), vmax ) );
+		const __m256i s1 = _mm256_cvttps_epi32( _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( mixBuffer + i + 8 ), vmin ), vmax ) );
+		// the pack works on the 128 bit lanes so the quad words have to be put back in order
+		const __m256i s = _mm256_permute4x64_epi64( _mm256_packs_epi32( s0, s1 ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
+		_mm256_storeu_si256( (__m256i *)( samples + i ), s );
+	}
+
+	for ( ; i < numSamples; i++ ) {
+		if ( mixBuffer[i] <= -32768.0f ) {
+			samples[i] = -32768;
+		} else if ( mixBuffer[i] >= 32767.0f ) {
+			samples[i] = 32767;
+		} else {
+			samples[i] = (short) mixBuffer[i];
+		}
+	}
+}
+
+#endif /* ID_SIMD_INTRIN */
@@ -30,6 +30,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "renderer/tr_local.h"
 #include "renderer/RenderWorld_local.h"
 #include "renderer/VertexCache.h"
+#include "renderer/ShadowVolumeCache.h"
 
 #include "renderer/Interaction.h"
 
@@ -292,7 +293,7 @@ static srfTriangles_t *R_CreateLightTris( const idRenderEntityLocal *ent,
 	bool		includeBackFaces;
 	int			faceNum;
 
-	tr.pc.c_createLightTris++;
+	R_FrontEndCounters().c_createLightTris++;
 	c_backfaced = 0;
 	c_distance = 0;
 
@@ -506,11 +507,45 @@ idInteraction *idInteraction::AllocAndLink( idRenderEntityLocal *edef, idRenderL
 			common->Error( "idInteraction::AllocAndLink: non NULL table entry" );
 		}
 		renderWorld->interactionTable[ index ] = interaction;
+	} else if ( renderWorld->interactionHash.IsAllocated() ) {
+		renderWorld->interactionHash.Add( ldef->index, edef->index, interaction );
 	}
 
 	return interaction;
 }
 
+/*
+===============
+R_InteractionShadowGen
+===============
+*/
+static shadowGen_t R_InteractionShadowGen( const idRenderEntityLocal *def, const idRenderModel *model ) {
+	idBounds bounds = model->Bounds( &def->parms );
+
+	// really large models, like outside terrain meshes, should use
+	// the more exactly culled static shadow path instead of the turbo shadow path.
+	// FIXME: this is a HACK, we should probably have a material flag.
+	if ( bounds[1][0] - bounds[0][0] > 3000 ) {
+		return SG_STATIC;
+	}
+
+	// use the turbo shadow path
+	return SG_DYNAMIC;
+}
+
+/*
+===============
+R_ShadowSeeThrough
+
+If any surface is a shadow-casting perforated or translucent surface, or the
+base surface is suppressed in the view (world weapon shadows) we can't use
+the external shadow optimizations because we can see through some of the faces.
+===============
+*/
+static bool R_ShadowSeeThrough( const idRenderEntityLocal *def, const idMaterial *shader ) {
+	return ( shader->Coverage() != MC_OPAQUE || ( !r_skipSuppress.GetBool() && def->parms.suppressSurfaceInViewID ) );
+}
+
 /*
 ===============
 idInteraction::FreeSurfaces
@@ -534,7 +569,15 @@ void idInteraction::FreeSurfaces( void ) {
 				// if it doesn't have an entityDef, it is part of a prelight
 				// model, not a generated interaction
 				if ( this->entityDef ) {
-					R_FreeStaticTriSurf( sint->shadowTris );
+					// the entity and light are freed before they are changed, so this is
+					// still the model and setup the shadow volume was created with
+					const idRenderModel *model = this->entityDef->parms.hModel;
+					if ( model && shadowVolumeCache.IsEnabled( model ) ) {
+						shadowVolumeCache.Release( this->entityDef, this->lightDef, model, sint->ambientTris,
+							R_InteractionShadowGen( this->entityDef, model ), R_ShadowSeeThrough( this->entityDef, sint->shader ), sint->shadowTris );
+					} else {
+						R_FreeStaticTriSurf( sint->shadowTris );
+					}
 					sint->shadowTris = NULL;
 				}
 			}
@@ -598,6 +641,10 @@ void idInteraction::UnlinkAndFree( void ) {
 			common->Error( "idInteraction::UnlinkAndFree: interactionTable wasn't set" );
 		}
 		renderWorld->interactionTable[index] = NULL;
+	} else if ( renderWorld->interactionHash.IsAllocated() ) {
+		if ( !renderWorld->interactionHash.Remove( this->lightDef->index, this->entityDef->index ) ) {
+			common->Error( "idInteraction::UnlinkAndFree: interactionHash wasn't set" );
+		}
 	}
 
 	Unlink();
@@ -828,7 +875,7 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	bool				interactionGenerated;
 	idBounds			bounds;
 
-	tr.pc.c_createInteractions++;
+	R_FrontEndCounters().c_createInteractions++;
 
 	bounds = model->Bounds( &entityDef->parms );
 
@@ -838,15 +885,10 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 		return;
 	}
 
-	// use the turbo shadow path
-	shadowGen_t shadowGen = SG_DYNAMIC;
+	shadowGen_t shadowGen = R_InteractionShadowGen( entityDef, model );
 
-	// really large models, like outside terrain meshes, should use
-	// the more exactly culled static shadow path instead of the turbo shadow path.
-	// FIXME: this is a HACK, we should probably have a material flag.
-	if ( bounds[1][0] - bounds[0][0] > 3000 ) {
-		shadowGen = SG_STATIC;
-	}
+	// shadow volumes of static models may still be around from an earlier interaction
+	const bool cacheShadows = shadowVolumeCache.IsEnabled( model );
 
 	//
 	// create slots for each of the model's surfaces
@@ -912,13 +954,16 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 			// if the light has an optimized shadow volume, don't create shadows for any models that are part of the base areas
 			if ( lightDef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || !r_useOptimizedShadows.GetBool() ) {
 
-				// this is the only place during gameplay (outside the utilities) that R_CreateShadowVolume() is called
-				sint->shadowTris = R_CreateShadowVolume( entityDef, tri, lightDef, shadowGen, sint->cullInfo );
-				if ( sint->shadowTris ) {
-					if ( shader->Coverage() != MC_OPAQUE || ( !r_skipSuppress.GetBool() && entityDef->parms.suppressSurfaceInViewID ) ) {
-						// if any surface is a shadow-casting perforated or translucent surface, or the
-						// base surface is suppressed in the view (world weapon shadows) we can't use
-						// the external shadow optimizations because we can see through some of the faces
+				const bool seeThrough = R_ShadowSeeThrough( entityDef, shader );
+
+				if ( cacheShadows ) {
+					sint->shadowTris = shadowVolumeCache.Find( entityDef, lightDef, tri, shadowGen, seeThrough );
+				}
+
+				if ( !sint->shadowTris ) {
+					// this is the only place during gameplay (outside the utilities) that R_CreateShadowVolume() is called
+					sint->shadowTris = R_CreateShadowVolume( entityDef, tri, lightDef, shadowGen, sint->cullInfo );
+					if ( sint->shadowTris && seeThrough ) {
 						sint->shadowTris->numShadowIndexesNoCaps = sint->shadowTris->numIndexes;
 						sint->shadowTris->numShadowIndexesNoFrontCaps = sint->shadowTris->numIndexes;
 					}
@@ -1014,37 +1059,22 @@ static bool R_PotentiallyInsideInfiniteShadow( const srfTriangles_t *occluder,
 
 /*
 ==================
-idInteraction::AddActiveInteraction
-
-Create and add any necessary light and shadow triangles
-
-If the model doesn't have any surfaces that need interactions
-with this type of light, it can be skipped, but we might need to
-instantiate the dynamic model to find out
+idInteraction::CalcShadowScissor
 ==================
 */
-void idInteraction::AddActiveInteraction( void ) {
-	viewLight_t *	vLight;
-	viewEntity_t *	vEntity;
-	idScreenRect	shadowScissor;
-	idScreenRect	lightScissor;
-	idVec3			localLightOrigin;
-	idVec3			localViewOrigin;
-
-	vLight = lightDef->viewLight;
-	vEntity = entityDef->viewEntity;
+idInteraction::scissorResult_t idInteraction::CalcShadowScissor( idScreenRect &shadowScissor, bool inJob ) {
 
 	// do not waste time culling the interaction frustum if there will be no shadows
 	if ( !HasShadows() ) {
 
 		// use the entity scissor rectangle
-		shadowScissor = vEntity->scissorRect;
+		shadowScissor = entityDef->viewEntity->scissorRect;
 
 	// culling does not seem to be worth it for static world models
 	} else if ( entityDef->parms.hModel->IsStaticWorldModel() ) {
 
 		// use the light scissor rectangle
-		shadowScissor = vLight->scissorRect;
+		shadowScissor = lightDef->viewLight->scissorRect;
 
 	} else {
 
@@ -1052,7 +1082,16 @@ void idInteraction::AddActiveInteraction( void ) {
 		// this will also cull the case where the light origin is inside the
 		// view frustum and the entity bounds are outside the view frustum
 		if ( CullInteractionByViewFrustum( tr.viewDef->viewFrustum ) ) {
-			return;
+			return SCISSOR_CULLED;
+		}
+
+		// flooding the frustum areas allocates from and walks the world, and
+		// the nvidia scissor code uses static buffers
+		if ( inJob ) {
+			const int useScissors = r_useInteractionScissors.GetInteger();
+			if ( useScissors < 0 || ( useScissors > 1 && frustumState == idInteraction::FRUSTUM_VALID ) ) {
+				return SCISSOR_MAIN_THREAD;
+			}
 		}
 
 		// calculate the shadow scissor rectangle
@@ -1061,9 +1100,48 @@ void idInteraction::AddActiveInteraction( void ) {
 
 	// get out before making the dynamic model if the shadow scissor rectangle is empty
 	if ( shadowScissor.IsEmpty() ) {
+		return SCISSOR_CULLED;
+	}
+
+	return SCISSOR_VISIBLE;
+}
+
+/*
+==================
+idInteraction::AddActiveInteraction
+
+Create and add any necessary light and shadow triangles
+
+If the model doesn't have any surfaces that need interactions
+with this type of light, it can be skipped, but we might need to
+instantiate the dynamic model to find out
+==================
+*/
+void idInteraction::AddActiveInteraction( void ) {
+	idScreenRect	shadowScissor;
+
+	if ( CalcShadowScissor( shadowScissor, false ) != SCISSOR_VISIBLE ) {
 		return;
 	}
 
+	AddActiveInteraction( shadowScissor );
+}
+
+/*
+==================
+idInteraction::AddActiveInteraction
+==================
+*/
+void idInteraction::AddActiveInteraction( const idScreenRect &shadowScissor ) {
+	viewLight_t *	vLight;
+	viewEntity_t *	vEntity;
+	idScreenRect	lightScissor;
+	idVec3			localLightOrigin;
+	idVec3			localViewOrigin;
+
+	vLight = lightDef->viewLight;
+	vEntity = entityDef->viewEntity;
+
 	// We will need the dynamic surface created to make interactions, even if the
 	// model itself wasn't visible.  This just returns a cached value after it
 	// has been generated once in the view.
@@ -1245,6 +1323,175 @@ void idInteraction::AddActiveInteraction( void ) {
 	}
 }
 
+/*
+===============================================================================
+
+	idInteractionHash
+
+===============================================================================
+*/
+
+/*
+===================
+idInteractionHash::idInteractionHash
+===================
+*/
+idInteractionHash::idInteractionHash( void ) {
+	entries = NULL;
+	tableSize = 0;
+	numEntries = 0;
+}
+
+/*
+===================
+idInteractionHash::~idInteractionHash
+===================
+*/
+idInteractionHash::~idInteractionHash( void ) {
+	Shutdown();
+}
+
+/*
+===================
+idInteractionHash::Init
+===================
+*/
+void idInteractionHash::Init( int numInteractions ) {
+	Shutdown();
+	Resize( idMath::CeilPowerOfTwo( Max( numInteractions * 2, 1024 ) ) );
+}
+
+/*
+===================
+idInteractionHash::Shutdown
+===================
+*/
+void idInteractionHash::Shutdown( void ) {
+	if ( entries ) {
+		R_StaticFree( entries );
+	}
+	entries = NULL;
+	tableSize = 0;
+	numEntries = 0;
+}
+
+/*
+===================
+idInteractionHash::Resize
+===================
+*/
+void idInteractionHash::Resize( int newSize ) {
+	interactionHashEntry_t *oldEntries = entries;
+	int oldSize = tableSize;
+
+	entries = (interactionHashEntry_t *)R_StaticAlloc( newSize * sizeof( entries[0] ) );
+	tableSize = newSize;
+	numEntries = 0;
+	for ( int i = 0; i < newSize; i++ ) {
+		entries[i].lightIndex = -1;
+		entries[i].entityIndex = -1;
+		entries[i].interaction = NULL;
+	}
+
+	if ( oldEntries ) {
+		for ( int i = 0; i < oldSize; i++ ) {
+			if ( oldEntries[i].lightIndex != -1 ) {
+				Add( oldEntries[i].lightIndex, oldEntries[i].entityIndex, oldEntries[i].interaction );
+			}
+		}
+		R_StaticFree( oldEntries );
+	}
+}
+
+/*
+===================
+idInteractionHash::Add
+===================
+*/
+void idInteractionHash::Add( int lightIndex, int entityIndex, idInteraction *interaction ) {
+	// keep the table at most half full so the probe sequences stay short
+	if ( ( numEntries + 1 ) * 2 > tableSize ) {
+		Resize( Max( tableSize * 2, 1024 ) );
+	}
+
+	int i;
+	for ( i = Slot( lightIndex, entityIndex ); entries[i].lightIndex != -1; i = ( i + 1 ) & ( tableSize - 1 ) ) {
+		if ( entries[i].lightIndex == lightIndex && entries[i].entityIndex == entityIndex ) {
+			common->Error( "idInteractionHash::Add: interaction already in table" );
+		}
+	}
+	entries[i].lightIndex = lightIndex;
+	entries[i].entityIndex = entityIndex;
+	entries[i].interaction = interaction;
+	numEntries++;
+}
+
+/*
+===================
+idInteractionHash::Remove
+
+Shifts the entries that follow in the probe sequence back into the
+freed slot, so no tombstones are needed.
+===================
+*/
+bool idInteractionHash::Remove( int lightIndex, int entityIndex ) {
+	const int mask = tableSize - 1;
+	int i;
+
+	if ( !entries ) {
+		return false;
+	}
+
+	for ( i = Slot( lightIndex, entityIndex ); ; i = ( i + 1 ) & mask ) {
+		if ( entries[i].lightIndex == -1 ) {
+			return false;
+		}
+		if ( entries[i].lightIndex == lightIndex && entries[i].entityIndex == entityIndex ) {
+			break;
+		}
+	}
+
+	for ( int j = ( i + 1 ) & mask; entries[j].lightIndex != -1; j = ( j + 1 ) & mask ) {
+		int home = Slot( entries[j].lightIndex, entries[j].entityIndex );
+
+		// the entry can move back to the hole if its home slot isn't cyclically inside ( i, j ]
+		if ( ( ( j - home ) & mask ) >= ( ( j - i ) & mask ) ) {
+			entries[i] = entries[j];
+			i = j;
+		}
+	}
+
+	entries[i].lightIndex = -1;
+	entries[i].entityIndex = -1;
+	entries[i].interaction = NULL;
+	numEntries--;
+	return true;
+}
+
+/*
+===================
+idInteractionHash::GetProbeStats
+
+Average and longest number of slots a successful lookup has to look at.
+===================
+*/
+void idInteractionHash::GetProbeStats( float &average, int &longest ) const {
+	int total = 0;
+
+	longest = 0;
+	for ( int i = 0; i < tableSize; i++ ) {
+		if ( entries[i].lightIndex == -1 ) {
+			continue;
+		}
+		int probes = ( ( i - Slot( entries[i].lightIndex, entries[i].entityIndex ) ) & ( tableSize - 1 ) ) + 1;
+		total += probes;
+		if ( probes > longest ) {
+			longest = probes;
+		}
+	}
+	average = numEntries ? (float)total / numEntries : 0.0f;
+}
+
 /*
 ===================
 R_ShowInteractionMemory_f
@@ -1307,4 +1554,20 @@ void R_ShowInteractionMemory_f( const idCmdArgs &args ) {
 	common->Printf( "%i deferred interactions, %i empty interactions\n", deferredInteractions, emptyInteractions );
 	common->Printf( "%5i indexes %5i verts in %5i light tris\n", lightTriIndexes, lightTriVerts, lightTris );
 	common->Printf( "%5i indexes %5i verts in %5i shadow tris\n", shadowTriIndexes, shadowTriVerts, shadowTris );
+
+	const idRenderWorldLocal *world = tr.primaryWorld;
+	if ( world->interactionTable ) {
+		common->Printf( "full interaction table: %i * %i, %ik\n", world->interactionTableWidth, world->interactionTableHeight,
+			(int)( world->interactionTableWidth * world->interactionTableHeight * sizeof( world->interactionTable[0] ) / 1024 ) );
+	} else if ( world->interactionHash.IsAllocated() ) {
+		float averageProbes;
+		int longestProbe;
+		world->interactionHash.GetProbeStats( averageProbes, longestProbe );
+		common->Printf( "sparse interaction table: %i of %i slots used, %ik, %.2f average probes, %i longest\n",
+			world->interactionHash.Num(), world->interactionHash.Size(), world->interactionHash.MemoryUsed() / 1024,
+			averageProbes, longestProbe );
+	} else {
+		common->Printf( "no interaction table\n" );
+	}
+	shadowVolumeCache.PrintStats();
 }
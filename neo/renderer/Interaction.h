@@ -146,10 +146,24 @@ public:
 	// will be used to determine when we need to start purging old interactions
 	int						MemoryUsed( void );
 
+	typedef enum {
+		SCISSOR_CULLED,						// nothing of the interaction is visible
+		SCISSOR_VISIBLE,					// the shadow scissor rectangle is valid
+		SCISSOR_MAIN_THREAD					// has to be calculated again on the main thread
+	} scissorResult_t;
+
+	// culls the interaction against the view and calculates the shadow scissor rectangle
+	// when called from a front end job the interactions that need their frustum areas
+	// flooded through the world return SCISSOR_MAIN_THREAD
+	scissorResult_t			CalcShadowScissor( idScreenRect &shadowScissor, bool inJob );
+
 	// makes sure all necessary light surfaces and shadow surfaces are created, and
 	// calls R_LinkLightSurf() for each one
 	void					AddActiveInteraction( void );
 
+	// same as above, with a shadow scissor rectangle from CalcShadowScissor
+	void					AddActiveInteraction( const idScreenRect &shadowScissor );
+
 private:
 	enum {
 		FRUSTUM_UNINITIALIZED,
@@ -179,6 +193,72 @@ private:
 };
 
 
+/*
+===============================================================================
+
+	Sparse lookup of the interaction between a lightDef and an entityDef.
+
+	Open addressing hash table with linear probing, keyed by the lightDef
+	and entityDef indexes.  It is used instead of the full entityDefs *
+	lightDefs interaction table on maps where that would take too much
+	memory.  The table is kept at most half full, and removal shifts the
+	following entries back, so lookups never have to skip deleted slots.
+
+===============================================================================
+*/
+
+typedef struct {
+	int						lightIndex;				// -1 if the slot is empty
+	int						entityIndex;
+	idInteraction *			interaction;
+} interactionHashEntry_t;
+
+class idInteractionHash {
+public:
+							idInteractionHash( void );
+							~idInteractionHash( void );
+
+	void					Init( int numInteractions );	// allocates for an expected number of interactions
+	void					Shutdown( void );
+	bool					IsAllocated( void ) const { return entries != NULL; }
+
+	idInteraction *			Find( int lightIndex, int entityIndex ) const;
+	void					Add( int lightIndex, int entityIndex, idInteraction *interaction );
+	bool					Remove( int lightIndex, int entityIndex );
+
+	int						Num( void ) const { return numEntries; }
+	int						Size( void ) const { return tableSize; }
+	int						MemoryUsed( void ) const { return tableSize * sizeof( entries[0] ); }
+	void					GetProbeStats( float &average, int &longest ) const;
+
+private:
+	interactionHashEntry_t *entries;
+	int						tableSize;				// always a power of two
+	int						numEntries;
+
+	int						Slot( int lightIndex, int entityIndex ) const;
+	void					Resize( int newSize );
+};
+
+ID_INLINE int idInteractionHash::Slot( int lightIndex, int entityIndex ) const {
+	unsigned int h = (unsigned int)lightIndex * 0x9E3779B1u ^ (unsigned int)entityIndex * 0x85EBCA6Bu;
+	h ^= h >> 15;
+	return h & ( tableSize - 1 );
+}
+
+ID_INLINE idInteraction *idInteractionHash::Find( int lightIndex, int entityIndex ) const {
+	for ( int i = Slot( lightIndex, entityIndex ); ; i = ( i + 1 ) & ( tableSize - 1 ) ) {
+		const interactionHashEntry_t &entry = entries[i];
+		if ( entry.lightIndex == lightIndex && entry.entityIndex == entityIndex ) {
+			return entry.interaction;
+		}
+		if ( entry.lightIndex == -1 ) {
+			return NULL;
+		}
+	}
+}
+
+
 void R_CalcInteractionFacing( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idRenderLightLocal *light, srfCullInfo_t &cullInfo );
 void R_CalcInteractionCullBits( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idRenderLightLocal *light, srfCullInfo_t &cullInfo );
 void R_FreeInteractionCullInfo( srfCullInfo_t &cullInfo );
@@ -94,6 +94,7 @@ void idMaterial::CommonInit() {
 	numRegisters = 0;
 	expressionRegisters = NULL;
 	constantRegisters = NULL;
+	soundRegisters = false;
 	numStages = 0;
 	numAmbientStages = 0;
 	stages = NULL;
@@ -2303,6 +2304,13 @@ bool idMaterial::Parse( const char *text, const int textLength ) {
 		memcpy( ops, pd->shaderOps, numOps * sizeof( ops[0] ) );
 	}
 
+	for ( i = 0 ; i < numOps ; i++ ) {
+		if ( ops[i].opType == OP_TYPE_SOUND ) {
+			soundRegisters = true;
+			break;
+		}
+	}
+
 	if ( numRegisters ) {
 		expressionRegisters = (float *)R_StaticAlloc( numRegisters * sizeof( expressionRegisters[0] ) );
 		memcpy( expressionRegisters, pd->shaderRegisters, numRegisters * sizeof( expressionRegisters[0] ) );
@@ -587,6 +587,10 @@ public:
 						// to be called.  If NULL is returned, EvaluateRegisters must be used.
 	const float *		ConstantRegisters() const;
 
+						// true if the registers depend on the amplitude of the sound emitter passed to
+						// EvaluateRegisters, which isn't safe to evaluate outside of the main thread
+	bool				ReferencesSoundAmplitude() const		{ return soundRegisters; };
+
 	bool				SuppressInSubview() const				{ return suppressInSubview; };
 	bool				IsPortalSky() const						{ return portalSky; };
 	void				AddReference();
@@ -668,6 +672,7 @@ private:
 	float *				expressionRegisters;
 
 	float *				constantRegisters;	// NULL if ops ever reference globalParms or entityParms
+	bool				soundRegisters;		// true if any op is OP_TYPE_SOUND
 
 	int					numStages;
 	int					numAmbientStages;
@@ -29,12 +29,14 @@ If you have questions concerning this license or the applicable additional terms
 #include "sys/platform.h"
 #include "idlib/containers/VectorSet.h"
 #include "framework/DemoFile.h"
+#include "framework/FileSystem.h"
 #include "renderer/tr_local.h"
 #include "renderer/Model_local.h"
 #include "renderer/Model_ase.h"
 #include "renderer/Model_lwo.h"
 #include "renderer/Model_ma.h"
 #include "renderer/VertexCache.h"
+#include "renderer/ShadowVolumeCache.h"
 
 #include "renderer/Model.h"
 
@@ -62,6 +64,8 @@ idRenderModelStatic::idRenderModelStatic() {
 	reloadable = true;
 	levelLoadReferenced = false;
 	timeStamp = 0;
+	cacheMissRatioBefore = 0.0f;
+	cacheMissRatioAfter = 0.0f;
 }
 
 /*
@@ -174,6 +178,9 @@ void idRenderModelStatic::List() const {
 	if ( bounds[1][0] - bounds[0][0] > 100000 ) {
 		common->Printf( " (HUGE BOUNDS)" );
 	}
+	if ( cacheMissRatioAfter > 0.0f ) {
+		common->Printf( " (ACMR %.2f -> %.2f)", cacheMissRatioBefore, cacheMissRatioAfter );
+	}
 
 	common->Printf( "\n" );
 }
@@ -554,6 +561,179 @@ int idRenderModelStatic::NearestJoint( int surfaceNum, int a, int b, int c ) con
 
 //=====================================================================
 
+#define	SURFACE_ORDER_ID		"SurfaceOrder"
+#define	SURFACE_ORDER_VERSION	1
+
+/*
+================
+SurfaceCanBeOrdered
+
+Autosprites, flares and tubes need the vertexes in the order the
+artist made them, and gui surfaces take their axis from the first
+triangle.
+================
+*/
+static bool SurfaceCanBeOrdered( const modelSurface_t *surf ) {
+	return surf->shader->Deform() == DFRM_NONE && !surf->shader->HasGui() && surf->geometry->silIndexes == NULL;
+}
+
+/*
+================
+idRenderModelStatic::ReadSurfaceOrder
+
+Reads the vertex remap and the indexes of a surface from a file
+written by OrderSurfaces and applies them if they match.
+================
+*/
+bool idRenderModelStatic::ReadSurfaceOrder( idFile *file, int surfaceNum, idList<int> &remap ) {
+	srfTriangles_t	*tri = surfaces[surfaceNum].geometry;
+	idList<glIndex_t> indexes;
+	idList<bool>	used;
+	int				numVerts, numIndexes;
+	bool			ordered;
+	int				i;
+
+	file->ReadInt( numVerts );
+	file->ReadInt( numIndexes );
+	file->ReadBool( ordered );
+	if ( numVerts != tri->numVerts || numIndexes != tri->numIndexes || ordered != SurfaceCanBeOrdered( &surfaces[surfaceNum] ) ) {
+		return false;
+	}
+	if ( !ordered ) {
+		return true;
+	}
+
+	remap.SetNum( numVerts );
+	indexes.SetNum( numIndexes );
+	if ( file->Read( remap.Ptr(), numVerts * sizeof( int ) ) != numVerts * (int)sizeof( int )
+		|| file->Read( indexes.Ptr(), numIndexes * sizeof( glIndex_t ) ) != numIndexes * (int)sizeof( glIndex_t ) ) {
+		return false;
+	}
+
+	// make sure it is a permutation, so a damaged file can't crash us
+	used.AssureSize( numVerts, false );
+	for ( i = 0 ; i < numVerts ; i++ ) {
+		if ( remap[i] < 0 || remap[i] >= numVerts || used[remap[i]] ) {
+			return false;
+		}
+		used[remap[i]] = true;
+	}
+	for ( i = 0 ; i < numIndexes ; i++ ) {
+		if ( indexes[i] < 0 || indexes[i] >= numVerts ) {
+			return false;
+		}
+	}
+
+	R_RemapVertexes( tri, remap.Ptr() );
+	memcpy( tri->indexes, indexes.Ptr(), numIndexes * sizeof( glIndex_t ) );
+
+	return true;
+}
+
+/*
+================
+idRenderModelStatic::OrderSurfaces
+
+Reorders the indexes of the surfaces for the post transform vertex cache
+and then the vertexes for the order they are fetched in.
+
+This is too slow to do every time a level loads, so the result is saved
+next to the model source and used until the source timestamp changes.
+World area models have no source file of their own and are left alone.
+================
+*/
+void idRenderModelStatic::OrderSurfaces() {
+	idList<int>	*remaps;
+	idFile		*file;
+	idStr		fileName;
+	idStr		fileId;
+	int			version, fileTimeStamp, numSurfaces;
+	int			totalTris;
+	bool		rewrite;
+	int			i;
+
+	cacheMissRatioBefore = 0.0f;
+	cacheMissRatioAfter = 0.0f;
+
+	if ( !r_orderIndexes.GetBool() || timeStamp == 0 || timeStamp == FILE_NOT_FOUND_TIMESTAMP ) {
+		return;
+	}
+
+	fileName = name + ".vcache";
+	file = fileSystem->OpenFileRead( fileName );
+	if ( file ) {
+		file->ReadString( fileId );
+		file->ReadInt( version );
+		file->ReadInt( fileTimeStamp );
+		file->ReadInt( numSurfaces );
+		if ( fileId != SURFACE_ORDER_ID || version != SURFACE_ORDER_VERSION
+			|| fileTimeStamp != (int)timeStamp || numSurfaces != surfaces.Num() ) {
+			fileSystem->CloseFile( file );
+			file = NULL;
+		}
+	}
+
+	remaps = new idList<int>[surfaces.Num()];
+	rewrite = ( file == NULL );
+	totalTris = 0;
+
+	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
+		const modelSurface_t *surf = &surfaces[i];
+		srfTriangles_t *tri = surf->geometry;
+		int numTris = tri->numIndexes / 3;
+
+		totalTris += numTris;
+		cacheMissRatioBefore += R_VertexCacheMissRatio( tri->numIndexes, tri->indexes ) * numTris;
+
+		// once a surface doesn't match, the rest of the file is out of sync
+		if ( file && !ReadSurfaceOrder( file, i, remaps[i] ) ) {
+			fileSystem->CloseFile( file );
+			file = NULL;
+			rewrite = true;
+		}
+		if ( !file && SurfaceCanBeOrdered( surf ) ) {
+			R_OrderIndexes( tri->numIndexes, tri->indexes );
+			remaps[i].SetNum( tri->numVerts );
+			R_OrderVertexes( tri, remaps[i].Ptr() );
+		}
+
+		cacheMissRatioAfter += R_VertexCacheMissRatio( tri->numIndexes, tri->indexes ) * numTris;
+	}
+
+	if ( file ) {
+		fileSystem->CloseFile( file );
+	}
+
+	if ( totalTris > 0 ) {
+		cacheMissRatioBefore /= totalTris;
+		cacheMissRatioAfter /= totalTris;
+	}
+
+	if ( rewrite ) {
+		file = fileSystem->OpenFileWrite( fileName );
+		if ( file ) {
+			file->WriteString( SURFACE_ORDER_ID );
+			file->WriteInt( SURFACE_ORDER_VERSION );
+			file->WriteInt( (int)timeStamp );
+			file->WriteInt( surfaces.Num() );
+			for ( i = 0 ; i < surfaces.Num() ; i++ ) {
+				const srfTriangles_t *tri = surfaces[i].geometry;
+				bool ordered = SurfaceCanBeOrdered( &surfaces[i] );
+
+				file->WriteInt( tri->numVerts );
+				file->WriteInt( tri->numIndexes );
+				file->WriteBool( ordered );
+				if ( ordered ) {
+					file->Write( remaps[i].Ptr(), tri->numVerts * sizeof( int ) );
+					file->Write( tri->indexes, tri->numIndexes * sizeof( glIndex_t ) );
+				}
+			}
+			fileSystem->CloseFile( file );
+		}
+	}
+
+	delete[] remaps;
+}
 
 /*
 ================
@@ -651,6 +831,9 @@ void idRenderModelStatic::FinishSurfaces() {
 		}
 	}
 
+	// optimize the index and vertex order for the vertex cache
+	OrderSurfaces();
+
 	// clean the surfaces
 	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
 		const modelSurface_t	*surf = &surfaces[i];
@@ -2111,6 +2294,9 @@ void idRenderModelStatic::PurgeModel() {
 	int		i;
 	modelSurface_t	*surf;
 
+	// cached shadow volumes are keyed on the surfaces
+	shadowVolumeCache.PurgeModel( this );
+
 	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
 		surf = &surfaces[i];
 
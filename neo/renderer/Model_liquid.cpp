@@ -75,9 +75,9 @@ modelSurface_t idRenderModelLiquid::GenerateSurface( float lerp ) {
 		vert->xyz.z = page1[ i ] * lerp + page2[ i ] * inv_lerp;
 	}
 
-	tr.pc.c_deformedSurfaces++;
-	tr.pc.c_deformedVerts += deformInfo->numOutputVerts;
-	tr.pc.c_deformedIndexes += deformInfo->numIndexes;
+	R_FrontEndCounters().c_deformedSurfaces++;
+	R_FrontEndCounters().c_deformedVerts += deformInfo->numOutputVerts;
+	R_FrontEndCounters().c_deformedIndexes += deformInfo->numIndexes;
 
 	tri = R_AllocStaticTriSurf();
 
@@ -105,6 +105,9 @@ public:
 	void						DeleteSurfacesWithNegativeId( void );
 	bool						FindSurfaceWithId( int id, int &surfaceNum );
 
+	void						OrderSurfaces();
+	bool						ReadSurfaceOrder( idFile *file, int surfaceNum, idList<int> &remap );
+
 public:
 	idList<modelSurface_t>		surfaces;
 	idBounds					bounds;
@@ -123,6 +126,8 @@ protected:
 	bool						reloadable;				// if not, reloadModels won't check timestamp
 	bool						levelLoadReferenced;	// for determining if it needs to be freed
 	ID_TIME_T						timeStamp;
+	float						cacheMissRatioBefore;	// average vertex cache misses per triangle in the source order
+	float						cacheMissRatioAfter;	// and after OrderSurfaces, 0 if it hasn't run
 
 	static idCVar				r_mergeModelSurfaces;	// combine model surfaces with the same material
 	static idCVar				r_slopVertex;			// merge xyz coordinates this far apart
@@ -146,7 +151,8 @@ public:
 								~idMD5Mesh();
 
 	void						ParseMesh( idLexer &parser, int numJoints, const idJointMat *joints );
-	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf );
+	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf, idBounds &modelBounds );
+	void						SkinSurface( srfTriangles_t *tri, const idJointMat *joints, float skinScale, bool deriveTangents ) const;
 	idBounds					CalcBounds( const idJointMat *joints );
 	int							NearestJoint( int a, int b, int c ) const;
 	int							NumVerts( void ) const;
@@ -163,8 +169,8 @@ private:
 	struct deformInfo_s *		deformInfo;			// used to create srfTriangles_t from base frames and new vertexes
 	int							surfaceNum;			// number of the static surface created for this mesh
 
-	void						TransformVerts( idDrawVert *verts, const idJointMat *joints );
-	void						TransformScaledVerts( idDrawVert *verts, const idJointMat *joints, float scale );
+	void						TransformVerts( idDrawVert *verts, const idJointMat *joints ) const;
+	void						TransformScaledVerts( idDrawVert *verts, const idJointMat *joints, float scale ) const;
 };
 
 class idRenderModelMD5 : public idRenderModelStatic {
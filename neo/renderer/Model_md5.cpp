@@ -34,6 +34,19 @@ If you have questions concerning this license or the applicable additional terms
 
 static const char *MD5_SnapshotName = "_MD5_Snapshot_";
 
+// mesh skinning queued between R_BeginSkinningBatch and R_EndSkinningBatch
+typedef struct {
+	const idMD5Mesh *			mesh;
+	srfTriangles_t *			tri;
+	const idJointMat *			joints;
+	float						skinScale;
+	bool						deriveTangents;
+	idBounds *					modelBounds;
+} md5SkinJob_t;
+
+static bool						skinBatchActive = false;
+static idList<md5SkinJob_t>		skinJobs;
+
 /***********************************************************************
 
 	idMD5Mesh
@@ -249,7 +262,7 @@ void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joi
 idMD5Mesh::TransformVerts
 ====================
 */
-void idMD5Mesh::TransformVerts( idDrawVert *verts, const idJointMat *entJoints ) {
+void idMD5Mesh::TransformVerts( idDrawVert *verts, const idJointMat *entJoints ) const {
 	SIMDProcessor->TransformVerts( verts, texCoords.Num(), entJoints, scaledWeights, weightIndex, numWeights );
 }
 
@@ -260,7 +273,7 @@ idMD5Mesh::TransformScaledVerts
 Special transform to make the mesh seem fat or skinny.  May be used for zombie deaths
 ====================
 */
-void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJoints, float scale ) {
+void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJoints, float scale ) const {
 	idVec4 *scaledWeights = (idVec4 *) _alloca16( numWeights * sizeof( scaledWeights[0] ) );
 	SIMDProcessor->Mul( scaledWeights[0].ToFloatPtr(), scale, scaledWeights[0].ToFloatPtr(), numWeights * 4 );
 	SIMDProcessor->TransformVerts( verts, texCoords.Num(), entJoints, scaledWeights, weightIndex, numWeights );
@@ -268,16 +281,47 @@ void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJo
 
 /*
 ====================
-idMD5Mesh::UpdateSurface
+idMD5Mesh::SkinSurface
+
+Transforms the vertexes, replicates the mirror seams and bounds the surface.
+Doesn't allocate anything, so it can run in a front end job.
 ====================
 */
-void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) {
+void idMD5Mesh::SkinSurface( srfTriangles_t *tri, const idJointMat *entJoints, float skinScale, bool deriveTangents ) const {
 	int i, base;
+
+	if ( skinScale != 0.0f ) {
+		TransformScaledVerts( tri->verts, entJoints, skinScale );
+	} else {
+		TransformVerts( tri->verts, entJoints );
+	}
+
+	// replicate the mirror seam vertexes
+	base = deformInfo->numOutputVerts - deformInfo->numMirroredVerts;
+	for ( i = 0; i < deformInfo->numMirroredVerts; i++ ) {
+		tri->verts[base + i] = tri->verts[deformInfo->mirroredVerts[i]];
+	}
+
+	R_BoundTriSurf( tri );
+
+	if ( deriveTangents ) {
+		// set face planes, vertex normals, tangents
+		R_DeriveTangents( tri, false );
+	}
+}
+
+/*
+====================
+idMD5Mesh::UpdateSurface
+====================
+*/
+void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf, idBounds &modelBounds ) {
+	int i;
 	srfTriangles_t *tri;
 
-	tr.pc.c_deformedSurfaces++;
-	tr.pc.c_deformedVerts += deformInfo->numOutputVerts;
-	tr.pc.c_deformedIndexes += deformInfo->numIndexes;
+	R_FrontEndCounters().c_deformedSurfaces++;
+	R_FrontEndCounters().c_deformedVerts += deformInfo->numOutputVerts;
+	R_FrontEndCounters().c_deformedIndexes += deformInfo->numIndexes;
 
 	surf->shader = shader;
 
@@ -321,28 +365,83 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 		}
 	}
 
-	if ( ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] != 0.0f ) {
-		TransformScaledVerts( tri->verts, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
-	} else {
-		TransformVerts( tri->verts, entJoints );
+	// If a surface is going to be have a lighting interaction generated, it will also have to call
+	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
+	// needs shadows generated, it will only have to generate face planes.  If it only
+	// has ambient drawing, or is culled, no additional work will be necessary
+	bool deriveTangents = !r_useDeferredTangents.GetBool();
+
+	if ( !skinBatchActive ) {
+		if ( deriveTangents && !tri->facePlanes && !tri->dominantTris ) {
+			R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
+		}
+		SkinSurface( tri, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ], deriveTangents );
+		modelBounds.AddBounds( tri->bounds );
+		return;
 	}
 
-	// replicate the mirror seam vertexes
-	base = deformInfo->numOutputVerts - deformInfo->numMirroredVerts;
-	for ( i = 0; i < deformInfo->numMirroredVerts; i++ ) {
-		tri->verts[base + i] = tri->verts[deformInfo->mirroredVerts[i]];
+	// the surface is visible, so a lit surface will almost certainly need
+	// its tangents, and they are cheaper to derive in the job than later
+	// on the main thread
+	if ( shader->ReceivesLighting() ) {
+		deriveTangents = true;
+	}
+	if ( deriveTangents && !tri->facePlanes && !tri->dominantTris ) {
+		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
 	}
 
-	R_BoundTriSurf( tri );
+	md5SkinJob_t &job = skinJobs.Alloc();
+	job.mesh = this;
+	job.tri = tri;
+	job.joints = entJoints;
+	job.skinScale = ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ];
+	job.deriveTangents = deriveTangents;
+	job.modelBounds = &modelBounds;
+}
 
-	// If a surface is going to be have a lighting interaction generated, it will also have to call
-	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
-	// needs shadows generated, it will only have to generate face planes.  If it only
-	// has ambient drawing, or is culled, no additional work will be necessary
-	if ( !r_useDeferredTangents.GetBool() ) {
-		// set face planes, vertex normals, tangents
-		R_DeriveTangents( tri );
+/*
+====================
+R_BeginSkinningBatch
+====================
+*/
+void R_BeginSkinningBatch( void ) {
+	assert( !skinBatchActive );
+	skinJobs.SetNum( 0, false );
+	skinBatchActive = true;
+}
+
+/*
+====================
+R_SkinMeshJob
+====================
+*/
+static void R_SkinMeshJob( void *data, int jobNum ) {
+	const md5SkinJob_t &job = static_cast<md5SkinJob_t *>( data )[jobNum];
+	job.mesh->SkinSurface( job.tri, job.joints, job.skinScale, job.deriveTangents );
+}
+
+/*
+====================
+R_EndSkinningBatch
+
+Skins all the queued meshes in parallel, then adds the surface
+bounds to their models in queue order.
+====================
+*/
+void R_EndSkinningBatch( void ) {
+	assert( skinBatchActive );
+	skinBatchActive = false;
+
+	if ( !skinJobs.Num() ) {
+		return;
 	}
+
+	R_RunFrontEndJobs( R_SkinMeshJob, skinJobs.Ptr(), skinJobs.Num() );
+
+	for ( int i = 0; i < skinJobs.Num(); i++ ) {
+		skinJobs[i].modelBounds->AddBounds( skinJobs[i].tri->bounds );
+	}
+	skinJobs.SetNum( 0, false );
 }
 
 /*
@@ -743,7 +842,7 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		return NULL;
 	}
 
-	tr.pc.c_generateMd5++;
+	R_FrontEndCounters().c_generateMd5++;
 
 	if ( cachedModel ) {
 		assert( dynamic_cast<idRenderModelStatic *>(cachedModel) != NULL );
@@ -800,10 +899,8 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
-		mesh->UpdateSurface( ent, ent->joints, surf );
-
-		staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
-		staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
+		// the bounds are added once the surface has been skinned
+		mesh->UpdateSurface( ent, ent->joints, surf, staticModel->bounds );
 	}
 
 	return staticModel;
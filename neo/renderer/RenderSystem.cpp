@@ -30,6 +30,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "framework/EventLoop.h"
 #include "framework/Session.h"
 #include "framework/DemoFile.h"
+#include "framework/FileSystem.h"
 #include "renderer/ModelManager.h"
 #include "renderer/Material.h"
 #include "renderer/GuiModel.h"
@@ -42,6 +43,60 @@ idRenderSystemLocal	tr;
 idRenderSystem	*renderSystem = &tr;
 
 
+static idFile *	benchmarkFile = NULL;
+
+/*
+=====================
+R_CloseBenchmarkCSV
+=====================
+*/
+void R_CloseBenchmarkCSV( void ) {
+	if ( benchmarkFile ) {
+		fileSystem->CloseFile( benchmarkFile );
+		benchmarkFile = NULL;
+	}
+}
+
+/*
+=====================
+R_WriteBenchmarkCSV
+
+Writes a line with the front end time and counters of the
+frame to r_benchmarkCSV, reopening the file if the cvar changed.
+=====================
+*/
+static void R_WriteBenchmarkCSV( void ) {
+	const char *fileName = r_benchmarkCSV.GetString();
+
+	if ( benchmarkFile && idStr::Icmp( benchmarkFile->GetName(), fileName ) != 0 ) {
+		R_CloseBenchmarkCSV();
+	}
+	if ( fileName[0] == '\0' ) {
+		return;
+	}
+	if ( !benchmarkFile ) {
+		benchmarkFile = fileSystem->OpenFileWrite( fileName );
+		if ( !benchmarkFile ) {
+			common->Warning( "couldn't open %s for writing", fileName );
+			r_benchmarkCSV.SetString( "" );
+			return;
+		}
+		benchmarkFile->Printf( "frame,time_frontend,frontend_usec,views,entity_callbacks,md5,deformed_verts,tangent_tris,"
+			"sphere_cull_in,sphere_cull_clip,sphere_cull_out,box_cull_in,box_cull_out,"
+			"view_entities,shadow_entities,view_lights,create_interactions,create_light_tris,create_shadow_volumes,"
+			"draw_surfs,sort_usec,occluded_entities,occluded_lights,frame_memory\n" );
+	}
+
+	benchmarkFile->Printf( "%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i\n",
+		tr.frameCount, tr.pc.frontEndMsec, tr.pc.frontEndUsec, tr.pc.c_numViews,
+		tr.pc.c_entityDefCallbacks, tr.pc.c_generateMd5, tr.pc.c_deformedVerts, tr.pc.c_tangentIndexes / 3,
+		tr.pc.c_sphere_cull_in, tr.pc.c_sphere_cull_clip, tr.pc.c_sphere_cull_out, tr.pc.c_box_cull_in, tr.pc.c_box_cull_out,
+		tr.pc.c_visibleViewEntities, tr.pc.c_shadowViewEntities, tr.pc.c_viewLights,
+		tr.pc.c_createInteractions, tr.pc.c_createLightTris, tr.pc.c_createShadowVolumes,
+		tr.pc.c_sortedDrawSurfs, tr.pc.sortUsec, tr.pc.c_occludedEntities, tr.pc.c_occludedLights,
+		R_CountFrameData() );
+}
+
 /*
 =====================
 R_PerformanceCounters
@@ -51,6 +106,8 @@ only be called when the back end thread is idle.
 =====================
 */
 static void R_PerformanceCounters( void ) {
+	R_WriteBenchmarkCSV();
+
 	if ( r_showPrimitives.GetInteger() != 0 ) {
 
 		float megaBytes = globalImages->SumOfUsedImages() / ( 1024*1024.0 );
@@ -108,6 +165,14 @@ static void R_PerformanceCounters( void ) {
 		common->Printf( "viewEntities:%i  shadowEntities:%i  viewLights:%i\n", tr.pc.c_visibleViewEntities,
 			tr.pc.c_shadowViewEntities, tr.pc.c_viewLights );
 	}
+	if ( r_showSort.GetBool() ) {
+		common->Printf( "sortedSurfs:%i  sortUsec:%i  entitySetupsSkipped:%i  materialSetupsSkipped:%i\n", tr.pc.c_sortedDrawSurfs,
+			tr.pc.sortUsec, backEnd.pc.c_entitySetupsSkipped, backEnd.pc.c_materialSetupsSkipped );
+	}
+	if ( r_showOcclusion.GetBool() ) {
+		common->Printf( "occluderTris:%i  occludedEntities:%i  occludedLights:%i\n", tr.pc.c_occluderTris,
+			tr.pc.c_occludedEntities, tr.pc.c_occludedLights );
+	}
 	if ( r_showUpdates.GetBool() ) {
 		common->Printf( "entityUpdates:%i  entityRefs:%i  lightUpdates:%i  lightRefs:%i\n",
 			tr.pc.c_entityUpdates, tr.pc.c_entityReferences,
@@ -149,7 +214,9 @@ static void R_IssueRenderCommands( void ) {
 
 	// r_skipRender is usually more usefull, because it will still
 	// draw 2D graphics
-	if ( !r_skipBackEnd.GetBool() ) {
+	// r_frontEndBenchmark does the same, so the front end can be
+	// timed on machines with only a stubbed OpenGL
+	if ( !r_skipBackEnd.GetBool() && !r_frontEndBenchmark.GetBool() ) {
 		RB_ExecuteBackEndCommands( frameData->cmdHead );
 	}
 
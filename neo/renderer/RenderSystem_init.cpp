@@ -32,6 +32,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "framework/Console.h"
 #include "framework/Session.h"
 #include "renderer/VertexCache.h"
+#include "renderer/ShadowVolumeCache.h"
 #include "renderer/ModelManager.h"
 #include "renderer/RenderWorld_local.h"
 #include "renderer/GuiModel.h"
@@ -71,7 +72,8 @@ idCVar r_useNodeCommonChildren( "r_useNodeCommonChildren", "1", CVAR_RENDERER |
 idCVar r_useShadowProjectedCull( "r_useShadowProjectedCull", "1", CVAR_RENDERER | CVAR_BOOL, "discard triangles outside light volume before shadowing" );
 idCVar r_useShadowVertexProgram( "r_useShadowVertexProgram", "1", CVAR_RENDERER | CVAR_BOOL, "do the shadow projection in the vertex program on capable cards" );
 idCVar r_useShadowSurfaceScissor( "r_useShadowSurfaceScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor shadows by the scissor rect of the interaction surfaces" );
-idCVar r_useInteractionTable( "r_useInteractionTable", "1", CVAR_RENDERER | CVAR_BOOL, "create a full entityDefs * lightDefs table to make finding interactions faster" );
+idCVar r_useInteractionTable( "r_useInteractionTable", "-1", CVAR_RENDERER | CVAR_INTEGER, "table to make finding interactions faster, -1 = choose from map size, 0 = none, 1 = full entityDefs * lightDefs table, 2 = sparse hash table", -1, 2, idCmdSystem::ArgCompletion_Integer<-1,2> );
+idCVar r_interactionTableMegs( "r_interactionTableMegs", "8", CVAR_RENDERER | CVAR_INTEGER, "largest full interaction table r_useInteractionTable -1 will create before using the sparse one" );
 idCVar r_useTurboShadow( "r_useTurboShadow", "1", CVAR_RENDERER | CVAR_BOOL, "use the infinite projection with W technique for dynamic shadows" );
 idCVar r_useTwoSidedStencil( "r_useTwoSidedStencil", "1", CVAR_RENDERER | CVAR_BOOL, "do stencil shadows in one pass with different ops on each side" );
 idCVar r_useDeferredTangents( "r_useDeferredTangents", "1", CVAR_RENDERER | CVAR_BOOL, "defer tangents calculations after deform" );
@@ -104,6 +106,8 @@ idCVar r_skipInteractions( "r_skipInteractions", "0", CVAR_RENDERER | CVAR_BOOL,
 idCVar r_skipDynamicTextures( "r_skipDynamicTextures", "0", CVAR_RENDERER | CVAR_BOOL, "don't dynamically create textures" );
 idCVar r_skipCopyTexture( "r_skipCopyTexture", "0", CVAR_RENDERER | CVAR_BOOL, "do all rendering, but don't actually copyTexSubImage2D" );
 idCVar r_skipBackEnd( "r_skipBackEnd", "0", CVAR_RENDERER | CVAR_BOOL, "don't draw anything" );
+idCVar r_frontEndBenchmark( "r_frontEndBenchmark", "0", CVAR_RENDERER | CVAR_BOOL, "run the whole front end but skip the back end, also on dedicated servers, to time render demos on machines without a GPU" );
+idCVar r_benchmarkCSV( "r_benchmarkCSV", "", CVAR_RENDERER, "write the front end timings and counters of every frame to this CSV file" );
 idCVar r_skipRender( "r_skipRender", "0", CVAR_RENDERER | CVAR_BOOL, "skip 3D rendering, but pass 2D" );
 idCVar r_skipRenderContext( "r_skipRenderContext", "0", CVAR_RENDERER | CVAR_BOOL, "NULL the rendering context during backend 3D rendering" );
 idCVar r_skipTranslucent( "r_skipTranslucent", "0", CVAR_RENDERER | CVAR_BOOL, "skip the translucent interaction rendering" );
@@ -132,6 +136,11 @@ idCVar r_useEntityScissors( "r_useEntityScissors", "0", CVAR_RENDERER | CVAR_BOO
 idCVar r_useInteractionCulling( "r_useInteractionCulling", "1", CVAR_RENDERER | CVAR_BOOL, "1 = cull interactions" );
 idCVar r_useInteractionScissors( "r_useInteractionScissors", "2", CVAR_RENDERER | CVAR_INTEGER, "1 = use a custom scissor rectangle for each shadow interaction, 2 = also crop using portal scissors", -2, 2, idCmdSystem::ArgCompletion_Integer<-2,2> );
 idCVar r_useShadowCulling( "r_useShadowCulling", "1", CVAR_RENDERER | CVAR_BOOL, "try to cull shadows from partially visible lights" );
+idCVar r_useParallelFrontEnd( "r_useParallelFrontEnd", "1", CVAR_RENDERER | CVAR_BOOL, "1 = split light and entity front end work into jobs on the job system" );
+idCVar r_useParallelSkinning( "r_useParallelSkinning", "1", CVAR_RENDERER | CVAR_BOOL, "1 = skin the md5 meshes of the visible entities in jobs, requires r_useParallelFrontEnd" );
+idCVar r_useOcclusionCulling( "r_useOcclusionCulling", "0", CVAR_RENDERER | CVAR_BOOL, "cull entities and lights hidden by the world geometry with a software depth buffer" );
+idCVar r_occluderBudget( "r_occluderBudget", "8000", CVAR_RENDERER | CVAR_INTEGER, "maximum number of occluder triangles rasterized per view" );
+idCVar r_useRadixSort( "r_useRadixSort", "1", CVAR_RENDERER | CVAR_BOOL, "sort draw surfaces by sort class, material, entity and depth with a radix sort, 0 = by sort value only" );
 idCVar r_useFrustumFarDistance( "r_useFrustumFarDistance", "0", CVAR_RENDERER | CVAR_FLOAT, "if != 0 force the view frustum far distance to this distance" );
 idCVar r_clear( "r_clear", "2", CVAR_RENDERER, "force screen clear every frame, 1 = purple, 2 = black, 'r g b' = custom" );
 idCVar r_offsetFactor( "r_offsetfactor", "0", CVAR_RENDERER | CVAR_FLOAT, "polygon offset parameter" );
@@ -166,7 +175,7 @@ idCVar r_singleEntity( "r_singleEntity", "-1", CVAR_RENDERER | CVAR_INTEGER, "su
 idCVar r_singleSurface( "r_singleSurface", "-1", CVAR_RENDERER | CVAR_INTEGER, "suppress all but one surface on each entity" );
 idCVar r_singleArea( "r_singleArea", "0", CVAR_RENDERER | CVAR_BOOL, "only draw the portal area the view is actually in" );
 idCVar r_forceLoadImages( "r_forceLoadImages", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "draw all images to screen after registration" );
-idCVar r_orderIndexes( "r_orderIndexes", "1", CVAR_RENDERER | CVAR_BOOL, "perform index reorganization to optimize vertex use" );
+idCVar r_orderIndexes( "r_orderIndexes", "1", CVAR_RENDERER | CVAR_BOOL, "reorder the indexes and vertexes of static models at load time to optimize vertex cache use" );
 idCVar r_lightAllBackFaces( "r_lightAllBackFaces", "0", CVAR_RENDERER | CVAR_BOOL, "light all the back faces, even when they would be shadowed" );
 
 // visual debugging info
@@ -179,6 +188,7 @@ idCVar r_showDemo( "r_showDemo", "0", CVAR_RENDERER | CVAR_BOOL, "report reads a
 idCVar r_showDynamic( "r_showDynamic", "0", CVAR_RENDERER | CVAR_BOOL, "report stats on dynamic surface generation" );
 idCVar r_showLightScale( "r_showLightScale", "0", CVAR_RENDERER | CVAR_BOOL, "report the scale factor applied to drawing for overbrights" );
 idCVar r_showDefs( "r_showDefs", "0", CVAR_RENDERER | CVAR_BOOL, "report the number of modeDefs and lightDefs in view" );
+idCVar r_showOcclusion( "r_showOcclusion", "0", CVAR_RENDERER | CVAR_BOOL, "report occluder triangles and occluded entities and lights" );
 idCVar r_showTrace( "r_showTrace", "0", CVAR_RENDERER | CVAR_INTEGER, "show the intersection of an eye trace with the world", idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar r_showIntensity( "r_showIntensity", "0", CVAR_RENDERER | CVAR_BOOL, "draw the screen colors based on intensity, red = 0, green = 128, blue = 255" );
 idCVar r_showImages( "r_showImages", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = show all images instead of rendering, 2 = show in proportional size", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
@@ -201,6 +211,7 @@ idCVar r_showInteractions( "r_showInteractions", "0", CVAR_RENDERER | CVAR_BOOL,
 idCVar r_showDepth( "r_showDepth", "0", CVAR_RENDERER | CVAR_BOOL, "display the contents of the depth buffer and the depth range" );
 idCVar r_showSurfaces( "r_showSurfaces", "0", CVAR_RENDERER | CVAR_BOOL, "report surface/light/shadow counts" );
 idCVar r_showPrimitives( "r_showPrimitives", "0", CVAR_RENDERER | CVAR_INTEGER, "report drawsurf/index/vertex counts" );
+idCVar r_showSort( "r_showSort", "0", CVAR_RENDERER | CVAR_BOOL, "report draw surface sort time and skipped back end state changes" );
 idCVar r_showEdges( "r_showEdges", "0", CVAR_RENDERER | CVAR_BOOL, "draw the sil edges" );
 idCVar r_showTexturePolarity( "r_showTexturePolarity", "0", CVAR_RENDERER | CVAR_BOOL, "shade triangles by texture area polarity" );
 idCVar r_showTangentSpace( "r_showTangentSpace", "0", CVAR_RENDERER | CVAR_INTEGER, "shade triangles by tangent space, 1 = use 1st tangent vector, 2 = use 2nd tangent vector, 3 = use normal vector", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
@@ -2074,6 +2085,7 @@ void R_InitCommands( void ) {
 	cmdSystem->AddCommand( "vid_restart", R_VidRestart_f, CMD_FL_RENDERER, "restarts renderSystem" );
 	cmdSystem->AddCommand( "listRenderEntityDefs", R_ListRenderEntityDefs_f, CMD_FL_RENDERER, "lists the entity defs" );
 	cmdSystem->AddCommand( "listRenderLightDefs", R_ListRenderLightDefs_f, CMD_FL_RENDERER, "lists the light defs" );
+	cmdSystem->AddCommand( "listFrameMemory", R_ListFrameMemory_f, CMD_FL_RENDERER, "lists the frame memory used by each front end thread" );
 	cmdSystem->AddCommand( "listModes", R_ListModes_f, CMD_FL_RENDERER, "lists all video modes" );
 	cmdSystem->AddCommand( "reloadSurface", R_ReloadSurface_f, CMD_FL_RENDERER, "reloads the decl and images for selected surface" );
 }
@@ -2149,6 +2161,8 @@ void idRenderSystemLocal::Init( void ) {
 
 	R_InitTriSurfData();
 
+	shadowVolumeCache.Init();
+
 	globalImages->Init();
 
 	idCinematic::InitCinematic( );
@@ -2187,6 +2201,11 @@ void idRenderSystemLocal::Shutdown( void ) {
 
 	globalImages->Shutdown();
 
+	// free the shadow volumes no interaction took back
+	shadowVolumeCache.Shutdown();
+
+	R_CloseBenchmarkCSV();
+
 	// free frame memory
 	R_ShutdownFrameData();
 
@@ -2211,6 +2230,7 @@ idRenderSystemLocal::BeginLevelLoad
 ========================
 */
 void idRenderSystemLocal::BeginLevelLoad( void ) {
+	shadowVolumeCache.PurgeAll();
 	renderModelManager->BeginLevelLoad();
 	globalImages->BeginLevelLoad();
 }
@@ -210,7 +210,7 @@ void idRenderWorldLocal::UpdateEntityDef( qhandle_t entityHandle, const renderEn
 		return;
 	}
 
-	tr.pc.c_entityUpdates++;
+	R_FrontEndCounters().c_entityUpdates++;
 
 	if ( !re->hModel && !re->callback ) {
 		common->Error( "idRenderWorld::UpdateEntityDef: NULL hModel" );
@@ -388,7 +388,7 @@ void idRenderWorldLocal::UpdateLightDef( qhandle_t lightHandle, const renderLigh
 		return;
 	}
 
-	tr.pc.c_lightUpdates++;
+	R_FrontEndCounters().c_lightUpdates++;
 
 	// create new slots if needed
 	if ( lightHandle < 0 || lightHandle > LUDICROUS_INDEX ) {
@@ -678,7 +678,12 @@ to handle mirrors,
 extern void R_SetupViewFrustum( viewDef_t* viewDef );
 extern void R_SetupProjection( viewDef_t * viewDef );
 void idRenderWorldLocal::RenderScene( const renderView_t *renderView ) {
-#ifndef	ID_DEDICATED
+#ifdef	ID_DEDICATED
+	// dedicated servers only render to benchmark the front end
+	if ( !r_frontEndBenchmark.GetBool() ) {
+		return;
+	}
+#endif
 	renderView_t	copy;
 
 	if ( !glConfig.isInitialized ) {
@@ -702,6 +707,7 @@ void idRenderWorldLocal::RenderScene( const renderView_t *renderView ) {
 	tr.guiModel->Clear();
 
 	int startTime = Sys_Milliseconds();
+	unsigned int startUsec = Sys_Microseconds();
 
 	// setup view parms for the initial view
 	//
@@ -804,10 +810,10 @@ void idRenderWorldLocal::RenderScene( const renderView_t *renderView ) {
 	int endTime = Sys_Milliseconds();
 
 	tr.pc.frontEndMsec += endTime - startTime;
+	tr.pc.frontEndUsec += Sys_Microseconds() - startUsec;
 
 	// prepare for any 2D drawing after this
 	tr.guiModel->Clear();
-#endif
 }
 
 /*
@@ -1413,7 +1419,7 @@ void idRenderWorldLocal::AddEntityRefToArea( idRenderEntityLocal *def, portalAre
 
 	ref = areaReferenceAllocator.Alloc();
 
-	tr.pc.c_entityReferences++;
+	R_FrontEndCounters().c_entityReferences++;
 
 	ref->entity = def;
 
@@ -1444,7 +1450,7 @@ void idRenderWorldLocal::AddLightRefToArea( idRenderLightLocal *light, portalAre
 	lref->area = area;
 	lref->ownerNext = light->references;
 	light->references = lref;
-	tr.pc.c_lightReferences++;
+	R_FrontEndCounters().c_lightReferences++;
 
 	// doubly linked list so we can free them easily later
 	area->lightRefs.areaNext->areaPrev = lref;
@@ -1496,13 +1502,36 @@ void idRenderWorldLocal::GenerateAllInteractions() {
 
 
 	// build the interaction table
-	if ( r_useInteractionTable.GetBool() ) {
+	int mode = r_useInteractionTable.GetInteger();
+	if ( mode != 0 ) {
+		int	count = 0;
+		for ( int i = 0 ; i < this->lightDefs.Num() ; i++ ) {
+			idRenderLightLocal	*ldef = this->lightDefs[i];
+			if ( !ldef ) {
+				continue;
+			}
+			for ( idInteraction *inter = ldef->firstInteraction; inter != NULL; inter = inter->lightNext ) {
+				count++;
+			}
+		}
+
 		interactionTableWidth = entityDefs.Num() + 100;
 		interactionTableHeight = lightDefs.Num() + 100;
 		int	size =  interactionTableWidth * interactionTableHeight * sizeof( *interactionTable );
-		interactionTable = (idInteraction **)R_ClearedStaticAlloc( size );
 
-		int	count = 0;
+		// the full table grows with entities * lights, on big maps the
+		// sparse one is much smaller for the same constant time lookup
+		if ( mode == -1 ) {
+			mode = ( size <= r_interactionTableMegs.GetInteger() * 1024 * 1024 ) ? 1 : 2;
+		}
+
+		if ( mode == 1 ) {
+			interactionTable = (idInteraction **)R_ClearedStaticAlloc( size );
+		} else {
+			interactionHash.Init( count );
+			size = interactionHash.MemoryUsed();
+		}
+
 		for ( int i = 0 ; i < this->lightDefs.Num() ; i++ ) {
 			idRenderLightLocal	*ldef = this->lightDefs[i];
 			if ( !ldef ) {
@@ -1511,14 +1540,16 @@ void idRenderWorldLocal::GenerateAllInteractions() {
 			idInteraction	*inter;
 			for ( inter = ldef->firstInteraction; inter != NULL; inter = inter->lightNext ) {
 				idRenderEntityLocal	*edef = inter->entityDef;
-				int index = ldef->index * interactionTableWidth + edef->index;
-
-				interactionTable[ index ] = inter;
-				count++;
+				if ( interactionTable ) {
+					int index = ldef->index * interactionTableWidth + edef->index;
+					interactionTable[ index ] = inter;
+				} else {
+					interactionHash.Add( ldef->index, edef->index, inter );
+				}
 			}
 		}
 
-		common->Printf( "interactionTable size: %i bytes\n", size );
+		common->Printf( "%s interactionTable size: %i bytes\n", interactionTable ? "full" : "sparse", size );
 		common->Printf( "%d interaction take %zd bytes\n", count, count * sizeof( idInteraction ) );
 	}
 
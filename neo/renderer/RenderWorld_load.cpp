@@ -445,6 +445,7 @@ void idRenderWorldLocal::FreeDefs() {
 		R_StaticFree( interactionTable );
 		interactionTable = NULL;
 	}
+	interactionHash.Shutdown();
 
 	// free all lightDefs
 	for ( i = 0 ; i < lightDefs.Num() ; i++ ) {
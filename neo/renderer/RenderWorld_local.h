@@ -172,6 +172,9 @@ public:
 	int						interactionTableWidth;		// entityDefs
 	int						interactionTableHeight;		// lightDefs
 
+	// used instead of interactionTable when the full table would take too much memory
+	idInteractionHash		interactionHash;
+
 
 	bool					generateAllInteractionsCalled;
 
@@ -705,7 +705,7 @@ bool idRenderWorldLocal::CullLightByPortals( const idRenderLightLocal *light, co
 			}
 			if ( j == tri->numVerts ) {
 				// all points were outside one of the planes
-				tr.pc.c_box_cull_out++;
+				R_FrontEndCounters().c_box_cull_out++;
 				return true;
 			}
 		}
@@ -0,0 +1,322 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code ("Doom 3 Source Code").
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "sys/platform.h"
+#include "framework/Common.h"
+#include "renderer/tr_local.h"
+
+#include "renderer/ShadowVolumeCache.h"
+
+idCVar idShadowVolumeCache::r_shadowVolumeCacheMegs( "r_shadowVolumeCacheMegs", "8", CVAR_INTEGER|CVAR_RENDERER, "memory for shadow volumes kept after their interaction is freed, 0 = disable" );
+
+idShadowVolumeCache		shadowVolumeCache;
+
+// bits of shadowCacheKey_t::flags
+static const int	SCF_POINT_LIGHT			= BIT( 0 );
+static const int	SCF_PARALLEL			= BIT( 1 );
+static const int	SCF_STATIC_SHADOW		= BIT( 2 );		// SG_STATIC instead of SG_DYNAMIC
+static const int	SCF_SEE_THROUGH			= BIT( 3 );		// no external shadow optimizations
+static const int	SCF_TURBO				= BIT( 4 );
+static const int	SCF_VERTEX_PROGRAM		= BIT( 5 );
+static const int	SCF_PROJECTED_CULL		= BIT( 6 );
+
+/*
+==============
+idShadowVolumeCache::Init
+==============
+*/
+void idShadowVolumeCache::Init( void ) {
+	memset( hashTable, 0, sizeof( hashTable ) );
+	lru.lruNext = lru.lruPrev = &lru;
+
+	numEntries = 0;
+	totalBytes = 0;
+
+	numHits = 0;
+	numMisses = 0;
+	numEvictions = 0;
+}
+
+/*
+==============
+idShadowVolumeCache::Shutdown
+==============
+*/
+void idShadowVolumeCache::Shutdown( void ) {
+	PurgeAll();
+	entryAllocator.Shutdown();
+}
+
+/*
+==============
+idShadowVolumeCache::IsEnabled
+==============
+*/
+bool idShadowVolumeCache::IsEnabled( const idRenderModel *model ) const {
+	return ( r_shadowVolumeCacheMegs.GetInteger() > 0 && model->IsDynamicModel() == DM_STATIC );
+}
+
+/*
+==============
+idShadowVolumeCache::MakeKey
+
+Everything R_CreateShadowVolume() depends on, with the light transformed into entity space
+so a light and entity that move together still match.
+==============
+*/
+void idShadowVolumeCache::MakeKey( shadowCacheKey_t &key, const idRenderEntityLocal *ent, const idRenderLightLocal *light,
+								const srfTriangles_t *tri, shadowGen_t shadowGen, bool seeThrough ) const {
+	// the key is compared with memcmp, so clear the padding
+	memset( &key, 0, sizeof( key ) );
+
+	key.entityDef = ent;
+	key.lightDef = light;
+	key.tri = tri;
+
+	R_GlobalPointToLocal( ent->modelMatrix, light->parms.origin, key.lightOrigin );
+	for ( int i = 0 ; i < 3 ; i++ ) {
+		R_GlobalVectorToLocal( ent->modelMatrix, light->parms.axis[i], key.lightAxis[i] );
+		key.entityScale[i] = ent->parms.axis[i].LengthSqr();
+	}
+
+	key.lightCenter = light->parms.lightCenter;
+	key.lightRadius = light->parms.lightRadius;
+	key.target = light->parms.target;
+	key.right = light->parms.right;
+	key.up = light->parms.up;
+	key.start = light->parms.start;
+	key.end = light->parms.end;
+
+	if ( light->parms.pointLight ) {
+		key.flags |= SCF_POINT_LIGHT;
+	}
+	if ( light->parms.parallel ) {
+		key.flags |= SCF_PARALLEL;
+	}
+	if ( shadowGen == SG_STATIC ) {
+		key.flags |= SCF_STATIC_SHADOW;
+	}
+	if ( seeThrough ) {
+		key.flags |= SCF_SEE_THROUGH;
+	}
+	if ( r_useTurboShadow.GetBool() ) {
+		key.flags |= SCF_TURBO;
+	}
+	if ( tr.backEndRendererHasVertexPrograms && r_useShadowVertexProgram.GetBool() ) {
+		key.flags |= SCF_VERTEX_PROGRAM;
+	}
+	if ( r_useShadowProjectedCull.GetBool() ) {
+		key.flags |= SCF_PROJECTED_CULL;
+	}
+}
+
+/*
+==============
+idShadowVolumeCache::HashKey
+==============
+*/
+int idShadowVolumeCache::HashKey( const idRenderEntityLocal *ent, const idRenderLightLocal *light, const srfTriangles_t *tri ) const {
+	uintptr_t h = ( (uintptr_t)ent >> 4 ) * 31 + ( (uintptr_t)light >> 4 );
+	h = h * 31 + ( (uintptr_t)tri >> 4 );
+	return (int)( ( h ^ ( h >> 12 ) ) & ( HASH_SIZE - 1 ) );
+}
+
+/*
+==============
+idShadowVolumeCache::FindEntry
+==============
+*/
+shadowCacheEntry_t *idShadowVolumeCache::FindEntry( int hash, const idRenderEntityLocal *ent, const idRenderLightLocal *light, const srfTriangles_t *tri ) const {
+	for ( shadowCacheEntry_t *entry = hashTable[hash]; entry; entry = entry->hashNext ) {
+		if ( entry->key.entityDef == ent && entry->key.lightDef == light && entry->key.tri == tri ) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+/*
+==============
+idShadowVolumeCache::Remove
+
+Unlinks the entry and frees it, but not its shadow volume
+==============
+*/
+void idShadowVolumeCache::Remove( shadowCacheEntry_t *entry ) {
+	int hash = HashKey( entry->key.entityDef, entry->key.lightDef, entry->key.tri );
+	shadowCacheEntry_t **prev;
+
+	for ( prev = &hashTable[hash]; *prev; prev = &(*prev)->hashNext ) {
+		if ( *prev == entry ) {
+			*prev = entry->hashNext;
+			break;
+		}
+	}
+
+	entry->lruPrev->lruNext = entry->lruNext;
+	entry->lruNext->lruPrev = entry->lruPrev;
+
+	numEntries--;
+	totalBytes -= entry->bytes;
+
+	entryAllocator.Free( entry );
+}
+
+/*
+==============
+idShadowVolumeCache::Evict
+==============
+*/
+void idShadowVolumeCache::Evict( shadowCacheEntry_t *entry ) {
+	R_FreeStaticTriSurf( entry->shadowTris );
+	Remove( entry );
+	numEvictions++;
+}
+
+/*
+==============
+idShadowVolumeCache::Find
+==============
+*/
+srfTriangles_t *idShadowVolumeCache::Find( const idRenderEntityLocal *ent, const idRenderLightLocal *light, const srfTriangles_t *tri,
+											shadowGen_t shadowGen, bool seeThrough ) {
+	if ( !r_shadows.GetBool() ) {
+		return NULL;
+	}
+
+	shadowCacheEntry_t *entry = FindEntry( HashKey( ent, light, tri ), ent, light, tri );
+	if ( entry ) {
+		shadowCacheKey_t key;
+		MakeKey( key, ent, light, tri, shadowGen, seeThrough );
+
+		if ( !memcmp( &key, &entry->key, sizeof( key ) ) ) {
+			srfTriangles_t *shadowTris = entry->shadowTris;
+			Remove( entry );
+			numHits++;
+			return shadowTris;
+		}
+
+		// the light or entity moved, the volume will never be used again
+		Evict( entry );
+	}
+
+	numMisses++;
+	return NULL;
+}
+
+/*
+==============
+idShadowVolumeCache::Release
+==============
+*/
+void idShadowVolumeCache::Release( const idRenderEntityLocal *ent, const idRenderLightLocal *light, const idRenderModel *model,
+								const srfTriangles_t *tri, shadowGen_t shadowGen, bool seeThrough, srfTriangles_t *shadowTris ) {
+	const int maxBytes = r_shadowVolumeCacheMegs.GetInteger() * 1024 * 1024;
+
+	if ( maxBytes <= 0 ) {
+		R_FreeStaticTriSurf( shadowTris );
+		PurgeAll();
+		return;
+	}
+
+	// without private shadow vertexes the shadow cache is a reference to the
+	// one of the source surface, which AddActiveInteraction() sets every view
+	if ( shadowTris->shadowVertexes == NULL && shadowTris->verts == NULL ) {
+		shadowTris->shadowCache = NULL;
+	}
+
+	int hash = HashKey( ent, light, tri );
+
+	// only the most recent volume of a surface is kept, an entity
+	// that moves every frame would flush the cache otherwise
+	shadowCacheEntry_t *entry = FindEntry( hash, ent, light, tri );
+	if ( entry ) {
+		Evict( entry );
+	}
+
+	entry = entryAllocator.Alloc();
+	MakeKey( entry->key, ent, light, tri, shadowGen, seeThrough );
+	entry->model = model;
+	entry->shadowTris = shadowTris;
+	entry->bytes = sizeof( *entry ) + R_TriSurfMemory( shadowTris );
+
+	entry->hashNext = hashTable[hash];
+	hashTable[hash] = entry;
+
+	entry->lruNext = lru.lruNext;
+	entry->lruPrev = &lru;
+	lru.lruNext->lruPrev = entry;
+	lru.lruNext = entry;
+
+	numEntries++;
+	totalBytes += entry->bytes;
+
+	// free the least recently released volumes
+	while ( totalBytes > maxBytes && lru.lruPrev != &lru ) {
+		Evict( lru.lruPrev );
+	}
+}
+
+/*
+==============
+idShadowVolumeCache::PurgeModel
+==============
+*/
+void idShadowVolumeCache::PurgeModel( const idRenderModel *model ) {
+	shadowCacheEntry_t *entry, *prev;
+
+	for ( entry = lru.lruPrev; entry != &lru; entry = prev ) {
+		prev = entry->lruPrev;
+		if ( entry->model == model ) {
+			R_FreeStaticTriSurf( entry->shadowTris );
+			Remove( entry );
+		}
+	}
+}
+
+/*
+==============
+idShadowVolumeCache::PurgeAll
+==============
+*/
+void idShadowVolumeCache::PurgeAll( void ) {
+	while ( lru.lruPrev != &lru ) {
+		R_FreeStaticTriSurf( lru.lruPrev->shadowTris );
+		Remove( lru.lruPrev );
+	}
+}
+
+/*
+==============
+idShadowVolumeCache::PrintStats
+==============
+*/
+void idShadowVolumeCache::PrintStats( void ) const {
+	common->Printf( "%i cached shadow volumes totalling %ik of %ik\n", numEntries, totalBytes / 1024, r_shadowVolumeCacheMegs.GetInteger() * 1024 );
+	common->Printf( "shadow volume cache: %i hits, %i misses, %i evictions\n", numHits, numMisses, numEvictions );
+}
@@ -0,0 +1,141 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code ("Doom 3 Source Code").
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __SHADOWVOLUMECACHE_H__
+#define __SHADOWVOLUMECACHE_H__
+
+#include "framework/CVarSystem.h"
+#include "renderer/tr_local.h"
+
+/*
+===============================================================================
+
+	Shadow volume cache
+
+	Interactions are thrown away whenever their light or entity is updated,
+	even if the two didn't move relative to each other, and the shadow volumes
+	would be generated again from scratch.  When an interaction with a static
+	model frees its surfaces the shadow volumes are handed to the cache instead,
+	keyed on the entity, light and surface, the position of the light relative
+	to the entity and everything else that goes into the generation.  The next
+	CreateInteraction() for the same setup takes them back, including any index
+	and vertex buffers that were already uploaded.
+
+	Only shadow volumes not owned by an interaction are in the cache, so they
+	can be evicted at any time.  The least recently released volumes are freed
+	when r_shadowVolumeCacheMegs is exceeded, and at most one volume is kept per
+	entity / light / surface.
+
+	The cache is only used by the front end.
+
+===============================================================================
+*/
+
+typedef struct {
+	const idRenderEntityLocal *	entityDef;
+	const idRenderLightLocal *	lightDef;
+	const srfTriangles_t *		tri;				// source surface
+
+	idVec3						lightOrigin;		// light origin and axis in entity space
+	idMat3						lightAxis;
+	idVec3						entityScale;		// squared length of the entity axis
+
+	idVec3						lightCenter;		// shape of the light
+	idVec3						lightRadius;
+	idVec3						target;
+	idVec3						right;
+	idVec3						up;
+	idVec3						start;
+	idVec3						end;
+
+	int							flags;				// light type, generation method and cvars
+} shadowCacheKey_t;
+
+typedef struct shadowCacheEntry_s {
+	shadowCacheKey_t			key;
+	const idRenderModel *		model;				// for purging when the model is freed
+	srfTriangles_t *			shadowTris;
+	int							bytes;
+
+	struct shadowCacheEntry_s *	hashNext;
+	struct shadowCacheEntry_s *	lruNext;			// lru.lruNext is the most recently released
+	struct shadowCacheEntry_s *	lruPrev;
+} shadowCacheEntry_t;
+
+class idShadowVolumeCache {
+public:
+	void				Init( void );
+	void				Shutdown( void );
+
+	// shadow volumes of static models may be cached
+	bool				IsEnabled( const idRenderModel *model ) const;
+
+	// returns a shadow volume that is now owned by the caller, or NULL
+	srfTriangles_t *	Find( const idRenderEntityLocal *ent, const idRenderLightLocal *light, const srfTriangles_t *tri,
+								shadowGen_t shadowGen, bool seeThrough );
+
+	// takes ownership of a shadow volume that was created for the given surface,
+	// the entity and light must not have changed since it was created
+	void				Release( const idRenderEntityLocal *ent, const idRenderLightLocal *light, const idRenderModel *model,
+								const srfTriangles_t *tri, shadowGen_t shadowGen, bool seeThrough, srfTriangles_t *shadowTris );
+
+	// frees all volumes generated from the surfaces of the model
+	void				PurgeModel( const idRenderModel *model );
+
+	void				PurgeAll( void );
+
+	// showInteractionMemory calls this
+	void				PrintStats( void ) const;
+
+private:
+	static const int	HASH_SIZE = 4096;
+
+	void				MakeKey( shadowCacheKey_t &key, const idRenderEntityLocal *ent, const idRenderLightLocal *light,
+								const srfTriangles_t *tri, shadowGen_t shadowGen, bool seeThrough ) const;
+	int					HashKey( const idRenderEntityLocal *ent, const idRenderLightLocal *light, const srfTriangles_t *tri ) const;
+	shadowCacheEntry_t *FindEntry( int hash, const idRenderEntityLocal *ent, const idRenderLightLocal *light, const srfTriangles_t *tri ) const;
+	void				Remove( shadowCacheEntry_t *entry );
+	void				Evict( shadowCacheEntry_t *entry );
+
+	static idCVar		r_shadowVolumeCacheMegs;
+
+	idBlockAlloc<shadowCacheEntry_t,256>	entryAllocator;
+	shadowCacheEntry_t *hashTable[HASH_SIZE];
+	shadowCacheEntry_t	lru;						// head of doubly linked list
+
+	int					numEntries;
+	int					totalBytes;
+
+	int					numHits;
+	int					numMisses;
+	int					numEvictions;
+};
+
+extern idShadowVolumeCache	shadowVolumeCache;
+
+#endif /* !__SHADOWVOLUMECACHE_H__ */
@@ -488,13 +488,23 @@ void RB_T_FillDepthBuffer( const drawSurf_t *surf ) {
 		qglDisable( GL_ALPHA_TEST );
 		if ( !didDraw ) {
 			drawSolid = true;
+		} else {
+			// the color and texture were changed by the alpha tested stages
+			backEnd.depthFillMaterial = NULL;
 		}
 	}
 
 	// draw the entire surface solid
 	if ( drawSolid ) {
-		qglColor4fv( color );
-		globalImages->whiteImage->Bind();
+		// the color only depends on the material, and surfaces are
+		// sorted by material, so runs of the same material skip the setup
+		if ( backEnd.depthFillMaterial != shader ) {
+			qglColor4fv( color );
+			globalImages->whiteImage->Bind();
+			backEnd.depthFillMaterial = shader;
+		} else {
+			backEnd.pc.c_materialSetupsSkipped++;
+		}
 
 		// draw it
 		RB_DrawElementsWithCounters( tri );
@@ -551,7 +561,9 @@ void RB_STD_FillDepthBuffer( drawSurf_t **drawSurfs, int numDrawSurfs ) {
 	qglEnable( GL_STENCIL_TEST );
 	qglStencilFunc( GL_ALWAYS, 1, 255 );
 
+	backEnd.depthFillMaterial = NULL;
 	RB_RenderDrawSurfListWithFunction( drawSurfs, numDrawSurfs, RB_T_FillDepthBuffer );
+	backEnd.depthFillMaterial = NULL;
 
 	if ( backEnd.viewDef->numClipPlanes ) {
 		GL_SelectTexture( 1 );
@@ -728,6 +740,8 @@ void RB_STD_T_RenderShaderPasses( const drawSurf_t *surf ) {
 		qglLoadMatrixf( surf->space->modelViewMatrix );
 		backEnd.currentSpace = surf->space;
 		RB_SetProgramEnvironmentSpace();
+	} else {
+		backEnd.pc.c_entitySetupsSkipped++;
 	}
 
 	// change the scissor if needed
@@ -761,13 +775,8 @@ void RB_STD_T_RenderShaderPasses( const drawSurf_t *surf ) {
 		qglPolygonOffset( r_offsetFactor.GetFloat(), r_offsetUnits.GetFloat() * shader->GetPolygonOffset() );
 	}
 
-	if ( surf->space->weaponDepthHack ) {
-		RB_EnterWeaponDepthHack();
-	}
-
-	if ( surf->space->modelDepthHack != 0.0f ) {
-		RB_EnterModelDepthHack( surf->space->modelDepthHack );
-	}
+	// the depth hack stays set for following surfaces of the same entity
+	RB_SetDepthHack( surf->space );
 
 	idDrawVert *ac = (idDrawVert *)vertexCache.Position( tri->ambientCache );
 	qglVertexPointer( 3, GL_FLOAT, sizeof( idDrawVert ), ac->xyz.ToFloatPtr() );
@@ -972,9 +981,6 @@ void RB_STD_T_RenderShaderPasses( const drawSurf_t *surf ) {
 	if ( shader->TestMaterialFlag(MF_POLYGONOFFSET) ) {
 		qglDisable( GL_POLYGON_OFFSET_FILL );
 	}
-	if ( surf->space->weaponDepthHack || surf->space->modelDepthHack != 0.0f ) {
-		RB_LeaveDepthHack();
-	}
 }
 
 /*
@@ -1043,6 +1049,8 @@ int RB_STD_DrawShaderPasses( drawSurf_t **drawSurfs, int numDrawSurfs ) {
 		RB_STD_T_RenderShaderPasses( drawSurfs[i] );
 	}
 
+	RB_SetDepthHack( NULL );
+
 	GL_Cull( CT_FRONT_SIDED );
 	qglColor3f( 1, 1, 1 );
 
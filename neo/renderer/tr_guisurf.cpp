@@ -141,7 +141,7 @@ void R_RenderGuiSurf( idUserInterface *gui, drawSurf_t *drawSurf ) {
 		return;
 	}
 
-	tr.pc.c_guiSurfs++;
+	R_FrontEndCounters().c_guiSurfs++;
 
 	// create the new matrix to draw on this surface
 	R_SurfaceToTextureAxis( drawSurf->geo, origin, axis );
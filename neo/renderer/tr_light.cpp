@@ -584,11 +584,15 @@ void idRenderWorldLocal::CreateLightDefInteractions( idRenderLightLocal *ldef )
 
 			// if any of the edef's interaction match this light, we don't
 			// need to consider it.
-			if ( r_useInteractionTable.GetBool() && this->interactionTable ) {
+			if ( r_useInteractionTable.GetInteger() != 0 && ( this->interactionTable || this->interactionHash.IsAllocated() ) ) {
 				// allocating these tables may take several megs on big maps, but it saves 3% to 5% of
 				// the CPU time.  The table is updated at interaction::AllocAndLink() and interaction::UnlinkAndFree()
-				int index = ldef->index * this->interactionTableWidth + edef->index;
-				inter = this->interactionTable[ index ];
+				if ( this->interactionTable ) {
+					int index = ldef->index * this->interactionTableWidth + edef->index;
+					inter = this->interactionTable[ index ];
+				} else {
+					inter = this->interactionHash.Find( ldef->index, edef->index );
+				}
 				if ( inter ) {
 					// if this entity wasn't in view already, the scissor rect will be empty,
 					// so it will only be used for shadow casting
@@ -857,11 +861,126 @@ idScreenRect	R_CalcLightScissorRectangle( viewLight_t *vLight ) {
 	return r;
 }
 
+/*
+=================
+R_SetupViewLight
+
+Evaluates the light shader registers and calculates the light scissor rect.
+Returns false if the light is suppressed in this view or doesn't add anything.
+
+This only reads the light and the view, so it is also run from front end jobs.
+=================
+*/
+static bool R_SetupViewLight( viewLight_t *vLight ) {
+	idRenderLightLocal	*light = vLight->lightDef;
+	const idMaterial	*lightShader = light->lightShader;
+
+	// see if we are suppressing the light in this view
+	if ( !r_skipSuppress.GetBool() ) {
+		if ( light->parms.suppressLightInViewID
+		&& light->parms.suppressLightInViewID == tr.viewDef->renderView.viewID ) {
+			return false;
+		}
+		if ( light->parms.allowLightInViewID
+		&& light->parms.allowLightInViewID != tr.viewDef->renderView.viewID ) {
+			return false;
+		}
+	}
+
+	// evaluate the light shader registers
+	float *lightRegs =(float *)R_FrameAlloc( lightShader->GetNumRegisters() * sizeof( float ) );
+	vLight->shaderRegisters = lightRegs;
+	lightShader->EvaluateRegisters( lightRegs, light->parms.shaderParms, tr.viewDef, light->parms.referenceSound );
+
+	// if this is a purely additive light and no stage in the light shader evaluates
+	// to a positive light value, we can completely skip the light
+	if ( !lightShader->IsFogLight() && !lightShader->IsBlendLight() ) {
+		int lightStageNum;
+		for ( lightStageNum = 0 ; lightStageNum < lightShader->GetNumStages() ; lightStageNum++ ) {
+			const shaderStage_t	*lightStage = lightShader->GetStage( lightStageNum );
+
+			// ignore stages that fail the condition
+			if ( !lightRegs[ lightStage->conditionRegister ] ) {
+				continue;
+			}
+
+			const int *registers = lightStage->color.registers;
+
+			// snap tiny values to zero to avoid lights showing up with the wrong color
+			if ( lightRegs[ registers[0] ] < 0.001f ) {
+				lightRegs[ registers[0] ] = 0.0f;
+			}
+			if ( lightRegs[ registers[1] ] < 0.001f ) {
+				lightRegs[ registers[1] ] = 0.0f;
+			}
+			if ( lightRegs[ registers[2] ] < 0.001f ) {
+				lightRegs[ registers[2] ] = 0.0f;
+			}
+
+			// FIXME:	when using the following values the light shows up bright red when using nvidia drivers/hardware
+			//			this seems to have been fixed ?
+			//lightRegs[ registers[0] ] = 1.5143074e-005f;
+			//lightRegs[ registers[1] ] = 1.5483369e-005f;
+			//lightRegs[ registers[2] ] = 1.7014690e-005f;
+
+			if ( lightRegs[ registers[0] ] > 0.0f ||
+					lightRegs[ registers[1] ] > 0.0f ||
+						lightRegs[ registers[2] ] > 0.0f ) {
+				break;
+			}
+		}
+		if ( lightStageNum == lightShader->GetNumStages() ) {
+			// we went through all the stages and didn't find one that adds anything
+			return false;
+		}
+	}
+
+	if ( r_useLightScissors.GetBool() ) {
+		// calculate the screen area covered by the light frustum
+		// which will be used to crop the stencil cull
+		idScreenRect scissorRect = R_CalcLightScissorRectangle( vLight );
+		// intersect with the portal crossing scissor rectangle
+		vLight->scissorRect.Intersect( scissorRect );
+	}
+
+	return true;
+}
+
+// results of the front end jobs, in the order of the viewLights / viewEntitys lists
+typedef enum {
+	FRONTEND_JOB_MAIN_THREAD,	// the job couldn't do the work, the main thread has to
+	FRONTEND_JOB_VISIBLE,
+	FRONTEND_JOB_CULLED
+} frontEndJobResult_t;
+
+typedef struct {
+	viewLight_t *			vLight;
+	frontEndJobResult_t		result;
+} viewLightJob_t;
+
+/*
+=================
+R_ViewLightJob
+=================
+*/
+static void R_ViewLightJob( void *data, int jobNum ) {
+	viewLightJob_t *job = (viewLightJob_t *)data + jobNum;
+	const idRenderLightLocal *light = job->vLight->lightDef;
+
+	// sound emitters can't be sampled off the main thread
+	if ( light->parms.referenceSound && light->lightShader->ReferencesSoundAmplitude() ) {
+		job->result = FRONTEND_JOB_MAIN_THREAD;
+		return;
+	}
+
+	job->result = R_SetupViewLight( job->vLight ) ? FRONTEND_JOB_VISIBLE : FRONTEND_JOB_CULLED;
+}
+
 /*
 =================
 R_AddLightSurfaces
 
-Calc the light shader values, removing any light from the viewLight list
+Calc the light shader values, removing any light from the viewLights list
 if it is determined to not have any visible effect due to being flashed off or turned off.
 
 Adds entities to the viewEntity list if they are needed for shadow casting.
@@ -873,16 +992,39 @@ turned off, or completely off screen.
 
 Create any new interactions needed between the viewLights
 and the viewEntitys due to game movement
+
+With r_useParallelFrontEnd the register evaluation and scissor calculation
+of all lights is done by jobs first, everything that modifies the world
+or the vertex cache still happens here in viewLights order.
 =================
 */
 void R_AddLightSurfaces( void ) {
 	viewLight_t		*vLight;
 	idRenderLightLocal *light;
 	viewLight_t		**ptr;
+	viewLightJob_t	*jobs = NULL;
+	int				numJobs = 0;
+
+	if ( R_UseParallelFrontEnd() ) {
+		for ( vLight = tr.viewDef->viewLights ; vLight ; vLight = vLight->next ) {
+			if ( !vLight->lightDef->lightShader ) {
+				common->Error( "R_AddLightSurfaces: NULL lightShader" );
+			}
+			numJobs++;
+		}
+		jobs = (viewLightJob_t *)R_FrameAlloc( numJobs * sizeof( jobs[0] ) );
+		numJobs = 0;
+		for ( vLight = tr.viewDef->viewLights ; vLight ; vLight = vLight->next ) {
+			jobs[numJobs].vLight = vLight;
+			jobs[numJobs].result = FRONTEND_JOB_MAIN_THREAD;
+			numJobs++;
+		}
+		R_RunFrontEndJobs( R_ViewLightJob, jobs, numJobs );
+	}
 
 	// go through each visible light, possibly removing some from the list
 	ptr = &tr.viewDef->viewLights;
-	while ( *ptr ) {
+	for ( int jobNum = 0 ; *ptr ; jobNum++ ) {
 		vLight = *ptr;
 		light = vLight->lightDef;
 
@@ -891,85 +1033,26 @@ void R_AddLightSurfaces( void ) {
 			common->Error( "R_AddLightSurfaces: NULL lightShader" );
 		}
 
-		// see if we are suppressing the light in this view
-		if ( !r_skipSuppress.GetBool() ) {
-			if ( light->parms.suppressLightInViewID
-			&& light->parms.suppressLightInViewID == tr.viewDef->renderView.viewID ) {
-				*ptr = vLight->next;
-				light->viewCount = -1;
-				continue;
-			}
-			if ( light->parms.allowLightInViewID
-			&& light->parms.allowLightInViewID != tr.viewDef->renderView.viewID ) {
-				*ptr = vLight->next;
-				light->viewCount = -1;
-				continue;
-			}
+		frontEndJobResult_t result = FRONTEND_JOB_MAIN_THREAD;
+		if ( jobNum < numJobs ) {
+			assert( jobs[jobNum].vLight == vLight );
+			result = jobs[jobNum].result;
 		}
-
-		// evaluate the light shader registers
-		float *lightRegs =(float *)R_FrameAlloc( lightShader->GetNumRegisters() * sizeof( float ) );
-		vLight->shaderRegisters = lightRegs;
-		lightShader->EvaluateRegisters( lightRegs, light->parms.shaderParms, tr.viewDef, light->parms.referenceSound );
-
-		// if this is a purely additive light and no stage in the light shader evaluates
-		// to a positive light value, we can completely skip the light
-		if ( !lightShader->IsFogLight() && !lightShader->IsBlendLight() ) {
-			int lightStageNum;
-			for ( lightStageNum = 0 ; lightStageNum < lightShader->GetNumStages() ; lightStageNum++ ) {
-				const shaderStage_t	*lightStage = lightShader->GetStage( lightStageNum );
-
-				// ignore stages that fail the condition
-				if ( !lightRegs[ lightStage->conditionRegister ] ) {
-					continue;
-				}
-
-				const int *registers = lightStage->color.registers;
-
-				// snap tiny values to zero to avoid lights showing up with the wrong color
-				if ( lightRegs[ registers[0] ] < 0.001f ) {
-					lightRegs[ registers[0] ] = 0.0f;
-				}
-				if ( lightRegs[ registers[1] ] < 0.001f ) {
-					lightRegs[ registers[1] ] = 0.0f;
-				}
-				if ( lightRegs[ registers[2] ] < 0.001f ) {
-					lightRegs[ registers[2] ] = 0.0f;
-				}
-
-				// FIXME:	when using the following values the light shows up bright red when using nvidia drivers/hardware
-				//			this seems to have been fixed ?
-				//lightRegs[ registers[0] ] = 1.5143074e-005f;
-				//lightRegs[ registers[1] ] = 1.5483369e-005f;
-				//lightRegs[ registers[2] ] = 1.7014690e-005f;
-
-				if ( lightRegs[ registers[0] ] > 0.0f ||
-						lightRegs[ registers[1] ] > 0.0f ||
-							lightRegs[ registers[2] ] > 0.0f ) {
-					break;
-				}
-			}
-			if ( lightStageNum == lightShader->GetNumStages() ) {
-				// we went through all the stages and didn't find one that adds anything
-				// remove the light from the viewLights list, and change its frame marker
-				// so interaction generation doesn't think the light is visible and
-				// create a shadow for it
-				*ptr = vLight->next;
-				light->viewCount = -1;
-				continue;
-			}
+		if ( result == FRONTEND_JOB_MAIN_THREAD ) {
+			result = R_SetupViewLight( vLight ) ? FRONTEND_JOB_VISIBLE : FRONTEND_JOB_CULLED;
 		}
 
-		if ( r_useLightScissors.GetBool() ) {
-			// calculate the screen area covered by the light frustum
-			// which will be used to crop the stencil cull
-			idScreenRect scissorRect = R_CalcLightScissorRectangle( vLight );
-			// intersect with the portal crossing scissor rectangle
-			vLight->scissorRect.Intersect( scissorRect );
+		if ( result == FRONTEND_JOB_CULLED ) {
+			// remove the light from the viewLights list, and change its frame marker
+			// so interaction generation doesn't think the light is visible and
+			// create a shadow for it
+			*ptr = vLight->next;
+			light->viewCount = -1;
+			continue;
+		}
 
-			if ( r_showLightScissors.GetBool() ) {
-				R_ShowColoredScreenRect( vLight->scissorRect, light->index );
-			}
+		if ( r_useLightScissors.GetBool() && r_showLightScissors.GetBool() ) {
+			R_ShowColoredScreenRect( vLight->scissorRect, light->index );
 		}
 
 #if 0
@@ -996,7 +1079,7 @@ void R_AddLightSurfaces( void ) {
 		// that may cast shadows, even if they aren't directly visible.  Any real work
 		// will be deferred until we walk through the viewEntities
 		tr.viewDef->renderWorld->CreateLightDefInteractions( light );
-		tr.pc.c_viewLights++;
+		R_FrontEndCounters().c_viewLights++;
 
 		// fog lights will need to draw the light frustum triangles, so make sure they
 		// are in the vertex cache
@@ -1070,7 +1153,7 @@ bool R_IssueEntityDefCallback( idRenderEntityLocal *def ) {
 	}
 
 	def->archived = false;		// will need to be written to the demo file
-	tr.pc.c_entityDefCallbacks++;
+	R_FrontEndCounters().c_entityDefCallbacks++;
 	if ( tr.viewDef ) {
 		update = def->parms.callback( &def->parms, &tr.viewDef->renderView );
 	} else {
@@ -1096,6 +1179,38 @@ bool R_IssueEntityDefCallback( idRenderEntityLocal *def ) {
 	return update;
 }
 
+/*
+===================
+R_FinishEntityDefDynamicModel
+
+Adds the overlays to a newly instantiated dynamic model and checks its bounds.
+===================
+*/
+void R_FinishEntityDefDynamicModel( idRenderEntityLocal *def ) {
+	if ( !def->cachedDynamicModel ) {
+		return;
+	}
+
+	// add any overlays to the snapshot of the dynamic model
+	if ( def->overlay && !r_skipOverlays.GetBool() ) {
+		def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
+	} else {
+		idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
+	}
+
+	if ( r_checkBounds.GetBool() ) {
+		idBounds b = def->cachedDynamicModel->Bounds();
+		if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
+				b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
+				b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
+				b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
+				b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
+				b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
+			common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
+		}
+	}
+}
+
 /*
 ===================
 R_EntityDefDynamicModel
@@ -1104,9 +1219,13 @@ Issues a deferred entity callback if necessary.
 If the model isn't dynamic, it returns the original.
 Returns the cached dynamic model if present, otherwise creates
 it and any necessary overlays
+
+If needsFinish is given, a newly created model is not finished,
+*needsFinish is set instead, and R_FinishEntityDefDynamicModel has
+to be called once the skinning batch it was queued on has completed.
 ===================
 */
-idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
+idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def, bool *needsFinish ) {
 	bool callbackUpdate;
 
 	// allow deferred entities to construct themselves
@@ -1139,26 +1258,10 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 		// instantiate the snapshot of the dynamic model, possibly reusing memory from the cached snapshot
 		def->cachedDynamicModel = model->InstantiateDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
 
-		if ( def->cachedDynamicModel ) {
-
-			// add any overlays to the snapshot of the dynamic model
-			if ( def->overlay && !r_skipOverlays.GetBool() ) {
-				def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
-			} else {
-				idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
-			}
-
-			if ( r_checkBounds.GetBool() ) {
-				idBounds b = def->cachedDynamicModel->Bounds();
-				if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
-						b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
-						b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
-						b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
-						b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
-						b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
-					common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
-				}
-			}
+		if ( needsFinish ) {
+			*needsFinish = ( def->cachedDynamicModel != NULL );
+		} else {
+			R_FinishEntityDefDynamicModel( def );
 		}
 
 		def->dynamicModel = def->cachedDynamicModel;
@@ -1182,24 +1285,34 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 
 /*
 =================
-R_AddDrawSurf
+R_AllocDrawSurf
 =================
 */
-void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const renderEntity_t *renderEntity,
-					const idMaterial *shader, const idScreenRect &scissor ) {
+static drawSurf_t *R_AllocDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const idMaterial *shader, const idScreenRect &scissor ) {
 	drawSurf_t		*drawSurf;
-	const float		*shaderParms;
-	static float	refRegs[MAX_EXPRESSION_REGISTERS];	// don't put on stack, or VC++ will do a page touch
-	float			generatedShaderParms[MAX_ENTITY_SHADER_PARMS];
 
 	drawSurf = (drawSurf_t *)R_FrameAlloc( sizeof( *drawSurf ) );
 	drawSurf->geo = tri;
 	drawSurf->space = space;
 	drawSurf->material = shader;
 	drawSurf->scissorRect = scissor;
-	drawSurf->sort = shader->GetSort() + tr.sortOffset;
+	drawSurf->sort = shader->GetSort();
+	drawSurf->shaderRegisters = NULL;
 	drawSurf->dsFlags = 0;
 
+	return drawSurf;
+}
+
+/*
+=================
+R_LinkDrawSurf
+
+Adds the drawSurf to the view's list
+=================
+*/
+static void R_LinkDrawSurf( drawSurf_t *drawSurf ) {
+	drawSurf->sort += tr.sortOffset;
+
 	// bumping this offset each time causes surfaces with equal sort orders to still
 	// deterministically draw in the order they are added
 	tr.sortOffset += 0.000001f;
@@ -1221,56 +1334,88 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 	}
 	tr.viewDef->drawSurfs[tr.viewDef->numDrawSurfs] = drawSurf;
 	tr.viewDef->numDrawSurfs++;
+}
+
+/*
+=================
+R_EvaluateDrawSurfRegisters
+
+Process the shader expressions for conditionals / color / texcoords.
+The view must already have the entity's time group time.  If refRegs
+is NULL, reference shaders are evaluated into frame memory.
+=================
+*/
+static void R_EvaluateDrawSurfRegisters( drawSurf_t *drawSurf, const renderEntity_t *renderEntity, const viewDef_t *view, float *refRegs ) {
+	const idMaterial	*shader = drawSurf->material;
+	const float			*shaderParms;
+	float				generatedShaderParms[MAX_ENTITY_SHADER_PARMS];
 
-	// process the shader expressions for conditionals / color / texcoords
 	const float	*constRegs = shader->ConstantRegisters();
 	if ( constRegs ) {
 		// shader only uses constant values
 		drawSurf->shaderRegisters = constRegs;
-	} else {
-		float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
-		drawSurf->shaderRegisters = regs;
-
-		// a reference shader will take the calculated stage color value from another shader
-		// and use that for the parm0-parm3 of the current shader, which allows a stage of
-		// a light model and light flares to pick up different flashing tables from
-		// different light shaders
-		if ( renderEntity->referenceShader ) {
-			// evaluate the reference shader to find our shader parms
-			const shaderStage_t *pStage;
-
-			renderEntity->referenceShader->EvaluateRegisters( refRegs, renderEntity->shaderParms, tr.viewDef, renderEntity->referenceSound );
-			pStage = renderEntity->referenceShader->GetStage(0);
-
-			memcpy( generatedShaderParms, renderEntity->shaderParms, sizeof( generatedShaderParms ) );
-			generatedShaderParms[0] = refRegs[ pStage->color.registers[0] ];
-			generatedShaderParms[1] = refRegs[ pStage->color.registers[1] ];
-			generatedShaderParms[2] = refRegs[ pStage->color.registers[2] ];
-
-			shaderParms = generatedShaderParms;
-		} else {
-			// evaluate with the entityDef's shader parms
-			shaderParms = renderEntity->shaderParms;
-		}
+		return;
+	}
 
-		float oldFloatTime = 0.0f;
-		int oldTime = 0;
+	float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
+	drawSurf->shaderRegisters = regs;
 
-		if ( space->entityDef && space->entityDef->parms.timeGroup ) {
-			oldFloatTime = tr.viewDef->floatTime;
-			oldTime = tr.viewDef->renderView.time;
+	// a reference shader will take the calculated stage color value from another shader
+	// and use that for the parm0-parm3 of the current shader, which allows a stage of
+	// a light model and light flares to pick up different flashing tables from
+	// different light shaders
+	if ( renderEntity->referenceShader ) {
+		// evaluate the reference shader to find our shader parms
+		const shaderStage_t *pStage;
 
-			tr.viewDef->floatTime = game->GetTimeGroupTime( space->entityDef->parms.timeGroup ) * 0.001;
-			tr.viewDef->renderView.time = game->GetTimeGroupTime( space->entityDef->parms.timeGroup );
+		if ( !refRegs ) {
+			refRegs = (float *)R_FrameAlloc( renderEntity->referenceShader->GetNumRegisters() * sizeof( float ) );
 		}
+		renderEntity->referenceShader->EvaluateRegisters( refRegs, renderEntity->shaderParms, view, renderEntity->referenceSound );
+		pStage = renderEntity->referenceShader->GetStage(0);
 
-		shader->EvaluateRegisters( regs, shaderParms, tr.viewDef, renderEntity->referenceSound );
+		memcpy( generatedShaderParms, renderEntity->shaderParms, sizeof( generatedShaderParms ) );
+		generatedShaderParms[0] = refRegs[ pStage->color.registers[0] ];
+		generatedShaderParms[1] = refRegs[ pStage->color.registers[1] ];
+		generatedShaderParms[2] = refRegs[ pStage->color.registers[2] ];
 
-		if ( space->entityDef && space->entityDef->parms.timeGroup ) {
-			tr.viewDef->floatTime = oldFloatTime;
-			tr.viewDef->renderView.time = oldTime;
-		}
+		shaderParms = generatedShaderParms;
+	} else {
+		// evaluate with the entityDef's shader parms
+		shaderParms = renderEntity->shaderParms;
+	}
+
+	shader->EvaluateRegisters( regs, shaderParms, view, renderEntity->referenceSound );
+}
+
+/*
+=================
+R_DrawSurfNeedsMainThread
+
+Sound emitters can only be sampled on the main thread.
+=================
+*/
+static bool R_DrawSurfNeedsMainThread( const idMaterial *shader, const renderEntity_t *renderEntity ) {
+	if ( !renderEntity->referenceSound ) {
+		return false;
+	}
+	if ( shader->ReferencesSoundAmplitude() ) {
+		return true;
 	}
+	return ( renderEntity->referenceShader && renderEntity->referenceShader->ReferencesSoundAmplitude() );
+}
+
+/*
+=================
+R_FinishDrawSurf
+
+Deforms, texgens and guis, which need the vertex cache or
+the gui system, and have to be run on the main thread.
+=================
+*/
+static void R_FinishDrawSurf( drawSurf_t *drawSurf, const renderEntity_t *renderEntity ) {
+	const idMaterial	*shader = drawSurf->material;
+	const viewEntity_t	*space = drawSurf->space;
 
 	// check for deformations
 	R_DeformDrawSurf( drawSurf );
@@ -1328,6 +1473,163 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 	// adds for this view
 }
 
+/*
+=================
+R_AddPreparedDrawSurf
+
+Adds a drawSurf from R_AllocDrawSurf to the view, evaluating
+its registers now if a front end job didn't already do it.
+=================
+*/
+static void R_AddPreparedDrawSurf( drawSurf_t *drawSurf, const renderEntity_t *renderEntity ) {
+	static float	refRegs[MAX_EXPRESSION_REGISTERS];	// don't put on stack, or VC++ will do a page touch
+	const viewEntity_t *space = drawSurf->space;
+
+	R_LinkDrawSurf( drawSurf );
+
+	if ( !drawSurf->shaderRegisters ) {
+		float oldFloatTime = 0.0f;
+		int oldTime = 0;
+
+		if ( space->entityDef && space->entityDef->parms.timeGroup ) {
+			oldFloatTime = tr.viewDef->floatTime;
+			oldTime = tr.viewDef->renderView.time;
+
+			tr.viewDef->floatTime = game->GetTimeGroupTime( space->entityDef->parms.timeGroup ) * 0.001;
+			tr.viewDef->renderView.time = game->GetTimeGroupTime( space->entityDef->parms.timeGroup );
+		}
+
+		R_EvaluateDrawSurfRegisters( drawSurf, renderEntity, tr.viewDef, refRegs );
+
+		if ( space->entityDef && space->entityDef->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+	}
+
+	R_FinishDrawSurf( drawSurf, renderEntity );
+}
+
+/*
+=================
+R_AddDrawSurf
+=================
+*/
+void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const renderEntity_t *renderEntity,
+					const idMaterial *shader, const idScreenRect &scissor ) {
+	R_AddPreparedDrawSurf( R_AllocDrawSurf( tri, space, shader, scissor ), renderEntity );
+}
+
+/*
+===============
+R_AmbientSurfShader
+
+Returns the shader the surface of the entity's model should be drawn with,
+or NULL if it isn't drawn or is outside the view frustum.
+===============
+*/
+static const idMaterial *R_AmbientSurfShader( const viewEntity_t *vEntity, const idRenderModel *model, int surfNum ) {
+	const idRenderEntityLocal	*def = vEntity->entityDef;
+	const modelSurface_t		*surf = model->Surface( surfNum );
+	const srfTriangles_t		*tri;
+	const idMaterial			*shader;
+
+	// for debugging, only show a single surface at a time
+	if ( r_singleSurface.GetInteger() >= 0 && surfNum != r_singleSurface.GetInteger() ) {
+		return NULL;
+	}
+
+	tri = surf->geometry;
+	if ( !tri ) {
+		return NULL;
+	}
+	if ( !tri->numIndexes ) {
+		return NULL;
+	}
+	shader = surf->shader;
+	shader = R_RemapShaderBySkin( shader, def->parms.customSkin, def->parms.customShader );
+
+	R_GlobalShaderOverride( &shader );
+
+	if ( !shader ) {
+		return NULL;
+	}
+	if ( !shader->IsDrawn() ) {
+		return NULL;
+	}
+
+	// debugging tool to make sure we are have the correct pre-calculated bounds
+	if ( r_checkBounds.GetBool() ) {
+		int j, k;
+		for ( j = 0 ; j < tri->numVerts ; j++ ) {
+			for ( k = 0 ; k < 3 ; k++ ) {
+				if ( tri->verts[j].xyz[k] > tri->bounds[1][k] + CHECK_BOUNDS_EPSILON
+					|| tri->verts[j].xyz[k] < tri->bounds[0][k] - CHECK_BOUNDS_EPSILON ) {
+					common->Printf( "bad tri->bounds on %s:%s\n", def->parms.hModel->Name(), shader->GetName() );
+					break;
+				}
+				if ( tri->verts[j].xyz[k] > def->referenceBounds[1][k] + CHECK_BOUNDS_EPSILON
+					|| tri->verts[j].xyz[k] < def->referenceBounds[0][k] - CHECK_BOUNDS_EPSILON ) {
+					common->Printf( "bad referenceBounds on %s:%s\n", def->parms.hModel->Name(), shader->GetName() );
+					break;
+				}
+			}
+			if ( k != 3 ) {
+				break;
+			}
+		}
+	}
+
+	if ( R_CullLocalBox( tri->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
+		return NULL;
+	}
+
+	return shader;
+}
+
+/*
+===============
+R_AddAmbientDrawSurf
+
+Makes sure the surface has an ambient cache and adds it to the view.
+If drawSurf is NULL, a new drawSurf is created.  Returns false
+if the vertex cache was too full to give us an ambient cache.
+===============
+*/
+static bool R_AddAmbientDrawSurf( viewEntity_t *vEntity, srfTriangles_t *tri, const idMaterial *shader, drawSurf_t *drawSurf ) {
+	idRenderEntityLocal	*def = vEntity->entityDef;
+
+	def->visibleCount = tr.viewCount;
+
+	// make sure we have an ambient cache
+	if ( !R_CreateAmbientCache( tri, shader->ReceivesLighting() ) ) {
+		// don't add anything if the vertex cache was too full to give us an ambient cache
+		return false;
+	}
+	// touch it so it won't get purged
+	vertexCache.Touch( tri->ambientCache );
+
+	if ( r_useIndexBuffers.GetBool() && !tri->indexCache ) {
+		vertexCache.Alloc( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ), &tri->indexCache, true );
+	}
+	if ( tri->indexCache ) {
+		vertexCache.Touch( tri->indexCache );
+	}
+
+	// add the surface for drawing
+	if ( drawSurf ) {
+		R_AddPreparedDrawSurf( drawSurf, &def->parms );
+	} else {
+		R_AddDrawSurf( tri, vEntity, &def->parms, shader, vEntity->scissorRect );
+	}
+
+	// ambientViewCount is used to allow light interactions to be rejected
+	// if the ambient surface isn't visible at all
+	tri->ambientViewCount = tr.viewCount;
+
+	return true;
+}
+
 /*
 ===============
 R_AddAmbientDrawsurfs
@@ -1340,7 +1642,6 @@ each viewEntity that has a non-empty scissorRect
 static void R_AddAmbientDrawsurfs( viewEntity_t *vEntity ) {
 	int					i, total;
 	idRenderEntityLocal	*def;
-	srfTriangles_t		*tri;
 	idRenderModel		*model;
 	const idMaterial	*shader;
 
@@ -1355,79 +1656,12 @@ static void R_AddAmbientDrawsurfs( viewEntity_t *vEntity ) {
 	// add all the surfaces
 	total = model->NumSurfaces();
 	for ( i = 0 ; i < total ; i++ ) {
-		const modelSurface_t	*surf = model->Surface( i );
-
-		// for debugging, only show a single surface at a time
-		if ( r_singleSurface.GetInteger() >= 0 && i != r_singleSurface.GetInteger() ) {
-			continue;
-		}
-
-		tri = surf->geometry;
-		if ( !tri ) {
-			continue;
-		}
-		if ( !tri->numIndexes ) {
-			continue;
-		}
-		shader = surf->shader;
-		shader = R_RemapShaderBySkin( shader, def->parms.customSkin, def->parms.customShader );
-
-		R_GlobalShaderOverride( &shader );
-
+		shader = R_AmbientSurfShader( vEntity, model, i );
 		if ( !shader ) {
 			continue;
 		}
-		if ( !shader->IsDrawn() ) {
-			continue;
-		}
-
-		// debugging tool to make sure we are have the correct pre-calculated bounds
-		if ( r_checkBounds.GetBool() ) {
-			int j, k;
-			for ( j = 0 ; j < tri->numVerts ; j++ ) {
-				for ( k = 0 ; k < 3 ; k++ ) {
-					if ( tri->verts[j].xyz[k] > tri->bounds[1][k] + CHECK_BOUNDS_EPSILON
-						|| tri->verts[j].xyz[k] < tri->bounds[0][k] - CHECK_BOUNDS_EPSILON ) {
-						common->Printf( "bad tri->bounds on %s:%s\n", def->parms.hModel->Name(), shader->GetName() );
-						break;
-					}
-					if ( tri->verts[j].xyz[k] > def->referenceBounds[1][k] + CHECK_BOUNDS_EPSILON
-						|| tri->verts[j].xyz[k] < def->referenceBounds[0][k] - CHECK_BOUNDS_EPSILON ) {
-						common->Printf( "bad referenceBounds on %s:%s\n", def->parms.hModel->Name(), shader->GetName() );
-						break;
-					}
-				}
-				if ( k != 3 ) {
-					break;
-				}
-			}
-		}
-
-		if ( !R_CullLocalBox( tri->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
-
-			def->visibleCount = tr.viewCount;
-
-			// make sure we have an ambient cache
-			if ( !R_CreateAmbientCache( tri, shader->ReceivesLighting() ) ) {
-				// don't add anything if the vertex cache was too full to give us an ambient cache
-				return;
-			}
-			// touch it so it won't get purged
-			vertexCache.Touch( tri->ambientCache );
-
-			if ( r_useIndexBuffers.GetBool() && !tri->indexCache ) {
-				vertexCache.Alloc( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ), &tri->indexCache, true );
-			}
-			if ( tri->indexCache ) {
-				vertexCache.Touch( tri->indexCache );
-			}
-
-			// add the surface for drawing
-			R_AddDrawSurf( tri, vEntity, &vEntity->entityDef->parms, shader, vEntity->scissorRect );
-
-			// ambientViewCount is used to allow light interactions to be rejected
-			// if the ambient surface isn't visible at all
-			tri->ambientViewCount = tr.viewCount;
+		if ( !R_AddAmbientDrawSurf( vEntity, model->Surface( i )->geometry, shader, NULL ) ) {
+			return;
 		}
 	}
 
@@ -1453,24 +1687,28 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 
 /*
 ===================
-R_AddModelSurfaces
+R_ViewEntityInteractionsVisible
 
-Here is where dynamic models actually get instantiated, and necessary
-interactions get created.  This is all done on a sort-by-model basis
-to keep source data in cache (most likely L2) as any interactions and
-shadows are generated, since dynamic models will typically be lit by
-two or more lights.
+Returns true if the interactions of the viewEntity should be added to the view.
 ===================
 */
-void R_AddModelSurfaces( void ) {
+static bool R_ViewEntityInteractionsVisible( const viewEntity_t *vEntity ) {
+	if ( tr.viewDef->isXraySubview ) {
+		return ( vEntity->entityDef->parms.xrayIndex == 2 );
+	}
+	return true;
+}
+
+/*
+===================
+R_AddModelSurfacesSerial
+===================
+*/
+static void R_AddModelSurfacesSerial( void ) {
 	viewEntity_t		*vEntity;
 	idInteraction		*inter, *next;
 	idRenderModel		*model;
 
-	// clear the ambient surface list
-	tr.viewDef->numDrawSurfs = 0;
-	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
-
 	// go through each entity that is either visible to the view, or to
 	// any light that intersects the view (for shadows)
 	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
@@ -1525,25 +1763,15 @@ void R_AddModelSurfaces( void ) {
 			}
 
 			R_AddAmbientDrawsurfs( vEntity );
-			tr.pc.c_visibleViewEntities++;
+			R_FrontEndCounters().c_visibleViewEntities++;
 		} else {
-			tr.pc.c_shadowViewEntities++;
+			R_FrontEndCounters().c_shadowViewEntities++;
 		}
 
 		//
 		// for all the entity / light interactions on this entity, add them to the view
 		//
-		if ( tr.viewDef->isXraySubview ) {
-			if ( vEntity->entityDef->parms.xrayIndex == 2 ) {
-				for ( inter = vEntity->entityDef->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = next ) {
-					next = inter->entityNext;
-					if ( inter->lightDef->viewCount != tr.viewCount ) {
-						continue;
-					}
-					inter->AddActiveInteraction();
-				}
-			}
-		} else {
+		if ( R_ViewEntityInteractionsVisible( vEntity ) ) {
 			// all empty interactions are at the end of the list so once the
 			// first is encountered all the remaining interactions are empty
 			for ( inter = vEntity->entityDef->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = next ) {
@@ -1567,6 +1795,323 @@ void R_AddModelSurfaces( void ) {
 	}
 }
 
+/*
+===================================================================================
+
+Parallel front end
+
+R_AddModelSurfacesParallel produces exactly the same drawSurfs, in the same order,
+as R_AddModelSurfacesSerial.  The entity and interaction scissors, the culling of
+the ambient surfaces, the evaluation of their shader registers and the culling of
+the interactions against the view are done by jobs, one per viewEntity, which
+only read shared data and write into their own viewEntityJob_t and the frame
+memory of their thread.
+
+Everything that calls into the game, instantiates dynamic models, or touches
+the vertex cache or the world is still done on the main thread, walking the
+viewEntitys in list order, so draw surfaces get their sort offsets, and shadows
+and interactions get linked on the lights, in the serial order.
+
+===================================================================================
+*/
+
+typedef enum {
+	VIEW_ENTITY_SKIPPED,		// xray filtered, or without a model
+	VIEW_ENTITY_VISIBLE,		// adds ambient surfaces and interactions
+	VIEW_ENTITY_SHADOW			// only adds interactions
+} viewEntityState_t;
+
+typedef struct {
+	viewEntity_t *			vEntity;
+	const viewDef_t *		view;				// tr.viewDef, or a copy with the entity's time group time
+	viewEntityState_t		state;
+	idRenderModel *			model;				// instantiated model of a visible entity
+	bool					finishModel;		// model was instantiated in the skinning batch
+
+	// ambient surfaces which passed culling, set up by the job
+	drawSurf_t **			drawSurfs;
+	int						numDrawSurfs;
+
+	// shadow scissors of the interactions with visible lights, in list order
+	idInteraction **		interactions;
+	idScreenRect *			shadowScissors;
+	frontEndJobResult_t *	results;
+	int						numInteractions;
+} viewEntityJob_t;
+
+/*
+===================
+R_ViewEntityScissorJob
+===================
+*/
+static void R_ViewEntityScissorJob( void *data, int jobNum ) {
+	viewEntityJob_t *job = (viewEntityJob_t *)data + jobNum;
+
+	// calculate the screen area covered by the entity
+	idScreenRect scissorRect = R_CalcEntityScissorRectangle( job->vEntity );
+	// intersect with the portal crossing scissor rectangle
+	job->vEntity->scissorRect.Intersect( scissorRect );
+}
+
+/*
+===================
+R_ViewEntityJob
+===================
+*/
+static void R_ViewEntityJob( void *data, int jobNum ) {
+	viewEntityJob_t		*job = (viewEntityJob_t *)data + jobNum;
+	viewEntity_t		*vEntity = job->vEntity;
+	idRenderEntityLocal	*def = vEntity->entityDef;
+	idInteraction		*inter;
+
+	if ( job->state == VIEW_ENTITY_SKIPPED ) {
+		return;
+	}
+
+	if ( job->state == VIEW_ENTITY_VISIBLE ) {
+		const idRenderModel *model = job->model;
+		const int total = model->NumSurfaces();
+
+		job->drawSurfs = (drawSurf_t **)R_FrameAlloc( total * sizeof( job->drawSurfs[0] ) );
+		for ( int i = 0 ; i < total ; i++ ) {
+			const idMaterial *shader = R_AmbientSurfShader( vEntity, model, i );
+			if ( !shader ) {
+				continue;
+			}
+			drawSurf_t *drawSurf = R_AllocDrawSurf( model->Surface( i )->geometry, vEntity, shader, vEntity->scissorRect );
+			if ( !R_DrawSurfNeedsMainThread( shader, &def->parms ) ) {
+				R_EvaluateDrawSurfRegisters( drawSurf, &def->parms, job->view, NULL );
+			}
+			job->drawSurfs[job->numDrawSurfs++] = drawSurf;
+		}
+	}
+
+	if ( !R_ViewEntityInteractionsVisible( vEntity ) ) {
+		return;
+	}
+
+	int count = 0;
+	for ( inter = def->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = inter->entityNext ) {
+		count++;
+	}
+	job->interactions = (idInteraction **)R_FrameAlloc( count * sizeof( job->interactions[0] ) );
+	job->shadowScissors = (idScreenRect *)R_FrameAlloc( count * sizeof( job->shadowScissors[0] ) );
+	job->results = (frontEndJobResult_t *)R_FrameAlloc( count * sizeof( job->results[0] ) );
+
+	for ( inter = def->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = inter->entityNext ) {
+		if ( inter->lightDef->viewCount != tr.viewCount ) {
+			continue;
+		}
+		const int n = job->numInteractions++;
+		job->interactions[n] = inter;
+		switch( inter->CalcShadowScissor( job->shadowScissors[n], true ) ) {
+			case idInteraction::SCISSOR_VISIBLE:
+				job->results[n] = FRONTEND_JOB_VISIBLE;
+				break;
+			case idInteraction::SCISSOR_CULLED:
+				job->results[n] = FRONTEND_JOB_CULLED;
+				break;
+			default:
+				job->results[n] = FRONTEND_JOB_MAIN_THREAD;
+				break;
+		}
+	}
+}
+
+/*
+===================
+R_AddModelSurfacesParallel
+===================
+*/
+static void R_AddModelSurfacesParallel( void ) {
+	viewEntity_t		*vEntity;
+	viewEntityJob_t		*jobs, *job;
+	int					numJobs;
+	idInteraction		*inter, *next;
+	idRenderModel		*model;
+
+	numJobs = 0;
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		numJobs++;
+	}
+	if ( !numJobs ) {
+		return;
+	}
+	jobs = (viewEntityJob_t *)R_ClearedFrameAlloc( numJobs * sizeof( jobs[0] ) );
+	numJobs = 0;
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		jobs[numJobs].vEntity = vEntity;
+		jobs[numJobs].view = tr.viewDef;
+		numJobs++;
+	}
+
+	if ( r_useEntityScissors.GetBool() ) {
+		R_RunFrontEndJobs( R_ViewEntityScissorJob, jobs, numJobs );
+	}
+
+	// issue the entity callbacks and instantiate the dynamic models of the visible entities,
+	// the vertex skinning of md5 meshes is queued and done by jobs afterwards
+	const bool batchSkinning = r_useParallelSkinning.GetBool();
+	if ( batchSkinning ) {
+		R_BeginSkinningBatch();
+	}
+	for ( job = jobs; job < jobs + numJobs; job++ ) {
+		vEntity = job->vEntity;
+		idRenderEntityLocal *def = vEntity->entityDef;
+
+		if ( r_useEntityScissors.GetBool() && r_showEntityScissors.GetBool() ) {
+			R_ShowColoredScreenRect( vEntity->scissorRect, def->index );
+		}
+
+		if ( tr.viewDef->isXraySubview && def->parms.xrayIndex == 1 ) {
+			job->state = VIEW_ENTITY_SKIPPED;
+			continue;
+		} else if ( !tr.viewDef->isXraySubview && def->parms.xrayIndex == 2 ) {
+			job->state = VIEW_ENTITY_SKIPPED;
+			continue;
+		}
+
+		float oldFloatTime = 0.0f;
+		int oldTime = 0;
+
+		game->SelectTimeGroup( def->parms.timeGroup );
+
+		if ( def->parms.timeGroup ) {
+			oldFloatTime = tr.viewDef->floatTime;
+			oldTime = tr.viewDef->renderView.time;
+
+			tr.viewDef->floatTime = game->GetTimeGroupTime( def->parms.timeGroup ) * 0.001;
+			tr.viewDef->renderView.time = game->GetTimeGroupTime( def->parms.timeGroup );
+
+			// the jobs evaluate the registers with a copy of the view on the time group time
+			viewDef_t *view = (viewDef_t *)R_FrameAlloc( sizeof( *view ) );
+			*view = *tr.viewDef;
+			job->view = view;
+		}
+
+		if ( !vEntity->scissorRect.IsEmpty() ) {
+			model = R_EntityDefDynamicModel( def, batchSkinning ? &job->finishModel : NULL );
+			if ( model == NULL || model->NumSurfaces() <= 0 ) {
+				job->state = VIEW_ENTITY_SKIPPED;
+			} else {
+				job->state = VIEW_ENTITY_VISIBLE;
+				job->model = model;
+			}
+		} else {
+			job->state = VIEW_ENTITY_SHADOW;
+		}
+
+		if ( def->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+	}
+
+	if ( batchSkinning ) {
+		R_EndSkinningBatch();
+
+		// the overlays need the skinned vertexes
+		for ( job = jobs; job < jobs + numJobs; job++ ) {
+			if ( job->finishModel ) {
+				R_FinishEntityDefDynamicModel( job->vEntity->entityDef );
+			}
+		}
+	}
+
+	R_RunFrontEndJobs( R_ViewEntityJob, jobs, numJobs );
+
+	// add everything to the view in the serial order
+	for ( job = jobs; job < jobs + numJobs; job++ ) {
+		if ( job->state == VIEW_ENTITY_SKIPPED ) {
+			continue;
+		}
+		vEntity = job->vEntity;
+		idRenderEntityLocal *def = vEntity->entityDef;
+
+		float oldFloatTime = 0.0f;
+		int oldTime = 0;
+
+		game->SelectTimeGroup( def->parms.timeGroup );
+
+		if ( def->parms.timeGroup ) {
+			oldFloatTime = tr.viewDef->floatTime;
+			oldTime = tr.viewDef->renderView.time;
+
+			tr.viewDef->floatTime = job->view->floatTime;
+			tr.viewDef->renderView.time = job->view->renderView.time;
+		}
+
+		if ( job->state == VIEW_ENTITY_VISIBLE ) {
+			int i;
+			for ( i = 0 ; i < job->numDrawSurfs ; i++ ) {
+				drawSurf_t *drawSurf = job->drawSurfs[i];
+				if ( !R_AddAmbientDrawSurf( vEntity, const_cast<srfTriangles_t *>( drawSurf->geo ), drawSurf->material, drawSurf ) ) {
+					break;
+				}
+			}
+			if ( i == job->numDrawSurfs ) {
+				// add the lightweight decal surfaces
+				for ( idRenderModelDecal *decal = def->decals; decal; decal = decal->Next() ) {
+					decal->AddDecalDrawSurf( vEntity );
+				}
+			}
+			R_FrontEndCounters().c_visibleViewEntities++;
+		} else {
+			R_FrontEndCounters().c_shadowViewEntities++;
+		}
+
+		if ( R_ViewEntityInteractionsVisible( vEntity ) ) {
+			int cursor = 0;
+			for ( inter = def->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = next ) {
+				next = inter->entityNext;
+
+				if ( inter->lightDef->viewCount != tr.viewCount ) {
+					continue;
+				}
+
+				// interactions may have been emptied and moved to the end of
+				// the list since the job ran, but never reordered otherwise
+				while ( cursor < job->numInteractions && job->interactions[cursor] != inter ) {
+					cursor++;
+				}
+				if ( cursor == job->numInteractions || job->results[cursor] == FRONTEND_JOB_MAIN_THREAD ) {
+					inter->AddActiveInteraction();
+				} else if ( job->results[cursor] == FRONTEND_JOB_VISIBLE ) {
+					inter->AddActiveInteraction( job->shadowScissors[cursor] );
+				}
+			}
+		}
+
+		if ( def->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+	}
+}
+
+/*
+===================
+R_AddModelSurfaces
+
+Here is where dynamic models actually get instantiated, and necessary
+interactions get created.  This is all done on a sort-by-model basis
+to keep source data in cache (most likely L2) as any interactions and
+shadows are generated, since dynamic models will typically be lit by
+two or more lights.
+===================
+*/
+void R_AddModelSurfaces( void ) {
+	// clear the ambient surface list
+	tr.viewDef->numDrawSurfs = 0;
+	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
+
+	if ( R_UseParallelFrontEnd() ) {
+		R_AddModelSurfacesParallel();
+	} else {
+		R_AddModelSurfacesSerial();
+	}
+}
+
 /*
 =====================
 R_RemoveUnecessaryViewLights
@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 
 class idScreenRect; // yay for include recursion
 
+#include "framework/JobSystem.h"
 #include "renderer/Image.h"
 #include "renderer/Interaction.h"
 #include "renderer/MegaTexture.h"
@@ -521,17 +522,35 @@ typedef struct frameMemoryBlock_s {
 	byte	base[4];	// dynamically allocated as [size]
 } frameMemoryBlock_t;
 
+// every thread that runs front end code bump allocates from its own
+// arena, so R_FrameAlloc never needs to lock.  Index 0 is the main thread,
+// the others are the job workers.  When the current block runs out, the
+// arena takes another one from the shared pool of free blocks.
+typedef struct {
+	// chain of blocks taken from the pool this frame
+	frameMemoryBlock_t	*memory;
+
+	// alloc will point at the last block of the memory chain
+	frameMemoryBlock_t	*alloc;
+
+	int					numBlocks;			// blocks in the memory chain
+	int					highwater;			// max used on any frame
+	int					blocksHighwater;	// max numBlocks on any frame
+} frameArena_t;
+
 // all of the information needed by the back end must be
 // contained in a frameData_t.  This entire structure is
 // duplicated so the front and back end can run in parallel
 // on an SMP machine (OBSOLETE: this capability has been removed)
 typedef struct {
-	// one or more blocks of memory for all frame
-	// temporary allocations
-	frameMemoryBlock_t	*memory;
+	frameArena_t		arenas[MAX_JOB_THREADS];
 
-	// alloc will point somewhere into the memory chain
-	frameMemoryBlock_t	*alloc;
+	// free blocks, popped lock free by the arenas and only pushed back
+	// by R_ToggleSmpFrame or with blocks that were never used this frame
+	frameMemoryBlock_t * volatile freeBlocks;
+
+	int					numBlocks;			// blocks allocated from the heap
+	int					numPoolGrowths;		// times the pool ran empty
 
 	srfTriangles_t *	firstDeferredFreeTriSurf;
 	srfTriangles_t *	lastDeferredFreeTriSurf;
@@ -588,7 +607,12 @@ typedef struct {
 	int		c_tangentIndexes;	// R_DeriveTangents()
 	int		c_entityUpdates, c_lightUpdates, c_entityReferences, c_lightReferences;
 	int		c_guiSurfs;
+	int		c_occluderTris;		// triangles rasterized into the occlusion buffer
+	int		c_occludedEntities, c_occludedLights;
+	int		c_sortedDrawSurfs;
+	int		sortUsec;			// time spent in R_SortDrawSurfs
 	int		frontEndMsec;		// sum of time in all RE_RenderScene's in a frame
+	int		frontEndUsec;		// same in microseconds
 } performanceCounters_t;
 
 
@@ -631,10 +655,19 @@ typedef struct {
 	int		c_vboIndexes;
 	float	c_overDraw;
 
+	int		c_entitySetupsSkipped;		// surfaces drawn in the same space as the one before
+	int		c_materialSetupsSkipped;	// depth fill surfaces drawn with the same material as the one before
+
 	float	maxLightValue;	// for light scale
 	int		msec;			// total msec for backend run
 } backEndCounters_t;
 
+typedef enum {
+	DEPTHHACK_NONE,
+	DEPTHHACK_WEAPON,
+	DEPTHHACK_MODEL
+} depthHack_t;
+
 // all state modified by the back end is separated
 // from the front end state
 typedef struct {
@@ -664,6 +697,10 @@ typedef struct {
 	glstate_t			glState;
 
 	int					c_copyFrameBuffer;
+
+	depthHack_t			depthHack;			// set by RB_SetDepthHack
+	float				depthHackValue;		// modelDepthHack of DEPTHHACK_MODEL
+	const idMaterial *	depthFillMaterial;	// material of the last plain depth fill surface
 } backEndState_t;
 
 
@@ -782,6 +819,7 @@ public:
 	viewDef_t *				viewDef;
 
 	performanceCounters_t	pc;					// performance counters
+	performanceCounters_t	jobPc[MAX_JOB_THREADS];	// counters of front end jobs on worker threads, added to pc after each batch
 
 	drawSurfsCommand_t		lockSurfacesCmd;	// use this when r_lockSurfaces = 1
 	//renderView_t			lockSurfacesRenderView;
@@ -846,7 +884,8 @@ extern idCVar r_checkBounds;			// compare all surface bounds with precalculated
 extern idCVar r_useLightPortalFlow;		// 1 = do a more precise area reference determination
 extern idCVar r_useShadowSurfaceScissor;// 1 = scissor shadows by the scissor rect of the interaction surfaces
 extern idCVar r_useConstantMaterials;	// 1 = use pre-calculated material registers if possible
-extern idCVar r_useInteractionTable;	// create a full entityDefs * lightDefs table to make finding interactions faster
+extern idCVar r_useInteractionTable;	// -1 = choose from map size, 0 = none, 1 = full entityDefs * lightDefs table, 2 = sparse hash table
+extern idCVar r_interactionTableMegs;	// largest full interaction table r_useInteractionTable -1 will create
 extern idCVar r_useNodeCommonChildren;	// stop pushing reference bounds early when possible
 extern idCVar r_useSilRemap;			// 1 = consider verts with the same XYZ, but different ST the same for shadows
 extern idCVar r_useCulling;				// 0 = none, 1 = sphere, 2 = sphere + box
@@ -859,6 +898,11 @@ extern idCVar r_useInteractionCulling;	// 1 = cull interactions
 extern idCVar r_useInteractionScissors;	// 1 = use a custom scissor rectangle for each interaction
 extern idCVar r_useFrustumFarDistance;	// if != 0 force the view frustum far distance to this distance
 extern idCVar r_useShadowCulling;		// try to cull shadows from partially visible lights
+extern idCVar r_useParallelFrontEnd;	// 1 = split light and entity front end work into jobs
+extern idCVar r_useParallelSkinning;	// 1 = skin the md5 meshes of the visible entities in jobs
+extern idCVar r_useOcclusionCulling;	// cull entities and lights hidden by the world with a software depth buffer
+extern idCVar r_occluderBudget;		// maximum number of occluder triangles rasterized per view
+extern idCVar r_useRadixSort;			// sort draw surfaces by packed 64 bit keys instead of the sort value
 extern idCVar r_usePreciseTriangleInteractions;	// 1 = do winding clipping to determine if each ambiguous tri should be lit
 extern idCVar r_useTurboShadow;			// 1 = use the infinite projection with W technique for dynamic shadows
 extern idCVar r_useExternalShadows;		// 1 = skip drawing caps when outside the light volume
@@ -884,6 +928,8 @@ extern idCVar r_skipSuppress;			// ignore the per-view suppressions
 extern idCVar r_skipInteractions;		// skip all light/surface interaction drawing
 extern idCVar r_skipFrontEnd;			// bypasses all front end work, but 2D gui rendering still draws
 extern idCVar r_skipBackEnd;			// don't draw anything
+extern idCVar r_frontEndBenchmark;		// run the whole front end but not the back end, also on dedicated servers
+extern idCVar r_benchmarkCSV;			// file to write the front end timings and counters of every frame to
 extern idCVar r_skipCopyTexture;		// do all rendering, but don't actually copyTexSubImage2D
 extern idCVar r_skipRender;				// skip 3D rendering, but pass 2D
 extern idCVar r_skipRenderContext;		// NULL the rendering context during backend 3D rendering
@@ -920,6 +966,7 @@ extern idCVar r_showDynamic;			// report stats on dynamic surface generation
 extern idCVar r_showLightScale;			// report the scale factor applied to drawing for overbrights
 extern idCVar r_showIntensity;			// draw the screen colors based on intensity, red = 0, green = 128, blue = 255
 extern idCVar r_showDefs;				// report the number of modeDefs and lightDefs in view
+extern idCVar r_showOcclusion;			// report occluder triangles and occluded entities and lights
 extern idCVar r_showTrace;				// show the intersection of an eye trace with the world
 extern idCVar r_showSmp;				// show which end (front or back) is blocking
 extern idCVar r_showDepth;				// display the contents of the depth buffer and the depth range
@@ -946,6 +993,7 @@ extern idCVar r_showCull;				// report sphere and box culling stats
 extern idCVar r_showInteractions;		// report interaction generation activity
 extern idCVar r_showSurfaces;			// report surface/light/shadow counts
 extern idCVar r_showPrimitives;			// report vertex/index/draw counts
+extern idCVar r_showSort;				// report draw surface sort time and skipped back end state changes
 extern idCVar r_showPortals;			// draw portal outlines in color based on passed / not passed
 extern idCVar r_showAlloc;				// report alloc/free counts
 extern idCVar r_showSkel;				// draw the skeleton when model animates
@@ -969,7 +1017,7 @@ extern idCVar r_shadowPolygonFactor;	// scale value for stencil shadow drawing
 extern idCVar r_jitter;					// randomly subpixel jitter the projection matrix
 extern idCVar r_lightSourceRadius;		// for soft-shadow sampling
 extern idCVar r_lockSurfaces;
-extern idCVar r_orderIndexes;			// perform index reorganization to optimize vertex use
+extern idCVar r_orderIndexes;			// reorder static model indexes and vertexes for the vertex cache
 
 extern idCVar r_debugLineDepthTest;		// perform depth test on debug lines
 extern idCVar r_debugLineWidth;			// width of debug lines
@@ -1164,7 +1212,8 @@ void R_ListRenderLightDefs_f( const idCmdArgs &args );
 void R_ListRenderEntityDefs_f( const idCmdArgs &args );
 
 bool R_IssueEntityDefCallback( idRenderEntityLocal *def );
-idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def );
+idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def, bool *needsFinish = NULL );
+void R_FinishEntityDefDynamicModel( idRenderEntityLocal *def );
 
 viewEntity_t *R_SetEntityDefViewEntity( idRenderEntityLocal *def );
 viewLight_t *R_SetLightDefViewLight( idRenderLightLocal *def );
@@ -1239,6 +1288,7 @@ RENDER
 void RB_EnterWeaponDepthHack();
 void RB_EnterModelDepthHack( float depth );
 void RB_LeaveDepthHack();
+void RB_SetDepthHack( const viewEntity_t *space );	// NULL leaves any depth hack
 void RB_DrawElementsImmediate( const srfTriangles_t *tri );
 void RB_RenderTriangleSurface( const srfTriangles_t *tri );
 void RB_T_RenderTriangleSurface( const drawSurf_t *surf );
@@ -1405,6 +1455,18 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 /*
 ============================================================
 
+TR_OCCLUSION
+
+Software depth buffer culling of the view entities and lights
+
+============================================================
+*/
+
+void R_OcclusionCull( void );
+
+/*
+============================================================
+
 util/shadowopt3
 
 dmap time optimization of shadow volumes, called from R_CreateShadowVolume
@@ -1538,11 +1600,23 @@ SCENE GENERATION
 void R_InitFrameData( void );
 void R_ShutdownFrameData( void );
 int R_CountFrameData( void );
+void R_ListFrameMemory_f( const idCmdArgs &args );
+void R_CloseBenchmarkCSV( void );
 void R_ToggleSmpFrame( void );
 void *R_FrameAlloc( int bytes );
 void *R_ClearedFrameAlloc( int bytes );
 void R_FrameFree( void *data );
 
+// front end work can be split into jobs that run on the job system, see R_RunFrontEndJobs
+bool R_UseParallelFrontEnd( void );
+void R_RunFrontEndJobs( jobRun_t function, void *data, int numJobs );
+performanceCounters_t &R_FrontEndCounters( void );	// tr.pc, or the job counters on worker threads
+
+// md5 meshes instantiated between these only get their surfaces set up,
+// the vertexes are skinned by front end jobs in R_EndSkinningBatch
+void R_BeginSkinningBatch( void );
+void R_EndSkinningBatch( void );
+
 void *R_StaticAlloc( int bytes );		// just malloc with error checking
 void *R_ClearedStaticAlloc( int bytes );	// with memset
 void R_StaticFree( void *data );
@@ -1608,7 +1682,10 @@ TR_ORDERINDEXES
 =============================================================
 */
 
+float R_VertexCacheMissRatio( int numIndexes, const glIndex_t *indexes );
 void R_OrderIndexes( int numIndexes, glIndex_t *indexes );
+void R_OrderVertexes( srfTriangles_t *tri, int *remap );
+void R_RemapVertexes( srfTriangles_t *tri, const int *remap );
 
 /*
 =============================================================
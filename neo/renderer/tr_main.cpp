@@ -189,18 +189,28 @@ void R_ToggleSmpFrame( void ) {
 	// clear frame-temporary data
 	frameData_t		*frame;
 	frameMemoryBlock_t	*block;
+	frameMemoryBlock_t	*nextBlock;
 
-	// update the highwater mark
+	// update the highwater marks
 	R_CountFrameData();
 
 	frame = frameData;
 
-	// reset the memory allocation to the first block
-	frame->alloc = frame->memory;
-
-	// clear all the blocks
-	for ( block = frame->memory ; block ; block = block->next ) {
-		block->used = 0;
+	// give all the blocks back to the pool, the next frame will
+	// hand them out to whichever threads need them.  No job is running,
+	// so nothing can be popping concurrently.
+	for ( int i = 0 ; i < MAX_JOB_THREADS ; i++ ) {
+		frameArena_t *arena = &frame->arenas[i];
+
+		for ( block = arena->memory ; block ; block = nextBlock ) {
+			nextBlock = block->next;
+			block->used = 0;
+			block->next = frame->freeBlocks;
+			frame->freeBlocks = block;
+		}
+		arena->memory = NULL;
+		arena->alloc = NULL;
+		arena->numBlocks = 0;
 	}
 
 	R_ClearCommandChain();
@@ -211,6 +221,87 @@ void R_ToggleSmpFrame( void ) {
 
 #define	MEMORY_BLOCK_SIZE	0x100000
 
+// number of blocks the pool grows by when it runs empty, so an allocation
+// spike costs one trip to the heap for several blocks instead of one per block
+#define	MEMORY_POOL_GROWTH	4
+
+/*
+=====================
+R_PushFrameBlock
+
+Adds a block to the free pool.  This may run at the same time as
+R_PopFrameBlock, but only with blocks that nobody has popped this frame,
+which is what keeps the pool safe from ABA problems.
+=====================
+*/
+static void R_PushFrameBlock( frameMemoryBlock_t *block ) {
+	frameMemoryBlock_t *head;
+
+	do {
+		head = frameData->freeBlocks;
+		block->next = head;
+	} while ( !Sys_CompareAndSwapPointer( (void * volatile *)&frameData->freeBlocks, head, block ) );
+}
+
+/*
+=====================
+R_PopFrameBlock
+
+Takes a block from the free pool, or returns NULL if it is empty.
+=====================
+*/
+static frameMemoryBlock_t *R_PopFrameBlock( void ) {
+	frameMemoryBlock_t *head;
+
+	do {
+		head = frameData->freeBlocks;
+		if ( !head ) {
+			return NULL;
+		}
+	} while ( !Sys_CompareAndSwapPointer( (void * volatile *)&frameData->freeBlocks, head, head->next ) );
+
+	head->next = NULL;
+	return head;
+}
+
+/*
+=====================
+R_GrowFramePool
+
+Allocates MEMORY_POOL_GROWTH blocks from the heap, keeps one for the
+caller and puts the rest into the free pool.  The heap isn't thread safe,
+so growing is serialized while jobs are running.
+=====================
+*/
+static frameMemoryBlock_t *R_GrowFramePool( void ) {
+	frameMemoryBlock_t *blocks[MEMORY_POOL_GROWTH];
+	const bool lock = jobSystem->IsRunningJobs();
+
+	if ( lock ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_TWO );
+	}
+	for ( int i = 0 ; i < MEMORY_POOL_GROWTH ; i++ ) {
+		blocks[i] = (frameMemoryBlock_t *)Mem_Alloc( MEMORY_BLOCK_SIZE + sizeof( *blocks[i] ) );
+		if ( !blocks[i] ) {
+			common->FatalError( "R_FrameAlloc: Mem_Alloc() failed" );
+		}
+		blocks[i]->size = MEMORY_BLOCK_SIZE;
+		blocks[i]->used = 0;
+		blocks[i]->next = NULL;
+	}
+	frameData->numBlocks += MEMORY_POOL_GROWTH;
+	frameData->numPoolGrowths++;
+	if ( lock ) {
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_TWO );
+	}
+
+	for ( int i = 1 ; i < MEMORY_POOL_GROWTH ; i++ ) {
+		R_PushFrameBlock( blocks[i] );
+	}
+
+	return blocks[0];
+}
+
 /*
 =====================
 R_ShutdownFrameData
@@ -229,7 +320,13 @@ void R_ShutdownFrameData( void ) {
 	R_FreeDeferredTriSurfs( frame );
 
 	frameMemoryBlock_t *nextBlock;
-	for ( block = frame->memory ; block ; block = nextBlock ) {
+	for ( int i = 0 ; i < MAX_JOB_THREADS ; i++ ) {
+		for ( block = frame->arenas[i].memory ; block ; block = nextBlock ) {
+			nextBlock = block->next;
+			Mem_Free( block );
+		}
+	}
+	for ( block = frame->freeBlocks ; block ; block = nextBlock ) {
 		nextBlock = block->next;
 		Mem_Free( block );
 	}
@@ -243,25 +340,21 @@ R_InitFrameData
 =====================
 */
 void R_InitFrameData( void ) {
-	int size;
 	frameData_t *frame;
-	frameMemoryBlock_t *block;
 
 	R_ShutdownFrameData();
 
 	frameData = (frameData_t *)Mem_ClearedAlloc( sizeof( *frameData ));
 	frame = frameData;
-	size = MEMORY_BLOCK_SIZE;
-	block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-	if ( !block ) {
-		common->FatalError( "R_InitFrameData: Mem_Alloc() failed" );
-	}
-	block->size = size;
-	block->used = 0;
-	block->next = NULL;
-	frame->memory = block;
 	frame->memoryHighwater = 0;
 
+	// enough blocks up front for every job thread, so the common case
+	// never has to go to the heap from a job
+	while ( frame->numBlocks < jobSystem->GetNumThreads() ) {
+		R_PushFrameBlock( R_GrowFramePool() );
+	}
+	frame->numPoolGrowths = 0;
+
 	R_ToggleSmpFrame();
 }
 
@@ -277,11 +370,20 @@ int R_CountFrameData( void ) {
 
 	count = 0;
 	frame = frameData;
-	for ( block = frame->memory ; block ; block=block->next ) {
-		count += block->used;
-		if ( block == frame->alloc ) {
-			break;
+	for ( int i = 0 ; i < MAX_JOB_THREADS ; i++ ) {
+		frameArena_t *arena = &frame->arenas[i];
+		int arenaCount = 0;
+
+		for ( block = arena->memory ; block ; block = block->next ) {
+			arenaCount += block->used;
+		}
+		if ( arenaCount > arena->highwater ) {
+			arena->highwater = arenaCount;
 		}
+		if ( arena->numBlocks > arena->blocksHighwater ) {
+			arena->blocksHighwater = arena->numBlocks;
+		}
+		count += arenaCount;
 	}
 
 	// note if this is a new highwater mark
@@ -292,6 +394,43 @@ int R_CountFrameData( void ) {
 	return count;
 }
 
+/*
+================
+R_ListFrameMemory_f
+================
+*/
+void R_ListFrameMemory_f( const idCmdArgs &args ) {
+	frameData_t		*frame;
+	frameMemoryBlock_t	*block;
+	int				freeBlocks;
+
+	frame = frameData;
+	if ( !frame ) {
+		return;
+	}
+
+	R_CountFrameData();
+
+	common->Printf( "thread blocks   used  highwater  blocksHighwater\n" );
+	for ( int i = 0 ; i < jobSystem->GetNumThreads() ; i++ ) {
+		const frameArena_t *arena = &frame->arenas[i];
+		int used = 0;
+
+		for ( block = arena->memory ; block ; block = block->next ) {
+			used += block->used;
+		}
+		common->Printf( "%6i %6i %5ik %9ik %16i\n", i, arena->numBlocks, used >> 10, arena->highwater >> 10, arena->blocksHighwater );
+	}
+
+	freeBlocks = 0;
+	for ( block = frame->freeBlocks ; block ; block = block->next ) {
+		freeBlocks++;
+	}
+	common->Printf( "%i blocks of %ik, %i free, pool grown %i times\n", frame->numBlocks, MEMORY_BLOCK_SIZE >> 10,
+		freeBlocks, frame->numPoolGrowths );
+	common->Printf( "%ik highwater\n", frame->memoryHighwater >> 10 );
+}
+
 /*
 =================
 R_StaticAlloc
@@ -300,7 +439,7 @@ R_StaticAlloc
 void *R_StaticAlloc( int bytes ) {
 	void	*buf;
 
-	tr.pc.c_alloc++;
+	R_FrontEndCounters().c_alloc++;
 
 	tr.staticAllocCount += bytes;
 
@@ -332,7 +471,7 @@ R_StaticFree
 =================
 */
 void R_StaticFree( void *data ) {
-	tr.pc.c_free++;
+	R_FrontEndCounters().c_free++;
 	Mem_Free( data );
 }
 
@@ -358,50 +497,47 @@ contiguous with previous allocations even
 from this frame.
 
 The memory is NOT zero filled.
-Should part of this be inlined in a macro?
+
+It can be called from front end jobs, every thread
+allocates from its own arena.
 ================
 */
 void *R_FrameAlloc( int bytes ) {
-	frameData_t		*frame;
+	frameArena_t		*arena;
 	frameMemoryBlock_t	*block;
 	void			*buf;
 
 	bytes = (bytes+16)&~15;
 	// see if it can be satisfied in the current block
-	frame = frameData;
-	block = frame->alloc;
+	arena = &frameData->arenas[jobSystem->IsRunningJobs() ? jobSystem->GetThreadIndex() : 0];
+	block = arena->alloc;
 
-	if ( block->size - block->used >= bytes ) {
+	if ( block && block->size - block->used >= bytes ) {
 		buf = block->base + block->used;
 		block->used += bytes;
 		return buf;
 	}
 
-	// advance to the next memory block if available
-	block = block->next;
-	// create a new block if we are at the end of
-	// the chain
-	if ( !block ) {
-		int		size;
-
-		size = MEMORY_BLOCK_SIZE;
-		block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-		if ( !block ) {
-			common->FatalError( "R_FrameAlloc: Mem_Alloc() failed" );
-		}
-		block->size = size;
-		block->used = 0;
-		block->next = NULL;
-		frame->alloc->next = block;
-	}
-
 	// we could fix this if we needed to...
-	if ( bytes > block->size ) {
+	if ( bytes > MEMORY_BLOCK_SIZE ) {
 		common->FatalError( "R_FrameAlloc of %i exceeded MEMORY_BLOCK_SIZE",
 			bytes );
 	}
 
-	frame->alloc = block;
+	// take a new block from the pool, growing
+	// it if every block is in use
+	block = R_PopFrameBlock();
+	if ( !block ) {
+		block = R_GrowFramePool();
+	}
+
+	if ( arena->alloc ) {
+		arena->alloc->next = block;
+	} else {
+		arena->memory = block;
+	}
+	arena->alloc = block;
+	arena->numBlocks++;
 
 	block->used = bytes;
 
@@ -437,6 +573,61 @@ to both alloc and free.
 void R_FrameFree( void *data ) {
 }
 
+/*
+==================
+R_UseParallelFrontEnd
+
+The debugging tools that draw or print from inside the front end
+loops are not thread safe, so they force the serial path.
+==================
+*/
+bool R_UseParallelFrontEnd( void ) {
+	if ( !r_useParallelFrontEnd.GetBool() || jobSystem->GetNumThreads() < 2 ) {
+		return false;
+	}
+	if ( r_checkBounds.GetBool() || r_showInteractionFrustums.GetInteger() || r_showInteractionScissors.GetInteger()
+		|| r_materialOverride.GetString()[0] != '\0' ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+==================
+R_FrontEndCounters
+==================
+*/
+performanceCounters_t &R_FrontEndCounters( void ) {
+	if ( jobSystem->IsRunningJobs() ) {
+		int thread = jobSystem->GetThreadIndex();
+		if ( thread ) {
+			return tr.jobPc[thread];
+		}
+	}
+	return tr.pc;
+}
+
+/*
+==================
+R_RunFrontEndJobs
+
+Runs a batch of front end jobs and adds the performance
+counters of the worker threads to tr.pc afterwards.
+==================
+*/
+void R_RunFrontEndJobs( jobRun_t function, void *data, int numJobs ) {
+	jobSystem->RunJobs( function, data, numJobs );
+
+	for ( int i = 1 ; i < jobSystem->GetNumThreads() ; i++ ) {
+		const int *src = (const int *)&tr.jobPc[i];
+		int *dst = (int *)&tr.pc;
+		for ( int j = 0 ; j < sizeof( performanceCounters_t ) / sizeof( int ) ; j++ ) {
+			dst[j] += src[j];
+		}
+		memset( &tr.jobPc[i], 0, sizeof( tr.jobPc[i] ) );
+	}
+}
+
 
 
 //==========================================================================
@@ -653,12 +844,12 @@ bool R_CornerCullLocalBox( const idBounds &bounds, const float modelMatrix[16],
 		}
 		if ( j == 8 ) {
 			// all points were behind one of the planes
-			tr.pc.c_box_cull_out++;
+			R_FrontEndCounters().c_box_cull_out++;
 			return true;
 		}
 	}
 
-	tr.pc.c_box_cull_in++;
+	R_FrontEndCounters().c_box_cull_in++;
 
 	return false;		// not culled
 }
@@ -1062,15 +1253,135 @@ static int R_QsortSurfaces( const void *a, const void *b ) {
 }
 
 
+/*
+=================
+R_DrawSurfSortKey
+
+Packs a drawSurf into a 64 bit key, from most to least significant:
+20 bits sort class, 16 bits material, 12 bits entity, 16 bits depth.
+The sort class is the order preserving integer form of the material sort
+value, truncated to its upper 20 bits.  Material, entity and depth are only
+filled in for opaque surfaces, every other class keeps the order the surfaces
+were added in, because the radix sort is stable.
+=================
+*/
+static uint64_t R_DrawSurfSortKey( const drawSurf_t *drawSurf ) {
+	const idMaterial *shader = drawSurf->material;
+	float sort = shader->GetSort();
+
+	// flip the float so that unsigned compares order the same way as float compares
+	unsigned int sortBits = *reinterpret_cast<unsigned int *>( &sort );
+	if ( sortBits & 0x80000000 ) {
+		sortBits = ~sortBits;
+	} else {
+		sortBits |= 0x80000000;
+	}
+	uint64_t key = (uint64_t)( sortBits >> 12 ) << 44;
+
+	if ( sort != SS_OPAQUE ) {
+		return key;
+	}
+
+	const viewEntity_t *space = drawSurf->space;
+	unsigned int entity = space->entityDef ? ( ( space->entityDef->index + 1 ) & 0xfff ) : 0;
+
+	// eye space depth of the surface bounds center
+	idVec3 center = drawSurf->geo->bounds.GetCenter();
+	const float *m = space->modelViewMatrix;
+	float depth = -( center.x * m[2] + center.y * m[6] + center.z * m[10] + m[14] );
+	unsigned int depthBits;
+	if ( depth <= 0.0f ) {
+		depthBits = 0;
+	} else if ( depth >= 65535.0f ) {
+		depthBits = 65535;
+	} else {
+		depthBits = (unsigned int)depth;
+	}
+
+	key |= (uint64_t)( shader->Index() & 0xffff ) << 28;
+	key |= (uint64_t)entity << 16;
+	key |= depthBits;
+	return key;
+}
+
+/*
+=================
+R_RadixSortDrawSurfs
+
+Least significant digit radix sort on 8 bit digits.  All histograms are
+built in a single pass over the keys, and digits that are the same for
+every key are skipped.
+=================
+*/
+static void R_RadixSortDrawSurfs( drawSurf_t **drawSurfs, int numDrawSurfs ) {
+	uint64_t *keys = (uint64_t *)R_FrameAlloc( numDrawSurfs * 2 * sizeof( keys[0] ) );
+	int *indexes = (int *)R_FrameAlloc( numDrawSurfs * 2 * sizeof( indexes[0] ) );
+	uint64_t *tempKeys = keys + numDrawSurfs;
+	int *tempIndexes = indexes + numDrawSurfs;
+	int histogram[8][256];
+
+	memset( histogram, 0, sizeof( histogram ) );
+	for ( int i = 0; i < numDrawSurfs; i++ ) {
+		uint64_t key = R_DrawSurfSortKey( drawSurfs[i] );
+		keys[i] = key;
+		indexes[i] = i;
+		for ( int pass = 0; pass < 8; pass++ ) {
+			histogram[pass][( key >> ( pass * 8 ) ) & 0xff]++;
+		}
+	}
+
+	for ( int pass = 0; pass < 8; pass++ ) {
+		int *count = histogram[pass];
+		int shift = pass * 8;
+
+		// every key has the same digit
+		if ( count[( keys[0] >> shift ) & 0xff] == numDrawSurfs ) {
+			continue;
+		}
+
+		int offset = 0;
+		for ( int i = 0; i < 256; i++ ) {
+			int c = count[i];
+			count[i] = offset;
+			offset += c;
+		}
+
+		for ( int i = 0; i < numDrawSurfs; i++ ) {
+			int dest = count[( keys[i] >> shift ) & 0xff]++;
+			tempKeys[dest] = keys[i];
+			tempIndexes[dest] = indexes[i];
+		}
+
+		idSwap( keys, tempKeys );
+		idSwap( indexes, tempIndexes );
+	}
+
+	drawSurf_t **sorted = (drawSurf_t **)R_FrameAlloc( numDrawSurfs * sizeof( sorted[0] ) );
+	for ( int i = 0; i < numDrawSurfs; i++ ) {
+		sorted[i] = drawSurfs[indexes[i]];
+	}
+	memcpy( drawSurfs, sorted, numDrawSurfs * sizeof( drawSurfs[0] ) );
+}
+
 /*
 =================
 R_SortDrawSurfs
 =================
 */
 static void R_SortDrawSurfs( void ) {
-	// sort the drawsurfs by sort type, then orientation, then shader
-	qsort( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs, sizeof( tr.viewDef->drawSurfs[0] ),
-		R_QsortSurfaces );
+	unsigned int start = Sys_Microseconds();
+
+	if ( r_useRadixSort.GetBool() && tr.viewDef->numDrawSurfs > 1 ) {
+		// sort the drawsurfs by sort class, then shader, then entity, then depth
+		R_RadixSortDrawSurfs( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs );
+	} else {
+		// sort the drawsurfs by sort type, then orientation, then shader
+		qsort( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs, sizeof( tr.viewDef->drawSurfs[0] ),
+			R_QsortSurfaces );
+	}
+
+	R_FrontEndCounters().c_sortedDrawSurfs += tr.viewDef->numDrawSurfs;
+	tr.pc.sortUsec += Sys_Microseconds() - start;
 }
 
 
@@ -1123,6 +1434,9 @@ void R_RenderView( viewDef_t *parms ) {
 	// lightDefs that are in them and pass culling.
 	static_cast<idRenderWorldLocal *>(parms->renderWorld)->FindViewLightsAndEntities();
 
+	// cull the lights and entities hidden behind the world geometry
+	R_OcclusionCull();
+
 	// constrain the view frustum to the view lights and entities
 	R_ConstrainViewFrustum();
 
@@ -0,0 +1,475 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code ("Doom 3 Source Code").
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "sys/platform.h"
+
+#include "renderer/tr_local.h"
+
+/*
+===========================================================================
+
+Software occlusion culling
+
+Portal flooding only culls to the portal frustums, so everything in a visible
+area is processed even if a wall or pillar in the same area hides it.  After
+the flood, the opaque world surfaces of the visible areas are rasterized front
+to back into a small software depth buffer, until r_occluderBudget triangles
+have been drawn, and the bounds of the view entities and lights are tested
+against it.
+
+Occluded entities get an empty scissor rect, so they are only used for the
+shadows they may still cast into view.  Occluded lights are removed from the
+view, because everything they can light is inside their bounds.
+
+The buffer holds 1/w of the nearest occluder, which is linear in screen space.
+Tiles keep the farthest value of their pixels for a quick reject.
+
+===========================================================================
+*/
+
+static const int	OCCLUSION_WIDTH = 256;
+static const int	OCCLUSION_HEIGHT = 128;
+static const int	OCCLUSION_TILE_SHIFT = 3;
+static const int	OCCLUSION_TILE_SIZE = 1 << OCCLUSION_TILE_SHIFT;
+static const int	OCCLUSION_TILES_WIDE = OCCLUSION_WIDTH >> OCCLUSION_TILE_SHIFT;
+static const int	OCCLUSION_TILES_HIGH = OCCLUSION_HEIGHT >> OCCLUSION_TILE_SHIFT;
+
+// tested bounds must be this much farther than the occluders
+static const float	OCCLUSION_DEPTH_BIAS = 1.01f;
+
+static float		occlusionDepth[OCCLUSION_HEIGHT][OCCLUSION_WIDTH];
+static float		occlusionTiles[OCCLUSION_TILES_HIGH][OCCLUSION_TILES_WIDE];
+
+typedef struct {
+	const viewEntity_t *	vEntity;
+	const srfTriangles_t *	tri;
+	cullType_t				cullType;
+	float					distance;
+} occluderSurface_t;
+
+/*
+=================
+R_SortOccluderSurfaces
+=================
+*/
+static int R_SortOccluderSurfaces( const void *a, const void *b ) {
+	const occluderSurface_t *ea = (const occluderSurface_t *)a;
+	const occluderSurface_t *eb = (const occluderSurface_t *)b;
+
+	if ( ea->distance < eb->distance ) {
+		return -1;
+	}
+	if ( ea->distance > eb->distance ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+=================
+R_ClipToOcclusionBuffer
+
+Returns false if the point is too close to the eye to be projected.
+=================
+*/
+static bool R_ClipToOcclusionBuffer( const idPlane &clip, idVec3 &screen ) {
+	if ( clip[3] < r_znear.GetFloat() ) {
+		return false;
+	}
+	float invW = 1.0f / clip[3];
+	screen[0] = ( clip[0] * invW * 0.5f + 0.5f ) * OCCLUSION_WIDTH;
+	screen[1] = ( clip[1] * invW * 0.5f + 0.5f ) * OCCLUSION_HEIGHT;
+	screen[2] = invW;
+	return true;
+}
+
+/*
+=================
+R_TransformToClip
+=================
+*/
+static ID_INLINE void R_TransformToClip( const idVec3 &v, const float mvp[16], idPlane &clip ) {
+	for ( int i = 0 ; i < 4 ; i++ ) {
+		clip[i] = v[0] * mvp[ i + 0 * 4 ] + v[1] * mvp[ i + 1 * 4 ] + v[2] * mvp[ i + 2 * 4 ] + mvp[ i + 3 * 4 ];
+	}
+}
+
+/*
+=================
+R_RasterizeOccluderTriangle
+
+Pixels are covered if their center is inside the triangle.
+=================
+*/
+static void R_RasterizeOccluderTriangle( const idVec3 &a, const idVec3 &b, const idVec3 &c ) {
+	const idVec3 *v0 = &a, *v1 = &b, *v2 = &c;
+
+	float area = ( b[0] - a[0] ) * ( c[1] - a[1] ) - ( c[0] - a[0] ) * ( b[1] - a[1] );
+	if ( area < 0.0f ) {
+		v1 = &c;
+		v2 = &b;
+		area = -area;
+	}
+	if ( area < 1e-4f ) {
+		return;
+	}
+
+	float minX = Min3( (*v0)[0], (*v1)[0], (*v2)[0] );
+	float maxX = Max3( (*v0)[0], (*v1)[0], (*v2)[0] );
+	float minY = Min3( (*v0)[1], (*v1)[1], (*v2)[1] );
+	float maxY = Max3( (*v0)[1], (*v1)[1], (*v2)[1] );
+
+	int x0 = Max( 0, (int)idMath::Ceil( minX - 0.5f ) );
+	int x1 = Min( OCCLUSION_WIDTH - 1, (int)idMath::Floor( maxX - 0.5f ) );
+	int y0 = Max( 0, (int)idMath::Ceil( minY - 0.5f ) );
+	int y1 = Min( OCCLUSION_HEIGHT - 1, (int)idMath::Floor( maxY - 0.5f ) );
+	if ( x0 > x1 || y0 > y1 ) {
+		return;
+	}
+
+	// edge functions, positive inside
+	const idVec3 *edgeStart[3] = { v1, v2, v0 };
+	const idVec3 *edgeEnd[3] = { v2, v0, v1 };
+	float stepX[3], stepY[3], row[3];
+	float px = x0 + 0.5f;
+	float py = y0 + 0.5f;
+	for ( int i = 0 ; i < 3 ; i++ ) {
+		const idVec3 &s = *edgeStart[i];
+		const idVec3 &e = *edgeEnd[i];
+		stepX[i] = -( e[1] - s[1] );
+		stepY[i] = e[0] - s[0];
+		row[i] = ( e[0] - s[0] ) * ( py - s[1] ) - ( e[1] - s[1] ) * ( px - s[0] );
+	}
+
+	// the edge functions are the barycentric weights of the opposite vertex
+	const float invArea = 1.0f / area;
+	const float depthX = ( stepX[0] * (*v0)[2] + stepX[1] * (*v1)[2] + stepX[2] * (*v2)[2] ) * invArea;
+	const float depthY = ( stepY[0] * (*v0)[2] + stepY[1] * (*v1)[2] + stepY[2] * (*v2)[2] ) * invArea;
+	float depthRow = ( row[0] * (*v0)[2] + row[1] * (*v1)[2] + row[2] * (*v2)[2] ) * invArea;
+
+	for ( int y = y0 ; y <= y1 ; y++ ) {
+		float e0 = row[0];
+		float e1 = row[1];
+		float e2 = row[2];
+		float depth = depthRow;
+		float *dest = occlusionDepth[y];
+
+		for ( int x = x0 ; x <= x1 ; x++ ) {
+			if ( e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && depth > dest[x] ) {
+				dest[x] = depth;
+			}
+			e0 += stepX[0];
+			e1 += stepX[1];
+			e2 += stepX[2];
+			depth += depthX;
+		}
+
+		row[0] += stepY[0];
+		row[1] += stepY[1];
+		row[2] += stepY[2];
+		depthRow += depthY;
+	}
+}
+
+enum {
+	PROJECTED_NOT_YET,
+	PROJECTED_IN_FRONT,
+	PROJECTED_BEHIND
+};
+
+/*
+=================
+R_RasterizeOccluderSurface
+
+Returns the number of triangles that were tested
+=================
+*/
+static int R_RasterizeOccluderSurface( const occluderSurface_t *surf, int maxTris ) {
+	const srfTriangles_t *tri = surf->tri;
+	const viewEntity_t *vEntity = surf->vEntity;
+	float mvp[16];
+	idVec3 localViewOrigin;
+
+	myGlMultMatrix( vEntity->modelViewMatrix, tr.viewDef->projectionMatrix, mvp );
+	R_GlobalPointToLocal( vEntity->modelMatrix, tr.viewDef->renderView.vieworg, localViewOrigin );
+
+	// vertexes are only projected when a triangle uses them, the budget may
+	// end the surface early and world surfaces can be large
+	idVec3 *screen = (idVec3 *)R_FrameAlloc( tri->numVerts * sizeof( screen[0] ) );
+	byte *projected = (byte *)R_ClearedFrameAlloc( tri->numVerts * sizeof( projected[0] ) );
+
+	int numTris = Min( tri->numIndexes / 3, maxTris );
+	for ( int i = 0 ; i < numTris ; i++ ) {
+		const glIndex_t *indexes = tri->indexes + i * 3;
+		int j;
+
+		for ( j = 0 ; j < 3 ; j++ ) {
+			const glIndex_t index = indexes[j];
+			if ( !projected[index] ) {
+				idPlane clip;
+				R_TransformToClip( tri->verts[index].xyz, mvp, clip );
+				projected[index] = R_ClipToOcclusionBuffer( clip, screen[index] ) ? PROJECTED_IN_FRONT : PROJECTED_BEHIND;
+			}
+			// triangles crossing the near plane are not clipped, just skipped
+			if ( projected[index] == PROJECTED_BEHIND ) {
+				break;
+			}
+		}
+		if ( j != 3 ) {
+			continue;
+		}
+
+		if ( surf->cullType != CT_TWO_SIDED ) {
+			const idVec3 &a = tri->verts[indexes[0]].xyz;
+			const idVec3 &b = tri->verts[indexes[1]].xyz;
+			const idVec3 &c = tri->verts[indexes[2]].xyz;
+			// same winding as the face planes
+			idVec3 normal = ( c - a ).Cross( b - a );
+			float side = normal * ( localViewOrigin - a );
+			if ( ( surf->cullType == CT_FRONT_SIDED ) == ( side < 0.0f ) ) {
+				continue;
+			}
+		}
+
+		R_RasterizeOccluderTriangle( screen[indexes[0]], screen[indexes[1]], screen[indexes[2]] );
+	}
+
+	return numTris;
+}
+
+/*
+=================
+R_IsOccluderSurface
+=================
+*/
+static bool R_IsOccluderSurface( const idMaterial *shader, const srfTriangles_t *tri ) {
+	if ( !shader || !tri || !tri->verts || !tri->indexes || tri->numIndexes == 0 ) {
+		return false;
+	}
+	if ( !shader->IsDrawn() || shader->Coverage() != MC_OPAQUE || shader->GetSort() != SS_OPAQUE ) {
+		return false;
+	}
+	if ( shader->Deform() != DFRM_NONE || shader->HasSubview() || shader->IsPortalSky() ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+=================
+R_RenderOcclusionBuffer
+
+Returns the number of occluder triangles
+=================
+*/
+static int R_RenderOcclusionBuffer( void ) {
+	const viewEntity_t *vEntity;
+	occluderSurface_t *surfs;
+	int numSurfs, maxSurfs;
+
+	memset( occlusionDepth, 0, sizeof( occlusionDepth ) );
+
+	// the world models of the visible areas
+	maxSurfs = 0;
+	for ( vEntity = tr.viewDef->viewEntitys ; vEntity ; vEntity = vEntity->next ) {
+		if ( !vEntity->scissorRect.IsEmpty() && vEntity->entityDef->parms.hModel->IsStaticWorldModel() ) {
+			maxSurfs += vEntity->entityDef->parms.hModel->NumSurfaces();
+		}
+	}
+	if ( !maxSurfs ) {
+		return 0;
+	}
+
+	surfs = (occluderSurface_t *)R_FrameAlloc( maxSurfs * sizeof( surfs[0] ) );
+	numSurfs = 0;
+	for ( vEntity = tr.viewDef->viewEntitys ; vEntity ; vEntity = vEntity->next ) {
+		const idRenderModel *model = vEntity->entityDef->parms.hModel;
+		if ( vEntity->scissorRect.IsEmpty() || !model->IsStaticWorldModel() ) {
+			continue;
+		}
+		for ( int i = 0 ; i < model->NumSurfaces() ; i++ ) {
+			const modelSurface_t *surf = model->Surface( i );
+			if ( !R_IsOccluderSurface( surf->shader, surf->geometry ) ) {
+				continue;
+			}
+			if ( R_CullLocalBox( surf->geometry->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
+				continue;
+			}
+			occluderSurface_t *occluder = &surfs[numSurfs++];
+			occluder->vEntity = vEntity;
+			occluder->tri = surf->geometry;
+			occluder->cullType = surf->shader->GetCullType();
+			idVec3 center;
+			R_LocalPointToGlobal( vEntity->modelMatrix, surf->geometry->bounds.GetCenter(), center );
+			occluder->distance = ( center - tr.viewDef->renderView.vieworg ).LengthSqr();
+		}
+	}
+
+	// front to back, so the budget goes to the nearest occluders
+	qsort( surfs, numSurfs, sizeof( surfs[0] ), R_SortOccluderSurfaces );
+
+	int budget = r_occluderBudget.GetInteger();
+	int numTris = 0;
+	for ( int i = 0 ; i < numSurfs && numTris < budget ; i++ ) {
+		numTris += R_RasterizeOccluderSurface( &surfs[i], budget - numTris );
+	}
+
+	// build the tiles, which hold the farthest depth of their pixels
+	for ( int ty = 0 ; ty < OCCLUSION_TILES_HIGH ; ty++ ) {
+		for ( int tx = 0 ; tx < OCCLUSION_TILES_WIDE ; tx++ ) {
+			float farthest = idMath::INFINITY;
+			for ( int y = ty << OCCLUSION_TILE_SHIFT ; y < ( ty + 1 ) << OCCLUSION_TILE_SHIFT ; y++ ) {
+				const float *src = &occlusionDepth[y][tx << OCCLUSION_TILE_SHIFT];
+				for ( int x = 0 ; x < OCCLUSION_TILE_SIZE ; x++ ) {
+					farthest = Min( farthest, src[x] );
+				}
+			}
+			occlusionTiles[ty][tx] = farthest;
+		}
+	}
+
+	return numTris;
+}
+
+/*
+=================
+R_BoundsOccluded
+
+The bounds are transformed by mvp, and must be entirely in front of the near plane to be culled.
+=================
+*/
+static bool R_BoundsOccluded( const idBounds &bounds, const float mvp[16] ) {
+	idVec3 mins( idMath::INFINITY, idMath::INFINITY, 0.0f );
+	idVec3 maxs( -idMath::INFINITY, -idMath::INFINITY, 0.0f );
+
+	for ( int i = 0 ; i < 8 ; i++ ) {
+		idVec3 corner( bounds[i&1][0], bounds[(i>>1)&1][1], bounds[(i>>2)&1][2] );
+		idPlane clip;
+		idVec3 screen;
+
+		R_TransformToClip( corner, mvp, clip );
+		if ( !R_ClipToOcclusionBuffer( clip, screen ) ) {
+			return false;
+		}
+		mins[0] = Min( mins[0], screen[0] );
+		mins[1] = Min( mins[1], screen[1] );
+		maxs[0] = Max( maxs[0], screen[0] );
+		maxs[1] = Max( maxs[1], screen[1] );
+		// 1/w is largest at the nearest corner
+		maxs[2] = Max( maxs[2], screen[2] );
+	}
+
+	// grow by a pixel for the pixel center sampling of the occluders
+	int x0 = Max( 0, (int)idMath::Floor( mins[0] ) - 1 );
+	int x1 = Min( OCCLUSION_WIDTH - 1, (int)idMath::Floor( maxs[0] ) + 1 );
+	int y0 = Max( 0, (int)idMath::Floor( mins[1] ) - 1 );
+	int y1 = Min( OCCLUSION_HEIGHT - 1, (int)idMath::Floor( maxs[1] ) + 1 );
+	if ( x0 > x1 || y0 > y1 ) {
+		// off screen, leave it to the frustum culling
+		return false;
+	}
+
+	const float nearest = maxs[2] * OCCLUSION_DEPTH_BIAS;
+
+	for ( int ty = y0 >> OCCLUSION_TILE_SHIFT ; ty <= y1 >> OCCLUSION_TILE_SHIFT ; ty++ ) {
+		for ( int tx = x0 >> OCCLUSION_TILE_SHIFT ; tx <= x1 >> OCCLUSION_TILE_SHIFT ; tx++ ) {
+			if ( occlusionTiles[ty][tx] > nearest ) {
+				continue;
+			}
+
+			// check the pixels of the tile that are covered
+			int px0 = Max( x0, tx << OCCLUSION_TILE_SHIFT );
+			int px1 = Min( x1, ( ( tx + 1 ) << OCCLUSION_TILE_SHIFT ) - 1 );
+			int py0 = Max( y0, ty << OCCLUSION_TILE_SHIFT );
+			int py1 = Min( y1, ( ( ty + 1 ) << OCCLUSION_TILE_SHIFT ) - 1 );
+			for ( int y = py0 ; y <= py1 ; y++ ) {
+				for ( int x = px0 ; x <= px1 ; x++ ) {
+					if ( occlusionDepth[y][x] <= nearest ) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+=================
+R_OcclusionCull
+
+Called after the portal flood has found the view lights and entities.
+=================
+*/
+void R_OcclusionCull( void ) {
+	viewEntity_t *vEntity;
+	viewLight_t *vLight, **ptr;
+	float mvp[16];
+
+	if ( !r_useOcclusionCulling.GetBool() || tr.viewDef->isSubview || r_occluderBudget.GetInteger() <= 0 ) {
+		return;
+	}
+
+	int numTris = R_RenderOcclusionBuffer();
+	R_FrontEndCounters().c_occluderTris += numTris;
+	if ( !numTris ) {
+		return;
+	}
+
+	for ( vEntity = tr.viewDef->viewEntitys ; vEntity ; vEntity = vEntity->next ) {
+		if ( vEntity->scissorRect.IsEmpty() ) {
+			continue;
+		}
+		// depth hacked models are drawn in front of the world
+		if ( vEntity->weaponDepthHack || vEntity->modelDepthHack != 0.0f ) {
+			continue;
+		}
+		myGlMultMatrix( vEntity->modelViewMatrix, tr.viewDef->projectionMatrix, mvp );
+		if ( R_BoundsOccluded( vEntity->entityDef->referenceBounds, mvp ) ) {
+			// it may still cast shadows into the view
+			vEntity->scissorRect.Clear();
+			R_FrontEndCounters().c_occludedEntities++;
+		}
+	}
+
+	myGlMultMatrix( tr.viewDef->worldSpace.modelViewMatrix, tr.viewDef->projectionMatrix, mvp );
+	ptr = &tr.viewDef->viewLights;
+	while ( *ptr ) {
+		vLight = *ptr;
+		if ( R_BoundsOccluded( vLight->lightDef->frustumTris->bounds, mvp ) ) {
+			// remove the light from the viewLights list, and change its frame marker
+			// so interaction generation doesn't think the light is visible
+			*ptr = vLight->next;
+			vLight->lightDef->viewCount = -1;
+			R_FrontEndCounters().c_occludedLights++;
+			continue;
+		}
+		ptr = &vLight->next;
+	}
+}
@@ -32,52 +32,87 @@ If you have questions concerning this license or the applicable additional terms
 
 /*
 ===============
-R_MeshCost
+R_VertexCacheMissRatio
+
+Average number of vertexes that have to be transformed per triangle
+with a FIFO post transform cache, 0.5 is about the best a regular grid
+can get and 3.0 means that nothing is ever reused.
 ===============
 */
-#if 0
-#define	CACHE_SIZE	24
-#define	STALL_SIZE	8
-int	R_MeshCost( int numIndexes, glIndex_t *indexes ) {
-	int	inCache[CACHE_SIZE];
+#define	FIFO_CACHE_SIZE		24
+
+float R_VertexCacheMissRatio( int numIndexes, const glIndex_t *indexes ) {
+	int	inCache[FIFO_CACHE_SIZE];
 	int	i, j, v;
-	int	c_stalls;
 	int	c_loads;
 	int	fifo;
 
-	for ( i = 0 ; i < CACHE_SIZE ; i++ ) {
+	if ( numIndexes < 3 ) {
+		return 0.0f;
+	}
+
+	for ( i = 0 ; i < FIFO_CACHE_SIZE ; i++ ) {
 		inCache[i] = -1;
 	}
 
 	c_loads = 0;
-	c_stalls = 0;
 	fifo = 0;
 
 	for ( i = 0 ; i < numIndexes ; i++ ) {
 		v = indexes[i];
-		for ( j = 0 ; j < CACHE_SIZE ; j++ ) {
-			if ( inCache[ ( fifo + j ) % CACHE_SIZE ] == v ) {
+		for ( j = 0 ; j < FIFO_CACHE_SIZE ; j++ ) {
+			if ( inCache[j] == v ) {
 				break;
 			}
 		}
-		if ( j == CACHE_SIZE ) {
+		if ( j == FIFO_CACHE_SIZE ) {
 			c_loads++;
-			inCache[ fifo % CACHE_SIZE ] = v;
+			inCache[ fifo % FIFO_CACHE_SIZE ] = v;
 			fifo++;
-		} else if ( j < STALL_SIZE ) {
-			c_stalls++;
 		}
 	}
 
-	return c_loads;
+	return (float)c_loads / ( numIndexes / 3 );
 }
-#endif
 
+/*
+===============
+R_VertexScore
+
+Scoring from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation":
+the three most recently used vertexes get a fixed score so the next
+triangle doesn't just reuse the last one, the rest of the LRU cache
+decays with age, and vertexes with few remaining triangles are boosted
+so they get finished off instead of leaving lone triangles behind.
+===============
+*/
+#define	LRU_CACHE_SIZE			32
+#define	CACHE_DECAY_POWER		1.5f
+#define	LAST_TRI_SCORE			0.75f
+#define	VALENCE_BOOST_SCALE		2.0f
+
+static float R_VertexScore( int cachePosition, int numActiveTris ) {
+	float	score;
+
+	if ( numActiveTris == 0 ) {
+		// no triangles left to use this vertex
+		return -1.0f;
+	}
+
+	score = 0.0f;
+	if ( cachePosition >= 0 ) {
+		if ( cachePosition < 3 ) {
+			score = LAST_TRI_SCORE;
+		} else {
+			score = 1.0f - ( cachePosition - 3 ) * ( 1.0f / ( LRU_CACHE_SIZE - 3 ) );
+			score = idMath::Pow( score, CACHE_DECAY_POWER );
+		}
+	}
 
-typedef struct vertRef_s {
-	struct vertRef_s	*next;
-	int			tri;
-} vertRef_t;
+	score += VALENCE_BOOST_SCALE * idMath::InvSqrt( (float)numActiveTris );
+
+	return score;
+}
 
 /*
 ====================
@@ -88,125 +123,197 @@ of the internal GPU vertex caches
 ====================
 */
 void R_OrderIndexes( int numIndexes, glIndex_t *indexes ) {
-	bool	*triangleUsed;
-	int			numTris;
-	glIndex_t	*oldIndexes;
-	glIndex_t	*base;
-	int			numOldIndexes;
-	int			tri;
-	int			i;
-	vertRef_t	*vref, **vrefs, *vrefTable;
-	int			numVerts;
-	int			v1, v2;
-	int			c_starts;
-	//int			c_cost;
-
-	if ( !r_orderIndexes.GetBool() ) {
-		return;
-	}
-
-	// save off the original indexes
-	oldIndexes = (glIndex_t *)_alloca( numIndexes * sizeof( *oldIndexes ) );
-	memcpy( oldIndexes, indexes, numIndexes * sizeof( *oldIndexes ) );
-	numOldIndexes = numIndexes;
+	idList<int>		vertTriCount;
+	idList<int>		vertTriStart;
+	idList<int>		vertTris;
+	idList<int>		vertCachePosition;
+	idList<float>	vertScore;
+	idList<bool>	triAdded;
+	idList<glIndex_t> oldIndexes;
+	int				cache[LRU_CACHE_SIZE+3];
+	int				newCache[LRU_CACHE_SIZE+3];
+	int				cacheSize, newCacheSize;
+	int				numTris, numVerts;
+	int				bestTri, nextUnadded;
+	float			bestScore;
+	int				i, j, k, v;
 
-	// make a table to mark the triangles when they are emited
 	numTris = numIndexes / 3;
-	triangleUsed = (bool *)_alloca( numTris * sizeof( *triangleUsed ) );
-	memset( triangleUsed, 0, numTris * sizeof( *triangleUsed ) );
+	if ( numTris < 2 ) {
+		return;
+	}
 
 	// find the highest vertex number
 	numVerts = 0;
 	for ( i = 0 ; i < numIndexes ; i++ ) {
-		if ( indexes[i] > numVerts ) {
-			numVerts = indexes[i];
+		if ( indexes[i] >= numVerts ) {
+			numVerts = indexes[i] + 1;
 		}
 	}
-	numVerts++;
 
-	// create a table of triangles used by each vertex
-	vrefs = (vertRef_t **)_alloca( numVerts * sizeof( *vrefs ) );
-	memset( vrefs, 0, numVerts * sizeof( *vrefs ) );
+	oldIndexes.SetNum( numIndexes );
+	memcpy( oldIndexes.Ptr(), indexes, numIndexes * sizeof( indexes[0] ) );
 
-	vrefTable = (vertRef_t *)_alloca( numIndexes * sizeof( *vrefTable ) );
+	// create a table of triangles used by each vertex, the first
+	// vertTriCount[v] entries are the ones that haven't been emitted yet
+	vertTriCount.AssureSize( numVerts, 0 );
 	for ( i = 0 ; i < numIndexes ; i++ ) {
-		tri = i / 3;
+		vertTriCount[oldIndexes[i]]++;
+	}
+	vertTriStart.SetNum( numVerts );
+	for ( i = 0, k = 0 ; i < numVerts ; i++ ) {
+		vertTriStart[i] = k;
+		k += vertTriCount[i];
+		vertTriCount[i] = 0;
+	}
+	vertTris.SetNum( numIndexes );
+	for ( i = 0 ; i < numIndexes ; i++ ) {
+		v = oldIndexes[i];
+		vertTris[vertTriStart[v] + vertTriCount[v]++] = i / 3;
+	}
 
-		vrefTable[i].tri = tri;
-		vrefTable[i].next = vrefs[oldIndexes[i]];
-		vrefs[oldIndexes[i]] = &vrefTable[i];
+	vertCachePosition.AssureSize( numVerts, -1 );
+	vertScore.SetNum( numVerts );
+	for ( i = 0 ; i < numVerts ; i++ ) {
+		vertScore[i] = R_VertexScore( -1, vertTriCount[i] );
 	}
 
-	// generate new indexes
-	numIndexes = 0;
-	c_starts = 0;
-	while ( numIndexes != numOldIndexes ) {
-		// find a triangle that hasn't been used
-		for ( tri = 0 ; tri < numTris ; tri++ ) {
-			if ( !triangleUsed[tri] ) {
-				break;
+	triAdded.AssureSize( numTris, false );
+
+	cacheSize = 0;
+	nextUnadded = 0;
+	bestTri = -1;
+
+	for ( numIndexes = 0 ; numIndexes < numTris * 3 ; numIndexes += 3 ) {
+		// if nothing in the cache has triangles left, start on the
+		// next unused one, which is usually a new disconnected piece
+		if ( bestTri == -1 ) {
+			while ( triAdded[nextUnadded] ) {
+				nextUnadded++;
 			}
-		}
-		if ( tri == numTris ) {
-			common->Error( "R_OrderIndexes: ran out of unused tris" );
+			bestTri = nextUnadded;
 		}
 
-		c_starts++;
-
-		do {
-			// emit this tri
-			base = oldIndexes + tri * 3;
-			indexes[numIndexes+0] = base[0];
-			indexes[numIndexes+1] = base[1];
-			indexes[numIndexes+2] = base[2];
-			numIndexes += 3;
-
-			triangleUsed[tri] = true;
-
-			// try to find a shared edge to another unused tri
-			for ( i = 0 ; i < 3 ; i++ ) {
-				v1 = base[i];
-				v2 = base[(i+1)%3];
-
-				for ( vref = vrefs[v1] ; vref ; vref = vref->next ) {
-					tri = vref->tri;
-					if ( triangleUsed[tri] ) {
-						continue;
-					}
-
-					// if this triangle also uses v2, grab it
-					if ( oldIndexes[tri*3+0] == v2
-						|| oldIndexes[tri*3+1] == v2
-						|| oldIndexes[tri*3+2] == v2 ) {
-						break;
-					}
-				}
-				if ( vref ) {
+		// emit this tri
+		const glIndex_t *base = oldIndexes.Ptr() + bestTri * 3;
+		indexes[numIndexes+0] = base[0];
+		indexes[numIndexes+1] = base[1];
+		indexes[numIndexes+2] = base[2];
+		triAdded[bestTri] = true;
+
+		// move the vertexes of the triangle to the front of the cache and
+		// remove the triangle from their lists of remaining triangles
+		newCacheSize = 0;
+		for ( i = 0 ; i < 3 ; i++ ) {
+			v = base[i];
+
+			int *tris = vertTris.Ptr() + vertTriStart[v];
+			for ( j = 0 ; j < vertTriCount[v] ; j++ ) {
+				if ( tris[j] == bestTri ) {
+					tris[j] = tris[--vertTriCount[v]];
 					break;
 				}
 			}
 
-			// if we couldn't chain off of any verts, we need to find a new one
-			if ( i == 3 ) {
-				break;
+			for ( j = 0 ; j < newCacheSize ; j++ ) {
+				if ( newCache[j] == v ) {
+					break;
+				}
 			}
-		} while ( 1 );
-	}
+			if ( j == newCacheSize ) {
+				newCache[newCacheSize++] = v;
+			}
+		}
+		for ( i = 0 ; i < cacheSize ; i++ ) {
+			v = cache[i];
+			if ( v != base[0] && v != base[1] && v != base[2] ) {
+				newCache[newCacheSize++] = v;
+			}
+		}
 
-	//c_cost = R_MeshCost( numIndexes, indexes );
+		// rescore the cached vertexes, including the ones that just fell out
+		for ( i = 0 ; i < newCacheSize ; i++ ) {
+			v = newCache[i];
+			vertCachePosition[v] = ( i < LRU_CACHE_SIZE ) ? i : -1;
+			vertScore[v] = R_VertexScore( vertCachePosition[v], vertTriCount[v] );
+		}
 
-}
+		// rescore the triangles they are used by and pick the best one
+		bestTri = -1;
+		bestScore = -1.0f;
+		for ( i = 0 ; i < newCacheSize ; i++ ) {
+			v = newCache[i];
+
+			const int *tris = vertTris.Ptr() + vertTriStart[v];
+			for ( j = 0 ; j < vertTriCount[v] ; j++ ) {
+				int tri = tris[j];
+				const glIndex_t *triIndexes = oldIndexes.Ptr() + tri * 3;
+				float score = vertScore[triIndexes[0]] + vertScore[triIndexes[1]] + vertScore[triIndexes[2]];
+				if ( score > bestScore ) {
+					bestScore = score;
+					bestTri = tri;
+				}
+			}
+		}
 
+		cacheSize = Min( newCacheSize, LRU_CACHE_SIZE );
+		memcpy( cache, newCache, cacheSize * sizeof( cache[0] ) );
+	}
+}
 
 /*
+====================
+R_OrderVertexes
 
-  add all triangles that can be specified by the vertexes in the last 14 cache positions
+Renumbers the vertexes in the order the indexes first reference them,
+so vertex fetching walks through memory linearly.  Vertexes that are
+not referenced at all are moved to the end.
 
-  pick a new vert to add to the cache
-  don't pick one in the 24 previous cache positions
-  try to pick one that will enable the creation of as many triangles as possible
+remap[newVertex] will be set to the old vertex number.
+====================
+*/
+void R_OrderVertexes( srfTriangles_t *tri, int *remap ) {
+	idList<int>	oldToNew;
+	int			i, v, numNew;
+
+	oldToNew.AssureSize( tri->numVerts, -1 );
+
+	numNew = 0;
+	for ( i = 0 ; i < tri->numIndexes ; i++ ) {
+		v = tri->indexes[i];
+		if ( oldToNew[v] == -1 ) {
+			oldToNew[v] = numNew;
+			remap[numNew] = v;
+			numNew++;
+		}
+		tri->indexes[i] = oldToNew[v];
+	}
+	for ( i = 0 ; i < tri->numVerts ; i++ ) {
+		if ( oldToNew[i] == -1 ) {
+			oldToNew[i] = numNew;
+			remap[numNew] = i;
+			numNew++;
+		}
+	}
 
-  look for a vert that shares an edge with the vert about to be evicted
+	R_RemapVertexes( tri, remap );
+}
 
+/*
+====================
+R_RemapVertexes
 
+Moves the vertexes of a surface so that new vertex i is old vertex
+remap[i].  The indexes are not touched.
+====================
 */
+void R_RemapVertexes( srfTriangles_t *tri, const int *remap ) {
+	idList<idDrawVert>	oldVerts;
+
+	oldVerts.SetNum( tri->numVerts );
+	SIMDProcessor->Memcpy( oldVerts.Ptr(), tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+
+	for ( int i = 0 ; i < tri->numVerts ; i++ ) {
+		tri->verts[i] = oldVerts[remap[i]];
+	}
+}
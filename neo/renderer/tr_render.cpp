@@ -220,6 +220,49 @@ void RB_LeaveDepthHack() {
 	qglMatrixMode(GL_MODELVIEW);
 }
 
+/*
+===============
+RB_SetDepthHack
+
+Enters the depth hack needed by space, or leaves any depth hack if space
+is NULL.  The projection matrix and depth range are only touched when the
+hack actually changes, so consecutive surfaces of the same entity don't
+reload them.  A model depth hack takes precedence over the weapon one.
+===============
+*/
+void RB_SetDepthHack( const viewEntity_t *space ) {
+	depthHack_t hack = DEPTHHACK_NONE;
+	float value = 0.0f;
+
+	if ( space ) {
+		if ( space->modelDepthHack != 0.0f ) {
+			hack = DEPTHHACK_MODEL;
+			value = space->modelDepthHack;
+		} else if ( space->weaponDepthHack ) {
+			hack = DEPTHHACK_WEAPON;
+		}
+	}
+
+	if ( hack == backEnd.depthHack && value == backEnd.depthHackValue ) {
+		return;
+	}
+
+	switch ( hack ) {
+	case DEPTHHACK_WEAPON:
+		RB_EnterWeaponDepthHack();
+		break;
+	case DEPTHHACK_MODEL:
+		RB_EnterModelDepthHack( value );
+		break;
+	default:
+		RB_LeaveDepthHack();
+		break;
+	}
+
+	backEnd.depthHack = hack;
+	backEnd.depthHackValue = value;
+}
+
 /*
 ====================
 RB_RenderDrawSurfListWithFunction
@@ -240,17 +283,12 @@ void RB_RenderDrawSurfListWithFunction( drawSurf_t **drawSurfs, int numDrawSurfs
 	for (i = 0  ; i < numDrawSurfs ; i++ ) {
 		drawSurf = drawSurfs[i];
 
-		// change the matrix if needed
+		// change the matrix and depth hack if needed
 		if ( drawSurf->space != backEnd.currentSpace ) {
 			qglLoadMatrixf( drawSurf->space->modelViewMatrix );
-		}
-
-		if ( drawSurf->space->weaponDepthHack ) {
-			RB_EnterWeaponDepthHack();
-		}
-
-		if ( drawSurf->space->modelDepthHack != 0.0f ) {
-			RB_EnterModelDepthHack( drawSurf->space->modelDepthHack );
+			RB_SetDepthHack( drawSurf->space );
+		} else {
+			backEnd.pc.c_entitySetupsSkipped++;
 		}
 
 		// change the scissor if needed
@@ -265,12 +303,10 @@ void RB_RenderDrawSurfListWithFunction( drawSurf_t **drawSurfs, int numDrawSurfs
 		// render it
 		triFunc_( drawSurf );
 
-		if ( drawSurf->space->weaponDepthHack || drawSurf->space->modelDepthHack != 0.0f ) {
-			RB_LeaveDepthHack();
-		}
-
 		backEnd.currentSpace = drawSurf->space;
 	}
+
+	RB_SetDepthHack( NULL );
 }
 
 /*
@@ -285,17 +321,12 @@ void RB_RenderDrawSurfChainWithFunction( const drawSurf_t *drawSurfs,
 	backEnd.currentSpace = NULL;
 
 	for ( drawSurf = drawSurfs ; drawSurf ; drawSurf = drawSurf->nextOnLight ) {
-		// change the matrix if needed
+		// change the matrix and depth hack if needed
 		if ( drawSurf->space != backEnd.currentSpace ) {
 			qglLoadMatrixf( drawSurf->space->modelViewMatrix );
-		}
-
-		if ( drawSurf->space->weaponDepthHack ) {
-			RB_EnterWeaponDepthHack();
-		}
-
-		if ( drawSurf->space->modelDepthHack ) {
-			RB_EnterModelDepthHack( drawSurf->space->modelDepthHack );
+			RB_SetDepthHack( drawSurf->space );
+		} else {
+			backEnd.pc.c_entitySetupsSkipped++;
 		}
 
 		// change the scissor if needed
@@ -310,12 +341,10 @@ void RB_RenderDrawSurfChainWithFunction( const drawSurf_t *drawSurfs,
 		// render it
 		triFunc_( drawSurf );
 
-		if ( drawSurf->space->weaponDepthHack || drawSurf->space->modelDepthHack != 0.0f ) {
-			RB_LeaveDepthHack();
-		}
-
 		backEnd.currentSpace = drawSurf->space;
 	}
+
+	RB_SetDepthHack( NULL );
 }
 
 /*
@@ -575,6 +604,11 @@ void RB_BeginDrawingView (void) {
 		viewDef->scissor.y2 + 1 - viewDef->scissor.y1 );
 	backEnd.currentScissor = viewDef->scissor;
 
+	// the projection matrix was just reset
+	backEnd.depthHack = DEPTHHACK_NONE;
+	backEnd.depthHackValue = 0.0f;
+	backEnd.depthFillMaterial = NULL;
+
 	// ensures that depth writes are enabled for the depth clear
 	GL_State( GLS_DEFAULT );
 
@@ -722,13 +756,7 @@ void RB_CreateSingleDrawInteractions( const drawSurf_t *surf, void (*DrawInterac
 	}
 
 	// hack depth range if needed
-	if ( surf->space->weaponDepthHack ) {
-		RB_EnterWeaponDepthHack();
-	}
-
-	if ( surf->space->modelDepthHack ) {
-		RB_EnterModelDepthHack( surf->space->modelDepthHack );
-	}
+	RB_SetDepthHack( surf->space );
 
 	inter.surf = surf;
 	inter.lightFalloffImage = vLight->falloffImage;
@@ -840,9 +868,7 @@ void RB_CreateSingleDrawInteractions( const drawSurf_t *surf, void (*DrawInterac
 	}
 
 	// unhack depth range if needed
-	if ( surf->space->weaponDepthHack || surf->space->modelDepthHack != 0.0f ) {
-		RB_LeaveDepthHack();
-	}
+	RB_SetDepthHack( NULL );
 }
 
 /*
@@ -1237,7 +1237,7 @@ srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 		common->Error( "R_CreateShadowVolume: tri->numVerts = %i", tri->numVerts );
 	}
 
-	tr.pc.c_createShadowVolumes++;
+	R_FrontEndCounters().c_createShadowVolumes++;
 
 	// use the fast infinite projection in dynamic situations, which
 	// trades somewhat more overdraw and no cap optimizations for
@@ -1668,7 +1668,7 @@ void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
 		return;
 	}
 
-	tr.pc.c_tangentIndexes += tri->numIndexes;
+	R_FrontEndCounters().c_tangentIndexes += tri->numIndexes;
 
 	if ( !tri->facePlanes && allocFacePlanes ) {
 		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
@@ -2124,8 +2124,8 @@ void R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifyS
 	// bust vertexes that share a mirrored edge into separate vertexes
 	R_DuplicateMirroredVertexes( tri );
 
-	// optimize the index order (not working?)
-//	R_OrderIndexes( tri->numIndexes, tri->indexes );
+	// the index and vertex order has already been optimized for the vertex
+	// cache by idRenderModelStatic::OrderSurfaces, which can save it to disk
 
 	R_CreateDupVerts( tri );
 
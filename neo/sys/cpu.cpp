@@ -79,27 +79,50 @@ static inline void CPUid(int index, int *a, int *b, int *c, int *d) {
 		"xchg %%" REG_b ", %%" REG_S
 		:	"=a" (*a), "=S" (*b),
 			"=c" (*c), "=d" (*d)
-		: "0" (index));
+		: "0" (index), "2" (0));
+}
+
+static inline unsigned int XGetBV(unsigned int index) {
+	unsigned int eax, edx;
+
+	__asm__ volatile
+	(	".byte 0x0f, 0x01, 0xd0"	// xgetbv, spelled out for old assemblers
+		:	"=a" (eax), "=d" (edx)
+		:	"c" (index));
+
+	return eax;
 }
 #elif defined(_MSC_VER)
 #include <intrin.h>
 static inline void CPUid(int index, int *a, int *b, int *c, int *d) {
 	int info[4] = { };
 
-	// VS2005 and up
-	__cpuid(info, index);
+	// VS2008 SP1 and up
+	__cpuidex(info, index, 0);
 
 	*a = info[0];
 	*b = info[1];
 	*c = info[2];
 	*d = info[3];
 }
+
+static inline unsigned int XGetBV(unsigned int index) {
+	// VS2010 SP1 and up
+	return (unsigned int)_xgetbv(index);
+}
 #else
 #error unsupported compiler
 #endif
 
 #define c_SSE3		(1 << 0)
+#define c_SSE41		(1 << 19)
+#define c_OSXSAVE	(1 << 27)
+#define c_AVX		(1 << 28)
 #define d_FXSAVE	(1 << 24)
+#define b7_AVX2		(1 << 5)
+
+#define XCR0_SSE	(1 << 1)
+#define XCR0_AVX	(1 << 2)
 
 static inline bool HasDAZ() {
 	int a, b, c, d;
@@ -125,6 +148,38 @@ static inline bool HasSSE3() {
 	return (c & c_SSE3) == c_SSE3;
 }
 
+static inline bool HasSSE41() {
+	int a, b, c, d;
+
+	CPUid(0, &a, &b, &c, &d);
+	if (a < 1)
+		return false;
+
+	CPUid(1, &a, &b, &c, &d);
+
+	return (c & c_SSE41) == c_SSE41;
+}
+
+static inline bool HasAVX2() {
+	int a, b, c, d, maxLeaf;
+
+	CPUid(0, &maxLeaf, &b, &c, &d);
+	if (maxLeaf < 7)
+		return false;
+
+	// the CPU has to support AVX and the OS has to save the ymm registers on context switches
+	CPUid(1, &a, &b, &c, &d);
+	if ((c & (c_OSXSAVE | c_AVX)) != (c_OSXSAVE | c_AVX))
+		return false;
+
+	if ((XGetBV(0) & (XCR0_SSE | XCR0_AVX)) != (XCR0_SSE | XCR0_AVX))
+		return false;
+
+	CPUid(7, &a, &b, &c, &d);
+
+	return (b & b7_AVX2) == b7_AVX2;
+}
+
 #define MXCSR_DAZ	(1 << 6)
 #define MXCSR_FTZ	(1 << 15)
 
@@ -214,6 +269,12 @@ int Sys_GetProcessorId( void ) {
 	// there is no SDL_HasSSE3() in SDL 1.2
 	if (HasSSE3())
 		flags |= CPUID_SSE3;
+
+	if (HasSSE41())
+		flags |= CPUID_SSE41;
+
+	if (HasAVX2())
+		flags |= CPUID_AVX2;
 #endif
 
 	if (SDL_HasAltiVec())
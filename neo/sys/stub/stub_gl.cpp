@@ -386,7 +386,14 @@ void APIENTRY glVertexPointer(GLint size, GLenum type, GLsizei stride, const GLv
 void APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height){};
 
 static void StubFunction( void ) {};
-GLExtension_t GLimp_ExtensionPointer( const char *a) { return StubFunction; };
+
+// the core functions resolve to the stubs above, so queries like glGetString
+// and glGetIntegerv give sane answers, extensions get a function that does nothing
+GLExtension_t GLimp_ExtensionPointer( const char *a) {
+#define QGLPROC(name, rettype, args) if ( strcmp( a, #name ) == 0 ) { return (GLExtension_t)name; }
+#include "renderer/qgl_proc.h"
+	return StubFunction;
+};
 
 bool GLimp_Init(glimpParms_t a) {return true;};
 void GLimp_SetGamma(unsigned short*a, unsigned short*b, unsigned short*c) {};
@@ -57,6 +57,10 @@ unsigned int idSysLocal::GetMilliseconds( void ) {
 	return Sys_Milliseconds();
 }
 
+unsigned int idSysLocal::GetMicroseconds( void ) {
+	return Sys_Microseconds();
+}
+
 int idSysLocal::GetProcessorId( void ) {
 	return Sys_GetProcessorId();
 }
@@ -47,6 +47,7 @@ public:
 	virtual void			DebugVPrintf( const char *fmt, va_list arg );
 
 	virtual unsigned int	GetMilliseconds( void );
+	virtual unsigned int	GetMicroseconds( void );
 	virtual int				GetProcessorId( void );
 	virtual void			FPU_SetFTZ( bool enable );
 	virtual void			FPU_SetDAZ( bool enable );
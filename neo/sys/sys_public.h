@@ -41,6 +41,8 @@ typedef enum {
 	CPUID_SSE2							= 0x00080,	// Streaming SIMD Extensions 2
 	CPUID_SSE3							= 0x00100,	// Streaming SIMD Extentions 3 aka Prescott's New Instructions
 	CPUID_ALTIVEC						= 0x00200,	// AltiVec
+	CPUID_SSE41							= 0x00400,	// Streaming SIMD Extensions 4.1
+	CPUID_AVX2							= 0x00800,	// Advanced Vector Extensions 2 (with OS support for the ymm state)
 } cpuidSimd_t;
 
 typedef enum {
@@ -121,6 +123,9 @@ void			Sys_Sleep( int msec );
 // any game related timing information should come from event timestamps
 unsigned int	Sys_Milliseconds( void );
 
+// Sys_Microseconds is for timing short code paths, it wraps around after about 71 minutes
+unsigned int	Sys_Microseconds( void );
+
 // returns a selection of the CPUID_* flags
 int				Sys_GetProcessorId( void );
 
@@ -336,6 +341,9 @@ enum {
 void				Sys_EnterCriticalSection( int index = CRITICAL_SECTION_ZERO );
 void				Sys_LeaveCriticalSection( int index = CRITICAL_SECTION_ZERO );
 
+// atomically replaces *ptr with newValue if it still holds oldValue, returns true if it did
+bool				Sys_CompareAndSwapPointer( void * volatile *ptr, void *oldValue, void *newValue );
+
 const int MAX_TRIGGER_EVENTS		= 4;
 
 enum {
@@ -362,6 +370,7 @@ public:
 	virtual void			DebugVPrintf( const char *fmt, va_list arg ) = 0;
 
 	virtual unsigned int	GetMilliseconds( void ) = 0;
+	virtual unsigned int	GetMicroseconds( void ) = 0;		// for timing short code paths, wraps around
 	virtual int				GetProcessorId( void ) = 0;
 	virtual void			FPU_SetFTZ( bool enable ) = 0;
 	virtual void			FPU_SetDAZ( bool enable ) = 0;
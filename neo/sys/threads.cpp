@@ -30,6 +30,9 @@ If you have questions concerning this license or the applicable additional terms
 #include <SDL_mutex.h>
 #include <SDL_thread.h>
 #include <SDL_timer.h>
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+#include <SDL_atomic.h>
+#endif
 
 #include "sys/platform.h"
 #include "framework/Common.h"
@@ -65,6 +68,23 @@ unsigned int Sys_Milliseconds() {
 	return SDL_GetTicks();
 }
 
+/*
+================
+Sys_Microseconds
+================
+*/
+unsigned int Sys_Microseconds() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	static const Uint64 frequency = SDL_GetPerformanceFrequency();
+	Uint64 counter = SDL_GetPerformanceCounter();
+
+	// split up to not overflow the multiplication
+	return (unsigned int)( ( counter / frequency ) * 1000000 + ( counter % frequency ) * 1000000 / frequency );
+#else
+	return SDL_GetTicks() * 1000;
+#endif
+}
+
 /*
 ==================
 Sys_InitThreads
@@ -163,6 +183,29 @@ void Sys_LeaveCriticalSection(int index) {
 		common->Error("ERROR: SDL_UnlockMutex failed\n");
 }
 
+/*
+==================
+Sys_CompareAndSwapPointer
+==================
+*/
+bool Sys_CompareAndSwapPointer( void * volatile *ptr, void *oldValue, void *newValue ) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return SDL_AtomicCASPtr( (void **)ptr, oldValue, newValue ) == SDL_TRUE;
+#elif defined(__GNUC__)
+	return __sync_bool_compare_and_swap( ptr, oldValue, newValue );
+#else
+	// not lock free, but still atomic
+	bool swapped = false;
+	Sys_EnterCriticalSection( CRITICAL_SECTION_SYS );
+	if ( *ptr == oldValue ) {
+		*ptr = newValue;
+		swapped = true;
+	}
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_SYS );
+	return swapped;
+#endif
+}
+
 /*
 ======================================================
 wait and trigger events
@@ -27,7 +27,9 @@ If you have questions concerning this license or the applicable additional terms
 */
 
 #include "sys/platform.h"
+#include "idlib/hashing/CRC32.h"
 #include "framework/FileSystem.h"
+#include "framework/CVarSystem.h"
 #include "framework/DeclEntityDef.h"
 
 #include "tools/compilers/aas/AASFile_local.h"
@@ -563,6 +565,102 @@ bool idAASSettings::ValidEntity( const char *classname ) const {
 #define AAS_VERTEX_GRANULARITY	4096
 #define AAS_EDGE_GRANULARITY	4096
 
+idCVar aas_binaryFiles( "aas_binaryFiles", "1", CVAR_BOOL | CVAR_SYSTEM, "load AAS files from their binary version and write it when it is missing or out of date" );
+
+// lumps of the binary AAS file
+typedef enum {
+	AASLUMP_SETTINGS,
+	AASLUMP_PLANES,
+	AASLUMP_VERTICES,
+	AASLUMP_EDGES,
+	AASLUMP_EDGEINDEX,
+	AASLUMP_FACES,
+	AASLUMP_FACEINDEX,
+	AASLUMP_AREAS,
+	AASLUMP_REACHABILITIES,
+	AASLUMP_SPECIALKEYS,
+	AASLUMP_NODES,
+	AASLUMP_PORTALS,
+	AASLUMP_PORTALINDEX,
+	AASLUMP_CLUSTERS,
+	AASLUMP_NUMLUMPS
+} aasLump_t;
+
+typedef struct aasBinaryLump_s {
+	int							offset;				// offset from the start of the file
+	int							num;				// number of elements
+} aasBinaryLump_t;
+
+typedef struct aasBinaryHeader_s {
+	int							ident;
+	int							version;
+	unsigned int				mapFileCRC;
+	unsigned int				textFileCRC;		// CRC of the text file this file was converted from
+	unsigned int				checksum;			// CRC of everything after the header
+	aasBinaryLump_t				lumps[AASLUMP_NUMLUMPS];
+} aasBinaryHeader_t;
+
+typedef struct aasBinaryArea_s {
+	int							numFaces;
+	int							firstFace;
+	idBounds					bounds;
+	idVec3						center;
+	unsigned short				flags;
+	unsigned short				contents;
+	short						cluster;
+	short						clusterAreaNum;
+	int							travelFlags;
+	int							numReachabilities;	// reachabilities of this area in the reachability lump
+} aasBinaryArea_t;
+
+typedef struct aasBinaryReach_s {
+	int							travelType;
+	short						toAreaNum;
+	short						numKeyVals;			// special reachability key/value pairs in the key lump
+	idVec3						start;
+	idVec3						end;
+	int							edgeNum;
+	int							travelTime;
+} aasBinaryReach_t;
+
+static const int aasLumpSizes[AASLUMP_NUMLUMPS] = {
+	sizeof( char ),
+	sizeof( idPlane ),
+	sizeof( aasVertex_t ),
+	sizeof( aasEdge_t ),
+	sizeof( aasIndex_t ),
+	sizeof( aasFace_t ),
+	sizeof( aasIndex_t ),
+	sizeof( aasBinaryArea_t ),
+	sizeof( aasBinaryReach_t ),
+	sizeof( char ),
+	sizeof( aasNode_t ),
+	sizeof( aasPortal_t ),
+	sizeof( aasIndex_t ),
+	sizeof( aasCluster_t )
+};
+
+/*
+================
+AAS_TextFileCRC
+
+  CRC of the text AAS file, zero if it can't be read.
+================
+*/
+static unsigned int AAS_TextFileCRC( const idStr &fileName ) {
+	void *buffer;
+	int length;
+	unsigned int textFileCRC;
+
+	length = fileSystem->ReadFile( fileName, &buffer );
+	if ( length <= 0 || !buffer ) {
+		return 0;
+	}
+	textFileCRC = CRC32_BlockChecksum( buffer, length );
+	fileSystem->FreeFile( buffer );
+	return textFileCRC;
+}
+
 /*
 ================
 idAASFileLocal::idAASFileLocal
@@ -745,11 +843,130 @@ bool idAASFileLocal::Write( const idStr &fileName, unsigned int mapFileCRC ) {
 	// close file
 	fileSystem->CloseFile( aasFile );
 
+	// the binary file is converted from the text file so both load exactly the same
+	if ( aas_binaryFiles.GetBool() ) {
+		idAASFileLocal textFile;
+		if ( textFile.LoadText( fileName, mapFileCRC ) ) {
+			textFile.WriteBinary( fileName + AAS_BINARY_EXTENSION, "fs_devpath", AAS_TextFileCRC( fileName ) );
+		}
+	}
+
 	common->Printf( "done.\n" );
 
 	return true;
 }
 
+/*
+================
+WriteLump
+================
+*/
+static void WriteLump( idFile_Memory &data, aasBinaryLump_t &lump, const void *buffer, int num, int size ) {
+	lump.offset = sizeof( aasBinaryHeader_t ) + data.Length();
+	lump.num = num;
+	data.Write( buffer, num * size );
+}
+
+/*
+================
+idAASFileLocal::WriteBinary
+
+  The binary file is a copy of the file in memory which only needs to be read to load it.
+  It's written in native byte order and only used on little endian systems.
+================
+*/
+bool idAASFileLocal::WriteBinary( const idStr &fileName, const char *basePath, unsigned int textFileCRC ) const {
+	int i, j, numKeyVals;
+	idFile *aasFile;
+	idFile_Memory data, settingsText, specialKeys;
+	idList<aasBinaryArea_t> binaryAreas;
+	idList<aasBinaryReach_t> binaryReach;
+	aasBinaryHeader_t header;
+	const idReachability *reach;
+	const idKeyValue *keyValue;
+
+	if ( Swap_IsBigEndian() ) {
+		return false;
+	}
+
+	data.SetGranularity( 1024 * 1024 );
+	settings.WriteToFile( &settingsText );
+
+	binaryAreas.SetNum( areas.Num() );
+	for ( i = 0; i < areas.Num(); i++ ) {
+		aasBinaryArea_t &area = binaryAreas[i];
+
+		area.numFaces = areas[i].numFaces;
+		area.firstFace = areas[i].firstFace;
+		area.bounds = areas[i].bounds;
+		area.center = areas[i].center;
+		area.flags = areas[i].flags;
+		area.contents = areas[i].contents;
+		area.cluster = areas[i].cluster;
+		area.clusterAreaNum = areas[i].clusterAreaNum;
+		area.travelFlags = areas[i].travelFlags;
+		area.numReachabilities = 0;
+
+		for ( reach = areas[i].reach; reach; reach = reach->next ) {
+			numKeyVals = 0;
+			if ( reach->travelType == TFL_SPECIAL ) {
+				const idDict &dict = static_cast<const idReachability_Special *>(reach)->dict;
+				numKeyVals = dict.GetNumKeyVals();
+				for ( j = 0; j < numKeyVals; j++ ) {
+					keyValue = dict.GetKeyVal( j );
+					specialKeys.Write( keyValue->GetKey().c_str(), keyValue->GetKey().Length() + 1 );
+					specialKeys.Write( keyValue->GetValue().c_str(), keyValue->GetValue().Length() + 1 );
+				}
+			}
+
+			aasBinaryReach_t &r = binaryReach.Alloc();
+			r.travelType = reach->travelType;
+			r.toAreaNum = reach->toAreaNum;
+			r.numKeyVals = numKeyVals;
+			r.start = reach->start;
+			r.end = reach->end;
+			r.edgeNum = reach->edgeNum;
+			r.travelTime = reach->travelTime;
+			area.numReachabilities++;
+		}
+	}
+
+	memset( &header, 0, sizeof( header ) );
+	WriteLump( data, header.lumps[AASLUMP_SETTINGS], settingsText.GetDataPtr(), settingsText.Length(), aasLumpSizes[AASLUMP_SETTINGS] );
+	WriteLump( data, header.lumps[AASLUMP_PLANES], planeList.Ptr(), planeList.Num(), aasLumpSizes[AASLUMP_PLANES] );
+	WriteLump( data, header.lumps[AASLUMP_VERTICES], vertices.Ptr(), vertices.Num(), aasLumpSizes[AASLUMP_VERTICES] );
+	WriteLump( data, header.lumps[AASLUMP_EDGES], edges.Ptr(), edges.Num(), aasLumpSizes[AASLUMP_EDGES] );
+	WriteLump( data, header.lumps[AASLUMP_EDGEINDEX], edgeIndex.Ptr(), edgeIndex.Num(), aasLumpSizes[AASLUMP_EDGEINDEX] );
+	WriteLump( data, header.lumps[AASLUMP_FACES], faces.Ptr(), faces.Num(), aasLumpSizes[AASLUMP_FACES] );
+	WriteLump( data, header.lumps[AASLUMP_FACEINDEX], faceIndex.Ptr(), faceIndex.Num(), aasLumpSizes[AASLUMP_FACEINDEX] );
+	WriteLump( data, header.lumps[AASLUMP_AREAS], binaryAreas.Ptr(), binaryAreas.Num(), aasLumpSizes[AASLUMP_AREAS] );
+	WriteLump( data, header.lumps[AASLUMP_REACHABILITIES], binaryReach.Ptr(), binaryReach.Num(), aasLumpSizes[AASLUMP_REACHABILITIES] );
+	WriteLump( data, header.lumps[AASLUMP_SPECIALKEYS], specialKeys.GetDataPtr(), specialKeys.Length(), aasLumpSizes[AASLUMP_SPECIALKEYS] );
+	WriteLump( data, header.lumps[AASLUMP_NODES], nodes.Ptr(), nodes.Num(), aasLumpSizes[AASLUMP_NODES] );
+	WriteLump( data, header.lumps[AASLUMP_PORTALS], portals.Ptr(), portals.Num(), aasLumpSizes[AASLUMP_PORTALS] );
+	WriteLump( data, header.lumps[AASLUMP_PORTALINDEX], portalIndex.Ptr(), portalIndex.Num(), aasLumpSizes[AASLUMP_PORTALINDEX] );
+	WriteLump( data, header.lumps[AASLUMP_CLUSTERS], clusters.Ptr(), clusters.Num(), aasLumpSizes[AASLUMP_CLUSTERS] );
+
+	header.ident = AAS_BINARY_FILEID;
+	header.version = AAS_BINARY_FILEVERSION;
+	header.mapFileCRC = crc;
+	header.textFileCRC = textFileCRC;
+	header.checksum = CRC32_BlockChecksum( data.GetDataPtr(), data.Length() );
+
+	aasFile = fileSystem->OpenFileWrite( fileName, basePath );
+	if ( !aasFile ) {
+		common->Warning( "Error opening %s", fileName.c_str() );
+		return false;
+	}
+	aasFile->Write( &header, sizeof( header ) );
+	aasFile->Write( data.GetDataPtr(), data.Length() );
+	fileSystem->CloseFile( aasFile );
+
+	common->Printf( "wrote %s\n", fileName.c_str() );
+
+	return true;
+}
+
 /*
 ================
 idAASFileLocal::ParseIndex
@@ -1101,6 +1318,34 @@ idAASFileLocal::Load
 ================
 */
 bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
+	common->Printf( "[Load AAS]\n" );
+	common->Printf( "loading %s\n", fileName.c_str() );
+
+	if ( aas_binaryFiles.GetBool() && LoadBinary( fileName, mapFileCRC ) ) {
+		common->Printf( "done.\n" );
+		return true;
+	}
+
+	if ( !LoadText( fileName, mapFileCRC ) ) {
+		return false;
+	}
+
+	// convert the text file so it loads faster next time
+	if ( aas_binaryFiles.GetBool() ) {
+		WriteBinary( fileName + AAS_BINARY_EXTENSION, "fs_savepath", AAS_TextFileCRC( fileName ) );
+	}
+
+	common->Printf( "done.\n" );
+
+	return true;
+}
+
+/*
+================
+idAASFileLocal::LoadText
+================
+*/
+bool idAASFileLocal::LoadText( const idStr &fileName, unsigned int mapFileCRC ) {
 	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
 	idToken token;
 	int depth;
@@ -1109,9 +1354,6 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 	name = fileName;
 	crc = mapFileCRC;
 
-	common->Printf( "[Load AAS]\n" );
-	common->Printf( "loading %s\n", name.c_str() );
-
 	if ( !src.LoadFile( name ) ) {
 		return false;
 	}
@@ -1136,6 +1378,7 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 		common->Warning( "AAS file '%s' is out of date", name.c_str() );
 		return false;
 	}
+	crc = c;
 
 	// clear the file in memory
 	Clear();
@@ -1195,7 +1438,169 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
-	common->Printf( "done.\n" );
+	return true;
+}
+
+/*
+================
+CopyLump
+================
+*/
+template< class type >
+static void CopyLump( idList<type> &list, const byte *data, const aasBinaryLump_t &lump ) {
+	list.SetNum( lump.num );
+	if ( lump.num > 0 ) {
+		memcpy( list.Ptr(), data + lump.offset, lump.num * sizeof( type ) );
+	}
+}
+
+/*
+================
+idAASFileLocal::LoadBinary
+
+  Loads the binary version of the file, which has to be converted from the same
+  text file for the same map.  The text file is only read to compare its CRC, the
+  binary file is used as is when there is no text file.
+================
+*/
+bool idAASFileLocal::LoadBinary( const idStr &fileName, unsigned int mapFileCRC ) {
+	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
+	int i, j, k, length, numReach;
+	unsigned int textFileCRC;
+	idStr binaryName;
+	void *buffer;
+	const byte *data;
+	const aasBinaryHeader_t *header;
+	const aasBinaryArea_t *binaryAreas;
+	const aasBinaryReach_t *binaryReach;
+	const char *key, *value, *keysEnd;
+	idReachability *newReach, **lastReach;
+	idReachability_Special *special;
+	bool valid;
+
+	if ( Swap_IsBigEndian() ) {
+		return false;
+	}
+
+	binaryName = fileName + AAS_BINARY_EXTENSION;
+	length = fileSystem->ReadFile( binaryName, &buffer );
+	if ( length <= 0 || !buffer ) {
+		return false;
+	}
+
+	data = ( const byte * ) buffer;
+	header = ( const aasBinaryHeader_t * ) buffer;
+	textFileCRC = AAS_TextFileCRC( fileName );
+
+	valid = ( length >= ( int ) sizeof( aasBinaryHeader_t ) );
+	valid = valid && header->ident == AAS_BINARY_FILEID && header->version == AAS_BINARY_FILEVERSION;
+	valid = valid && ( !mapFileCRC || header->mapFileCRC == mapFileCRC );
+	valid = valid && ( !textFileCRC || header->textFileCRC == textFileCRC );
+	for ( i = 0; valid && i < AASLUMP_NUMLUMPS; i++ ) {
+		const aasBinaryLump_t &lump = header->lumps[i];
+		valid = lump.offset >= ( int ) sizeof( aasBinaryHeader_t ) && lump.offset <= length && lump.num >= 0;
+		valid = valid && lump.num <= ( length - lump.offset ) / aasLumpSizes[i];
+	}
+	valid = valid && header->checksum == CRC32_BlockChecksum( data + sizeof( aasBinaryHeader_t ), length - sizeof( aasBinaryHeader_t ) );
+	if ( !valid ) {
+		common->Warning( "AAS file '%s' is out of date", binaryName.c_str() );
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	name = fileName;
+	crc = header->mapFileCRC;
+
+	Clear();
+
+	src.LoadMemory( ( const char * ) data + header->lumps[AASLUMP_SETTINGS].offset, header->lumps[AASLUMP_SETTINGS].num, binaryName );
+	valid = settings.FromParser( src );
+
+	CopyLump( planeList, data, header->lumps[AASLUMP_PLANES] );
+	CopyLump( vertices, data, header->lumps[AASLUMP_VERTICES] );
+	CopyLump( edges, data, header->lumps[AASLUMP_EDGES] );
+	CopyLump( edgeIndex, data, header->lumps[AASLUMP_EDGEINDEX] );
+	CopyLump( faces, data, header->lumps[AASLUMP_FACES] );
+	CopyLump( faceIndex, data, header->lumps[AASLUMP_FACEINDEX] );
+	CopyLump( nodes, data, header->lumps[AASLUMP_NODES] );
+	CopyLump( portals, data, header->lumps[AASLUMP_PORTALS] );
+	CopyLump( portalIndex, data, header->lumps[AASLUMP_PORTALINDEX] );
+	CopyLump( clusters, data, header->lumps[AASLUMP_CLUSTERS] );
+
+	// link the reachabilities in the same order as when the file was written
+	binaryAreas = ( const aasBinaryArea_t * ) ( data + header->lumps[AASLUMP_AREAS].offset );
+	binaryReach = ( const aasBinaryReach_t * ) ( data + header->lumps[AASLUMP_REACHABILITIES].offset );
+	key = ( const char * ) data + header->lumps[AASLUMP_SPECIALKEYS].offset;
+	keysEnd = key + header->lumps[AASLUMP_SPECIALKEYS].num;
+	numReach = 0;
+
+	areas.SetNum( header->lumps[AASLUMP_AREAS].num );
+	for ( i = 0; i < areas.Num(); i++ ) {
+		aasArea_t &area = areas[i];
+
+		area.numFaces = binaryAreas[i].numFaces;
+		area.firstFace = binaryAreas[i].firstFace;
+		area.bounds = binaryAreas[i].bounds;
+		area.center = binaryAreas[i].center;
+		area.flags = binaryAreas[i].flags;
+		area.contents = binaryAreas[i].contents;
+		area.cluster = binaryAreas[i].cluster;
+		area.clusterAreaNum = binaryAreas[i].clusterAreaNum;
+		area.travelFlags = binaryAreas[i].travelFlags;
+		area.reach = NULL;
+		area.rev_reach = NULL;
+
+		lastReach = &area.reach;
+		for ( j = 0; valid && j < binaryAreas[i].numReachabilities; j++, numReach++ ) {
+			if ( numReach >= header->lumps[AASLUMP_REACHABILITIES].num ) {
+				valid = false;
+				break;
+			}
+			const aasBinaryReach_t &r = binaryReach[numReach];
+
+			if ( r.travelType == TFL_SPECIAL ) {
+				newReach = special = new idReachability_Special();
+				for ( k = 0; k < r.numKeyVals; k++ ) {
+					value = ( const char * ) memchr( key, '\0', keysEnd - key );
+					if ( !value ) {
+						valid = false;
+						break;
+					}
+					value++;
+					if ( !memchr( value, '\0', keysEnd - value ) ) {
+						valid = false;
+						break;
+					}
+					special->dict.Set( key, value );
+					key = value + strlen( value ) + 1;
+				}
+			} else {
+				newReach = new idReachability();
+			}
+			newReach->travelType = r.travelType;
+			newReach->toAreaNum = r.toAreaNum;
+			newReach->fromAreaNum = i;
+			newReach->start = r.start;
+			newReach->end = r.end;
+			newReach->edgeNum = r.edgeNum;
+			newReach->travelTime = r.travelTime;
+			newReach->next = NULL;
+			*lastReach = newReach;
+			lastReach = &newReach->next;
+		}
+	}
+	valid = valid && numReach == header->lumps[AASLUMP_REACHABILITIES].num;
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !valid ) {
+		common->Warning( "AAS file '%s' is corrupt", binaryName.c_str() );
+		DeleteReachabilities();
+		Clear();
+		return false;
+	}
+
+	LinkReversedReachability();
 
 	return true;
 }
@@ -44,6 +44,11 @@ If you have questions concerning this license or the applicable additional terms
 #define AAS_FILEID					"DewmAAS"
 #define AAS_FILEVERSION				"1.07"
 
+// binary version of the text file, loaded without any parsing
+#define AAS_BINARY_FILEID			( ( 'B' << 24 ) + ( 'S' << 16 ) + ( 'A' << 8 ) + 'A' )
+#define AAS_BINARY_FILEVERSION		2
+#define AAS_BINARY_EXTENSION		".bin"
+
 // travel flags
 #define TFL_INVALID					BIT(0)		// not valid
 #define TFL_WALK					BIT(1)		// walking
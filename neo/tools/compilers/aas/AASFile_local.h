@@ -78,6 +78,10 @@ public:
 	void						DeleteClusters( void );
 
 private:
+	bool						LoadText( const idStr &fileName, unsigned int mapFileCRC );
+	bool						LoadBinary( const idStr &fileName, unsigned int mapFileCRC );
+	bool						WriteBinary( const idStr &fileName, const char *basePath, unsigned int textFileCRC ) const;
+
 	bool						ParseIndex( idLexer &src, idList<aasIndex_t> &indexes );
 	bool						ParsePlanes( idLexer &src );
 	bool						ParseVertices( idLexer &src );